@@ -2,130 +2,231 @@
 
 #include "complex/DataStructure/AttributeMatrix.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
+#include "complex/DataStructure/DataStore.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
 #include "complex/Utilities/Math/StatisticsCalculations.hpp"
 #include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
-#include <unordered_map>
+#include <algorithm>
+#include <thread>
 
 using namespace complex;
 
 namespace
 {
+/**
+ * @brief The selected values grouped by feature id in compressed sparse row
+ * layout. The values of feature i are Values[Offsets[i], Offsets[i + 1]).
+ */
 template <typename T>
-class FindArrayStatisticsByIndexImpl
+struct FeatureValueTable
+{
+  std::vector<usize> Offsets;
+  std::vector<T> Values;
+};
+
+/**
+ * @brief One pass of the counting sort that builds a FeatureValueTable. The tuples
+ * are split into contiguous chunks and every chunk has its own row of per feature
+ * positions, so chunks can run in parallel. The count pass increments the row,
+ * the scatter pass uses it as the write cursor of each feature.
+ */
+template <typename T>
+class SortByFeatureImpl
 {
 public:
-  FindArrayStatisticsByIndexImpl(std::unordered_map<int32, std::list<T>>& featureDataMap, bool length, bool min, bool max, bool mean, bool median, bool stdDeviation, bool summation,
-                                 std::vector<IDataArray*>& arrays, bool hist, float64 histmin, float64 histmax, bool histfullrange, int32 numBins)
-  : m_FeatureDataMap(featureDataMap)
-  , m_Length(length)
-  , m_Min(min)
-  , m_Max(max)
-  , m_Mean(mean)
-  , m_Median(median)
-  , m_StdDeviation(stdDeviation)
-  , m_Summation(summation)
-  , m_Histogram(hist)
-  , m_HistMin(histmin)
-  , m_HistMax(histmax)
-  , m_HistFullRange(histfullrange)
-  , m_NumBins(numBins)
-  , m_Arrays(arrays)
+  SortByFeatureImpl(const AbstractDataStore<T>& source, const AbstractDataStore<int32>& featureIds, const MaskCompare* mask, int32 numFeatures, usize chunkSize, std::vector<usize>& positions,
+                    T* values)
+  : m_Source(source)
+  , m_FeatureIds(featureIds)
+  , m_Mask(mask)
+  , m_NumFeatures(numFeatures)
+  , m_ChunkSize(chunkSize)
+  , m_Positions(positions)
+  , m_Values(values)
   {
   }
 
-  virtual ~FindArrayStatisticsByIndexImpl() = default;
-
-  void compute(usize start, usize end) const
+  void operator()(const Range& range) const
   {
-    auto* array0 = dynamic_cast<DataArray<uint64>*>(m_Arrays[0]);
-    if(m_Length && array0 == nullptr)
-    {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Length' array to needed type. Check input array selection.");
-    }
-    auto* array1 = dynamic_cast<DataArray<T>*>(m_Arrays[1]);
-    if(m_Min && array1 == nullptr)
-    {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Min' array to needed type. Check input array selection.");
-    }
-    auto* array2 = dynamic_cast<DataArray<T>*>(m_Arrays[2]);
-    if(m_Max && array2 == nullptr)
-    {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Max' array to needed type. Check input array selection.");
+    const usize numTuples = m_Source.getNumberOfTuples();
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      const usize start = chunk * m_ChunkSize;
+      const usize count = std::min(m_ChunkSize, numTuples - start);
+      usize* positions = m_Positions.data() + chunk * static_cast<usize>(m_NumFeatures);
+      m_FeatureIds.visitConstChunks(start, count, [this, positions](usize idsStart, nonstd::span<const int32> ids) {
+        m_Source.visitConstChunks(idsStart, ids.size(), [this, positions, idsStart, ids](usize valuesStart, nonstd::span<const T> values) {
+          const int32* chunkIds = ids.data() + (valuesStart - idsStart);
+          for(usize i = 0; i < values.size(); i++)
+          {
+            const int32 featureId = chunkIds[i];
+            if(featureId < 0 || featureId >= m_NumFeatures || (m_Mask != nullptr && !m_Mask->isTrue(valuesStart + i)))
+            {
+              continue;
+            }
+            if(m_Values == nullptr)
+            {
+              positions[featureId]++;
+            }
+            else
+            {
+              m_Values[positions[featureId]++] = values[i];
+            }
+          }
+        });
+      });
     }
-    auto* array3 = dynamic_cast<Float32Array*>(m_Arrays[3]);
-    if(m_Mean && array3 == nullptr)
-    {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Mean' array to needed type. Check input array selection.");
-    }
-    auto* array4 = dynamic_cast<Float32Array*>(m_Arrays[4]);
-    if(m_Median && array4 == nullptr)
-    {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Median' array to needed type. Check input array selection.");
-    }
-    auto* array5 = dynamic_cast<Float32Array*>(m_Arrays[5]);
-    if(m_StdDeviation && array5 == nullptr)
-    {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'StdDev' array to needed type. Check input array selection.");
-    }
-    auto* array6 = dynamic_cast<Float32Array*>(m_Arrays[6]);
-    if(m_Summation && array6 == nullptr)
-    {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Summation' array to needed type. Check input array selection.");
-    }
-    auto* array7 = dynamic_cast<Float32Array*>(m_Arrays[7]);
-    if(m_Histogram && array7 == nullptr)
+  }
+
+private:
+  const AbstractDataStore<T>& m_Source;
+  const AbstractDataStore<int32>& m_FeatureIds;
+  const MaskCompare* m_Mask;
+  int32 m_NumFeatures;
+  usize m_ChunkSize;
+  std::vector<usize>& m_Positions;
+  T* m_Values;
+};
+
+/**
+ * @brief Groups the selected values by feature id with a parallel counting sort.
+ * @param source
+ * @param featureIds
+ * @param mask Only values where the mask is true are included. May be null.
+ * @param numFeatures
+ * @return
+ */
+template <typename T>
+FeatureValueTable<T> SortByFeature(const DataArray<T>& source, const Int32Array& featureIds, const MaskCompare* mask, int32 numFeatures)
+{
+  const usize numTuples = source.getNumberOfTuples();
+  const usize numFeatureRows = static_cast<usize>(numFeatures);
+
+  // Every chunk needs a row of numFeatures positions, so the number of chunks
+  // is limited to keep the rows small compared to the input
+  const usize maxChunks = std::max(std::thread::hardware_concurrency(), 1U);
+  const usize numChunks = std::clamp<usize>(numTuples / std::max<usize>(numFeatureRows, 1), 1, maxChunks);
+  const usize chunkSize = std::max<usize>((numTuples + numChunks - 1) / numChunks, 1);
+
+  std::vector<usize> positions(numChunks * numFeatureRows, 0);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numTuples == 0 ? 0 : (numTuples + chunkSize - 1) / chunkSize);
+  dataAlg.execute(SortByFeatureImpl<T>(source.getDataStoreRef(), featureIds.getDataStoreRef(), mask, numFeatures, chunkSize, positions, nullptr));
+
+  // Turn the per chunk counts into per chunk write cursors
+  FeatureValueTable<T> table;
+  table.Offsets.resize(numFeatureRows + 1, 0);
+  usize offset = 0;
+  for(usize featureId = 0; featureId < numFeatureRows; featureId++)
+  {
+    table.Offsets[featureId] = offset;
+    for(usize chunk = 0; chunk < numChunks; chunk++)
     {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Histogram' array to needed type. Check input array selection.");
+      usize& position = positions[chunk * numFeatureRows + featureId];
+      const usize count = position;
+      position = offset;
+      offset += count;
     }
+  }
+  table.Offsets[numFeatureRows] = offset;
+
+  table.Values.resize(offset);
+  dataAlg.execute(SortByFeatureImpl<T>(source.getDataStoreRef(), featureIds.getDataStoreRef(), mask, numFeatures, chunkSize, positions, table.Values.data()));
+
+  return table;
+}
 
+/**
+ * @brief Computes the requested statistics of each feature from its contiguous
+ * values in a FeatureValueTable. Length, min, max, sum, mean and standard deviation
+ * are gathered in a single pass. The histogram takes a second pass and the median
+ * a partial sort, both only when requested.
+ */
+template <typename T>
+class FindArrayStatisticsByIndexImpl
+{
+public:
+  FindArrayStatisticsByIndexImpl(FeatureValueTable<T>& featureValues, const FindArrayStatisticsInputValues* inputValues, std::vector<IDataArray*>& arrays)
+  : m_FeatureValues(featureValues)
+  , m_InputValues(inputValues)
+  {
+    m_LengthArray = GetOutputArray<uint64>(inputValues->FindLength, arrays[0], "Length");
+    m_MinArray = GetOutputArray<T>(inputValues->FindMin, arrays[1], "Min");
+    m_MaxArray = GetOutputArray<T>(inputValues->FindMax, arrays[2], "Max");
+    m_MeanArray = GetOutputArray<float32>(inputValues->FindMean, arrays[3], "Mean");
+    m_MedianArray = GetOutputArray<float32>(inputValues->FindMedian, arrays[4], "Median");
+    m_StdDeviationArray = GetOutputArray<float32>(inputValues->FindStdDeviation, arrays[5], "StdDev");
+    m_SummationArray = GetOutputArray<float32>(inputValues->FindSummation, arrays[6], "Summation");
+    m_HistogramArray = GetOutputArray<float32>(inputValues->FindHistogram, arrays[7], "Histogram");
+  }
+
+  virtual ~FindArrayStatisticsByIndexImpl() = default;
+
+  void compute(usize start, usize end) const
+  {
     for(usize i = start; i < end; i++)
     {
-      if(m_Length)
+      T* first = m_FeatureValues.Values.data() + m_FeatureValues.Offsets[i];
+      T* last = m_FeatureValues.Values.data() + m_FeatureValues.Offsets[i + 1];
+      const usize count = static_cast<usize>(last - first);
+
+      // Single pass accumulators. Welford's update keeps the variance stable for large features.
+      T minValue = count == 0 ? static_cast<T>(0) : *first;
+      T maxValue = minValue;
+      auto sum = decltype(StaticicsCalculations::computeSum(std::vector<T>{})){0};
+      float64 mean = 0.0;
+      float64 m2 = 0.0;
+      usize n = 0;
+      for(const T* value = first; value != last; ++value)
       {
-        uint64 val = static_cast<uint64>(m_FeatureDataMap[i].size());
-        array0->initializeTuple(i, val);
+        minValue = std::min(minValue, *value);
+        maxValue = std::max(maxValue, *value);
+        sum += *value;
+        n++;
+        const float64 delta = static_cast<float64>(*value) - mean;
+        mean += delta / static_cast<float64>(n);
+        m2 += delta * (static_cast<float64>(*value) - mean);
       }
-      if(m_Min)
+
+      if(m_LengthArray != nullptr)
       {
-        T val = StaticicsCalculations::findMin(m_FeatureDataMap[i]);
-        array1->initializeTuple(i, val);
+        m_LengthArray->initializeTuple(i, static_cast<uint64>(count));
       }
-      if(m_Max)
+      if(m_MinArray != nullptr)
       {
-        T val = StaticicsCalculations::findMax(m_FeatureDataMap[i]);
-        array2->initializeTuple(i, val);
+        m_MinArray->initializeTuple(i, minValue);
       }
-      if(m_Mean)
+      if(m_MaxArray != nullptr)
       {
-        float32 val = StaticicsCalculations::findMean(m_FeatureDataMap[i]);
-        array3->initializeTuple(i, val);
+        m_MaxArray->initializeTuple(i, maxValue);
       }
-      if(m_Median)
+      if(m_MeanArray != nullptr)
       {
-        float32 val = StaticicsCalculations::findMedian(m_FeatureDataMap[i]);
-        array4->initializeTuple(i, val);
+        m_MeanArray->initializeTuple(i, static_cast<float32>(mean));
       }
-      if(m_StdDeviation)
+      if(m_StdDeviationArray != nullptr)
       {
-        float32 val = StaticicsCalculations::findStdDeviation(m_FeatureDataMap[i]);
-        array5->initializeTuple(i, val);
+        m_StdDeviationArray->initializeTuple(i, count == 0 ? 0.0f : static_cast<float32>(std::sqrt(m2 / static_cast<float64>(count))));
       }
-      if(m_Summation)
+      if(m_SummationArray != nullptr)
       {
-        float32 val = StaticicsCalculations::findSummation(m_FeatureDataMap[i]);
-        array6->initializeTuple(i, val);
+        m_SummationArray->initializeTuple(i, static_cast<float32>(sum));
       }
-      if(m_Histogram)
+      if(m_HistogramArray != nullptr)
       {
-        auto* arr7DataStore = array7->getDataStore();
-        if(arr7DataStore != nullptr)
+        auto* histogramStore = m_HistogramArray->getDataStore();
+        if(histogramStore != nullptr)
         {
-          std::vector<float32> vals = StaticicsCalculations::findHistogram(m_FeatureDataMap[i], m_HistMin, m_HistMax, m_HistFullRange, m_NumBins);
-          arr7DataStore->setTuple(i, vals);
+          histogramStore->setTuple(i, findHistogram(first, last, minValue, maxValue));
         }
       }
+      // The partial sort reorders the feature's values so it has to come last
+      if(m_MedianArray != nullptr)
+      {
+        m_MedianArray->initializeTuple(i, findMedian(first, last));
+      }
     }
   }
 
@@ -135,38 +236,123 @@ public:
   }
 
 private:
-  std::unordered_map<int32, std::list<T>>& m_FeatureDataMap;
-  bool m_Length;
-  bool m_Min;
-  bool m_Max;
-  bool m_Mean;
-  bool m_Median;
-  bool m_StdDeviation;
-  bool m_Summation;
-  bool m_Histogram;
-  float64 m_HistMin;
-  float64 m_HistMax;
-  bool m_HistFullRange;
-  int32 m_NumBins;
-  std::vector<IDataArray*>& m_Arrays;
+  template <typename U>
+  static DataArray<U>* GetOutputArray(bool enabled, IDataArray* array, const std::string& name)
+  {
+    if(!enabled)
+    {
+      return nullptr;
+    }
+    auto* outputArray = dynamic_cast<DataArray<U>*>(array);
+    if(outputArray == nullptr)
+    {
+      throw std::invalid_argument(fmt::format("FindArrayStatisticsByIndexImpl could not dynamic_cast '{}' array to needed type. Check input array selection.", name));
+    }
+    return outputArray;
+  }
+
+  /**
+   * @brief Same binning as StaticicsCalculations::findHistogram
+   */
+  std::vector<float32> findHistogram(const T* first, const T* last, T minValue, T maxValue) const
+  {
+    int32 numBins = m_InputValues->NumBins;
+    if(first == last)
+    {
+      return std::vector<float32>(numBins, 0);
+    }
+
+    float32 min = static_cast<float32>(m_InputValues->MinRange);
+    float32 max = static_cast<float32>(m_InputValues->MaxRange);
+    if(m_InputValues->UseFullRange)
+    {
+      min = static_cast<float32>(minValue);
+      max = static_cast<float32>(maxValue);
+    }
+
+    const float32 increment = (max - min) / static_cast<float32>(numBins);
+    if(std::abs(increment) < 1E-10)
+    {
+      numBins = 1;
+    }
+
+    std::vector<float32> histogram(numBins, 0);
+    if(numBins == 1)
+    {
+      histogram[0] = static_cast<float32>(last - first);
+      return histogram;
+    }
+    for(const T* value = first; value != last; ++value)
+    {
+      const float32 floatValue = static_cast<float32>(*value);
+      const auto bin = static_cast<usize>((floatValue - min) / increment);
+      if(bin < static_cast<usize>(numBins))
+      {
+        histogram[bin]++;
+      }
+      else if(floatValue == max)
+      {
+        histogram[numBins - 1]++;
+      }
+    }
+    return histogram;
+  }
+
+  /**
+   * @brief Finds the median with nth_element instead of a full sort. Reorders the values.
+   */
+  static float32 findMedian(T* first, T* last)
+  {
+    const usize count = static_cast<usize>(last - first);
+    if(count == 0)
+    {
+      return 0.0f;
+    }
+    T* high = first + count / 2;
+    std::nth_element(first, high, last);
+    if(count % 2 == 1)
+    {
+      return static_cast<float32>(*high);
+    }
+    // The lower middle value is the largest value of the lower partition
+    const T low = *std::max_element(first, high);
+    return (static_cast<float32>(low) + static_cast<float32>(*high)) * 0.5f;
+  }
+
+  FeatureValueTable<T>& m_FeatureValues;
+  const FindArrayStatisticsInputValues* m_InputValues;
+  DataArray<uint64>* m_LengthArray = nullptr;
+  DataArray<T>* m_MinArray = nullptr;
+  DataArray<T>* m_MaxArray = nullptr;
+  Float32Array* m_MeanArray = nullptr;
+  Float32Array* m_MedianArray = nullptr;
+  Float32Array* m_StdDeviationArray = nullptr;
+  Float32Array* m_SummationArray = nullptr;
+  Float32Array* m_HistogramArray = nullptr;
 };
 
 // -----------------------------------------------------------------------------
 template <typename T>
-void findStatisticsByIndexImpl(std::unordered_map<int32, std::list<T>>& featureDataMap, std::vector<IDataArray*>& arrays, const FindArrayStatisticsInputValues* inputValues, int32 numFeatures)
+void findStatisticsByIndexImpl(FeatureValueTable<T>& featureValues, std::vector<IDataArray*>& arrays, const FindArrayStatisticsInputValues* inputValues, int32 numFeatures)
 {
   // Allow data-based parallelization
   ParallelDataAlgorithm dataAlg;
   dataAlg.setRange(0, numFeatures);
-  dataAlg.execute(FindArrayStatisticsByIndexImpl<T>(featureDataMap, inputValues->FindLength, inputValues->FindMin, inputValues->FindMax, inputValues->FindMean, inputValues->FindMedian,
-                                                    inputValues->FindStdDeviation, inputValues->FindSummation, arrays, inputValues->FindHistogram, inputValues->MinRange, inputValues->MaxRange,
-                                                    inputValues->UseFullRange, inputValues->NumBins));
+  dataAlg.execute(FindArrayStatisticsByIndexImpl<T>(featureValues, inputValues, arrays));
 }
 
 // -----------------------------------------------------------------------------
 template <typename T>
-void findStatisticsImpl(std::vector<T>& data, std::vector<IDataArray*>& arrays, const FindArrayStatisticsInputValues* inputValues)
+void findStatisticsImpl(nonstd::span<const T> data, std::vector<IDataArray*>& arrays, const FindArrayStatisticsInputValues* inputValues)
 {
+  // Min, max, mean, standard deviation and sum all come from one parallel pass
+  StaticicsCalculations::SpanSummary<T> summary;
+  if(inputValues->FindMin || inputValues->FindMax || inputValues->FindMean || inputValues->FindStdDeviation || inputValues->FindSummation ||
+     (inputValues->FindHistogram && inputValues->UseFullRange))
+  {
+    summary = StaticicsCalculations::summarize(data);
+  }
+
   if(inputValues->FindLength)
   {
     auto* array0 = dynamic_cast<DataArray<uint64>*>(arrays[0]);
@@ -184,7 +370,7 @@ void findStatisticsImpl(std::vector<T>& data, std::vector<IDataArray*>& arrays,
     {
       throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Min' array to needed type. Check input array selection.");
     }
-    T val = StaticicsCalculations::findMin(data);
+    T val = summary.Min;
     array1->initializeTuple(0, val);
   }
   if(inputValues->FindMax)
@@ -194,7 +380,7 @@ void findStatisticsImpl(std::vector<T>& data, std::vector<IDataArray*>& arrays,
     {
       throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Max' array to needed type. Check input array selection.");
     }
-    T val = StaticicsCalculations::findMax(data);
+    T val = summary.Max;
     array2->initializeTuple(0, val);
   }
   if(inputValues->FindMean)
@@ -204,7 +390,7 @@ void findStatisticsImpl(std::vector<T>& data, std::vector<IDataArray*>& arrays,
     {
       throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Mean' array to needed type. Check input array selection.");
     }
-    float32 val = StaticicsCalculations::findMean(data);
+    float32 val = summary.Count == 0 ? 0.0f : static_cast<float32>(static_cast<float64>(summary.Sum) / static_cast<float64>(summary.Count));
     array3->initializeTuple(0, val);
   }
   if(inputValues->FindMedian)
@@ -224,7 +410,7 @@ void findStatisticsImpl(std::vector<T>& data, std::vector<IDataArray*>& arrays,
     {
       throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'StdDev' array to needed type. Check input array selection.");
     }
-    float32 val = StaticicsCalculations::findStdDeviation(data);
+    float32 val = summary.Count == 0 ? 0.0f : static_cast<float32>(std::sqrt(summary.M2 / static_cast<float64>(summary.Count)));
     array5->initializeTuple(0, val);
   }
   if(inputValues->FindSummation)
@@ -234,7 +420,7 @@ void findStatisticsImpl(std::vector<T>& data, std::vector<IDataArray*>& arrays,
     {
       throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Summation' array to needed type. Check input array selection.");
     }
-    float32 val = StaticicsCalculations::findSummation(data);
+    float32 val = static_cast<float32>(summary.Sum);
     array6->initializeTuple(0, val);
   }
   if(inputValues->FindHistogram)
@@ -247,7 +433,15 @@ void findStatisticsImpl(std::vector<T>& data, std::vector<IDataArray*>& arrays,
     auto* arr7DataStore = array7->getDataStore();
     if(arr7DataStore != nullptr)
     {
-      std::vector<float32> vals = StaticicsCalculations::findHistogram(data, inputValues->MinRange, inputValues->MaxRange, inputValues->UseFullRange, inputValues->NumBins);
+      // The full range was already found with the other statistics
+      float32 histMin = inputValues->MinRange;
+      float32 histMax = inputValues->MaxRange;
+      if(inputValues->UseFullRange)
+      {
+        histMin = static_cast<float32>(summary.Min);
+        histMax = static_cast<float32>(summary.Max);
+      }
+      std::vector<float32> vals = StaticicsCalculations::findHistogram(data, histMin, histMax, false, inputValues->NumBins);
       arr7DataStore->setTuple(0, vals);
     }
   }
@@ -261,50 +455,36 @@ void findStatistics(const DataArray<T>& source, const Int32Array* featureIds, co
   usize numTuples = source.getNumberOfTuples();
   if(inputValues->ComputeByIndex)
   {
-    std::unordered_map<int32, std::list<T>> featureValueMap;
-
-    for(size_t i = 0; i < numTuples; i++)
-    {
-      if(inputValues->UseMask)
-      {
-        if(mask->isTrue(i))
-        {
-          featureValueMap[featureIds->at(i)].push_back(source[i]);
-        }
-      }
-      else
-      {
-        featureValueMap[featureIds->at(i)].push_back(source[i]);
-      }
-    }
+    // group the values by feature/ensemble id
+    FeatureValueTable<T> featureValues = SortByFeature<T>(source, *featureIds, inputValues->UseMask ? mask.get() : nullptr, numFeatures);
 
-    // compute the statistics by feature/ensemble id
-    findStatisticsByIndexImpl<T>(featureValueMap, arrays, inputValues, numFeatures);
+    findStatisticsByIndexImpl<T>(featureValues, arrays, inputValues, numFeatures);
+    return;
   }
-  else
+
+  // Contiguous values are used in place
+  const auto* inMemoryStore = dynamic_cast<const DataStore<T>*>(source.getDataStore());
+  if(inMemoryStore != nullptr && !inputValues->UseMask)
   {
-    std::vector<T> data;
-    data.reserve(numTuples);
-    for(size_t i = 0; i < numTuples; i++)
+    findStatisticsImpl<T>(nonstd::span<const T>(inMemoryStore->data(), numTuples), arrays, inputValues);
+    return;
+  }
+
+  // Otherwise the selected values are gathered first
+  std::vector<T> data;
+  data.reserve(numTuples);
+  source.getDataStoreRef().visitConstChunks(0, numTuples, [&data, &mask, inputValues](usize start, nonstd::span<const T> values) {
+    for(usize i = 0; i < values.size(); i++)
     {
-      if(inputValues->UseMask)
+      if(!inputValues->UseMask || mask->isTrue(start + i))
       {
-        if(mask->isTrue(i))
-        {
-          data.push_back(source[i]);
-        }
-      }
-      else
-      {
-        data.push_back(source[i]);
+        data.push_back(values[i]);
       }
     }
+  });
 
-    data.shrink_to_fit();
-
-    // compute the statistics for the entire array
-    findStatisticsImpl<T>(data, arrays, inputValues);
-  }
+  // compute the statistics for the entire array
+  findStatisticsImpl<T>(nonstd::span<const T>(data.data(), data.size()), arrays, inputValues);
 }
 
 // -----------------------------------------------------------------------------
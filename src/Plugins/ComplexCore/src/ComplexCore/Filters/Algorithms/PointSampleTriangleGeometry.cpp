@@ -120,6 +120,8 @@ Result<> PointSampleTriangleGeometry::operator()()
   {
     ::AddTupleTransferInstance(m_DataStructure, m_Inputs->pSelectedDataArrayPaths[i], m_Inputs->pCreatedDataArrayPaths[i], tupleTransferFunctions);
   }
+  // The triangle each vertex was sampled from
+  std::vector<TupleTransferIndices> transferIndices(tupleTransferFunctions.empty() ? 0 : m_Inputs->pNumberOfSamples);
 
   for(int64_t curVertex = 0; curVertex < m_Inputs->pNumberOfSamples; curVertex++)
   {
@@ -167,10 +169,9 @@ Result<> PointSampleTriangleGeometry::operator()()
     (*vertices)[curVertex * 3 + 1] = (prefactorA * a[1]) + (prefactorB * b[1]) + (prefactorC * c[1]);
     (*vertices)[curVertex * 3 + 2] = (prefactorA * a[2]) + (prefactorB * b[2]) + (prefactorC * c[2]);
 
-    // Transfer the face data to the vertex data
-    for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
+    if(!transferIndices.empty())
     {
-      tupleTransferFunctions[dataVectorIndex]->transfer(randomTri, curVertex);
+      transferIndices[curVertex] = {static_cast<usize>(curVertex), static_cast<usize>(randomTri), static_cast<usize>(randomTri)};
     }
 
     if(counter > prog)
@@ -183,5 +184,11 @@ Result<> PointSampleTriangleGeometry::operator()()
     counter++;
   }
 
+  // Transfer the face data to the vertex data
+  for(const auto& tupleTransfer : tupleTransferFunctions)
+  {
+    tupleTransfer->transfer(transferIndices, true);
+  }
+
   return {};
 }
@@ -1,15 +1,22 @@
 #include "QuickSurfaceMesh.hpp"
 
 #include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/Geometry/EdgeGeom.hpp"
 #include "complex/DataStructure/Geometry/ImageGeom.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
 #include "TupleTransfer.hpp"
 
+#include <algorithm>
 #include <array>
+#include <limits>
+#include <numeric>
 #include <random>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 
 using namespace complex;
@@ -55,6 +62,264 @@ struct EdgeHasher
 using VertexMap = std::unordered_map<Vertex, IGeometry::MeshIndexType, VertexHasher>;
 using EdgeMap = std::unordered_map<Edge, IGeometry::MeshIndexType, EdgeHasher>;
 
+// -----------------------------------------------------------------------------
+using MeshIndexType = IGeometry::MeshIndexType;
+constexpr MeshIndexType k_UnassignedNode = std::numeric_limits<MeshIndexType>::max();
+
+/**
+ * @brief The features that share a mesh node, with -1 standing for the outside of the
+ * geometry. Node types only tell apart up to four owners, so at most four are stored
+ * together with whether the node lies on the outer surface.
+ */
+class NodeOwners
+{
+public:
+  void insert(int32 owner)
+  {
+    m_OnSurface = m_OnSurface || owner == -1;
+    if(std::find(m_Owners.cbegin(), m_Owners.cbegin() + m_Size, owner) == m_Owners.cbegin() + m_Size && m_Size < k_Capacity)
+    {
+      m_Owners[m_Size] = owner;
+      m_Size++;
+    }
+  }
+
+  int8 nodeType() const
+  {
+    return static_cast<int8>(m_OnSurface ? m_Size + 10 : m_Size);
+  }
+
+private:
+  static constexpr uint8 k_Capacity = 4;
+  std::array<int32, k_Capacity> m_Owners = {};
+  uint8 m_Size = 0;
+  bool m_OnSurface = false;
+};
+
+/**
+ * @brief Position of a node relative to the layer of cells that is being meshed.
+ * Z is 0 for the plane below the layer and 1 for the plane above it.
+ */
+struct NodePosition
+{
+  usize X = 0;
+  usize Y = 0;
+  usize Z = 0;
+};
+
+using TriangleWinding = std::array<std::array<uint8, 3>, 2>;
+constexpr TriangleWinding k_ForwardWinding = {{{0, 1, 2}, {1, 3, 2}}};
+constexpr TriangleWinding k_ReverseWinding = {{{0, 2, 1}, {1, 2, 3}}};
+
+/**
+ * @brief A square cell face that is meshed with two triangles.
+ */
+struct QuadFace
+{
+  std::array<NodePosition, 4> Nodes;
+  const TriangleWinding* Winding = nullptr;
+  int32 Label0 = -1;
+  int32 Label1 = -1;
+  usize SourceCell = 0;
+  usize Cell = 0;
+};
+
+/**
+ * @brief Visits the faces of the cell that become part of the mesh, in the order that
+ * the triangles are numbered. Boundary faces are labeled -1 on the outside. Faces between
+ * two features are owned by the cell with the smaller index and oriented towards the larger
+ * feature id.
+ */
+template <class FeatureIdsType, class FaceVisitor>
+void VisitCellFaces(const FeatureIdsType& featureIds, const SizeVec3& dims, usize i, usize j, usize k, FaceVisitor&& visitor)
+{
+  const usize xP = dims[0];
+  const usize yP = dims[1];
+  const usize zP = dims[2];
+  const usize point = (k * yP + j) * xP + i;
+  const int32 feature = featureIds[point];
+
+  const auto visitBoundary = [&](const std::array<NodePosition, 4>& nodes, const TriangleWinding& winding) { visitor(QuadFace{nodes, &winding, -1, feature, point, point}); };
+  // 'flipped' is the winding used when this cell's feature is the smaller one
+  const auto visitInternal = [&](const std::array<NodePosition, 4>& nodes, usize neighbor, const TriangleWinding& winding, const TriangleWinding& flipped) {
+    const int32 neighborFeature = featureIds[neighbor];
+    if(feature == neighborFeature)
+    {
+      return;
+    }
+    if(feature < neighborFeature)
+    {
+      visitor(QuadFace{nodes, &flipped, feature, neighborFeature, neighbor, point});
+    }
+    else
+    {
+      visitor(QuadFace{nodes, &winding, neighborFeature, feature, neighbor, point});
+    }
+  };
+
+  if(i == 0)
+  {
+    visitBoundary({NodePosition{i, j, 0}, NodePosition{i, j + 1, 0}, NodePosition{i, j, 1}, NodePosition{i, j + 1, 1}}, k_ReverseWinding);
+  }
+  if(j == 0)
+  {
+    visitBoundary({NodePosition{i, j, 0}, NodePosition{i + 1, j, 0}, NodePosition{i, j, 1}, NodePosition{i + 1, j, 1}}, k_ForwardWinding);
+  }
+  if(k == 0)
+  {
+    visitBoundary({NodePosition{i, j, 0}, NodePosition{i + 1, j, 0}, NodePosition{i, j + 1, 0}, NodePosition{i + 1, j + 1, 0}}, k_ReverseWinding);
+  }
+
+  const std::array<NodePosition, 4> xNodes = {NodePosition{i + 1, j, 0}, NodePosition{i + 1, j + 1, 0}, NodePosition{i + 1, j, 1}, NodePosition{i + 1, j + 1, 1}};
+  if(i == xP - 1)
+  {
+    visitBoundary(xNodes, k_ForwardWinding);
+  }
+  else
+  {
+    visitInternal(xNodes, point + 1, k_ForwardWinding, k_ReverseWinding);
+  }
+
+  const std::array<NodePosition, 4> yNodes = {NodePosition{i + 1, j + 1, 0}, NodePosition{i, j + 1, 0}, NodePosition{i + 1, j + 1, 1}, NodePosition{i, j + 1, 1}};
+  if(j == yP - 1)
+  {
+    visitBoundary(yNodes, k_ForwardWinding);
+  }
+  else
+  {
+    visitInternal(yNodes, point + xP, k_ReverseWinding, k_ForwardWinding);
+  }
+
+  const std::array<NodePosition, 4> zNodes = {NodePosition{i + 1, j, 1}, NodePosition{i, j, 1}, NodePosition{i + 1, j + 1, 1}, NodePosition{i, j + 1, 1}};
+  if(k == zP - 1)
+  {
+    visitBoundary(zNodes, k_ReverseWinding);
+  }
+  else
+  {
+    visitInternal(zNodes, point + xP * yP, k_ForwardWinding, k_ReverseWinding);
+  }
+}
+
+/**
+ * @brief Meshes one layer of cells at a time while keeping the node ids and owners of
+ * only the two node planes that bound the layer. Nodes are numbered in the order that
+ * the faces of the layer first reach them.
+ */
+template <class FeatureIdsType>
+class LayerMesher
+{
+public:
+  LayerMesher(const FeatureIdsType& featureIds, const SizeVec3& dims, bool trackOwners)
+  : m_FeatureIds(featureIds)
+  , m_Dims(dims)
+  , m_PlaneSize((dims[0] + 1) * (dims[1] + 1))
+  , m_TrackOwners(trackOwners)
+  {
+    for(usize plane = 0; plane < 2; plane++)
+    {
+      m_NodeIds[plane].assign(m_PlaneSize, k_UnassignedNode);
+      m_Owners[plane].resize(trackOwners ? m_PlaneSize : 0);
+    }
+  }
+
+  /**
+   * @brief Meshes layer k. Nodes that do not have an id yet are numbered from nextId.
+   * @param k
+   * @param nextId
+   * @param newNode void(MeshIndexType id, usize x, usize y, usize z)
+   * @param face void(const QuadFace& face, const std::array<MeshIndexType, 4>& nodeIds)
+   * @return MeshIndexType The next unused node id
+   */
+  template <class NewNodeFunctor, class FaceFunctor>
+  MeshIndexType meshLayer(usize k, MeshIndexType nextId, NewNodeFunctor&& newNode, FaceFunctor&& face)
+  {
+    for(usize j = 0; j < m_Dims[1]; j++)
+    {
+      for(usize i = 0; i < m_Dims[0]; i++)
+      {
+        VisitCellFaces(m_FeatureIds, m_Dims, i, j, k, [&](const QuadFace& quad) {
+          std::array<MeshIndexType, 4> nodeIds = {};
+          for(usize n = 0; n < 4; n++)
+          {
+            const NodePosition& node = quad.Nodes[n];
+            const usize planeIndex = node.Y * (m_Dims[0] + 1) + node.X;
+            MeshIndexType& nodeId = m_NodeIds[node.Z][planeIndex];
+            if(nodeId == k_UnassignedNode)
+            {
+              nodeId = nextId;
+              nextId++;
+              newNode(nodeId, node.X, node.Y, k + node.Z);
+            }
+            nodeIds[n] = nodeId;
+            if(m_TrackOwners)
+            {
+              m_Owners[node.Z][planeIndex].insert(quad.Label0);
+              m_Owners[node.Z][planeIndex].insert(quad.Label1);
+            }
+          }
+          face(quad, nodeIds);
+        });
+      }
+    }
+    return nextId;
+  }
+
+  /**
+   * @brief Moves on to the next layer. The upper node plane becomes the lower one.
+   */
+  void advance()
+  {
+    std::swap(m_NodeIds[0], m_NodeIds[1]);
+    std::fill(m_NodeIds[1].begin(), m_NodeIds[1].end(), k_UnassignedNode);
+    if(m_TrackOwners)
+    {
+      std::swap(m_Owners[0], m_Owners[1]);
+      std::fill(m_Owners[1].begin(), m_Owners[1].end(), NodeOwners{});
+    }
+  }
+
+  /**
+   * @brief Writes the node types of the lower node plane. All of its faces must have been meshed.
+   * @param nodeTypes
+   */
+  void writeLowerNodeTypes(AbstractDataStore<int8>& nodeTypes) const
+  {
+    for(usize planeIndex = 0; planeIndex < m_PlaneSize; planeIndex++)
+    {
+      if(m_NodeIds[0][planeIndex] != k_UnassignedNode)
+      {
+        nodeTypes.setValue(m_NodeIds[0][planeIndex], m_Owners[0][planeIndex].nodeType());
+      }
+    }
+  }
+
+private:
+  const FeatureIdsType& m_FeatureIds;
+  const SizeVec3 m_Dims;
+  const usize m_PlaneSize = 0;
+  const bool m_TrackOwners = false;
+  std::array<std::vector<MeshIndexType>, 2> m_NodeIds;
+  std::array<std::vector<NodeOwners>, 2> m_Owners;
+};
+
+/**
+ * @brief Calls the function with a contiguous view of the feature ids if they are held
+ * in memory and with the store itself otherwise.
+ */
+template <class FunctionType>
+void ExecuteWithFeatureIds(const AbstractDataStore<int32>& featureIds, FunctionType&& function)
+{
+  if(const auto* inMemoryStore = dynamic_cast<const DataStore<int32>*>(&featureIds); inMemoryStore != nullptr)
+  {
+    function(nonstd::span<const int32>(inMemoryStore->data(), inMemoryStore->getSize()));
+    return;
+  }
+  function(featureIds);
+}
+
+// Nodes and triangles are counted and created on one slab of cell layers per task
+constexpr usize k_MinLayersPerSlab = 8;
 } // namespace
 
 // -----------------------------------------------------------------------------
@@ -80,24 +345,19 @@ Result<> QuickSurfaceMesh::operator()()
 
   SizeVec3 udims = grid.getDimensions();
 
-  size_t xP = udims[0];
-  size_t yP = udims[1];
-  size_t zP = udims[2];
-
-  std::vector<std::set<int32_t>> ownerLists;
-
-  size_t possibleNumNodes = (xP + 1) * (yP + 1) * (zP + 1);
-  std::vector<MeshIndexType> nodeIds(possibleNumNodes, std::numeric_limits<size_t>::max());
-
-  MeshIndexType nodeCount = 0;
-  MeshIndexType triangleCount = 0;
-
   if(m_Inputs->pFixProblemVoxels)
   {
     correctProblemVoxels();
   }
 
-  determineActiveNodes(nodeIds, nodeCount, triangleCount);
+  SlabCounts slabs;
+  determineActiveNodes(slabs);
+  if(m_ShouldCancel)
+  {
+    return {};
+  }
+  MeshIndexType nodeCount = slabs.NodeOffsets.back();
+  MeshIndexType triangleCount = slabs.TriangleOffsets.back();
 
   // now create node and triangle arrays knowing the number that will be needed
   std::vector<usize> tupleShape = {triangleCount};
@@ -112,7 +372,7 @@ Result<> QuickSurfaceMesh::operator()()
     Result<> result = complex::ResizeAndReplaceDataArray(m_DataStructure, dataPath, tupleShape, complex::IDataAction::Mode::Execute);
   }
 
-  createNodesAndTriangles(nodeIds, nodeCount, triangleCount);
+  createNodesAndTriangles(slabs);
 
 #if 0
   if(m_Inputs->pGenerateTripleLines)
@@ -466,341 +726,86 @@ void QuickSurfaceMesh::correctProblemVoxels()
 }
 
 // -----------------------------------------------------------------------------
-void QuickSurfaceMesh::determineActiveNodes(std::vector<MeshIndexType>& nodeIds, MeshIndexType& nodeCount, MeshIndexType& triangleCount)
+void QuickSurfaceMesh::determineActiveNodes(SlabCounts& slabs)
 {
-  m_MessageHandler(IFilter::Message::Type::Info, "Determining active Nodes");
-
-  auto* grid = m_DataStructure.getDataAs<IGridGeometry>(m_Inputs->pGridGeomDataPath);
-
-  Int32Array& featureIds = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFeatureIdsArrayPath);
-
-  SizeVec3 udims = grid->getDimensions();
-
-  MeshIndexType xP = udims[0];
-  MeshIndexType yP = udims[1];
-  MeshIndexType zP = udims[2];
-
-  std::vector<std::set<int32_t>> ownerLists;
-
-  MeshIndexType point = 0, neigh1 = 0, neigh2 = 0, neigh3 = 0;
-
-  MeshIndexType nodeId1 = 0, nodeId2 = 0, nodeId3 = 0, nodeId4 = 0;
-
-  // first determining which nodes are actually boundary nodes and
-  // count number of nodes and triangles that will be created
-  for(MeshIndexType k = 0; k < zP; k++)
+  m_MessageHandler(IFilter::Message::Type::Info, "Counting nodes and triangles");
+
+  const auto& featureIds = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFeatureIdsArrayPath).getDataStoreRef();
+  const auto* grid = m_DataStructure.getDataAs<IGridGeometry>(m_Inputs->pGridGeomDataPath);
+  const SizeVec3 udims = grid->getDimensions();
+  const usize zP = udims[2];
+
+  // Several slabs per thread keep the threads busy when the features are unevenly spread
+  const usize numThreads = std::max(std::thread::hardware_concurrency(), 1U);
+  const usize layersPerSlab = std::max((zP + 4 * numThreads - 1) / (4 * numThreads), k_MinLayersPerSlab);
+  const usize numSlabs = (zP + layersPerSlab - 1) / layersPerSlab;
+  slabs.FirstLayers.resize(numSlabs + 1);
+  for(usize slab = 0; slab < numSlabs; slab++)
   {
-    for(MeshIndexType j = 0; j < yP; j++)
-    {
-      for(MeshIndexType i = 0; i < xP; i++)
+    slabs.FirstLayers[slab] = slab * layersPerSlab;
+  }
+  slabs.FirstLayers[numSlabs] = zP;
+  slabs.NodeOffsets.assign(numSlabs + 1, 0);
+  slabs.TriangleOffsets.assign(numSlabs + 1, 0);
+  slabs.LastLayerNodes.assign(numSlabs, 0);
+
+  ExecuteWithFeatureIds(featureIds, [&](const auto& featureIdValues) {
+    using FeatureIdsType = std::decay_t<decltype(featureIdValues)>;
+    const auto countSlabs = [&](const Range& range) {
+      for(usize slab = range.min(); slab < range.max(); slab++)
       {
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1;
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
-
-        if(i == 0)
+        const usize firstLayer = slabs.FirstLayers[slab];
+        const usize endLayer = slabs.FirstLayers[slab + 1];
+        LayerMesher<FeatureIdsType> mesher(featureIdValues, udims, false);
+        const auto ignoreNode = [](MeshIndexType, usize, usize, usize) {};
+        MeshIndexType triangleCount = 0;
+        const auto countFace = [&triangleCount](const QuadFace&, const std::array<MeshIndexType, 4>&) { triangleCount += 2; };
+
+        // Nodes first reached by the layer below belong to the previous slab
+        if(firstLayer > 0)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(j == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
+          mesher.meshLayer(firstLayer - 1, 0, ignoreNode, [](const QuadFace&, const std::array<MeshIndexType, 4>&) {});
+          mesher.advance();
         }
-        if(k == 0)
+        MeshIndexType nodeCount = 0;
+        for(usize k = firstLayer; k < endLayer; k++)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
+          if(m_ShouldCancel)
           {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
+            return;
           }
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(i == (xP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(featureIds[point] != featureIds[neigh1])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(j == (yP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(featureIds[point] != featureIds[neigh2])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(k == (zP - 1))
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(k < zP - 1 && featureIds[point] != featureIds[neigh3])
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
+          const MeshIndexType layerStart = nodeCount;
+          nodeCount = mesher.meshLayer(k, nodeCount, ignoreNode, countFace);
+          slabs.LastLayerNodes[slab] = nodeCount - layerStart;
+          mesher.advance();
         }
+        slabs.NodeOffsets[slab + 1] = nodeCount;
+        slabs.TriangleOffsets[slab + 1] = triangleCount;
       }
-    }
-  }
+    };
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numSlabs);
+    dataAlg.setParallelizationEnabled(featureIds.getStoreType() == IDataStore::StoreType::InMemory);
+    dataAlg.execute(countSlabs);
+  });
+
+  std::partial_sum(slabs.NodeOffsets.begin(), slabs.NodeOffsets.end(), slabs.NodeOffsets.begin());
+  std::partial_sum(slabs.TriangleOffsets.begin(), slabs.TriangleOffsets.end(), slabs.TriangleOffsets.begin());
 }
 
 // -----------------------------------------------------------------------------
-void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType>& m_NodeIds, MeshIndexType nodeCount, MeshIndexType triangleCount)
+void QuickSurfaceMesh::createNodesAndTriangles(const SlabCounts& slabs)
 {
   m_MessageHandler(IFilter::Message::Type::Info, "Creating mesh");
 
-  Int32Array& featureIds = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFeatureIdsArrayPath);
-
-  size_t numFeatures = 0;
-  size_t numTuples = featureIds.getNumberOfTuples();
-  for(size_t i = 0; i < numTuples; i++)
-  {
-    if(static_cast<size_t>(featureIds[i]) > numFeatures)
-    {
-      numFeatures = static_cast<size_t>(featureIds[i]);
-    }
-  }
-
-  auto* grid = m_DataStructure.getDataAs<IGridGeometry>(m_Inputs->pGridGeomDataPath);
-
-  SizeVec3 udims = grid->getDimensions();
-
-  MeshIndexType xP = udims[0];
-  MeshIndexType yP = udims[1];
-  MeshIndexType zP = udims[2];
-
-  std::vector<std::set<int32_t>> ownerLists;
-
-  MeshIndexType point = 0;
-  MeshIndexType neigh1 = 0;
-  MeshIndexType neigh2 = 0;
-  MeshIndexType neigh3 = 0;
-
-  MeshIndexType nodeId1 = 0;
-  MeshIndexType nodeId2 = 0;
-  MeshIndexType nodeId3 = 0;
-  MeshIndexType nodeId4 = 0;
+  const auto& featureIds = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFeatureIdsArrayPath).getDataStoreRef();
+  const auto* grid = m_DataStructure.getDataAs<IGridGeometry>(m_Inputs->pGridGeomDataPath);
+  const SizeVec3 udims = grid->getDimensions();
+  const usize zP = udims[2];
+  const usize numSlabs = slabs.FirstLayers.size() - 1;
+  const MeshIndexType nodeCount = slabs.NodeOffsets.back();
+  const MeshIndexType triangleCount = slabs.TriangleOffsets.back();
 
   TriangleGeom* triangleGeom = m_DataStructure.getDataAs<TriangleGeom>(m_Inputs->pTriangleGeometryPath);
   LinkedGeometryData& linkedGeometryData = triangleGeom->getLinkedGeometryData();
@@ -814,19 +819,17 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType>& m_Nod
   // Remove and then insert a properly sized Int32Array for the FaceLabels
   m_DataStructure.removeData(m_Inputs->pFaceLabelsDataPath);
   Result<> faceLabelResult = complex::CreateArray<int32_t>(m_DataStructure, {triangleCount}, {2}, m_Inputs->pFaceLabelsDataPath, IDataAction::Mode::Execute);
-  Int32Array& faceLabels = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFaceLabelsDataPath);
+  auto& faceLabels = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFaceLabelsDataPath).getDataStoreRef();
   linkedGeometryData.addFaceData(m_Inputs->pFaceLabelsDataPath);
 
   // Remove and then insert a properly sized int8 for the NodeTypes
   m_DataStructure.removeData(m_Inputs->pNodeTypesDataPath);
   Result<> nodeTypeResult = complex::CreateArray<int8_t>(m_DataStructure, {nodeCount}, {1}, m_Inputs->pNodeTypesDataPath, IDataAction::Mode::Execute);
-  Int32Array& nodeTypes = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFaceLabelsDataPath);
+  auto& nodeTypes = m_DataStructure.getDataRefAs<Int8Array>(m_Inputs->pNodeTypesDataPath).getDataStoreRef();
   linkedGeometryData.addVertexData(m_Inputs->pFaceLabelsDataPath);
 
-  IGeometry::SharedVertexList& vertex = *(triangleGeom->getVertices());
-  IGeometry::SharedTriList& triangle = *(triangleGeom->getFaces());
-
-  ownerLists.resize(nodeCount);
+  auto& vertex = triangleGeom->getVertices()->getDataStoreRef();
+  auto& triangle = triangleGeom->getFaces()->getDataStoreRef();
 
   // Create a vector of TupleTransferFunctions for each of the Triangle Face to Vertex Data Arrays
   std::vector<std::shared_ptr<AbstractTupleTransfer>> tupleTransferFunctions;
@@ -836,522 +839,93 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType>& m_Nod
     linkedGeometryData.addFaceData(m_Inputs->pSelectedDataArrayPaths[i]);
     ::AddTupleTransferInstance(m_DataStructure, m_Inputs->pSelectedDataArrayPaths[i], m_Inputs->pCreatedDataArrayPaths[i], tupleTransferFunctions);
   }
+  const bool transferTuples = !tupleTransferFunctions.empty();
 
-  // Cycle through again assigning coordinates to each node and assigning node numbers and feature labels to each triangle
-  MeshIndexType triangleIndex = 0;
-  for(MeshIndexType k = 0; k < zP; k++)
-  {
-    for(MeshIndexType j = 0; j < yP; j++)
-    {
-      for(MeshIndexType i = 0; i < xP; i++)
-      {
-
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1; // <== What happens if we are at the end of a row?
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
+  // The cells each triangle takes its data from
+  std::vector<TupleTransferIndices> transferIndices(transferTuples ? triangleCount : 0);
 
-        if(i == 0)
+  ExecuteWithFeatureIds(featureIds, [&](const auto& featureIdValues) {
+    using FeatureIdsType = std::decay_t<decltype(featureIdValues)>;
+    const auto createSlabs = [&](const Range& range) {
+      for(usize slab = range.min(); slab < range.max(); slab++)
+      {
+        const usize firstLayer = slabs.FirstLayers[slab];
+        const usize endLayer = slabs.FirstLayers[slab + 1];
+        LayerMesher<FeatureIdsType> mesher(featureIdValues, udims, true);
+        const auto ignoreNode = [](MeshIndexType, usize, usize, usize) {};
+        const auto ignoreFace = [](const QuadFace&, const std::array<MeshIndexType, 4>&) {};
+
+        // Replay the end of the previous slab so that the shared node plane has the same ids and owners
+        if(firstLayer > 1)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
+          mesher.meshLayer(firstLayer - 2, 0, ignoreNode, ignoreFace);
+          mesher.advance();
         }
-        if(j == 0)
+        if(firstLayer > 0)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
+          mesher.meshLayer(firstLayer - 1, slabs.NodeOffsets[slab] - slabs.LastLayerNodes[slab - 1], ignoreNode, ignoreFace);
+          mesher.advance();
         }
-        if(k == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
 
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(i == (xP - 1)) // Takes care of the end of a Row...
+        MeshIndexType nodeId = slabs.NodeOffsets[slab];
+        MeshIndexType triangleIndex = slabs.TriangleOffsets[slab];
+        const auto createNode = [&](MeshIndexType newNodeId, usize x, usize y, usize z) {
+          const Point3D<float64> coords = grid->getPlaneCoords(x, y, z);
+          vertex.setValue(newNodeId * 3, static_cast<float32>(coords[0]));
+          vertex.setValue(newNodeId * 3 + 1, static_cast<float32>(coords[1]));
+          vertex.setValue(newNodeId * 3 + 2, static_cast<float32>(coords[2]));
+        };
+        const auto createFace = [&](const QuadFace& face, const std::array<MeshIndexType, 4>& nodeIds) {
+          for(const auto& winding : *face.Winding)
+          {
+            for(usize n = 0; n < 3; n++)
+            {
+              triangle.setValue(triangleIndex * 3 + n, nodeIds[winding[n]]);
+            }
+            faceLabels.setValue(triangleIndex * 2, face.Label0);
+            faceLabels.setValue(triangleIndex * 2 + 1, face.Label1);
+            if(transferTuples)
+            {
+              transferIndices[triangleIndex] = {triangleIndex, face.SourceCell, face.Cell};
+            }
+            triangleIndex++;
+          }
+        };
+
+        for(usize k = firstLayer; k < endLayer; k++)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
+          if(m_ShouldCancel)
           {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
+            return;
           }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
+          nodeId = mesher.meshLayer(k, nodeId, createNode, createFace);
+          // Only the layers below and above a node plane touch it
+          mesher.writeLowerNodeTypes(nodeTypes);
+          mesher.advance();
         }
-        else if(featureIds[point] != featureIds[neigh1])
+        if(endLayer == zP)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = featureIds[neigh1];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          if(featureIds[point] < featureIds[neigh1])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh1];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh1, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = featureIds[neigh1];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh1])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh1];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh1, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[neigh1]);
-        }
-        if(j == (yP - 1)) // Takes care of the end of a column
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(featureIds[point] != featureIds[neigh2])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          faceLabels[triangleIndex * 2] = featureIds[neigh2];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh2])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh2];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh2, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          faceLabels[triangleIndex * 2] = featureIds[neigh2];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh2])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh2];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh2, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[neigh2]);
-        }
-        if(k == (zP - 1)) // Takes care of the end of a Pillar
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
+          mesher.writeLowerNodeTypes(nodeTypes);
         }
-        else if(featureIds[point] != featureIds[neigh3])
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = featureIds[neigh3];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh3])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh3];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh3, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = featureIds[neigh3];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh3])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh3];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh3, point, true);
-          }
+      }
+    };
 
-          triangleIndex++;
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numSlabs);
+    dataAlg.setParallelizationEnabled(featureIds.getStoreType() == IDataStore::StoreType::InMemory && vertex.getStoreType() == IDataStore::StoreType::InMemory &&
+                                      triangle.getStoreType() == IDataStore::StoreType::InMemory && faceLabels.getStoreType() == IDataStore::StoreType::InMemory &&
+                                      nodeTypes.getStoreType() == IDataStore::StoreType::InMemory);
+    dataAlg.execute(createSlabs);
+  });
 
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[neigh3]);
-        }
-      }
-    }
+  if(!transferTuples || m_ShouldCancel)
+  {
+    return;
   }
 
-  Int8Array& m_NodeTypes = m_DataStructure.getDataRefAs<Int8Array>(m_Inputs->pNodeTypesDataPath);
-
-  for(size_t i = 0; i < nodeCount; i++)
+  for(const auto& tupleTransfer : tupleTransferFunctions)
   {
-    m_NodeTypes[i] = static_cast<int8_t>(ownerLists[i].size());
-    if(m_NodeTypes[i] > 4)
-    {
-      m_NodeTypes[i] = 4;
-    }
-    if(ownerLists[i].find(-1) != ownerLists[i].end())
-    {
-      m_NodeTypes[i] += 10;
-    }
+    tupleTransfer->transfer(transferIndices, true);
   }
 }
 
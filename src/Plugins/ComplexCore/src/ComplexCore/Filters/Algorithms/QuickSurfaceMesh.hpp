@@ -9,6 +9,7 @@
 #include "complex/Parameters/MultiArraySelectionParameter.hpp"
 
 #include <string>
+#include <vector>
 
 namespace complex
 {
@@ -90,20 +91,29 @@ public:
   void correctProblemVoxels();
 
   /**
-   * @brief
-   * @param m_NodeIds
-   * @param nodeCount
-   * @param triangleCount
+   * @brief Counts the nodes and triangles created by each slab of cell layers. The
+   * offsets are the running totals so that the last entry holds the mesh size.
    */
-  void determineActiveNodes(std::vector<MeshIndexType>& m_NodeIds, MeshIndexType& nodeCount, MeshIndexType& triangleCount);
+  struct SlabCounts
+  {
+    std::vector<usize> FirstLayers;
+    std::vector<MeshIndexType> NodeOffsets;
+    std::vector<MeshIndexType> TriangleOffsets;
+    std::vector<MeshIndexType> LastLayerNodes;
+  };
 
   /**
-   * @brief
-   * @param m_NodeIds
-   * @param nodeCount
-   * @param triangleCount
+   * @brief Splits the grid into slabs of z layers and counts the nodes and triangles of each slab in parallel.
+   * @param slabs
+   */
+  void determineActiveNodes(SlabCounts& slabs);
+
+  /**
+   * @brief Creates the nodes, triangles, face labels and node types of each slab in parallel. Only
+   * the two node planes bounding the current layer are held in memory.
+   * @param slabs
    */
-  void createNodesAndTriangles(std::vector<MeshIndexType>& m_NodeIds, MeshIndexType nodeCount, MeshIndexType triangleCount);
+  void createNodesAndTriangles(const SlabCounts& slabs);
 
   /**
    * @brief generateTripleLines
@@ -38,24 +38,22 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <memory>
 
 #include "complex/Common/Bit.hpp"
 #include "complex/Common/ComplexConstants.hpp"
 #include "complex/Common/Types.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStore.hpp"
+#include "complex/Utilities/MemoryMappedFile.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
 namespace fs = std::filesystem;
 using namespace complex;
 
 namespace
 {
-#if defined(_MSC_VER)
-#define FSEEK64 _fseeki64
-#else
-#define FSEEK64 std::fseek
-#endif
-
 constexpr int32 k_RbrFileNotOpen = -1000;
 constexpr int32 k_RbrFileTooSmall = -1010;
 constexpr int32 k_RbrFileTooBig = -1020;
@@ -77,7 +75,48 @@ int32 SanityCheckFileSizeVersusAllocatedSize(usize allocatedBytes, usize fileSiz
 
 // -----------------------------------------------------------------------------
 template <typename T>
-Result<> ReadBinaryFile(IDataArray& dataArrayPtr, const std::string& filename, uint64 skipHeaderBytes, ChoicesParameter::ValueType endian)
+void CopyValues(const uint8* source, T* destination, usize numValues, bool byteSwap)
+{
+  // The header may leave the values unaligned in the file, so copy bytes before touching them as T
+  std::memcpy(destination, source, numValues * sizeof(T));
+  if(byteSwap)
+  {
+    for(usize i = 0; i < numValues; i++)
+    {
+      destination[i] = complex::byteswap(destination[i]);
+    }
+  }
+}
+
+/**
+ * @brief Copies a range of values out of the mapped file and swaps their bytes
+ * while they are still in cache.
+ */
+template <typename T>
+class CopyValuesImpl
+{
+public:
+  CopyValuesImpl(const uint8* source, T* destination, bool byteSwap)
+  : m_Source(source)
+  , m_Destination(destination)
+  , m_ByteSwap(byteSwap)
+  {
+  }
+
+  void operator()(const Range& range) const
+  {
+    CopyValues(m_Source + range.min() * sizeof(T), m_Destination + range.min(), range.size(), m_ByteSwap);
+  }
+
+private:
+  const uint8* m_Source = nullptr;
+  T* m_Destination = nullptr;
+  bool m_ByteSwap = false;
+};
+
+// -----------------------------------------------------------------------------
+template <typename T>
+Result<> ReadBinaryFile(IDataArray& dataArrayPtr, const fs::path& filename, uint64 skipHeaderBytes, ChoicesParameter::ValueType endian)
 {
   constexpr usize k_DefaultBlocksize = 1048576;
 
@@ -96,45 +135,41 @@ Result<> ReadBinaryFile(IDataArray& dataArrayPtr, const std::string& filename, u
     return MakeWarningVoidResult(k_RbrFileTooBig, "The file size is larger than the allocated size");
   }
 
-  FILE* f = std::fopen(filename.c_str(), "rb");
-  if(f == nullptr)
+  Result<MemoryMappedFile> fileResult = MemoryMappedFile::Open(filename);
+  if(fileResult.invalid())
   {
     return MakeErrorResult(k_RbrFileNotOpen, "Unable to open the specified file");
   }
-
-  // Skip some header bytes if the user asked for it.
-  if(skipHeaderBytes > 0)
+  const MemoryMappedFile& inputFile = fileResult.value();
+  if(inputFile.size() < skipHeaderBytes + numBytesToRead)
   {
-    FSEEK64(f, skipHeaderBytes, SEEK_SET);
+    return MakeErrorResult(k_RbrFileTooSmall, "Unable to read the expected number of values from the file");
   }
+  const uint8* source = inputFile.bytes().data() + skipHeaderBytes;
 
-  std::byte* chunkptr = reinterpret_cast<std::byte*>(dataArray.template getIDataStoreAs<DataStore<T>>()->data());
+  const bool byteSwap = sizeof(T) > 1 && endian != static_cast<ChoicesParameter::ValueType>(complex::endian::native);
+  AbstractDataStore<T>& dataStore = dataArray.getDataStoreRef();
+  const usize numValuesToRead = dataArray.getSize();
 
-  // Now start reading the data in chunks if needed.
-  usize chunkSize = std::min(numBytesToRead, k_DefaultBlocksize);
-
-  usize master_counter = 0;
-  while(master_counter < numBytesToRead)
+  // In memory stores are filled straight from the mapping in parallel
+  if(auto* inMemoryStore = dynamic_cast<DataStore<T>*>(&dataStore); inMemoryStore != nullptr)
   {
-    usize bytes_read = std::fread(chunkptr, sizeof(std::byte), chunkSize, f);
-    chunkptr += bytes_read;
-    master_counter += bytes_read;
-
-    usize bytesLeft = numBytesToRead - master_counter;
-
-    if(bytesLeft < chunkSize)
-    {
-      chunkSize = bytesLeft;
-    }
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numValuesToRead);
+    dataAlg.execute(CopyValuesImpl<T>(source, inMemoryStore->data(), byteSwap));
+    return {};
   }
 
-  if(endian != static_cast<ChoicesParameter::ValueType>(complex::endian::native))
+  // Other stores are filled one block at a time
+  const usize chunkSize = std::min(numValuesToRead, std::max(k_DefaultBlocksize / sizeof(T), static_cast<usize>(1)));
+  auto buffer = std::make_unique<T[]>(chunkSize);
+  for(usize master_counter = 0; master_counter < numValuesToRead; master_counter += chunkSize)
   {
-    dataArray.byteSwapElements();
+    const usize valuesRead = std::min(chunkSize, numValuesToRead - master_counter);
+    CopyValues(source + master_counter * sizeof(T), buffer.get(), valuesRead, byteSwap);
+    dataStore.copyFromBuffer(master_counter, nonstd::span<const T>(buffer.get(), valuesRead));
   }
 
-  std::fclose(f);
-
   return {};
 }
 } // namespace
@@ -167,7 +202,7 @@ Result<> RawBinaryReader::execute()
     throw std::runtime_error(fmt::format("Failed to acquire DataArray from path '{}' with the correct number of components.", m_InputValues.createdAttributeArrayPathValue.toString()));
   }
 
-  const std::string inputFile = m_InputValues.inputFileValue.string();
+  const fs::path& inputFile = m_InputValues.inputFileValue;
 
   switch(m_InputValues.scalarTypeValue)
   {
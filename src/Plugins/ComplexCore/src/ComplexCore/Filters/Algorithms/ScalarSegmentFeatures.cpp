@@ -6,87 +6,91 @@
 #include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
 
+#include <nonstd/span.hpp>
+
 #include <chrono>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
 using namespace complex;
 
-#define CX_DEFAULT_CONSTRUCTORS(className)                                                                                                                                                             \
-  className(const className&) = delete;                                                                                                                                                                \
-  className(className&&) noexcept = delete;                                                                                                                                                            \
-  className& operator=(const className&) = delete;                                                                                                                                                     \
-  className& operator=(className&&) noexcept = delete;
-
 namespace
 {
+/**
+ * @brief The ContiguousValues class provides raw pointer access to the values of a
+ * DataStore so that the comparators can be inlined. Stores that are not contiguous
+ * in memory are copied into a temporary buffer.
+ */
+template <class T>
+class ContiguousValues
+{
+public:
+  explicit ContiguousValues(const AbstractDataStore<T>& store)
+  {
+    if(const auto* dataStore = dynamic_cast<const DataStore<T>*>(&store); dataStore != nullptr)
+    {
+      m_Data = dataStore->data();
+      return;
+    }
+    m_Buffer = std::make_unique<T[]>(store.getSize());
+    store.copyIntoBuffer(0, nonstd::span<T>(m_Buffer.get(), store.getSize()));
+    m_Data = m_Buffer.get();
+  }
 
-constexpr StringLiteral k_CompareFunctKey = "Compare Function";
+  const T* data() const
+  {
+    return m_Data;
+  }
 
-constexpr int64 k_IncorrectInputArray = -600;
-constexpr int64 k_MissingInputArray = -601;
-constexpr int64 k_MissingOrIncorrectGoodVoxelsArray = -602;
+private:
+  std::unique_ptr<T[]> m_Buffer;
+  const T* m_Data = nullptr;
+};
 
 /**
- * @brief The TSpecificCompareFunctorBool class extends @see CompareFunctor to compare boolean data
+ * @brief The TSpecificCompareFunctorBool class groups neighboring points with equal boolean values
  */
-class TSpecificCompareFunctorBool : public SegmentFeatures::CompareFunctor
+class TSpecificCompareFunctorBool
 {
 public:
-  using DataArrayType = BoolArray;
-  CX_DEFAULT_CONSTRUCTORS(TSpecificCompareFunctorBool)
-
-  TSpecificCompareFunctorBool(IDataArray* data, int64 length, bool tolerance, AbstractDataStore<int32>* featureIds)
+  TSpecificCompareFunctorBool(const bool* data, usize length)
   : m_Length(length)
-  , m_FeatureIdsArray(featureIds)
-  , m_Data(dynamic_cast<DataArrayType*>(data))
+  , m_Data(data)
   {
   }
-  ~TSpecificCompareFunctorBool() override = default;
 
-  bool operator()(int64 referencePoint, int64 neighborPoint, int32 gnum) override
+  bool operator()(usize referencePoint, usize neighborPoint) const
   {
     // Sanity check the indices that are being passed in.
     if(referencePoint >= m_Length || neighborPoint >= m_Length)
     {
       return false;
     }
-
-    if((*m_Data)[neighborPoint] == (*m_Data)[referencePoint])
-    {
-      m_FeatureIdsArray->setValue(neighborPoint, gnum);
-      return true;
-    }
-    return false;
+    return m_Data[neighborPoint] == m_Data[referencePoint];
   }
 
-protected:
-  TSpecificCompareFunctorBool() = default;
-
 private:
-  int64 m_Length = 0;                                    // Length of the Data Array
-  AbstractDataStore<int32>* m_FeatureIdsArray = nullptr; // The Feature Ids
-  DataArrayType* m_Data = nullptr;                       // The data that is being compared
+  usize m_Length = 0;          // Length of the Data Array
+  const bool* m_Data = nullptr; // The data that is being compared
 };
 
 /**
- * @brief The TSpecificCompareFunctor class extens @see CompareFunctor to compare templated data
+ * @brief The TSpecificCompareFunctor class groups neighboring points whose values differ by no more than the tolerance
  */
 template <class T>
-class TSpecificCompareFunctor : public SegmentFeatures::CompareFunctor
+class TSpecificCompareFunctor
 {
 public:
-  CX_DEFAULT_CONSTRUCTORS(TSpecificCompareFunctor<T>)
-
-  using DataArrayType = DataArray<T>;
-  TSpecificCompareFunctor(IDataArray* data, int64 length, T tolerance, AbstractDataStore<int32>* featureIds)
+  TSpecificCompareFunctor(const T* data, usize length, T tolerance)
   : m_Length(length)
   , m_Tolerance(tolerance)
-  , m_FeatureIdsArray(featureIds)
-  , m_Data(dynamic_cast<DataArrayType*>(data))
+  , m_Data(data)
   {
   }
-  ~TSpecificCompareFunctor() override = default;
 
-  bool operator()(int64 referencePoint, int64 neighborPoint, int32 gnum) override
+  bool operator()(usize referencePoint, usize neighborPoint) const
   {
     // Sanity check the indices that are being passed in.
     if(referencePoint >= m_Length || neighborPoint >= m_Length)
@@ -94,34 +98,47 @@ public:
       return false;
     }
 
-    if((*m_Data)[referencePoint] >= (*m_Data)[neighborPoint])
-    {
-      if(((*m_Data)[referencePoint] - (*m_Data)[neighborPoint]) <= m_Tolerance)
-      {
-        m_FeatureIdsArray->setValue(neighborPoint, gnum);
-        return true;
-      }
-    }
-    else
+    const T referenceValue = m_Data[referencePoint];
+    const T neighborValue = m_Data[neighborPoint];
+    if(referenceValue >= neighborValue)
     {
-      if(((*m_Data)[neighborPoint] - (*m_Data)[referencePoint]) <= m_Tolerance)
-      {
-        m_FeatureIdsArray->setValue(neighborPoint, gnum);
-        return true;
-      }
+      return (referenceValue - neighborValue) <= m_Tolerance;
     }
-    return false;
+    return (neighborValue - referenceValue) <= m_Tolerance;
   }
 
-protected:
-  TSpecificCompareFunctor() = default;
-
 private:
-  int64 m_Length = 0;                                    // Length of the Data Array
-  T m_Tolerance = static_cast<T>(0);                     // The tolerance of the comparison
-  AbstractDataStore<int32>* m_FeatureIdsArray = nullptr; // The Feature Ids
-  DataArrayType* m_Data = nullptr;                       // The data that is being compared
+  usize m_Length = 0;                // Length of the Data Array
+  T m_Tolerance = static_cast<T>(0); // The tolerance of the comparison
+  const T* m_Data = nullptr;         // The data that is being compared
 };
+
+/**
+ * @brief Segments the grid using the comparator that matches the input array type.
+ * Points are only grouped if they are both in the mask, when a mask is given.
+ */
+template <class T>
+usize SegmentArray(SegmentFeatures& segmentFeatures, const IGridGeometry& gridGeom, const IDataArray& inputDataArray, int32 tolerance, const bool* goodVoxels, AbstractDataStore<int32>& featureIds)
+{
+  auto include = [goodVoxels](usize index) { return goodVoxels == nullptr || goodVoxels[index]; };
+
+  // Multi-component arrays are never grouped so every point becomes its own feature
+  if(inputDataArray.getNumberOfComponents() != 1)
+  {
+    return segmentFeatures.executeParallel(gridGeom, featureIds, include, [](usize, usize) { return false; });
+  }
+
+  const auto& dataArray = dynamic_cast<const DataArray<T>&>(inputDataArray);
+  ContiguousValues<T> values(dataArray.getDataStoreRef());
+  if constexpr(std::is_same_v<T, bool>)
+  {
+    return segmentFeatures.executeParallel(gridGeom, featureIds, include, TSpecificCompareFunctorBool(values.data(), dataArray.getNumberOfTuples()));
+  }
+  else
+  {
+    return segmentFeatures.executeParallel(gridGeom, featureIds, include, TSpecificCompareFunctor<T>(values.data(), dataArray.getNumberOfTuples(), static_cast<T>(tolerance)));
+  }
+}
 } // namespace
 
 ScalarSegmentFeatures::ScalarSegmentFeatures(DataStructure& dataStructure, ScalarSegmentFeaturesInputValues* inputValues, const std::atomic_bool& shouldCancel,
@@ -136,90 +153,82 @@ ScalarSegmentFeatures::~ScalarSegmentFeatures() noexcept = default;
 // -----------------------------------------------------------------------------
 Result<> ScalarSegmentFeatures::operator()()
 {
-  complex::AbstractDataStore<bool>* goodVoxels = nullptr;
+  std::optional<ContiguousValues<bool>> goodVoxels;
   if(m_InputValues->pUseGoodVoxels)
   {
     m_GoodVoxelsArray = m_DataStructure.getDataAs<GoodVoxelsArrayType>(m_InputValues->pGoodVoxelsPath);
-    goodVoxels = m_GoodVoxelsArray->getDataStore();
+    goodVoxels.emplace(std::as_const(*m_GoodVoxelsArray).getDataStoreRef());
   }
+  const bool* goodVoxelsPtr = goodVoxels.has_value() ? goodVoxels->data() : nullptr;
 
   auto* gridGeom = m_DataStructure.getDataAs<IGridGeometry>(m_InputValues->pGridGeomPath);
 
   m_FeatureIdsArray = m_DataStructure.getDataAs<Int32Array>(m_InputValues->pFeatureIdsPath);
   m_FeatureIdsArray->fill(0); // initialize the output array with zeros
   IDataArray* inputDataArray = m_DataStructure.getDataAs<IDataArray>(m_InputValues->pInputDataPath);
-  size_t inDataPoints = inputDataArray->getNumberOfTuples();
   complex::DataType dataType = inputDataArray->getDataType();
 
-  auto featureIds = m_FeatureIdsArray->getDataStore();
+  auto& featureIds = m_FeatureIdsArray->getDataStoreRef();
+  const int32 tolerance = m_InputValues->pScalarTolerance;
 
+  usize numFeatures = 0;
   switch(dataType)
   {
   case complex::DataType::int8: {
-    m_CompareFunctor = std::make_shared<::TSpecificCompareFunctor<int8>>(inputDataArray, inDataPoints, static_cast<int8>(m_InputValues->pScalarTolerance), featureIds);
+    numFeatures = SegmentArray<int8>(*this, *gridGeom, *inputDataArray, tolerance, goodVoxelsPtr, featureIds);
     break;
   }
   case complex::DataType::uint8: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<uint8>>(inputDataArray, inDataPoints, static_cast<uint8>(m_InputValues->pScalarTolerance), featureIds);
+    numFeatures = SegmentArray<uint8>(*this, *gridGeom, *inputDataArray, tolerance, goodVoxelsPtr, featureIds);
     break;
   }
   case complex::DataType::boolean: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctorBool>(inputDataArray, inDataPoints, static_cast<bool>(m_InputValues->pScalarTolerance), featureIds);
+    numFeatures = SegmentArray<bool>(*this, *gridGeom, *inputDataArray, tolerance, goodVoxelsPtr, featureIds);
     break;
   }
   case complex::DataType::int16: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<int16>>(inputDataArray, inDataPoints, static_cast<int16>(m_InputValues->pScalarTolerance), featureIds);
+    numFeatures = SegmentArray<int16>(*this, *gridGeom, *inputDataArray, tolerance, goodVoxelsPtr, featureIds);
     break;
   }
   case complex::DataType::uint16: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<uint16>>(inputDataArray, inDataPoints, static_cast<uint16>(m_InputValues->pScalarTolerance), featureIds);
+    numFeatures = SegmentArray<uint16>(*this, *gridGeom, *inputDataArray, tolerance, goodVoxelsPtr, featureIds);
     break;
   }
   case complex::DataType::int32: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<int32>>(inputDataArray, inDataPoints, static_cast<int32>(m_InputValues->pScalarTolerance), featureIds);
+    numFeatures = SegmentArray<int32>(*this, *gridGeom, *inputDataArray, tolerance, goodVoxelsPtr, featureIds);
     break;
   }
   case complex::DataType::uint32: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<uint32>>(inputDataArray, inDataPoints, static_cast<uint32>(m_InputValues->pScalarTolerance), featureIds);
+    numFeatures = SegmentArray<uint32>(*this, *gridGeom, *inputDataArray, tolerance, goodVoxelsPtr, featureIds);
     break;
   }
   case complex::DataType::int64: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<int64>>(inputDataArray, inDataPoints, static_cast<int64>(m_InputValues->pScalarTolerance), featureIds);
+    numFeatures = SegmentArray<int64>(*this, *gridGeom, *inputDataArray, tolerance, goodVoxelsPtr, featureIds);
     break;
   }
   case complex::DataType::uint64: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<uint64>>(inputDataArray, inDataPoints, static_cast<uint64>(m_InputValues->pScalarTolerance), featureIds);
+    numFeatures = SegmentArray<uint64>(*this, *gridGeom, *inputDataArray, tolerance, goodVoxelsPtr, featureIds);
     break;
   }
   case complex::DataType::float32: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<float32>>(inputDataArray, inDataPoints, static_cast<float32>(m_InputValues->pScalarTolerance), featureIds);
+    numFeatures = SegmentArray<float32>(*this, *gridGeom, *inputDataArray, tolerance, goodVoxelsPtr, featureIds);
     break;
   }
   case complex::DataType::float64: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<float64>>(inputDataArray, inDataPoints, static_cast<float64>(m_InputValues->pScalarTolerance), featureIds);
+    numFeatures = SegmentArray<float64>(*this, *gridGeom, *inputDataArray, tolerance, goodVoxelsPtr, featureIds);
     break;
   }
   default:
     break;
   }
-  if(inputDataArray->getNumberOfComponents() != 1)
+  if(m_ShouldCancel)
   {
-    m_CompareFunctor = std::shared_ptr<SegmentFeatures::CompareFunctor>(new SegmentFeatures::CompareFunctor()); // The default CompareFunctor which ALWAYS returns false for the comparison
+    return {};
   }
 
-  // Generate the random voxel indices that will be used for the seed points to start a new grain growth/agglomeration
-  auto totalPoints = inputDataArray->getNumberOfTuples();
-
-  const int64 rangeMin = 0;
-  const int64 rangeMax = totalPoints - 1;
-  Int64Distribution distribution;
-  initializeVoxelSeedGenerator(distribution, rangeMin, rangeMax);
-
-  //  // Add compare function to arguments
-  //  Arguments newArgs = args;
-  //  newArgs.insert(k_CompareFunctKey, compare.get());
-
-  execute(gridGeom);
+  // Resize the feature attribute matrix once now that the number of features is known
+  auto& cellFeaturesAM = m_DataStructure.getDataRefAs<AttributeMatrix>(m_InputValues->pCellFeaturesPath);
+  ResizeAttributeMatrix(cellFeaturesAM, {numFeatures + 1}); // This will resize the active array
 
   IDataArray* activeArray = m_DataStructure.getDataAs<IDataArray>(m_InputValues->pActiveArrayPath);
   auto totalFeatures = activeArray->getNumberOfTuples();
@@ -231,75 +240,10 @@ Result<> ScalarSegmentFeatures::operator()()
   // By default we randomize grains
   if(m_InputValues->pShouldRandomizeFeatureIds)
   {
-    totalPoints = gridGeom->getNumberOfElements();
+    Int64Distribution distribution;
+    auto totalPoints = gridGeom->getNumberOfElements();
     randomizeFeatureIds(m_FeatureIdsArray, totalPoints, totalFeatures, distribution);
   }
 
   return {};
 }
-
-// -----------------------------------------------------------------------------
-int64_t ScalarSegmentFeatures::getSeed(int32 gnum, int64 nextSeed) const
-{
-  complex::AbstractDataStore<bool>* goodVoxels = nullptr;
-  if(m_InputValues->pUseGoodVoxels)
-  {
-    goodVoxels = m_GoodVoxelsArray->getDataStore();
-  }
-
-  complex::DataArray<int32>::store_type* featureIds = m_FeatureIdsArray->getDataStore();
-  usize totalPoints = featureIds->getNumberOfTuples();
-
-  int64 seed = -1;
-  // start with the next voxel after the last seed
-  usize randpoint = static_cast<usize>(nextSeed);
-  while(seed == -1 && randpoint < totalPoints)
-  {
-    if(featureIds->getValue(randpoint) == 0) // If the GrainId of the voxel is ZERO then we can use this as a seed point
-    {
-      if(!m_InputValues->pUseGoodVoxels || goodVoxels->getValue(randpoint))
-      {
-        seed = randpoint;
-      }
-      else
-      {
-        randpoint += 1;
-      }
-    }
-    else
-    {
-      randpoint += 1;
-    }
-  }
-  if(seed >= 0)
-  {
-    UInt8Array& activeArray = m_DataStructure.getDataRefAs<UInt8Array>(m_InputValues->pActiveArrayPath);
-    featureIds->setValue(static_cast<usize>(seed), gnum);
-    std::vector<usize> tDims = {static_cast<usize>(gnum) + 1};
-    auto& cellFeaturesAM = m_DataStructure.getDataRefAs<AttributeMatrix>(m_InputValues->pCellFeaturesPath);
-    ResizeAttributeMatrix(cellFeaturesAM, tDims); // This will resize the active array
-  }
-  return seed;
-}
-
-// -----------------------------------------------------------------------------
-bool ScalarSegmentFeatures::determineGrouping(int64 referencepoint, int64 neighborpoint, int32 gnum) const
-{
-
-  auto featureIds = m_FeatureIdsArray->getDataStore();
-
-  const complex::AbstractDataStore<bool>* goodVoxels = nullptr;
-  if(m_InputValues->pUseGoodVoxels)
-  {
-    goodVoxels = m_GoodVoxelsArray->getDataStore();
-  }
-
-  if(featureIds->getValue(neighborpoint) == 0 && (!m_InputValues->pUseGoodVoxels || goodVoxels->getValue(neighborpoint)))
-  {
-    CompareFunctor* func = m_CompareFunctor.get();
-    return (*func)((usize)(referencepoint), (usize)(neighborpoint), gnum);
-    //     | Functor  ||calling the operator() method of the CompareFunctor Class |
-  }
-
-  return false;
-}
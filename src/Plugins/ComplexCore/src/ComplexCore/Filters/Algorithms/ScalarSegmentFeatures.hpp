@@ -49,32 +49,9 @@ public:
 
   Result<> operator()();
 
-protected:
-  /**
-   * @brief
-   * @param data
-   * @param args
-   * @param gnum
-   * @param nextSeed
-   * @return int64
-   */
-  int64_t getSeed(int32 gnum, int64 nextSeed) const override;
-
-  /**
-   * @brief
-   * @param data
-   * @param args
-   * @param referencepoint
-   * @param neighborpoint
-   * @param gnum
-   * @return bool
-   */
-  bool determineGrouping(int64 referencePoint, int64 neighborPoint, int32 gnum) const override;
-
 private:
   const ScalarSegmentFeaturesInputValues* m_InputValues = nullptr;
   FeatureIdsArrayType* m_FeatureIdsArray = nullptr;
   GoodVoxelsArrayType* m_GoodVoxelsArray = nullptr;
-  std::shared_ptr<SegmentFeatures::CompareFunctor> m_CompareFunctor;
 };
 } // namespace complex
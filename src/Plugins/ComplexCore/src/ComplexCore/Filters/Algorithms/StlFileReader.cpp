@@ -2,96 +2,419 @@
 
 #include "ComplexCore/utils/StlUtilities.hpp"
 
+#include "complex/Common/Bit.hpp"
 #include "complex/Common/Range.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/MemoryMappedFile.hpp"
 #include "complex/Utilities/ParallelDataAlgorithm.hpp"
-
-#include <cstdio>
+#include "complex/Utilities/Parsing/Text/TextIngestion.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <numeric>
 #include <utility>
 
 using namespace complex;
 
 namespace
 {
+constexpr usize k_BinaryTriangleCountOffset = StlConstants::k_STL_HEADER_LENGTH;
+constexpr usize k_BinaryTrianglesOffset = k_BinaryTriangleCountOffset + sizeof(int32);
+// 12 floats for the normal and the vertices followed by the 2 byte attribute count
+constexpr usize k_BinaryTriangleLength = 50;
+constexpr usize k_TrianglesPerBlock = 4096;
+constexpr usize k_AsciiChunkSize = 1024 * 1024;
+constexpr usize k_NodesPerBucket = 4;
+
+using VertexKey = std::array<uint32, 3>;
 
 /**
- * @brief The FindUniqueIdsImpl class implements a threaded algorithm that determines the set of
- * unique vertices in the triangle geometry
+ * @brief Collects decoded triangles and writes them to the face normals and the
+ * vertex list one block at a time.
  */
-class FindUniqueIdsImpl
+class TriangleBlockWriter
 {
 public:
-  FindUniqueIdsImpl(IGeometry::SharedVertexList& vertex, const std::vector<std::vector<size_t>>& nodesInBin, complex::Int64DataStore& uniqueIds)
-  : m_Vertex(vertex)
-  , m_NodesInBin(nodesInBin)
-  , m_UniqueIds(uniqueIds)
+  TriangleBlockWriter(AbstractDataStore<float64>& faceNormals, AbstractDataStore<float32>& vertices)
+  : m_FaceNormals(faceNormals)
+  , m_Vertices(vertices)
   {
   }
 
-  // -----------------------------------------------------------------------------
-  void convert(size_t start, size_t end) const
+  void add(usize triangle, const std::array<float32, 12>& values)
   {
-    for(size_t i = start; i < end; i++)
+    if(m_Count == k_TrianglesPerBlock || (m_Count > 0 && triangle != m_FirstTriangle + m_Count))
     {
-      for(size_t j = 0; j < m_NodesInBin[i].size(); j++)
-      {
-        size_t node1 = m_NodesInBin[i][j];
-        if(m_UniqueIds[node1] == static_cast<int64_t>(node1))
-        {
-          for(size_t k = j + 1; k < m_NodesInBin[i].size(); k++)
-          {
-            size_t node2 = m_NodesInBin[i][k];
-            if(m_Vertex[node1 * 3] == m_Vertex[node2 * 3] && m_Vertex[node1 * 3 + 1] == m_Vertex[node2 * 3 + 1] && m_Vertex[node1 * 3 + 2] == m_Vertex[node2 * 3 + 2])
-            {
-              m_UniqueIds[node2] = node1;
-            }
-          }
-        }
-      }
+      flush();
+    }
+    if(m_Count == 0)
+    {
+      m_FirstTriangle = triangle;
     }
+    std::copy(values.cbegin(), values.cbegin() + 3, m_Normals.begin() + m_Count * 3);
+    std::copy(values.cbegin() + 3, values.cend(), m_Points.begin() + m_Count * 9);
+    m_Count++;
+  }
+
+  void flush()
+  {
+    if(m_Count == 0)
+    {
+      return;
+    }
+    m_FaceNormals.copyFromBuffer(m_FirstTriangle * 3, nonstd::span<const float64>(m_Normals.data(), m_Count * 3));
+    m_Vertices.copyFromBuffer(m_FirstTriangle * 9, nonstd::span<const float32>(m_Points.data(), m_Count * 9));
+    m_Count = 0;
+  }
+
+private:
+  AbstractDataStore<float64>& m_FaceNormals;
+  AbstractDataStore<float32>& m_Vertices;
+  std::array<float64, k_TrianglesPerBlock * 3> m_Normals = {};
+  std::array<float32, k_TrianglesPerBlock * 9> m_Points = {};
+  usize m_FirstTriangle = 0;
+  usize m_Count = 0;
+};
+
+/**
+ * @brief Decodes the binary triangle records. Records are either evenly spaced or
+ * start at the given offsets when some triangles carry attribute bytes.
+ */
+class DecodeBinaryTrianglesImpl
+{
+public:
+  DecodeBinaryTrianglesImpl(const uint8* contents, const std::vector<usize>& offsets, AbstractDataStore<float64>& faceNormals, AbstractDataStore<float32>& vertices,
+                            const std::atomic_bool& shouldCancel)
+  : m_Contents(contents)
+  , m_Offsets(offsets)
+  , m_FaceNormals(faceNormals)
+  , m_Vertices(vertices)
+  , m_ShouldCancel(shouldCancel)
+  {
   }
 
-  // -----------------------------------------------------------------------------
   void operator()(const Range& range) const
   {
-    convert(range.min(), range.max());
+    auto writer = std::make_unique<TriangleBlockWriter>(m_FaceNormals, m_Vertices);
+    std::array<float32, 12> values = {};
+    for(usize t = range.min(); t < range.max(); t++)
+    {
+      if(t % k_TrianglesPerBlock == 0 && m_ShouldCancel)
+      {
+        return;
+      }
+      const usize offset = m_Offsets.empty() ? k_BinaryTrianglesOffset + t * k_BinaryTriangleLength : m_Offsets[t];
+      std::memcpy(values.data(), m_Contents + offset, sizeof(values));
+      writer->add(t, values);
+    }
+    writer->flush();
   }
 
 private:
-  const IGeometry::SharedVertexList& m_Vertex;
-  const std::vector<std::vector<size_t>>& m_NodesInBin;
-  complex::Int64DataStore& m_UniqueIds;
+  const uint8* m_Contents = nullptr;
+  const std::vector<usize>& m_Offsets;
+  AbstractDataStore<float64>& m_FaceNormals;
+  AbstractDataStore<float32>& m_Vertices;
+  const std::atomic_bool& m_ShouldCancel;
 };
 
-class StlFileSentinel
+/**
+ * @brief Parses the facets of ASCII chunks that each start at a facet. Every facet is
+ * "facet normal nx ny nz outer loop vertex x y z (x3) endloop endfacet".
+ */
+class ParseAsciiFacetsImpl
 {
 public:
-  StlFileSentinel(FILE* file)
-  : m_File(file)
+  ParseAsciiFacetsImpl(std::string_view contents, const std::vector<TextIngestion::LineChunk>& chunks, const std::vector<usize>& facetOffsets, AbstractDataStore<float64>& faceNormals,
+                       AbstractDataStore<float32>& vertices, std::vector<Result<>>& chunkResults)
+  : m_Contents(contents)
+  , m_Chunks(chunks)
+  , m_FacetOffsets(facetOffsets)
+  , m_FaceNormals(faceNormals)
+  , m_Vertices(vertices)
+  , m_ChunkResults(chunkResults)
   {
   }
-  ~StlFileSentinel()
+
+  void operator()(const Range& range) const
   {
-    std::ignore = std::fclose(m_File);
+    auto writer = std::make_unique<TriangleBlockWriter>(m_FaceNormals, m_Vertices);
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      m_ChunkResults[chunk] = parseChunk(chunk, *writer);
+      if(m_ChunkResults[chunk].invalid())
+      {
+        return;
+      }
+    }
+    writer->flush();
   }
-  StlFileSentinel(const StlFileSentinel&) = delete;            // Copy Constructor Not Implemented
-  StlFileSentinel(StlFileSentinel&&) = delete;                 // Move Constructor Not Implemented
-  StlFileSentinel& operator=(const StlFileSentinel&) = delete; // Copy Assignment Not Implemented
-  StlFileSentinel& operator=(StlFileSentinel&&) = delete;      // Move Assignment Not Implemented
 
 private:
-  FILE* m_File = nullptr;
+  Result<> parseChunk(usize chunk, TriangleBlockWriter& writer) const
+  {
+    const TextIngestion::LineChunk& lineChunk = m_Chunks[chunk];
+    const std::string_view chunkText = m_Contents.substr(lineChunk.Begin, lineChunk.End - lineChunk.Begin);
+
+    std::array<float32, 12> values = {};
+    usize triangle = m_FacetOffsets[chunk];
+    usize numVertices = 0;
+    bool inFacet = false;
+    // Index of the next value to fill and the index after the last value that is expected
+    usize nextValue = 0;
+    usize endValue = 0;
+    bool valid = true;
+
+    const auto finishFacet = [&]() {
+      if(!inFacet)
+      {
+        return true;
+      }
+      if(numVertices != 3 || nextValue != endValue)
+      {
+        return false;
+      }
+      writer.add(triangle, values);
+      triangle++;
+      inFacet = false;
+      return true;
+    };
+
+    TextIngestion::ForEachValueToken(chunkText, ' ', [&](std::string_view token) {
+      if(nextValue < endValue)
+      {
+        valid = TextIngestion::ParseNumber(token, values[nextValue]) == std::errc{};
+        nextValue++;
+        return valid;
+      }
+      if(token == "facet")
+      {
+        valid = finishFacet();
+        inFacet = true;
+        numVertices = 0;
+        values.fill(0.0F);
+      }
+      else if(token == "normal" && inFacet)
+      {
+        nextValue = 0;
+        endValue = 3;
+      }
+      else if(token == "vertex" && inFacet)
+      {
+        valid = numVertices < 3;
+        numVertices++;
+        nextValue = numVertices * 3;
+        endValue = nextValue + 3;
+      }
+      return valid;
+    });
+    if(valid)
+    {
+      valid = finishFacet();
+    }
+
+    if(!valid)
+    {
+      return MakeErrorResult(StlConstants::k_TriangleParseError, fmt::format("Error reading Triangle '{}'. The facet does not have a normal and three vertices.", triangle));
+    }
+    return {};
+  }
+
+  std::string_view m_Contents;
+  const std::vector<TextIngestion::LineChunk>& m_Chunks;
+  const std::vector<usize>& m_FacetOffsets;
+  AbstractDataStore<float64>& m_FaceNormals;
+  AbstractDataStore<float32>& m_Vertices;
+  std::vector<Result<>>& m_ChunkResults;
 };
 
-std::array<float, 6> CreateMinMaxCoords()
+// -----------------------------------------------------------------------------
+bool IsInMemory(const IDataArray& dataArray)
 {
-  return {std::numeric_limits<float>::max(),  -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
-          -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),  -std::numeric_limits<float>::max()};
+  return dataArray.getIDataStoreRef().getStoreType() == IDataStore::StoreType::InMemory;
 }
 
+// -----------------------------------------------------------------------------
+VertexKey WeldKey(const std::array<float32, 3>& coords)
+{
+  // -0.0 and 0.0 are the same coordinate
+  constexpr uint32 k_NegativeZero = 0x80000000;
+  VertexKey key = {bit_cast<uint32>(coords[0]), bit_cast<uint32>(coords[1]), bit_cast<uint32>(coords[2])};
+  for(uint32& value : key)
+  {
+    value = value == k_NegativeZero ? 0 : value;
+  }
+  return key;
+}
+
+// -----------------------------------------------------------------------------
+usize HashVertexKey(const VertexKey& key)
+{
+  uint64 hash = key[0];
+  hash = hash * 0x9E3779B97F4A7C15ULL ^ key[1];
+  hash = hash * 0x9E3779B97F4A7C15ULL ^ key[2];
+  hash ^= hash >> 31;
+  hash *= 0xBF58476D1CE4E5B9ULL;
+  hash ^= hash >> 29;
+  return static_cast<usize>(hash);
+}
+
+// -----------------------------------------------------------------------------
+VertexKey ReadWeldKey(const AbstractDataStore<float32>& vertexStore, usize node)
+{
+  std::array<float32, 3> coords = {};
+  vertexStore.copyIntoBuffer(node * 3, nonstd::span<float32>(coords.data(), coords.size()));
+  return WeldKey(coords);
+}
+
+/**
+ * @brief Finds the nodes that have the same coordinates and numbers the unique nodes
+ * in the order they first appear. The keys are read from the vertex store again
+ * whenever they are needed instead of being kept for every node.
+ * @tparam NodeIndexT Index type of the temporary node lists. It must hold the number of nodes.
+ * @param vertexStore The vertices of the nodes
+ * @param parallelReads Whether the vertex store may be read from several threads
+ * @param uniqueIds Receives the new id of every node
+ * @param shouldCancel
+ * @return The number of unique nodes
+ */
+template <typename NodeIndexT>
+usize FindUniqueNodes(const AbstractDataStore<float32>& vertexStore, bool parallelReads, std::vector<IGeometry::MeshIndexType>& uniqueIds, const std::atomic_bool& shouldCancel)
+{
+  const usize nNodes = uniqueIds.size();
+
+  // Duplicate nodes have identical coordinates, so they are found by hashing the bits of the coordinates.
+  // The number of buckets follows the number of nodes so that every bucket only holds a few nodes.
+  const usize numBuckets = std::max<usize>(nNodes / k_NodesPerBucket, 1);
+  const auto bucketOf = [numBuckets](const VertexKey& key) { return HashVertexKey(key) % numBuckets; };
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, nNodes);
+  dataAlg.setParallelizationEnabled(parallelReads);
+  std::vector<std::atomic<NodeIndexT>> bucketCursors(numBuckets);
+  dataAlg.execute([&](const Range& range) {
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      bucketCursors[bucketOf(ReadWeldKey(vertexStore, i))].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+
+  if(shouldCancel)
+  {
+    return 0;
+  }
+
+  std::vector<NodeIndexT> bucketOffsets(numBuckets + 1, 0);
+  for(usize bucket = 0; bucket < numBuckets; bucket++)
+  {
+    bucketOffsets[bucket + 1] = bucketOffsets[bucket] + bucketCursors[bucket].load(std::memory_order_relaxed);
+    bucketCursors[bucket].store(bucketOffsets[bucket], std::memory_order_relaxed);
+  }
+  std::vector<NodeIndexT> bucketNodes(nNodes);
+  dataAlg.execute([&](const Range& range) {
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      bucketNodes[bucketCursors[bucketOf(ReadWeldKey(vertexStore, i))].fetch_add(1, std::memory_order_relaxed)] = static_cast<NodeIndexT>(i);
+    }
+  });
+  bucketCursors.clear();
+  bucketCursors.shrink_to_fit();
+
+  if(shouldCancel)
+  {
+    return 0;
+  }
+
+  // Within a bucket equal nodes are sorted next to each other and the first one of them is kept
+  dataAlg.setRange(0, numBuckets);
+  dataAlg.execute([&](const Range& range) {
+    for(usize bucket = range.min(); bucket < range.max(); bucket++)
+    {
+      const auto begin = bucketNodes.begin() + bucketOffsets[bucket];
+      const auto end = bucketNodes.begin() + bucketOffsets[bucket + 1];
+      if(end - begin > 1)
+      {
+        std::sort(begin, end, [&vertexStore](NodeIndexT lhs, NodeIndexT rhs) {
+          const VertexKey lhsKey = ReadWeldKey(vertexStore, lhs);
+          const VertexKey rhsKey = ReadWeldKey(vertexStore, rhs);
+          return lhsKey < rhsKey || (lhsKey == rhsKey && lhs < rhs);
+        });
+      }
+      VertexKey representativeKey = {};
+      IGeometry::MeshIndexType representative = 0;
+      for(auto node = begin; node != end; ++node)
+      {
+        const VertexKey key = ReadWeldKey(vertexStore, *node);
+        if(node == begin || key != representativeKey)
+        {
+          representativeKey = key;
+          representative = *node;
+        }
+        uniqueIds[*node] = representative;
+      }
+    }
+  });
+  bucketOffsets.clear();
+  bucketOffsets.shrink_to_fit();
+
+  if(shouldCancel)
+  {
+    return 0;
+  }
+
+  // Renumber the unique nodes in the order they first appear. Each block of nodes is counted
+  // first so that the blocks can be numbered independently.
+  const usize numBlocks = (nNodes + k_TrianglesPerBlock - 1) / k_TrianglesPerBlock;
+  std::vector<usize> blockOffsets(numBlocks + 1, 0);
+  dataAlg.setParallelizationEnabled(true);
+  dataAlg.setRange(0, numBlocks);
+  dataAlg.execute([&](const Range& range) {
+    for(usize block = range.min(); block < range.max(); block++)
+    {
+      usize count = 0;
+      for(usize i = block * k_TrianglesPerBlock; i < std::min(nNodes, (block + 1) * k_TrianglesPerBlock); i++)
+      {
+        count += uniqueIds[i] == i ? 1 : 0;
+      }
+      blockOffsets[block + 1] = count;
+    }
+  });
+  std::partial_sum(blockOffsets.begin(), blockOffsets.end(), blockOffsets.begin());
+
+  // The bucket lists are no longer needed, so they hold the new id of every unique node
+  std::vector<NodeIndexT>& newIds = bucketNodes;
+  dataAlg.execute([&](const Range& range) {
+    for(usize block = range.min(); block < range.max(); block++)
+    {
+      usize newId = blockOffsets[block];
+      for(usize i = block * k_TrianglesPerBlock; i < std::min(nNodes, (block + 1) * k_TrianglesPerBlock); i++)
+      {
+        if(uniqueIds[i] == i)
+        {
+          newIds[i] = static_cast<NodeIndexT>(newId);
+          newId++;
+        }
+      }
+    }
+  });
+
+  // Every node takes the new id of the node it was merged into
+  dataAlg.setRange(0, nNodes);
+  dataAlg.execute([&](const Range& range) {
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      uniqueIds[i] = newIds[uniqueIds[i]];
+    }
+  });
+
+  return blockOffsets.back();
+}
 } // End anonymous namespace
 
 StlFileReader::StlFileReader(DataStructure& data, fs::path stlFilePath, const DataPath& geometryPath, const DataPath& faceGroupPath, const DataPath& faceNormalsDataPath,
@@ -111,23 +434,33 @@ StlFileReader::~StlFileReader() noexcept = default;
 
 Result<> StlFileReader::operator()()
 {
+  const int32 stlFileType = StlUtilities::DetermineStlFileType(m_FilePath);
+  if(stlFileType < 0)
+  {
+    return MakeErrorResult(stlFileType, "Error opening STL file");
+  }
 
-  m_MinMaxCoords = ::CreateMinMaxCoords();
-
-  // Open File
-  FILE* f = std::fopen(m_FilePath.string().c_str(), "rb");
-  if(nullptr == f)
+  Result<MemoryMappedFile> fileResult = MemoryMappedFile::Open(m_FilePath);
+  if(fileResult.invalid())
   {
     return MakeErrorResult(complex::StlConstants::k_ErrorOpeningFile, "Error opening STL file");
   }
-  StlFileSentinel fileSentinel(f); // Will ensure that the file is closed when this method returns
+  const MemoryMappedFile& stlFile = fileResult.value();
+
+  Result<> result = stlFileType == 1 ? readAsciiFile(stlFile.text()) : readBinaryFile(stlFile.bytes());
+  if(result.invalid() || m_ShouldCancel)
+  {
+    return result;
+  }
 
-  // Read Header
-  std::array<char, complex::StlConstants::k_STL_HEADER_LENGTH> stlHeader = {0};
-  int32_t triCount = 0;
-  if(std::fread(stlHeader.data(), complex::StlConstants::k_STL_HEADER_LENGTH, 1, f) != 1)
+  return eliminate_duplicate_nodes();
+}
+
+Result<> StlFileReader::readBinaryFile(nonstd::span<const uint8> contents)
+{
+  if(contents.size() < k_BinaryTrianglesOffset)
   {
-    return MakeErrorResult(complex::StlConstants::k_StlHeaderParseError, "Error reading first 8 bytes of STL header. This can't be good.");
+    return MakeErrorResult(complex::StlConstants::k_TriangleCountParseError, "Error reading number of triangles from file. This is bad.");
   }
 
   // Look for the tell-tale signs that the file was written from Magics Materialise
@@ -136,153 +469,128 @@ Result<> StlFileReader::operator()()
   // This NON Zero value does NOT indicate a length but is some sort of color
   // value encoded into the file. Instead of being normal like everyone else and
   // using the STL spec they went off and did their own thing.
-  std::string stlHeaderStr(stlHeader.data(), complex::StlConstants::k_STL_HEADER_LENGTH);
+  const std::string_view stlHeader(reinterpret_cast<const char*>(contents.data()), complex::StlConstants::k_STL_HEADER_LENGTH);
+  const bool magicsFile = stlHeader.find("COLOR=") != std::string_view::npos && stlHeader.find("MATERIAL=") != std::string_view::npos;
 
-  bool magicsFile = false;
-  static const std::string k_ColorHeader("COLOR=");
-  static const std::string k_MaterialHeader("MATERIAL=");
-  if(stlHeaderStr.find(k_ColorHeader) != std::string::npos && stlHeaderStr.find(k_MaterialHeader) != std::string::npos)
+  int32 triCount = 0;
+  std::memcpy(&triCount, contents.data() + k_BinaryTriangleCountOffset, sizeof(int32));
+  if(triCount < 0)
   {
-    magicsFile = true;
+    return MakeErrorResult(complex::StlConstants::k_TriangleCountParseError, "Error reading number of triangles from file. This is bad.");
   }
-  // Read the number of triangles in the file.
-  if(std::fread(&triCount, sizeof(int32_t), 1, f) != 1)
+  const auto numTriangles = static_cast<usize>(triCount);
+
+  // Records are evenly spaced unless some triangles are followed by attribute bytes. That can only be
+  // the case if the file is larger than the records themselves, so only then are the offsets walked.
+  std::vector<usize> offsets;
+  const usize evenlySpacedSize = k_BinaryTrianglesOffset + numTriangles * k_BinaryTriangleLength;
+  if(!magicsFile && contents.size() > evenlySpacedSize)
   {
-    return MakeErrorResult(complex::StlConstants::k_TriangleCountParseError, "Error reading number of triangles from file. This is bad.");
+    offsets.resize(numTriangles);
+    usize offset = k_BinaryTrianglesOffset;
+    for(usize t = 0; t < numTriangles; t++)
+    {
+      if(offset + k_BinaryTriangleLength > contents.size())
+      {
+        return MakeErrorResult(complex::StlConstants::k_TriangleParseError, fmt::format("Error reading Triangle '{}'. The file ends before the triangle does.", t));
+      }
+      offsets[t] = offset;
+      uint16 attr = 0;
+      std::memcpy(&attr, contents.data() + offset + k_BinaryTriangleLength - sizeof(uint16), sizeof(uint16));
+      offset += k_BinaryTriangleLength + attr;
+    }
+  }
+  else if(contents.size() < evenlySpacedSize)
+  {
+    return MakeErrorResult(complex::StlConstants::k_TriangleParseError,
+                           fmt::format("Error reading Triangle '{}'. The file ends before the triangle does.", (contents.size() - k_BinaryTrianglesOffset) / k_BinaryTriangleLength));
   }
 
   TriangleGeom& triangleGeom = m_DataStructure.getDataRefAs<TriangleGeom>(m_GeometryDataPath);
+  triangleGeom.resizeFaceList(numTriangles);
+  triangleGeom.resizeVertexList(numTriangles * 3);
+  ResizeAttributeMatrix(*triangleGeom.getFaceData(), {numTriangles});
 
-  triangleGeom.resizeFaceList(triCount);
-  triangleGeom.resizeVertexList(triCount * 3);
-
-  using SharedTriList = IGeometry::MeshIndexArrayType;
-  using SharedVertList = IGeometry::SharedVertexList;
+  Float64Array& faceNormals = m_DataStructure.getDataRefAs<Float64Array>(m_FaceNormalsDataPath);
+  IGeometry::SharedVertexList& vertices = *(triangleGeom.getVertices());
 
-  SharedTriList& triangles = *(triangleGeom.getFaces());
-  SharedVertList& nodes = *(triangleGeom.getVertices());
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numTriangles);
+  dataAlg.setParallelizationEnabled(IsInMemory(faceNormals) && IsInMemory(vertices));
+  dataAlg.execute(DecodeBinaryTrianglesImpl(contents.data(), offsets, faceNormals.getDataStoreRef(), vertices.getDataStoreRef(), m_ShouldCancel));
 
-  Float64Array& faceNormals = m_DataStructure.getDataRefAs<Float64Array>(m_FaceNormalsDataPath);
+  return {};
+}
 
-  // Read the triangles
-  constexpr size_t k_StlElementCount = 12;
-  std::array<float, k_StlElementCount> fileVert = {0.0F};
-  uint16_t attr = 0;
-  std::vector<uint8_t> triangleAttributeBuffer(std::numeric_limits<uint16_t>::max()); // Just allocate a buffer of max UINT16 elements
-  for(int32_t t = 0; t < triCount; ++t)
-  {
-    size_t objsRead = std::fread(fileVert.data(), sizeof(float), k_StlElementCount, f); // Read the Triangle
-    if(k_StlElementCount != objsRead)
-    {
-      std::string msg = fmt::format("Error reading Triangle '{}}'. Object Count was {} and should have been {}", t, objsRead, k_StlElementCount);
-      return MakeErrorResult(complex::StlConstants::k_TriangleParseError, msg);
-    }
+Result<> StlFileReader::readAsciiFile(std::string_view contents)
+{
+  std::vector<TextIngestion::LineChunk> chunks = TextIngestion::SplitIntoLineChunks(contents, k_AsciiChunkSize);
 
-    objsRead = std::fread(&attr, sizeof(uint16_t), 1, f); // Read the Triangle Attribute Data length
-    if(objsRead != 1)
-    {
-      std::string msg = fmt::format("Error reading Number of attributes for triangle '{}'. Object Count was {} and should have been 1", t, objsRead);
-      return MakeErrorResult(complex::StlConstants::k_AttributeParseError, msg);
-    }
-    if(attr > 0 && !magicsFile)
-    {
-      std::ignore = std::fseek(f, static_cast<size_t>(attr), SEEK_CUR); // Skip past the Triangle Attribute data since we don't know how to read it anyways
-    }
-    if(fileVert[3] < m_MinMaxCoords[0])
-    {
-      m_MinMaxCoords[0] = fileVert[3];
-    }
-    if(fileVert[3] > m_MinMaxCoords[1])
-    {
-      m_MinMaxCoords[1] = fileVert[3];
-    }
-    if(fileVert[4] < m_MinMaxCoords[2])
-    {
-      m_MinMaxCoords[2] = fileVert[4];
-    }
-    if(fileVert[4] > m_MinMaxCoords[3])
-    {
-      m_MinMaxCoords[3] = fileVert[4];
-    }
-    if(fileVert[5] < m_MinMaxCoords[4])
-    {
-      m_MinMaxCoords[4] = fileVert[5];
-    }
-    if(fileVert[5] > m_MinMaxCoords[5])
-    {
-      m_MinMaxCoords[5] = fileVert[5];
-    }
-    if(fileVert[6] < m_MinMaxCoords[0])
-    {
-      m_MinMaxCoords[0] = fileVert[6];
-    }
-    if(fileVert[6] > m_MinMaxCoords[1])
-    {
-      m_MinMaxCoords[1] = fileVert[6];
-    }
-    if(fileVert[7] < m_MinMaxCoords[2])
-    {
-      m_MinMaxCoords[2] = fileVert[7];
-    }
-    if(fileVert[7] > m_MinMaxCoords[3])
-    {
-      m_MinMaxCoords[3] = fileVert[7];
-    }
-    if(fileVert[8] < m_MinMaxCoords[4])
-    {
-      m_MinMaxCoords[4] = fileVert[8];
-    }
-    if(fileVert[8] > m_MinMaxCoords[5])
-    {
-      m_MinMaxCoords[5] = fileVert[8];
-    }
-    if(fileVert[9] < m_MinMaxCoords[0])
-    {
-      m_MinMaxCoords[0] = fileVert[9];
-    }
-    if(fileVert[9] > m_MinMaxCoords[1])
-    {
-      m_MinMaxCoords[1] = fileVert[9];
-    }
-    if(fileVert[10] < m_MinMaxCoords[2])
-    {
-      m_MinMaxCoords[2] = fileVert[10];
-    }
-    if(fileVert[10] > m_MinMaxCoords[3])
+  // Move the start of every chunk to its first facet so that no facet is split between two chunks
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, chunks.size());
+  dataAlg.execute([&](const Range& range) {
+    for(usize chunk = std::max<usize>(range.min(), 1); chunk < range.max(); chunk++)
     {
-      m_MinMaxCoords[3] = fileVert[10];
+      usize facetBegin = std::string_view::npos;
+      TextIngestion::ForEachLine(contents, chunks[chunk], [&](usize, std::string_view line) {
+        const usize first = line.find_first_not_of(" \t");
+        if(first != std::string_view::npos && line.substr(first, 5) == "facet")
+        {
+          facetBegin = static_cast<usize>(line.data() + first - contents.data());
+          return false;
+        }
+        return true;
+      });
+      chunks[chunk].Begin = facetBegin;
     }
-    if(fileVert[11] < m_MinMaxCoords[4])
+  });
+  // A chunk without a facet start is part of the facet before it
+  for(usize chunk = chunks.size(); chunk-- > 1;)
+  {
+    if(chunks[chunk].Begin == std::string_view::npos)
     {
-      m_MinMaxCoords[4] = fileVert[11];
+      chunks[chunk].Begin = chunk + 1 < chunks.size() ? chunks[chunk + 1].Begin : contents.size();
     }
-    if(fileVert[11] > m_MinMaxCoords[5])
+    chunks[chunk - 1].End = chunks[chunk].Begin;
+  }
+
+  // Count the facets of every chunk so that each chunk knows the index of its first triangle
+  std::vector<usize> facetOffsets(chunks.size() + 1, 0);
+  dataAlg.execute([&](const Range& range) {
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
     {
-      m_MinMaxCoords[5] = fileVert[11];
+      usize count = 0;
+      TextIngestion::ForEachValueToken(contents.substr(chunks[chunk].Begin, chunks[chunk].End - chunks[chunk].Begin), ' ', [&count](std::string_view token) {
+        count += token == "facet" ? 1 : 0;
+        return true;
+      });
+      facetOffsets[chunk + 1] = count;
     }
-    faceNormals[3 * t + 0] = static_cast<double>(fileVert[0]);
-    faceNormals[3 * t + 1] = static_cast<double>(fileVert[1]);
-    faceNormals[3 * t + 2] = static_cast<double>(fileVert[2]);
-    nodes[3 * (3 * t + 0) + 0] = fileVert[3];
-    nodes[3 * (3 * t + 0) + 1] = fileVert[4];
-    nodes[3 * (3 * t + 0) + 2] = fileVert[5];
-    nodes[3 * (3 * t + 1) + 0] = fileVert[6];
-    nodes[3 * (3 * t + 1) + 1] = fileVert[7];
-    nodes[3 * (3 * t + 1) + 2] = fileVert[8];
-    nodes[3 * (3 * t + 2) + 0] = fileVert[9];
-    nodes[3 * (3 * t + 2) + 1] = fileVert[10];
-    nodes[3 * (3 * t + 2) + 2] = fileVert[11];
-    triangles[t * 3] = 3 * t + 0;
-    triangles[t * 3 + 1] = 3 * t + 1;
-    triangles[t * 3 + 2] = 3 * t + 2;
-    if(m_ShouldCancel)
+  });
+  std::partial_sum(facetOffsets.begin(), facetOffsets.end(), facetOffsets.begin());
+  const usize numTriangles = facetOffsets.back();
+
+  TriangleGeom& triangleGeom = m_DataStructure.getDataRefAs<TriangleGeom>(m_GeometryDataPath);
+  triangleGeom.resizeFaceList(numTriangles);
+  triangleGeom.resizeVertexList(numTriangles * 3);
+  ResizeAttributeMatrix(*triangleGeom.getFaceData(), {numTriangles});
+
+  Float64Array& faceNormals = m_DataStructure.getDataRefAs<Float64Array>(m_FaceNormalsDataPath);
+  IGeometry::SharedVertexList& vertices = *(triangleGeom.getVertices());
+
+  std::vector<Result<>> chunkResults(chunks.size());
+  dataAlg.setParallelizationEnabled(IsInMemory(faceNormals) && IsInMemory(vertices));
+  dataAlg.execute(ParseAsciiFacetsImpl(contents, chunks, facetOffsets, faceNormals.getDataStoreRef(), vertices.getDataStoreRef(), chunkResults));
+  for(Result<>& chunkResult : chunkResults)
+  {
+    if(chunkResult.invalid())
     {
-      return {};
+      return std::move(chunkResult);
     }
   }
 
-  return eliminate_duplicate_nodes();
-  // The fileSentinel will ensure the FILE* is closed.
+  return {};
 }
 
 Result<> StlFileReader::eliminate_duplicate_nodes()
@@ -295,67 +603,24 @@ Result<> StlFileReader::eliminate_duplicate_nodes()
   SharedTriList& triangles = *(triangleGeom.getFaces());
   SharedVertList& vertices = *(triangleGeom.getVertices());
 
-  IGeometry::MeshIndexType nNodesAll = triangleGeom.getNumberOfVertices();
-  IGeometry::MeshIndexType nTriangles = triangleGeom.getNumberOfFaces();
-  size_t nNodes = 0;
-  if(nNodesAll > 0)
-  {
-    nNodes = static_cast<size_t>(nNodesAll);
-  }
-  float stepX = (m_MinMaxCoords[1] - m_MinMaxCoords[0]) / 100.0f;
-  float stepY = (m_MinMaxCoords[3] - m_MinMaxCoords[2]) / 100.0f;
-  float stepZ = (m_MinMaxCoords[5] - m_MinMaxCoords[4]) / 100.0f;
+  const usize nNodes = triangleGeom.getNumberOfVertices();
+  const usize nTriangles = triangleGeom.getNumberOfFaces();
 
-  std::vector<std::vector<size_t>> nodesInBin(100 * 100 * 100);
-
-  // determine (xyz) bin each node falls in - used to speed up node comparison
-  int32_t bin = 0, xBin = 0, yBin = 0, zBin = 0;
-  for(size_t i = 0; i < nNodes; i++)
+  AbstractDataStore<float32>& vertexStore = vertices.getDataStoreRef();
+  std::vector<IGeometry::MeshIndexType> uniqueIds(nNodes);
+  usize uniqueCount = 0;
+  if(nNodes <= std::numeric_limits<uint32>::max())
   {
-    xBin = static_cast<int32_t>((vertices[i * 3] - m_MinMaxCoords[0]) / stepX);
-    yBin = static_cast<int32_t>((vertices[i * 3 + 1] - m_MinMaxCoords[2]) / stepY);
-    zBin = static_cast<int32_t>((vertices[i * 3 + 2] - m_MinMaxCoords[4]) / stepZ);
-    if(xBin == 100)
-    {
-      xBin = 99;
-    }
-    if(yBin == 100)
-    {
-      yBin = 99;
-    }
-    if(zBin == 100)
-    {
-      zBin = 99;
-    }
-    bin = (zBin * 10000) + (yBin * 100) + xBin;
-    nodesInBin[bin].push_back(i);
+    uniqueCount = FindUniqueNodes<uint32>(vertexStore, IsInMemory(vertices), uniqueIds, m_ShouldCancel);
   }
-
-  // Create array to hold unique node numbers
-  Int64DataStore uniqueIds(IDataStore::ShapeType{nNodes}, IDataStore::ShapeType{1}, {});
-  for(IGeometry::MeshIndexType i = 0; i < nNodesAll; i++)
+  else
   {
-    uniqueIds[i] = static_cast<int64_t>(i);
+    uniqueCount = FindUniqueNodes<uint64>(vertexStore, IsInMemory(vertices), uniqueIds, m_ShouldCancel);
   }
 
-  // Parallel algorithm to find duplicate nodes
-  ParallelDataAlgorithm dataAlg;
-  dataAlg.setRange(0ULL, static_cast<size_t>(100 * 100 * 100));
-  dataAlg.execute(::FindUniqueIdsImpl(vertices, nodesInBin, uniqueIds));
-
-  // renumber the unique nodes
-  int64_t uniqueCount = 0;
-  for(size_t i = 0; i < nNodes; i++)
+  if(m_ShouldCancel)
   {
-    if(uniqueIds[i] == static_cast<int64_t>(i))
-    {
-      uniqueIds[i] = uniqueCount;
-      uniqueCount++;
-    }
-    else
-    {
-      uniqueIds[i] = uniqueIds[uniqueIds[i]];
-    }
+    return {};
   }
 
   float scaleFactor = 1.0F;
@@ -364,27 +629,36 @@ Result<> StlFileReader::eliminate_duplicate_nodes()
     scaleFactor = m_ScaleFactor;
   }
 
-  // Move nodes to unique Id and then resize nodes array and apply optional scaling
-  for(size_t i = 0; i < nNodes; i++)
+  // Move nodes to unique Id and then resize nodes array. A unique node is never moved to a later
+  // position, so each block is read before the nodes of later blocks can overwrite it.
+  std::vector<float32> blockCoords(k_TrianglesPerBlock * 3);
+  usize newId = 0;
+  for(usize blockStart = 0; blockStart < nNodes; blockStart += k_TrianglesPerBlock)
   {
-    vertices[uniqueIds[i] * 3] = vertices[i * 3] * m_ScaleFactor;
-    vertices[uniqueIds[i] * 3 + 1] = vertices[i * 3 + 1] * m_ScaleFactor;
-    vertices[uniqueIds[i] * 3 + 2] = vertices[i * 3 + 2] * m_ScaleFactor;
+    const usize blockSize = std::min(k_TrianglesPerBlock, nNodes - blockStart);
+    vertexStore.copyIntoBuffer(blockStart * 3, nonstd::span<float32>(blockCoords.data(), blockSize * 3));
+    const usize blockFirstId = newId;
+    for(usize i = 0; i < blockSize; i++)
+    {
+      // Nodes are numbered in the order they first appear, so the first node of a group takes the next id
+      if(uniqueIds[blockStart + i] == newId)
+      {
+        for(usize k = 0; k < 3; k++)
+        {
+          blockCoords[(newId - blockFirstId) * 3 + k] = blockCoords[i * 3 + k] * scaleFactor;
+        }
+        newId++;
+      }
+    }
+    if(newId > blockFirstId)
+    {
+      vertexStore.copyFromBuffer(blockFirstId * 3, nonstd::span<const float32>(blockCoords.data(), (newId - blockFirstId) * 3));
+    }
   }
   triangleGeom.resizeVertexList(uniqueCount);
 
-  // Update the triangle nodes to reflect the unique ids
-  int64_t node1 = 0, node2 = 0, node3 = 0;
-  for(size_t i = 0; i < static_cast<size_t>(nTriangles); i++)
-  {
-    node1 = triangles[i * 3];
-    node2 = triangles[i * 3 + 1];
-    node3 = triangles[i * 3 + 2];
-
-    triangles[i * 3] = uniqueIds[node1];
-    triangles[i * 3 + 1] = uniqueIds[node2];
-    triangles[i * 3 + 2] = uniqueIds[node3];
-  }
+  // Update the triangle nodes to reflect the unique ids. The nodes of triangle t were 3t, 3t + 1 and 3t + 2.
+  triangles.getDataStoreRef().copyFromBuffer(0, nonstd::span<const IGeometry::MeshIndexType>(uniqueIds.data(), nTriangles * 3));
 
   ResizeAttributeMatrix(*triangleGeom.getFaceData(), {triangleGeom.getNumberOfFaces()});
   ResizeAttributeMatrix(*triangleGeom.getVertexData(), {triangleGeom.getNumberOfVertices()});
@@ -7,8 +7,10 @@
 #include "complex/Filter/Arguments.hpp"
 #include "complex/Filter/IFilter.hpp"
 
-#include <array>
+#include <nonstd/span.hpp>
+
 #include <filesystem>
+#include <string_view>
 
 namespace fs = std::filesystem;
 
@@ -33,21 +35,26 @@ public:
   Result<> operator()();
 
   /**
-   * @brief readFile Reads the .stl file
+   * @brief readBinaryFile Decodes the triangles of a binary .stl file in parallel
+   * @param contents The whole contents of the file
    */
-  Result<> readFile();
+  Result<> readBinaryFile(nonstd::span<const uint8> contents);
+
+  /**
+   * @brief readAsciiFile Parses the facets of an ASCII .stl file in parallel
+   * @param contents The whole contents of the file
+   */
+  Result<> readAsciiFile(std::string_view contents);
 
   /**
    * @brief eliminate_duplicate_nodes Removes duplicate nodes to ensure the
-   * created vertex list is shared
+   * created vertex list is shared. Each triangle is expected to own the three
+   * vertices that follow the vertices of the previous triangle, as they are read
+   * from the file.
    */
   Result<> eliminate_duplicate_nodes();
 
 private:
-  // Holds the min/max coordinates for X, Y, Z laid out at { X_Min, X_Max, Y_Min, Y_Max, Z_Min, Z_Max}
-  std::array<float, 6> m_MinMaxCoords = {std::numeric_limits<float>::max(),  -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
-                                         -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),  -std::numeric_limits<float>::max()};
-
   DataStructure& m_DataStructure;
   const fs::path m_FilePath;
   const DataPath& m_GeometryDataPath;
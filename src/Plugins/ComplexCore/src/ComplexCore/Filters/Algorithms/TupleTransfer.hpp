@@ -4,11 +4,30 @@
 
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataPath.hpp"
+#include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/DataStructure.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 #include "complex/Utilities/TemplateHelpers.hpp"
 
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
 namespace complex
 {
+/**
+ * @brief The destination tuple of a transfer and the two source tuples it is taken from.
+ */
+struct COMPLEXCORE_EXPORT TupleTransferIndices
+{
+  usize Destination = 0;
+  usize FirstSource = 0;
+  usize SecondSource = 0;
+};
+
 /**
  * @brief This is the base class that is used to transfer cell data to triangle face data
  * but could be used generally to copy the tuple value from one Data Array to another
@@ -35,6 +54,14 @@ public:
 
   virtual void transfer(size_t faceIndex, size_t firstcIndex) = 0;
 
+  /**
+   * @brief Transfers every set of indices in one typed pass over the arrays. No tuple may
+   * be written by more than one set of indices so that they can be copied in parallel.
+   * @param indices
+   * @param forceSecondToZero
+   */
+  virtual void transfer(nonstd::span<const TupleTransferIndices> indices, bool forceSecondToZero = false) = 0;
+
 protected:
   AbstractTupleTransfer() = default;
 
@@ -66,6 +93,7 @@ public:
     m_FacePtr = dynamic_cast<DataArrayType*>(faceArray);
 
     m_NumComps = m_CellPtr->getNumberOfComponents();
+    m_Buffer = std::make_unique<T[]>(m_NumComps);
   }
 
   ~TransferTuple() = default;
@@ -76,38 +104,66 @@ public:
 
   /**
    * @brief This method does the actual copying of the Tuple values from one DataArray to the other DataArray
-   * @param faceIndex
-   * @param firstcIndex
-   * @param secondcIndex
+   * @param faceIndex Destination tuple
+   * @param firstcIndex Source tuple
+   * @param secondcIndex Source tuple that is copied into the tuple after faceIndex
    * @param forceSecondToZero
    */
   void transfer(size_t faceIndex, size_t firstcIndex, size_t secondcIndex, bool forceSecondToZero = false) override
   {
-    for(size_t i = 0; i < m_NumComps; i++)
-    {
-      (*m_FacePtr)[faceIndex + i] = (*m_CellPtr)[firstcIndex + i];
-    }
+    transfer(faceIndex, firstcIndex);
 
     if(!forceSecondToZero)
     {
-      for(size_t i = 0; i < m_NumComps; i++)
-      {
-        (*m_FacePtr)[faceIndex + i + m_NumComps] = (*m_CellPtr)[secondcIndex + i];
-      }
+      transfer(faceIndex + 1, secondcIndex);
     }
   }
 
   void transfer(size_t faceIndex, size_t firstcIndex) override
   {
-    for(size_t i = 0; i < m_NumComps; i++)
+    nonstd::span<T> tuple(m_Buffer.get(), m_NumComps);
+    std::as_const(*m_CellPtr).getDataStoreRef().copyIntoBuffer(firstcIndex * m_NumComps, tuple);
+    m_FacePtr->getDataStoreRef().copyFromBuffer(faceIndex * m_NumComps, tuple);
+  }
+
+  void transfer(nonstd::span<const TupleTransferIndices> indices, bool forceSecondToZero = false) override
+  {
+    const auto& cellStore = std::as_const(*m_CellPtr).getDataStoreRef();
+    auto& faceStore = m_FacePtr->getDataStoreRef();
+    const auto* cellData = dynamic_cast<const DataStore<T>*>(&cellStore);
+    auto* faceData = dynamic_cast<DataStore<T>*>(&faceStore);
+    if(cellData == nullptr || faceData == nullptr)
     {
-      (*m_FacePtr)[faceIndex + i] = (*m_CellPtr)[firstcIndex + i];
+      // Out of core and bit packed stores are not safe to write from several threads
+      for(const auto& tupleIndices : indices)
+      {
+        transfer(tupleIndices.Destination, tupleIndices.FirstSource, tupleIndices.SecondSource, forceSecondToZero);
+      }
+      return;
     }
+
+    const usize numComps = m_NumComps;
+    const T* source = cellData->data();
+    T* destination = faceData->data();
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, indices.size());
+    dataAlg.execute([=](const Range& range) {
+      for(usize i = range.min(); i < range.max(); i++)
+      {
+        const TupleTransferIndices& tupleIndices = indices[i];
+        std::copy_n(source + tupleIndices.FirstSource * numComps, numComps, destination + tupleIndices.Destination * numComps);
+        if(!forceSecondToZero)
+        {
+          std::copy_n(source + tupleIndices.SecondSource * numComps, numComps, destination + (tupleIndices.Destination + 1) * numComps);
+        }
+      }
+    });
   }
 
 private:
   DataArrayType* m_CellPtr = nullptr;
   DataArrayType* m_FacePtr = nullptr;
+  std::unique_ptr<T[]> m_Buffer;
 };
 
 /**
@@ -3,18 +3,23 @@
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Parameters/FileSystemPathParameter.hpp"
+#include "complex/Parameters/NumberParameter.hpp"
 #include "complex/Parameters/StringParameter.hpp"
 #include "complex/Pipeline/Pipeline.hpp"
 #include "complex/Pipeline/PipelineFilter.hpp"
 #include "complex/Utilities/Parsing/DREAM3D/Dream3dIO.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5FileWriter.hpp"
 
+#include <fmt/core.h>
+
 namespace
 {
 constexpr complex::int32 k_NoExportPathError = -1;
 constexpr complex::int32 k_NoParentPathError = -2;
 constexpr complex::int32 k_FailedFileWriterError = -14;
 constexpr complex::int32 k_FailedFindPipelineError = -15;
+constexpr complex::int32 k_InvalidCompressionLevelError = -16;
+constexpr complex::int32 k_InvalidChunkSizeError = -17;
 } // namespace
 
 namespace complex
@@ -45,6 +50,13 @@ Parameters ExportDREAM3DFilter::parameters() const
   params.insert(std::make_unique<FileSystemPathParameter>(k_ExportFilePath, "Export File Path", "The file path the DataStructure should be written to as an HDF5 file.", "",
                                                           FileSystemPathParameter::ExtensionsType{".dream3d"}, FileSystemPathParameter::PathType::OutputFile));
   params.insert(std::make_unique<BoolParameter>(k_WriteXdmf, "Write Xdmf File", "", true));
+  params.insertSeparator(Parameters::Separator{"Compression"});
+  params.insert(std::make_unique<Int32Parameter>(k_CompressionLevel, "Compression Level", "Deflate (gzip) level from 1 to 9 used for the arrays. 0 writes the arrays uncompressed.", 0));
+  params.insert(std::make_unique<BoolParameter>(k_UseShuffle, "Use Shuffle Filter", "Shuffles the bytes of the values before they are compressed, which usually improves the compression ratio.",
+                                                false));
+  params.insert(std::make_unique<BoolParameter>(k_UseScaleOffset, "Use Scale-Offset Filter",
+                                                "Losslessly stores integer arrays with the fewest bits that hold their value range. Floating point arrays are not affected.", false));
+  params.insert(std::make_unique<UInt64Parameter>(k_ChunkSize, "Chunk Size (KiB)", "Target size of the chunks the arrays are split into when any filter is enabled.", 1024));
   return params;
 }
 
@@ -60,6 +72,15 @@ IFilter::PreflightResult ExportDREAM3DFilter::preflightImpl(const DataStructure&
   {
     return {nonstd::make_unexpected(std::vector<Error>{Error{k_NoExportPathError, "Export file path not provided."}})};
   }
+  auto compressionLevel = args.value<int32>(k_CompressionLevel);
+  if(compressionLevel < 0 || compressionLevel > 9)
+  {
+    return {nonstd::make_unexpected(std::vector<Error>{Error{k_InvalidCompressionLevelError, fmt::format("Compression level must be between 0 and 9 but is {}.", compressionLevel)}})};
+  }
+  if(args.value<uint64>(k_ChunkSize) == 0)
+  {
+    return {nonstd::make_unexpected(std::vector<Error>{Error{k_InvalidChunkSizeError, "Chunk size must be greater than 0 KiB."}})};
+  }
   return {};
 }
 
@@ -69,6 +90,12 @@ Result<> ExportDREAM3DFilter::executeImpl(DataStructure& dataStructure, const Ar
   auto exportFilePath = args.value<std::filesystem::path>(k_ExportFilePath);
   auto writeXdmf = args.value<bool>(k_WriteXdmf);
 
+  H5::DatasetCreationOptions datasetOptions;
+  datasetOptions.deflateLevel = args.value<int32>(k_CompressionLevel);
+  datasetOptions.shuffle = args.value<bool>(k_UseShuffle);
+  datasetOptions.scaleOffset = args.value<bool>(k_UseScaleOffset);
+  datasetOptions.targetChunkBytes = static_cast<usize>(args.value<uint64>(k_ChunkSize) * 1024);
+
   auto pipelinePtr = pipelineNode->getPrecedingPipeline();
   if(pipelinePtr == nullptr)
   {
@@ -76,7 +103,7 @@ Result<> ExportDREAM3DFilter::executeImpl(DataStructure& dataStructure, const Ar
   }
   Pipeline pipeline = *pipelinePtr;
 
-  auto results = DREAM3D::WriteFile(exportFilePath, dataStructure, pipeline, writeXdmf);
+  auto results = DREAM3D::WriteFile(exportFilePath, dataStructure, pipeline, writeXdmf, datasetOptions);
   return results;
 }
 } // namespace complex
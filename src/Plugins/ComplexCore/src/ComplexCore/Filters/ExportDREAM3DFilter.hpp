@@ -29,6 +29,10 @@ public:
   // Parameter Keys
   static inline constexpr StringLiteral k_ExportFilePath = "Export_File_Path";
   static inline constexpr StringLiteral k_WriteXdmf = "Write_Xdmf_File";
+  static inline constexpr StringLiteral k_CompressionLevel = "Compression_Level";
+  static inline constexpr StringLiteral k_UseShuffle = "Use_Shuffle";
+  static inline constexpr StringLiteral k_UseScaleOffset = "Use_Scale_Offset";
+  static inline constexpr StringLiteral k_ChunkSize = "Chunk_Size";
 
   /**
    * @brief Returns the name of the filter class.
@@ -5,6 +5,7 @@
 #include "complex/DataStructure/AttributeMatrix.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
+#include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/Geometry/ImageGeom.hpp"
 #include "complex/DataStructure/NeighborList.hpp"
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
@@ -15,9 +16,235 @@
 #include "complex/Parameters/DataObjectNameParameter.hpp"
 #include "complex/Parameters/GeometrySelectionParameter.hpp"
 #include "complex/Utilities/DataGroupUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <algorithm>
+#include <thread>
 
 namespace complex
 {
+namespace
+{
+constexpr usize k_ChunksPerThread = 4;
+constexpr usize k_MinChunkSize = 4096;
+
+/**
+ * @brief Number of faces a feature shares with a neighboring feature. The key
+ * holds the feature in the upper and the neighbor in the lower 32 bits.
+ */
+struct FaceCount
+{
+  uint64 key = 0;
+  usize count = 0;
+};
+
+/**
+ * @brief Sorts the face counts by feature and then by neighbor and sums the counts
+ * of identical faces.
+ * @param faceCounts
+ * @return std::vector<FaceCount>
+ */
+std::vector<FaceCount> ReduceFaceCounts(std::vector<FaceCount> faceCounts)
+{
+  std::sort(faceCounts.begin(), faceCounts.end(), [](const FaceCount& lhs, const FaceCount& rhs) { return lhs.key < rhs.key; });
+
+  usize numMerged = 0;
+  for(usize i = 0; i < faceCounts.size(); i++)
+  {
+    if(numMerged > 0 && faceCounts[numMerged - 1].key == faceCounts[i].key)
+    {
+      faceCounts[numMerged - 1].count += faceCounts[i].count;
+    }
+    else
+    {
+      faceCounts[numMerged++] = faceCounts[i];
+    }
+  }
+  faceCounts.resize(numMerged);
+  return faceCounts;
+}
+
+/**
+ * @brief Collects the faces between cells of different features for chunks of cells.
+ * Every face is seen once from each side. Runs of identical faces in the same direction
+ * are counted as they are found, and the runs of a chunk are then sorted and reduced to
+ * one FaceCount per feature and neighbor.
+ */
+class FindFaceCountsImpl
+{
+public:
+  FindFaceCountsImpl(const AbstractDataStore<int32>& featureIds, AbstractDataStore<int8>* boundaryCells, const SizeVec3& dims, usize chunkSize,
+                     std::vector<std::vector<FaceCount>>& chunkFaceCounts, const std::atomic_bool& shouldCancel)
+  : m_FeatureIds(featureIds)
+  , m_BoundaryCells(boundaryCells)
+  , m_Dims(dims)
+  , m_ChunkSize(chunkSize)
+  , m_ChunkFaceCounts(chunkFaceCounts)
+  , m_ShouldCancel(shouldCancel)
+  {
+    if(const auto* inMemoryStore = dynamic_cast<const DataStore<int32>*>(&featureIds); inMemoryStore != nullptr)
+    {
+      m_FeatureIdsData = inMemoryStore->data();
+    }
+  }
+
+  void operator()(const Range& range) const
+  {
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      if(m_ShouldCancel)
+      {
+        return;
+      }
+      // Reading contiguous stores directly avoids a virtual call per face
+      if(m_FeatureIdsData != nullptr)
+      {
+        findFaceCounts(chunk, [this](usize index) { return m_FeatureIdsData[index]; });
+      }
+      else
+      {
+        findFaceCounts(chunk, [this](usize index) { return m_FeatureIds.getValue(index); });
+      }
+    }
+  }
+
+private:
+  template <typename GetFeatureFunc>
+  void findFaceCounts(usize chunk, GetFeatureFunc&& getFeature) const
+  {
+    const usize xDim = m_Dims[0];
+    const usize yDim = m_Dims[1];
+    const usize zDim = m_Dims[2];
+    const usize xyDim = xDim * yDim;
+    const usize begin = chunk * m_ChunkSize;
+    const usize end = std::min(begin + m_ChunkSize, m_FeatureIds.getNumberOfTuples());
+
+    std::vector<FaceCount> faceCounts;
+    std::array<FaceCount, 6> runs = {};
+    for(usize index = begin; index < end; index++)
+    {
+      const int32 feature = getFeature(index);
+      int8 numFaces = 0;
+      if(feature > 0)
+      {
+        const usize column = index % xDim;
+        const usize row = (index / xDim) % yDim;
+        const usize plane = index / xyDim;
+        const std::array<bool, 6> valid = {plane > 0, row > 0, column > 0, column + 1 < xDim, row + 1 < yDim, plane + 1 < zDim};
+        const std::array<usize, 6> neighbors = {index - xyDim, index - xDim, index - 1, index + 1, index + xDim, index + xyDim};
+        for(usize k = 0; k < 6; k++)
+        {
+          if(!valid[k])
+          {
+            continue;
+          }
+          const int32 neighborFeature = getFeature(neighbors[k]);
+          if(neighborFeature > 0 && neighborFeature != feature)
+          {
+            numFaces++;
+            const uint64 key = static_cast<uint64>(feature) << 32 | static_cast<uint32>(neighborFeature);
+            if(runs[k].key != key)
+            {
+              if(runs[k].count > 0)
+              {
+                faceCounts.push_back(runs[k]);
+              }
+              runs[k] = {key, 0};
+            }
+            runs[k].count++;
+          }
+        }
+      }
+      if(m_BoundaryCells != nullptr)
+      {
+        m_BoundaryCells->setValue(index, numFaces);
+      }
+    }
+
+    for(const FaceCount& run : runs)
+    {
+      if(run.count > 0)
+      {
+        faceCounts.push_back(run);
+      }
+    }
+    m_ChunkFaceCounts[chunk] = ReduceFaceCounts(std::move(faceCounts));
+  }
+
+  const AbstractDataStore<int32>& m_FeatureIds;
+  const int32* m_FeatureIdsData = nullptr;
+  AbstractDataStore<int8>* m_BoundaryCells = nullptr;
+  const SizeVec3 m_Dims;
+  const usize m_ChunkSize = 0;
+  std::vector<std::vector<FaceCount>>& m_ChunkFaceCounts;
+  const std::atomic_bool& m_ShouldCancel;
+};
+
+/**
+ * @brief Combines the face counts of all chunks into one FaceCount per feature and
+ * neighbor, ordered by feature and then by neighbor.
+ * @param chunkFaceCounts
+ * @return std::vector<FaceCount>
+ */
+std::vector<FaceCount> MergeFaceCounts(std::vector<std::vector<FaceCount>>& chunkFaceCounts)
+{
+  std::vector<FaceCount> faceCounts;
+  for(auto& chunk : chunkFaceCounts)
+  {
+    faceCounts.insert(faceCounts.end(), chunk.cbegin(), chunk.cend());
+    chunk = {};
+  }
+  return ReduceFaceCounts(std::move(faceCounts));
+}
+
+/**
+ * @brief Flags the features that touch the outside of the geometry. Only the cells on
+ * the outside are visited. Single plane geometries only count their edges.
+ * @param featureIds
+ * @param dims
+ * @param surfaceFeatures
+ */
+void FindSurfaceFeatures(const AbstractDataStore<int32>& featureIds, const SizeVec3& dims, AbstractDataStore<bool>& surfaceFeatures)
+{
+  const usize numFeatures = surfaceFeatures.getNumberOfTuples();
+  for(usize i = 1; i < numFeatures; i++)
+  {
+    surfaceFeatures.setValue(i, false);
+  }
+
+  const usize xDim = dims[0];
+  const usize yDim = dims[1];
+  const usize zDim = dims[2];
+  const auto flagCell = [&](usize index) {
+    const int32 feature = featureIds.getValue(index);
+    if(feature > 0 && static_cast<usize>(feature) < numFeatures)
+    {
+      surfaceFeatures.setValue(feature, true);
+    }
+  };
+  for(usize plane = 0; plane < zDim; plane++)
+  {
+    const bool outerPlane = zDim != 1 && (plane == 0 || plane == zDim - 1);
+    for(usize row = 0; row < yDim; row++)
+    {
+      const usize rowStart = (plane * yDim + row) * xDim;
+      if(outerPlane || row == 0 || row == yDim - 1)
+      {
+        for(usize column = 0; column < xDim; column++)
+        {
+          flagCell(rowStart + column);
+        }
+      }
+      else
+      {
+        flagCell(rowStart);
+        flagCell(rowStart + xDim - 1);
+      }
+    }
+  }
+}
+} // namespace
+
 std::string FindNeighbors::name() const
 {
   return FilterTraits<FindNeighbors>::name;
@@ -172,222 +399,71 @@ Result<> FindNeighbors::executeImpl(DataStructure& data, const Arguments& args,
   usize totalFeatures = numNeighborsArray.getNumberOfTuples();
 
   /* Ensure that we will be able to work with the user selected featureId Array */
-  const auto [minFeatureId, maxFeatureId] = std::minmax_element(featureIdsArray.begin(), featureIdsArray.end());
-  if(static_cast<usize>(*maxFeatureId) >= totalFeatures)
+  int32 maxFeatureId = 0;
+  featureIds.visitConstChunks(0, totalPoints, [&maxFeatureId](usize index, nonstd::span<const int32> values) { maxFeatureId = std::max(maxFeatureId, *std::max_element(values.begin(), values.end())); });
+  if(static_cast<usize>(maxFeatureId) >= totalFeatures)
   {
     std::stringstream out;
-    out << "Data Array " << featureIdsArray.getName() << " has a maximum value of " << *maxFeatureId << " which is greater than the "
+    out << "Data Array " << featureIdsArray.getName() << " has a maximum value of " << maxFeatureId << " which is greater than the "
         << " number of features from array " << numNeighborsArray.getName() << " which has " << totalFeatures << ". Did you select the "
         << " incorrect array for the 'FeatureIds' array?";
     return MakeErrorResult(-24500, out.str());
   }
 
   auto& imageGeom = data.getDataRefAs<ImageGeom>(imageGeomPath);
-  SizeVec3 udims = imageGeom.getDimensions();
-  const auto imageGeomNumX = imageGeom.getNumXPoints();
-  const auto imageGeomNumY = imageGeom.getNumYPoints();
-  const auto imageGeomNumZ = imageGeom.getNumZPoints();
-
-  std::array<int64, 3> dims = {
-      static_cast<int64>(udims[0]),
-      static_cast<int64>(udims[1]),
-      static_cast<int64>(udims[2]),
-  };
-
-  std::array<int64, 6> neighPoints = {-dims[0] * dims[1], -dims[0], -1, 1, dims[0], dims[0] * dims[1]};
-
-  int64 column = 0;
-  int64 row = 0;
-  int64 plane = 0;
-  int32 feature = 0;
-  int32 nnum = 0;
-  uint8 onsurf = 0;
-  bool good = false;
-  int64 neighbor = 0;
-
-  std::vector<std::vector<int32>> neighborlist(totalFeatures);
-  std::vector<std::vector<float>> neighborsurfacearealist(totalFeatures);
-
-  int32 nListSize = 100;
+  const SizeVec3 dims = imageGeom.getDimensions();
+  const FloatVec3 spacing = imageGeom.getSpacing();
 
-  float progInt = 0.0F;
-  auto start = std::chrono::steady_clock::now();
-  // Initialize the neighbor lists
-  for(usize i = 1; i < totalFeatures; i++)
+  if(storeSurfaceFeatures)
   {
-    auto now = std::chrono::steady_clock::now();
-    // Only send updates every 1 second
-    if(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
-    {
-      progInt = static_cast<float>(i) / static_cast<float>(totalFeatures) * 100.0f;
-      std::string message = fmt::format("Initializing Neighbor Lists || {:2.0f}% Complete", progInt);
-      messageHandler(complex::IFilter::ProgressMessage{complex::IFilter::Message::Type::Info, message, static_cast<int32_t>(progInt)});
-      start = std::chrono::steady_clock::now();
-    }
-
-    if(shouldCancel)
-    {
-      return {};
-    }
-
-    numNeighbors[i] = 0;
-    neighborlist[i].resize(nListSize);
-    neighborsurfacearealist[i].assign(nListSize, -1.0f);
-    if(storeSurfaceFeatures)
-    {
-      auto& surfaceFeatures = surfaceFeaturesArray->getDataStoreRef();
-      surfaceFeatures[i] = 0;
-    }
+    FindSurfaceFeatures(featureIds, dims, surfaceFeaturesArray->getDataStoreRef());
   }
 
-  progInt = 0.0F;
-  start = std::chrono::steady_clock::now();
-  // Loop over all points to generate the neighbor lists
-  for(usize j = 0; j < totalPoints; j++)
+  // Each chunk of cells collects its feature faces independently
+  const usize numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  const usize chunkSize = std::max((totalPoints + numThreads * k_ChunksPerThread - 1) / (numThreads * k_ChunksPerThread), k_MinChunkSize);
+  const usize numChunks = (totalPoints + chunkSize - 1) / chunkSize;
+  std::vector<std::vector<FaceCount>> chunkFaceCounts(numChunks);
+  AbstractDataStore<int8>* boundaryCells = storeBoundaryCells ? &boundaryCellsArray->getDataStoreRef() : nullptr;
+
+  messageHandler(IFilter::Message{IFilter::Message::Type::Info, "Determining Neighbor Lists"});
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numChunks);
+  dataAlg.setParallelizationEnabled(featureIds.getStoreType() == IDataStore::StoreType::InMemory &&
+                                    (boundaryCells == nullptr || boundaryCells->getStoreType() == IDataStore::StoreType::InMemory));
+  dataAlg.execute(FindFaceCountsImpl(featureIds, boundaryCells, dims, chunkSize, chunkFaceCounts, shouldCancel));
+  if(shouldCancel)
   {
-    auto now = std::chrono::steady_clock::now();
-    // Only send updates every 1 second
-    if(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
-    {
-      progInt = static_cast<float>(j) / static_cast<float>(totalPoints) * 100.0f;
-      std::string message = fmt::format("Determining Neighbor Lists || {:2.0f}% Complete", progInt);
-      messageHandler(complex::IFilter::ProgressMessage{complex::IFilter::Message::Type::Info, message, static_cast<int32_t>(progInt)});
-      start = std::chrono::steady_clock::now();
-    }
-
-    if(shouldCancel)
-    {
-      return {};
-    }
-
-    onsurf = 0;
-    feature = featureIds[j];
-    if(feature > 0 && feature < neighborlist.size())
-    {
-      column = static_cast<int64>(j % imageGeomNumX);
-      row = static_cast<int64>((j / imageGeomNumX) % imageGeomNumY);
-      plane = static_cast<int64>(j / (imageGeomNumX * imageGeomNumY));
-      if(storeSurfaceFeatures)
-      {
-        auto& surfaceFeatures = surfaceFeaturesArray->getDataStoreRef();
-
-        if((column == 0 || column == static_cast<int64>((imageGeomNumX - 1)) || row == 0 || row == static_cast<int64>((imageGeomNumY)-1) || plane == 0 ||
-            plane == static_cast<int64>((imageGeomNumZ - 1))) &&
-           imageGeomNumZ != 1)
-        {
-          surfaceFeatures[feature] = 1;
-        }
-        if((column == 0 || column == static_cast<int64>((imageGeomNumX - 1)) || row == 0 || row == static_cast<int64>((imageGeomNumY - 1))) && imageGeomNumZ == 1)
-        {
-          surfaceFeatures[feature] = 1;
-        }
-      }
-      for(size_t k = 0; k < 6; k++)
-      {
-        good = true;
-        neighbor = static_cast<int64>(j + neighPoints[k]);
-        if(k == 0 && plane == 0)
-        {
-          good = false;
-        }
-        if(k == 5 && plane == (imageGeomNumZ - 1))
-        {
-          good = false;
-        }
-        if(k == 1 && row == 0)
-        {
-          good = false;
-        }
-        if(k == 4 && row == (imageGeomNumY - 1))
-        {
-          good = false;
-        }
-        if(k == 2 && column == 0)
-        {
-          good = false;
-        }
-        if(k == 3 && column == (imageGeomNumX - 1))
-        {
-          good = false;
-        }
-        if(good && featureIds[neighbor] != feature && featureIds[neighbor] > 0)
-        {
-          onsurf++;
-          nnum = numNeighbors[feature];
-          neighborlist[feature].push_back(featureIds[neighbor]);
-          nnum++;
-          numNeighbors[feature] = nnum;
-        }
-      }
-    }
-    if(storeBoundaryCells)
-    {
-      auto& boundaryCells = boundaryCellsArray->getDataStoreRef();
-      boundaryCells[j] = static_cast<int32>(onsurf);
-    }
+    return {};
   }
 
-  FloatVec3 spacing = imageGeom.getSpacing();
+  messageHandler(IFilter::Message{IFilter::Message::Type::Info, "Calculating Surface Areas"});
+  std::vector<FaceCount> faceCounts = MergeFaceCounts(chunkFaceCounts);
 
-  progInt = 0;
-  start = std::chrono::steady_clock::now();
-  // We do this to create new set of NeighborList objects
+  // The merged counts are ordered by feature and then by neighbor, which is the order of each list
+  std::vector<usize> offsets(totalFeatures + 1, 0);
+  std::vector<int32> neighborValues(faceCounts.size());
+  std::vector<float32> surfaceAreaValues(faceCounts.size());
+  for(usize i = 0; i < faceCounts.size(); i++)
+  {
+    const auto feature = static_cast<usize>(faceCounts[i].key >> 32);
+    offsets[feature + 1]++;
+    neighborValues[i] = static_cast<int32>(faceCounts[i].key & 0xFFFFFFFF);
+    surfaceAreaValues[i] = static_cast<float32>(faceCounts[i].count) * spacing[0] * spacing[1];
+  }
+  for(usize i = 1; i <= totalFeatures; i++)
+  {
+    offsets[i] += offsets[i - 1];
+  }
   for(usize i = 1; i < totalFeatures; i++)
   {
-    auto now = std::chrono::steady_clock::now();
-    // Only send updates every 1 second
-    if(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
-    {
-      progInt = static_cast<float>(i) / static_cast<float>(totalFeatures) * 100.0f;
-      std::string message = fmt::format("Calculating Surface Areas || {:2.0f}% Complete", progInt);
-      messageHandler(complex::IFilter::ProgressMessage{complex::IFilter::Message::Type::Info, message, static_cast<int32>(progInt)});
-      start = std::chrono::steady_clock::now();
-    }
-    if(shouldCancel)
-    {
-      return {};
-    }
-
-    std::map<int32, int32> neighToCount;
-    auto numneighs = static_cast<int32>(neighborlist[i].size());
-
-    // this increments the voxel counts for each feature
-    for(int32 j = 0; j < numneighs; j++)
-    {
-      neighToCount[neighborlist[i][j]]++;
-    }
-
-    std::map<int32, int32>::iterator neighborIter = neighToCount.find(0);
-    neighToCount.erase(neighborIter);
-    neighborIter = neighToCount.find(-1);
-    if(neighborIter != neighToCount.end())
-    {
-      neighToCount.erase(neighborIter);
-    }
-    // Resize the features neighbor list to zero
-    neighborlist[i].resize(0);
-    neighborsurfacearealist[i].resize(0);
-
-    for(const auto [neigh, number] : neighToCount)
-    {
-      float area = static_cast<float>(number) * spacing[0] * spacing[1];
-
-      // Push the neighbor feature id back onto the list, so we stay synced up
-      neighborlist[i].push_back(neigh);
-      neighborsurfacearealist[i].push_back(area);
-    }
-    numNeighbors[i] = static_cast<int32>(neighborlist[i].size());
-
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<int32>::SharedVectorType sharedNeiLst(new std::vector<int32>);
-    sharedNeiLst->assign(neighborlist[i].begin(), neighborlist[i].end());
-    neighborList.setList(static_cast<int32>(i), sharedNeiLst);
-
-    NeighborList<float32>::SharedVectorType sharedSAL(new std::vector<float32>);
-    sharedSAL->assign(neighborsurfacearealist[i].begin(), neighborsurfacearealist[i].end());
-    sharedSurfaceAreaList.setList(static_cast<int32>(i), sharedSAL);
+    numNeighbors[i] = static_cast<int32>(offsets[i + 1] - offsets[i]);
   }
 
+  // Both lists keep the buffers as they are
+  neighborList.setLists(offsets, std::move(neighborValues));
+  sharedSurfaceAreaList.setLists(std::move(offsets), std::move(surfaceAreaValues));
+
   return {};
 }
 } // namespace complex
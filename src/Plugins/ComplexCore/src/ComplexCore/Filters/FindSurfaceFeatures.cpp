@@ -10,12 +10,18 @@
 #include "complex/Parameters/ArraySelectionParameter.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Parameters/GeometrySelectionParameter.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <mutex>
 
 using namespace complex;
 
 namespace
 {
-bool isPointASurfaceFeature(const Point2D<usize>& point, usize xPoints, usize yPoints, bool markFeature0Neighbors, const Int32Array& featureIds)
+template <class FeatureIdsType>
+bool isPointASurfaceFeature(const Point2D<usize>& point, usize xPoints, usize yPoints, bool markFeature0Neighbors, const FeatureIdsType& featureIds)
 {
   usize yStride = point.getY() * xPoints;
 
@@ -51,7 +57,8 @@ bool isPointASurfaceFeature(const Point2D<usize>& point, usize xPoints, usize yP
   return false;
 }
 
-bool isPointASurfaceFeature(const Point3D<usize>& point, usize xPoints, usize yPoints, usize zPoints, bool markFeature0Neighbors, const Int32Array& featureIds)
+template <class FeatureIdsType>
+bool isPointASurfaceFeature(const Point3D<usize>& point, usize xPoints, usize yPoints, usize zPoints, bool markFeature0Neighbors, const FeatureIdsType& featureIds)
 {
   usize yStride = point.getY() * xPoints;
   usize zStride = point.getZ() * xPoints * yPoints;
@@ -100,87 +107,120 @@ bool isPointASurfaceFeature(const Point3D<usize>& point, usize xPoints, usize yP
   return false;
 }
 
-void findSurfaceFeatures3D(DataStructure& ds, const DataPath& featureGeometryPathValue, const DataPath& featureIdsArrayPathValue, const DataPath& surfaceFeaturesArrayPathValue,
-                           bool markFeature0Neighbors, const std::atomic_bool& shouldCancel)
+/**
+ * @brief Checks a range of cells for surface features. Each range collects the features
+ * it finds locally and merges them into the shared flags once, so the cells are scanned
+ * without any synchronization.
+ */
+template <class FeatureIdsType>
+class FindSurfaceFeaturesImpl
 {
-  const ImageGeom& featureGeometry = ds.getDataRefAs<ImageGeom>(featureGeometryPathValue);
-  const Int32Array& featureIds = ds.getDataRefAs<Int32Array>(featureIdsArrayPathValue);
-  BoolArray& surfaceFeatures = ds.getDataRefAs<BoolArray>(surfaceFeaturesArrayPathValue);
-
-  usize xPoints = featureGeometry.getNumXPoints();
-  usize yPoints = featureGeometry.getNumYPoints();
-  usize zPoints = featureGeometry.getNumZPoints();
+public:
+  FindSurfaceFeaturesImpl(const FeatureIdsType& featureIds, usize xPoints, usize yPoints, usize zPoints, bool is3D, bool markFeature0Neighbors, std::vector<uint8>& surfaceFeatures,
+                          std::mutex& mutex, const std::atomic_bool& shouldCancel)
+  : m_FeatureIds(featureIds)
+  , m_XPoints(xPoints)
+  , m_YPoints(yPoints)
+  , m_ZPoints(zPoints)
+  , m_Is3D(is3D)
+  , m_MarkFeature0Neighbors(markFeature0Neighbors)
+  , m_SurfaceFeatures(surfaceFeatures)
+  , m_Mutex(mutex)
+  , m_ShouldCancel(shouldCancel)
+  {
+  }
 
-  for(usize z = 0; z < zPoints; z++)
+  void operator()(const Range& range) const
   {
-    usize zStride = z * xPoints * yPoints;
-    for(usize y = 0; y < yPoints; y++)
+    std::vector<int32> foundFeatures;
+    const usize xyPoints = m_XPoints * m_YPoints;
+    for(usize index = range.min(); index < range.max(); index++)
     {
-      usize yStride = y * xPoints;
-      for(usize x = 0; x < xPoints; x++)
+      if(m_ShouldCancel)
+      {
+        return;
+      }
+
+      const int32 gnum = m_FeatureIds[index];
+      if(gnum == 0 || (!foundFeatures.empty() && foundFeatures.back() == gnum))
+      {
+        continue;
+      }
+      const usize x = index % m_XPoints;
+      const usize y = (index / m_XPoints) % m_YPoints;
+      const bool isSurfaceFeature = m_Is3D ? isPointASurfaceFeature(Point3D{x, y, index / xyPoints}, m_XPoints, m_YPoints, m_ZPoints, m_MarkFeature0Neighbors, m_FeatureIds)
+                                           : isPointASurfaceFeature(Point2D{x, y}, m_XPoints, m_YPoints, m_MarkFeature0Neighbors, m_FeatureIds);
+      if(isSurfaceFeature)
       {
-        if(shouldCancel)
-        {
-          return;
-        }
-
-        int32 gnum = featureIds[zStride + yStride + x];
-        if(gnum != 0 && !surfaceFeatures[gnum])
-        {
-          if(isPointASurfaceFeature(Point3D{x, y, z}, xPoints, yPoints, zPoints, markFeature0Neighbors, featureIds))
-          {
-            surfaceFeatures[gnum] = true;
-          }
-        }
+        foundFeatures.push_back(gnum);
       }
     }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for(int32 gnum : foundFeatures)
+    {
+      m_SurfaceFeatures[gnum] = 1;
+    }
   }
-}
 
-void findSurfaceFeatures2D(DataStructure& ds, const DataPath& featureGeometryPathValue, const DataPath& featureIdsArrayPathValue, const DataPath& surfaceFeaturesArrayPathValue,
-                           bool markFeature0Neighbors, const std::atomic_bool& shouldCancel)
+private:
+  const FeatureIdsType& m_FeatureIds;
+  usize m_XPoints = 0;
+  usize m_YPoints = 0;
+  usize m_ZPoints = 0;
+  bool m_Is3D = true;
+  bool m_MarkFeature0Neighbors = true;
+  std::vector<uint8>& m_SurfaceFeatures;
+  std::mutex& m_Mutex;
+  const std::atomic_bool& m_ShouldCancel;
+};
+
+void findSurfaceFeatures(DataStructure& ds, const DataPath& featureGeometryPathValue, const DataPath& featureIdsArrayPathValue, const DataPath& surfaceFeaturesArrayPathValue,
+                         bool markFeature0Neighbors, const std::atomic_bool& shouldCancel)
 {
   const ImageGeom& featureGeometry = ds.getDataRefAs<ImageGeom>(featureGeometryPathValue);
-  const Int32Array& featureIds = ds.getDataRefAs<Int32Array>(featureIdsArrayPathValue);
-  BoolArray& surfaceFeatures = ds.getDataRefAs<BoolArray>(surfaceFeaturesArrayPathValue);
-
-  usize xPoints = 0;
-  usize yPoints = 0;
+  const AbstractDataStore<int32>& featureIds = ds.getDataRefAs<Int32Array>(featureIdsArrayPathValue).getDataStoreRef();
+  AbstractDataStore<bool>& surfaceFeaturesStore = ds.getDataRefAs<BoolArray>(surfaceFeaturesArrayPathValue).getDataStoreRef();
 
-  if(featureGeometry.getNumXPoints() == 1)
+  usize xPoints = featureGeometry.getNumXPoints();
+  usize yPoints = featureGeometry.getNumYPoints();
+  usize zPoints = featureGeometry.getNumZPoints();
+  const bool is3D = featureGeometry.getDimensionality() == 3;
+  if(!is3D)
   {
-    xPoints = featureGeometry.getNumYPoints();
-    yPoints = featureGeometry.getNumZPoints();
+    // The two dimensions that are not 1 span the plane
+    if(xPoints == 1)
+    {
+      xPoints = yPoints;
+      yPoints = zPoints;
+    }
+    else if(yPoints == 1)
+    {
+      yPoints = zPoints;
+    }
+    zPoints = 1;
   }
-  if(featureGeometry.getNumYPoints() == 1)
+
+  std::vector<uint8> surfaceFeatures(surfaceFeaturesStore.getNumberOfTuples(), 0);
+  std::mutex mutex;
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, xPoints * yPoints * zPoints);
+  if(const auto* inMemoryStore = dynamic_cast<const DataStore<int32>*>(&featureIds); inMemoryStore != nullptr)
   {
-    xPoints = featureGeometry.getNumXPoints();
-    yPoints = featureGeometry.getNumZPoints();
+    const nonstd::span<const int32> featureIdsSpan(inMemoryStore->data(), inMemoryStore->getSize());
+    dataAlg.execute(FindSurfaceFeaturesImpl<nonstd::span<const int32>>(featureIdsSpan, xPoints, yPoints, zPoints, is3D, markFeature0Neighbors, surfaceFeatures, mutex, shouldCancel));
   }
-  if(featureGeometry.getNumZPoints() == 1)
+  else
   {
-    xPoints = featureGeometry.getNumXPoints();
-    yPoints = featureGeometry.getNumYPoints();
+    dataAlg.setParallelizationEnabled(featureIds.getStoreType() == IDataStore::StoreType::InMemory);
+    dataAlg.execute(FindSurfaceFeaturesImpl<AbstractDataStore<int32>>(featureIds, xPoints, yPoints, zPoints, is3D, markFeature0Neighbors, surfaceFeatures, mutex, shouldCancel));
   }
 
-  for(usize y = 0; y < yPoints; y++)
+  for(usize gnum = 0; gnum < surfaceFeatures.size(); gnum++)
   {
-    usize yStride = y * xPoints;
-    for(usize x = 0; x < xPoints; x++)
+    if(surfaceFeatures[gnum] != 0)
     {
-      if(shouldCancel)
-      {
-        return;
-      }
-
-      int32 gnum = featureIds[yStride + x];
-      if(gnum != 0 && surfaceFeatures[gnum] == 0)
-      {
-        if(isPointASurfaceFeature(Point2D{x, y}, xPoints, yPoints, markFeature0Neighbors, featureIds))
-        {
-          surfaceFeatures[gnum] = 1;
-        }
-      }
+      surfaceFeaturesStore.setValue(gnum, true);
     }
   }
 }
@@ -279,7 +319,7 @@ Result<> FindSurfaceFeatures::executeImpl(DataStructure& dataStructure, const Ar
   // Resize the surface features array to the proper size
   const Int32Array& featureIds = dataStructure.getDataRefAs<Int32Array>(pFeatureIdsArrayPathValue);
   BoolArray& surfaceFeatures = dataStructure.getDataRefAs<BoolArray>(pSurfaceFeaturesArrayPathValue);
-  DataStore<bool>& surfaceFeaturesStore = surfaceFeatures.getIDataStoreRefAs<DataStore<bool>>();
+  AbstractDataStore<bool>& surfaceFeaturesStore = surfaceFeatures.getDataStoreRef();
 
   usize featureIdsMaxIdx = std::distance(featureIds.begin(), std::max_element(featureIds.cbegin(), featureIds.cend()));
   usize maxFeature = featureIds[featureIdsMaxIdx];
@@ -288,20 +328,7 @@ Result<> FindSurfaceFeatures::executeImpl(DataStructure& dataStructure, const Ar
   surfaceFeaturesStore.fill(0);
 
   // Find surface features
-  ImageGeom& featureGeometry = dataStructure.getDataRefAs<ImageGeom>(pFeatureGeometryPathValue);
-  usize geometryDimensionality = featureGeometry.getDimensionality();
-  if(geometryDimensionality == 3)
-  {
-    findSurfaceFeatures3D(dataStructure, pFeatureGeometryPathValue, pFeatureIdsArrayPathValue, pSurfaceFeaturesArrayPathValue, pMarkFeature0NeighborsValue, shouldCancel);
-  }
-  else if(geometryDimensionality == 2)
-  {
-    findSurfaceFeatures2D(dataStructure, pFeatureGeometryPathValue, pFeatureIdsArrayPathValue, pSurfaceFeaturesArrayPathValue, pMarkFeature0NeighborsValue, shouldCancel);
-  }
-  else
-  {
-    MakeErrorResult(-1000, fmt::format("Image Geometry at path '{}' must be either 3D or 2D", pFeatureGeometryPathValue.toString()));
-  }
+  findSurfaceFeatures(dataStructure, pFeatureGeometryPathValue, pFeatureIdsArrayPathValue, pSurfaceFeaturesArrayPathValue, pMarkFeature0NeighborsValue, shouldCancel);
 
   return {};
 }
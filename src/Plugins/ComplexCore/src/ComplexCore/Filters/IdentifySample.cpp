@@ -1,10 +1,13 @@
 #include "IdentifySample.hpp"
 
 #include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/Geometry/ImageGeom.hpp"
 #include "complex/Parameters/ArraySelectionParameter.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Parameters/GeometrySelectionParameter.hpp"
+#include "complex/Utilities/GridLabeling.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
 namespace complex
 {
@@ -12,216 +15,113 @@ namespace
 {
 constexpr int64 k_MISSING_GEOM_ERR = -650;
 
-template <typename T>
-void _execute(DataStructure& data, const DataPath& imageGeomPath, const DataPath& goodVoxelsArrayPath, bool fillHoles)
+/**
+ * @brief Sets every cell whose label matches the predicate to the given value. Labels
+ * and values are read and written directly for in memory DataStores.
+ */
+template <typename T, class PredicateType>
+class SetLabeledValuesImpl
 {
-  using ArrayType = DataArray<T>;
-
-  auto* imageGeom = data.getDataAs<ImageGeom>(imageGeomPath);
+public:
+  SetLabeledValuesImpl(T* values, const int32* labels, T value, const PredicateType& predicate)
+  : m_Values(values)
+  , m_Labels(labels)
+  , m_Value(value)
+  , m_Predicate(predicate)
+  {
+  }
 
-  std::vector<usize> cDims = {1};
-  auto* goodVoxelsPtr = data.getDataAs<ArrayType>(goodVoxelsArrayPath);
-  auto& goodVoxels = goodVoxelsPtr->getDataStoreRef();
-
-  int64 totalPoints = static_cast<int64>(goodVoxelsPtr->getNumberOfTuples());
-
-  SizeVec3 udims = imageGeom->getDimensions();
-
-  int64 dims[3] = {
-      static_cast<int64>(udims[0]),
-      static_cast<int64>(udims[1]),
-      static_cast<int64>(udims[2]),
-  };
-
-  int64 neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  int64 xp = dims[0];
-  int64 yp = dims[1];
-  int64 zp = dims[2];
-
-  neighpoints[0] = -(xp * yp);
-  neighpoints[1] = -xp;
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = xp;
-  neighpoints[5] = (xp * yp);
-  std::vector<int64> currentvlist;
-  std::vector<bool> checked(totalPoints, false);
-  std::vector<bool> sample(totalPoints, false);
-  int64 biggestBlock = 0;
-  usize count = 0;
-  int32 good = 0;
-  int64 neighbor = 0;
-  int64 column = 0, row = 0, plane = 0;
-  int64 index = 0;
-
-  // In this loop over the data we are finding the biggest contiguous set of GoodVoxels and calling that the 'sample'  All GoodVoxels that do not touch the 'sample'
-  // are flipped to be called 'bad' voxels or 'not sample'
-  float threshold = 0.0f;
-  for(int64 i = 0; i < totalPoints; i++)
+  void operator()(const Range& range) const
   {
-    float percentIncrement = static_cast<float>(i) / static_cast<float>(totalPoints) * 100.0f;
-    if(percentIncrement > threshold)
+    for(usize i = range.min(); i < range.max(); i++)
     {
-      // std::string ss = fmt::format("{}% Scanned", static_cast<int32>(percentIncrement));
-      // filter->notifyStatusMessage(ss);
-      threshold = threshold + 5.0f;
-      if(threshold < percentIncrement)
+      if(m_Predicate(m_Labels[i]))
       {
-        threshold = percentIncrement;
+        m_Values[i] = m_Value;
       }
     }
+  }
 
-    if(!checked[i] && goodVoxels.getValue(i))
-    {
-      currentvlist.push_back(i);
-      count = 0;
-      while(count < currentvlist.size())
-      {
-        index = currentvlist[count];
-        column = index % xp;
-        row = (index / xp) % yp;
-        plane = index / (xp * yp);
-        for(int32 j = 0; j < 6; j++)
-        {
-          good = 1;
-          neighbor = index + neighpoints[j];
-          if(j == 0 && plane == 0)
-          {
-            good = 0;
-          }
-          if(j == 5 && plane == (zp - 1))
-          {
-            good = 0;
-          }
-          if(j == 1 && row == 0)
-          {
-            good = 0;
-          }
-          if(j == 4 && row == (yp - 1))
-          {
-            good = 0;
-          }
-          if(j == 2 && column == 0)
-          {
-            good = 0;
-          }
-          if(j == 3 && column == (xp - 1))
-          {
-            good = 0;
-          }
-          if(good == 1 && !checked[neighbor] && goodVoxels.getValue(neighbor))
-          {
-            currentvlist.push_back(neighbor);
-            checked[neighbor] = true;
-          }
-        }
-        count++;
-      }
-      if(static_cast<int64>(currentvlist.size()) >= biggestBlock)
-      {
-        biggestBlock = currentvlist.size();
-        sample.assign(totalPoints, false);
-        for(int64 j = 0; j < biggestBlock; j++)
-        {
-          sample[currentvlist[j]] = true;
-        }
-      }
-      currentvlist.clear();
-    }
+private:
+  T* m_Values = nullptr;
+  const int32* m_Labels = nullptr;
+  T m_Value;
+  const PredicateType& m_Predicate;
+};
+
+template <typename T, class PredicateType>
+void setLabeledValues(AbstractDataStore<T>& goodVoxels, const DataStore<int32>& labels, T value, const PredicateType& predicate)
+{
+  if(auto* inMemoryStore = dynamic_cast<DataStore<T>*>(&goodVoxels); inMemoryStore != nullptr)
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, labels.getSize());
+    dataAlg.execute(SetLabeledValuesImpl<T, PredicateType>(inMemoryStore->data(), labels.data(), value, predicate));
+    return;
   }
-  for(int64 i = 0; i < totalPoints; i++)
+
+  // Out of core and bit packed stores are not safe to write from several threads
+  for(usize i = 0; i < labels.getSize(); i++)
   {
-    if(!sample[i] && goodVoxels.getValue(i))
+    if(predicate(labels[i]))
     {
-      goodVoxels.setValue(i, false);
+      goodVoxels.setValue(i, value);
     }
   }
-  sample.clear();
-  checked.assign(totalPoints, false);
+}
 
-  // In this loop we are going to 'close' all of the 'holes' inside of the region already identified as the 'sample' if the user chose to do so.
-  // This is done by flipping all 'bad' voxel features that do not touch the outside of the sample (i.e. they are fully contained inside of the 'sample'.
-  threshold = 0.0F;
-  if(fillHoles)
+template <typename T>
+void _execute(DataStructure& data, const DataPath& imageGeomPath, const DataPath& goodVoxelsArrayPath, bool fillHoles, const std::atomic_bool& shouldCancel)
+{
+  using ArrayType = DataArray<T>;
+
+  const auto* imageGeom = data.getDataAs<ImageGeom>(imageGeomPath);
+  auto& goodVoxels = data.getDataAs<ArrayType>(goodVoxelsArrayPath)->getDataStoreRef();
+
+  const SizeVec3 dims = imageGeom->getDimensions();
+  const usize totalPoints = goodVoxels.getNumberOfTuples();
+  const bool parallel = goodVoxels.getStoreType() == IDataStore::StoreType::InMemory;
+  const auto alwaysConnected = [](usize, usize) { return true; };
+
+  DataStore<int32> labels(totalPoints, std::nullopt);
+
+  // The biggest contiguous set of GoodVoxels is called the 'sample'. Components are labeled in the order a scan
+  // over the voxels finds them, so ties go to the last one found. All GoodVoxels that do not belong to the
+  // 'sample' are flipped to be called 'bad' voxels or 'not sample'
+  const auto isGood = [&goodVoxels](usize index) { return static_cast<bool>(goodVoxels.getValue(index)); };
+  std::vector<usize> sizes = GridLabeling::LabelConnectedComponentsWithSizes(dims, labels, isGood, alwaysConnected, shouldCancel, parallel);
+  if(shouldCancel)
   {
-    bool touchesBoundary = false;
-    for(int64 i = 0; i < totalPoints; i++)
-    {
-      float percentIncrement = static_cast<float>(i) / static_cast<float>(totalPoints) * 100.0f;
-      if(percentIncrement > threshold)
-      {
-        // std::string ss = fmt::format("{}% Filling Holes", static_cast<int32>(percentIncrement));
-        // filter->notifyStatusMessage(ss);
-        threshold = threshold + 5.0f;
-        if(threshold < percentIncrement)
-        {
-          threshold = percentIncrement;
-        }
-      }
+    return;
+  }
 
-      if(!checked[i] && !goodVoxels.getValue(i))
-      {
-        currentvlist.push_back(i);
-        count = 0;
-        touchesBoundary = false;
-        while(count < currentvlist.size())
-        {
-          index = currentvlist[count];
-          column = index % xp;
-          row = (index / xp) % yp;
-          plane = index / (xp * yp);
-          if(column == 0 || column == (xp - 1) || row == 0 || row == (yp - 1) || plane == 0 || plane == (zp - 1))
-          {
-            touchesBoundary = true;
-          }
-          for(int32 j = 0; j < 6; j++)
-          {
-            good = 1;
-            neighbor = index + neighpoints[j];
-            if(j == 0 && plane == 0)
-            {
-              good = 0;
-            }
-            if(j == 5 && plane == (zp - 1))
-            {
-              good = 0;
-            }
-            if(j == 1 && row == 0)
-            {
-              good = 0;
-            }
-            if(j == 4 && row == (yp - 1))
-            {
-              good = 0;
-            }
-            if(j == 2 && column == 0)
-            {
-              good = 0;
-            }
-            if(j == 3 && column == (xp - 1))
-            {
-              good = 0;
-            }
-            if(good == 1 && !checked[neighbor] && !goodVoxels.getValue(neighbor))
-            {
-              currentvlist.push_back(neighbor);
-              checked[neighbor] = true;
-            }
-          }
-          count++;
-        }
-        if(!touchesBoundary)
-        {
-          for(int64_t j : currentvlist)
-          {
-            goodVoxels.setValue(j, true);
-          }
-        }
-        currentvlist.clear();
-      }
+  int32 sampleLabel = 0;
+  usize biggestBlock = 0;
+  for(usize label = 1; label < sizes.size(); label++)
+  {
+    if(sizes[label] >= biggestBlock)
+    {
+      biggestBlock = sizes[label];
+      sampleLabel = static_cast<int32>(label);
     }
   }
-  checked.clear();
+  setLabeledValues<T>(goodVoxels, labels, static_cast<T>(false), [sampleLabel](int32 label) { return label != 0 && label != sampleLabel; });
+
+  // 'Close' all of the 'holes' inside of the region already identified as the 'sample' if the user chose to do so.
+  // This is done by flipping all 'bad' voxel components that do not touch the outside of the geometry
+  if(!fillHoles)
+  {
+    return;
+  }
+  const auto isBad = [&goodVoxels](usize index) { return !static_cast<bool>(goodVoxels.getValue(index)); };
+  sizes = GridLabeling::LabelConnectedComponentsWithSizes(dims, labels, isBad, alwaysConnected, shouldCancel, parallel);
+  if(shouldCancel)
+  {
+    return;
+  }
+
+  const std::vector<bool> touchesBoundary = GridLabeling::FindBoundaryComponents(dims, labels, sizes.size() - 1);
+  setLabeledValues<T>(goodVoxels, labels, static_cast<T>(true), [&touchesBoundary](int32 label) { return label != 0 && !touchesBoundary[label]; });
 }
 
 int16 getArrayType(const IDataArray* inputData)
@@ -326,11 +226,11 @@ Result<> IdentifySample::executeImpl(DataStructure& data, const Arguments& args,
 
   if(arrayType == 1)
   {
-    _execute<bool>(data, imageGeomPath, goodVoxelsArrayPath, fillHoles);
+    _execute<bool>(data, imageGeomPath, goodVoxelsArrayPath, fillHoles, shouldCancel);
   }
   if(arrayType == 2)
   {
-    _execute<uint8>(data, imageGeomPath, goodVoxelsArrayPath, fillHoles);
+    _execute<uint8>(data, imageGeomPath, goodVoxelsArrayPath, fillHoles, shouldCancel);
   }
 
   return {};
@@ -1,7 +1,5 @@
 #include "ImportCSVDataFilter.hpp"
 
-#include <fstream>
-
 #include "complex/Common/TypeTraits.hpp"
 #include "complex/Common/Types.hpp"
 #include "complex/Common/TypesUtility.hpp"
@@ -16,6 +14,9 @@
 #include "complex/Parameters/DataGroupSelectionParameter.hpp"
 #include "complex/Parameters/DynamicTableParameter.hpp"
 #include "complex/Parameters/ImportCSVDataParameter.hpp"
+#include "complex/Utilities/MemoryMappedFile.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+#include "complex/Utilities/Parsing/Text/TextIngestion.hpp"
 #include "complex/Utilities/StringUtilities.hpp"
 
 #include "ComplexCore/utils/CSVDataParser.hpp"
@@ -31,6 +32,9 @@ namespace fs = std::filesystem;
 
 namespace
 {
+constexpr usize k_ChunkSize = 1024 * 1024;
+constexpr usize k_ChunksPerBatch = 64;
+
 enum class IssueCodes
 {
   EMPTY_FILE = -100,
@@ -214,12 +218,10 @@ Result<ParsersVector> createParsers(const DataTypeVector& dataTypes, const DataP
 }
 
 // -----------------------------------------------------------------------------
-Result<> parseLine(std::fstream& inStream, const ParsersVector& dataParsers, const CharVector& delimiters, bool consecutiveDelimiters, usize lineNumber, usize beginIndex)
+Result<> parseLine(std::string_view line, const ParsersVector& dataParsers, const CharVector& delimiters, bool consecutiveDelimiters, usize lineNumber, usize tupleIndex,
+                   std::vector<std::string_view>& tokens)
 {
-  std::string line;
-  std::getline(inStream, line);
-
-  StringVector tokens = StringUtilities::split(line, delimiters, consecutiveDelimiters);
+  TextIngestion::SplitLine(line, delimiters, consecutiveDelimiters, tokens);
 
   if(dataParsers.size() != tokens.size())
   {
@@ -236,7 +238,7 @@ Result<> parseLine(std::fstream& inStream, const ParsersVector& dataParsers, con
 
     usize index = dataParser->columnIndex();
 
-    Result<> result = dataParser->parse(tokens[index], lineNumber - beginIndex);
+    Result<> result = dataParser->parse(tokens[index], tupleIndex);
     if(result.invalid())
     {
       return result;
@@ -246,6 +248,59 @@ Result<> parseLine(std::fstream& inStream, const ParsersVector& dataParsers, con
   return {};
 }
 
+/**
+ * @brief Parses the lines of a chunk that fall within [firstLine, endLine) and keeps the first error.
+ */
+class ParseChunksImpl
+{
+public:
+  ParseChunksImpl(std::string_view text, const std::vector<TextIngestion::LineChunk>& chunks, const ParsersVector& dataParsers, const CharVector& delimiters, bool consecutiveDelimiters,
+                  usize firstLine, usize endLine, std::vector<Result<>>& chunkResults)
+  : m_Text(text)
+  , m_Chunks(chunks)
+  , m_DataParsers(dataParsers)
+  , m_Delimiters(delimiters)
+  , m_ConsecutiveDelimiters(consecutiveDelimiters)
+  , m_FirstLine(firstLine)
+  , m_EndLine(endLine)
+  , m_ChunkResults(chunkResults)
+  {
+  }
+
+  void operator()(const Range& range) const
+  {
+    // One token buffer per task keeps the per line tokenizing free of allocations
+    std::vector<std::string_view> tokens;
+    tokens.reserve(m_DataParsers.size());
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      Result<>& chunkResult = m_ChunkResults[chunk];
+      TextIngestion::ForEachLine(m_Text, m_Chunks[chunk], [&](usize lineNumber, std::string_view line) {
+        if(lineNumber >= m_EndLine)
+        {
+          return false;
+        }
+        if(lineNumber < m_FirstLine)
+        {
+          return true;
+        }
+        chunkResult = parseLine(line, m_DataParsers, m_Delimiters, m_ConsecutiveDelimiters, lineNumber + 1, lineNumber - m_FirstLine, tokens);
+        return chunkResult.valid();
+      });
+    }
+  }
+
+private:
+  std::string_view m_Text;
+  const std::vector<TextIngestion::LineChunk>& m_Chunks;
+  const ParsersVector& m_DataParsers;
+  const CharVector& m_Delimiters;
+  bool m_ConsecutiveDelimiters = false;
+  usize m_FirstLine = 0;
+  usize m_EndLine = 0;
+  std::vector<Result<>>& m_ChunkResults;
+};
+
 // -----------------------------------------------------------------------------
 void notifyProgress(const IFilter::MessageHandler& messageHandler, usize lineNumber, usize numberOfTuples, float32& threshold)
 {
@@ -262,15 +317,6 @@ void notifyProgress(const IFilter::MessageHandler& messageHandler, usize lineNum
   }
 }
 
-// -----------------------------------------------------------------------------
-void skipNumberOfLines(std::fstream& inStream, usize numberOfLines)
-{
-  for(usize i = 1; i < numberOfLines; i++)
-  {
-    std::string line;
-    std::getline(inStream, line);
-  }
-}
 } // namespace
 
 namespace complex
@@ -458,31 +504,63 @@ Result<> ImportCSVDataFilter::executeImpl(DataStructure& dataStructure, const Ar
 
   ParsersVector dataParsers = std::move(parsersResult.value());
 
-  std::fstream in(inputFilePath.c_str(), std::ios_base::in);
-  if(!in.is_open())
+  Result<MemoryMappedFile> fileResult = MemoryMappedFile::Open(inputFilePath);
+  if(fileResult.invalid())
   {
     return MakeErrorResult(to_underlying(IssueCodes::FILE_NOT_OPEN), fmt::format("Could not open file for reading: {}", inputFilePath));
   }
+  const MemoryMappedFile& inputFile = fileResult.value();
+  const std::string_view text = inputFile.text();
+
+  // Line numbers from the wizard are one based and inclusive
+  const usize firstLine = std::max<usize>(beginIndex, 1) - 1;
+  const usize endLine = numLines;
+  const usize numTuples = numLines - beginIndex + 1;
 
-  // Skip to the first data line
-  skipNumberOfLines(in, beginIndex);
+  const std::vector<TextIngestion::LineChunk> chunks = TextIngestion::SplitIntoLineChunks(text, k_ChunkSize);
+
+  bool parallelParsing = true;
+  for(const auto& dataParser : dataParsers)
+  {
+    parallelParsing = parallelParsing && (dataParser == nullptr || dataParser->canParseInParallel());
+  }
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setParallelizationEnabled(parallelParsing);
 
+  // Chunks are parsed in batches so that progress and cancellation are handled between them
   float32 threshold = 0.0f;
-  usize numTuples = numLines - beginIndex + 1;
-  for(usize lineNum = beginIndex; lineNum <= numLines; lineNum++)
+  std::vector<Result<>> chunkResults(chunks.size());
+  for(usize batchBegin = 0; batchBegin < chunks.size() && chunks[batchBegin].FirstLine < endLine; batchBegin += k_ChunksPerBatch)
   {
     if(shouldCancel)
     {
       return {};
     }
 
-    Result<> parsingResult = parseLine(in, dataParsers, delimiters, consecutiveDelimiters, lineNum, beginIndex);
-    if(parsingResult.invalid())
+    const usize batchEnd = std::min(batchBegin + k_ChunksPerBatch, chunks.size());
+    dataAlg.setRange(batchBegin, batchEnd);
+    dataAlg.execute(ParseChunksImpl(text, chunks, dataParsers, delimiters, consecutiveDelimiters, firstLine, endLine, chunkResults));
+    for(usize chunk = batchBegin; chunk < batchEnd; chunk++)
     {
-      return std::move(parsingResult);
+      if(chunkResults[chunk].invalid())
+      {
+        return std::move(chunkResults[chunk]);
+      }
+    }
+
+    const usize linesRead = batchEnd < chunks.size() ? chunks[batchEnd].FirstLine : endLine;
+    if(linesRead > firstLine)
+    {
+      notifyProgress(messageHandler, std::min(linesRead, endLine) - firstLine, numTuples, threshold);
     }
+  }
 
-    notifyProgress(messageHandler, lineNum, numTuples, threshold);
+  // Lines past the end of the file are empty lines without any columns
+  const usize fileLines = TextIngestion::CountLines(text, chunks);
+  if(fileLines < endLine && !dataParsers.empty())
+  {
+    return MakeErrorResult(to_underlying(IssueCodes::INCONSISTENT_COLS), fmt::format("Line {} has an inconsistent number of columns.\nExpecting {} but found {}\nInput line was:\n{}",
+                                                                                     std::to_string(std::max(fileLines, firstLine) + 1), std::to_string(dataParsers.size()), "0", ""));
   }
 
   return {};
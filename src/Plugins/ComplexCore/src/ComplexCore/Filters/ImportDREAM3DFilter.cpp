@@ -2,11 +2,15 @@
 
 #include "nlohmann/json.hpp"
 
+#include <fmt/core.h>
+
 #include "complex/Common/StringLiteral.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/Filter/Actions/ImportH5ObjectPathsAction.hpp"
+#include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Parameters/Dream3dImportParameter.hpp"
 #include "complex/Parameters/StringParameter.hpp"
+#include "complex/Parameters/VectorParameter.hpp"
 #include "complex/Pipeline/Pipeline.hpp"
 #include "complex/Utilities/Parsing/DREAM3D/Dream3dIO.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5FileReader.hpp"
@@ -17,6 +21,7 @@ constexpr complex::StringLiteral k_ImportedPipeline = "Imported Pipeline";
 constexpr complex::int32 k_NoImportPathError = -1;
 constexpr complex::int32 k_FailedOpenFileReaderError = -25;
 constexpr complex::int32 k_NoSelectedPaths = -26;
+constexpr complex::int32 k_InvalidSubVolume = -27;
 } // namespace
 
 namespace complex
@@ -45,6 +50,13 @@ Parameters ImportDREAM3DFilter::parameters() const
 {
   Parameters params;
   params.insert(std::make_unique<Dream3dImportParameter>(k_ImportFileData, "Import File Path", "The HDF5 file path the DataStructure should be imported from.", Dream3dImportParameter::ImportData()));
+  params.insertSeparator(Parameters::Separator{"Sub-Volume"});
+  params.insertLinkableParameter(std::make_unique<BoolParameter>(k_ImportSubVolume_Key, "Import Sub-Volume",
+                                                                 "Only read the voxels inside the bounds for the cell data of each Image Geometry in the file", false));
+  params.insert(std::make_unique<VectorUInt64Parameter>(k_MinVoxel_Key, "Min Voxel", "", std::vector<uint64>{0, 0, 0}, std::vector<std::string>{"X (Column)", "Y (Row)", "Z (Plane)"}));
+  params.insert(std::make_unique<VectorUInt64Parameter>(k_MaxVoxel_Key, "Max Voxel [Inclusive]", "", std::vector<uint64>{0, 0, 0}, std::vector<std::string>{"X (Column)", "Y (Row)", "Z (Plane)"}));
+  params.linkParameters(k_ImportSubVolume_Key, k_MinVoxel_Key, true);
+  params.linkParameters(k_ImportSubVolume_Key, k_MaxVoxel_Key, true);
   return params;
 }
 
@@ -73,8 +85,23 @@ IFilter::PreflightResult ImportDREAM3DFilter::preflightImpl(const DataStructure&
     importData.DataPaths = std::nullopt;
   }
 
+  std::optional<ImportH5ObjectPathsAction::SubVolume> subVolume;
+  if(args.value<bool>(k_ImportSubVolume_Key))
+  {
+    auto minVoxels = args.value<std::vector<uint64>>(k_MinVoxel_Key);
+    auto maxVoxels = args.value<std::vector<uint64>>(k_MaxVoxel_Key);
+    for(usize i = 0; i < 3; i++)
+    {
+      if(minVoxels[i] > maxVoxels[i])
+      {
+        return {MakeErrorResult<OutputActions>(k_InvalidSubVolume, fmt::format("The Min Voxel ({}) is greater than the Max Voxel ({}) for dimension {}", minVoxels[i], maxVoxels[i], i))};
+      }
+    }
+    subVolume = ImportH5ObjectPathsAction::SubVolume{std::move(minVoxels), std::move(maxVoxels)};
+  }
+
   OutputActions actions;
-  auto action = std::make_unique<ImportH5ObjectPathsAction>(importData.FilePath, importData.DataPaths);
+  auto action = std::make_unique<ImportH5ObjectPathsAction>(importData.FilePath, importData.DataPaths, subVolume);
   actions.actions.push_back(std::move(action));
   return {std::move(actions)};
 }
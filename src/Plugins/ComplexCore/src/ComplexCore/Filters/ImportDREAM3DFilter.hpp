@@ -28,6 +28,9 @@ public:
 
   // Parameter Keys
   static inline constexpr StringLiteral k_ImportFileData = "Import_File_Data";
+  static inline constexpr StringLiteral k_ImportSubVolume_Key = "Import_Sub_Volume";
+  static inline constexpr StringLiteral k_MinVoxel_Key = "Min_Voxel";
+  static inline constexpr StringLiteral k_MaxVoxel_Key = "Max_Voxel";
 
   /**
    * @brief Returns the name of the filter class.
@@ -11,6 +11,9 @@
 
 #include <nonstd/span.hpp>
 
+#include <algorithm>
+#include <numeric>
+
 using namespace complex;
 namespace fs = std::filesystem;
 
@@ -41,13 +44,83 @@ std::vector<size_t> createDimensionVector(const std::string& cDimsStr)
   return cDims;
 }
 
+/**
+ * @brief Fills a store without contiguous memory through the bulk copy API. The dataset
+ * is read in hyperslabs of at most k_VisitChunkSize values (or one innermost row if that
+ * is larger), so no buffer the size of the whole store is allocated.
+ * @param datasetReader
+ * @param dataStore
+ * @return bool
+ */
+template <typename T>
+bool readDatasetInBlocks(const H5::DatasetReader& datasetReader, AbstractDataStore<T>& dataStore)
+{
+  const std::vector<hsize_t> dims = datasetReader.getDimensions();
+  if(dims.empty() || datasetReader.getNumElements() != dataStore.getSize())
+  {
+    return false;
+  }
+  if(dataStore.getSize() == 0)
+  {
+    return true;
+  }
+
+  // Blocks are runs of rows of the outermost dimension whose rows fit in a block. The dimensions before it are read one index at a time.
+  const usize blockSize = AbstractDataStore<T>::k_VisitChunkSize;
+  usize splitDim = dims.size() - 1;
+  usize rowSize = 1;
+  while(splitDim > 0 && rowSize * dims[splitDim] <= blockSize)
+  {
+    rowSize *= dims[splitDim];
+    splitDim--;
+  }
+  const usize rowsPerBlock = std::max<usize>(blockSize / rowSize, 1);
+  const usize numOuter = std::accumulate(dims.cbegin(), dims.cbegin() + splitDim, static_cast<usize>(1), std::multiplies<>());
+
+  std::vector<hsize_t> start(dims.size(), 0);
+  std::vector<hsize_t> count = dims;
+  std::fill(count.begin(), count.begin() + splitDim, 1);
+  auto buffer = std::make_unique<T[]>(std::min<usize>(rowsPerBlock * rowSize, dataStore.getSize()));
+  usize offset = 0;
+  for(usize outer = 0; outer < numOuter; outer++)
+  {
+    usize outerIndex = outer;
+    for(usize dim = splitDim; dim-- > 0;)
+    {
+      start[dim] = outerIndex % dims[dim];
+      outerIndex /= dims[dim];
+    }
+    for(hsize_t row = 0; row < dims[splitDim]; row += rowsPerBlock)
+    {
+      start[splitDim] = row;
+      count[splitDim] = std::min<hsize_t>(rowsPerBlock, dims[splitDim] - row);
+      nonstd::span<T> values(buffer.get(), count[splitDim] * rowSize);
+      if(!datasetReader.readHyperslabIntoSpan<T>(start, count, values))
+      {
+        return false;
+      }
+      dataStore.copyFromBuffer(offset, values);
+      offset += values.size();
+    }
+  }
+  return true;
+}
+
 template <typename T>
 Result<> fillDataArray(DataStructure& dataStructure, const DataPath& dataArrayPath, const H5::DatasetReader& datasetReader)
 {
   auto& dataArray = dataStructure.getDataRefAs<DataArray<T>>(dataArrayPath);
   auto& absDataStore = dataArray.getDataStoreRef();
-  auto& dataStore = dynamic_cast<DataStore<T>&>(absDataStore);
-  if(!datasetReader.readIntoSpan<T>(dataStore.createSpan()))
+  bool success = false;
+  if(auto* dataStore = dynamic_cast<DataStore<T>*>(&absDataStore); dataStore != nullptr)
+  {
+    success = datasetReader.readIntoSpan<T>(dataStore->createSpan());
+  }
+  else
+  {
+    success = readDatasetInBlocks<T>(datasetReader, absDataStore);
+  }
+  if(!success)
   {
     return {MakeErrorResult(-21002, fmt::format("Error reading dataset '{}' with '{}' total elements into data store for data array '{}' with '{}' total elements ('{}' tuples and '{}' components)",
                                                 dataArrayPath.getTargetName(), datasetReader.getNumElements(), dataArrayPath.toString(), dataArray.getSize(), dataArray.getNumberOfTuples(),
@@ -9,6 +9,7 @@
 #include "complex/Parameters/MultiArraySelectionParameter.hpp"
 #include "complex/Parameters/NumberParameter.hpp"
 #include "complex/Utilities/DataGroupUtilities.hpp"
+#include "complex/Utilities/FeatureCleanup.hpp"
 
 namespace complex
 {
@@ -21,185 +22,22 @@ void assignBadPoints(DataStructure& data, const Arguments& args, const std::atom
 {
   auto imageGeomPath = args.value<DataPath>(MinNeighbors::k_ImageGeom_Key);
   auto featureIdsPath = args.value<DataPath>(MinNeighbors::k_FeatureIds_Key);
-  auto numNeighborsPath = args.value<DataPath>(MinNeighbors::k_NumNeighbors_Key);
-  auto ignoredVoxelArrayPaths = args.value<std::vector<DataPath>>(MinNeighbors::k_IgnoredVoxelArrays_Key);
   auto cellDataAttrMatrix = args.value<DataPath>(MinNeighbors::k_CellDataAttributeMatrix_Key);
 
   auto& featureIdsArray = data.getDataRefAs<Int32Array>(featureIdsPath);
-  auto& numNeighborsArray = data.getDataRefAs<Int32Array>(numNeighborsPath);
-
-  auto& featureIds = featureIdsArray.getDataStoreRef();
-
-  auto applyToSinglePhase = args.value<bool>(MinNeighbors::k_ApplyToSinglePhase_Key);
-  Int32Array* featurePhasesArray = nullptr;
-  if(applyToSinglePhase)
-  {
-    auto featurePhasesPath = args.value<DataPath>(MinNeighbors::k_FeaturePhases_Key);
-    featurePhasesArray = data.getDataAs<Int32Array>(featurePhasesPath);
-  }
-
-  usize totalPoints = featureIdsArray.getNumberOfTuples();
   SizeVec3 udims = data.getDataRefAs<ImageGeom>(imageGeomPath).getDimensions();
 
   // This was checked up in the execute function (which is called before this function)
   // so if we got this far then all should be good with the return. We might get
   // an empty vector<> but that is OK.
   std::vector<DataPath> cellDataArrayPaths = complex::GetAllChildDataPaths(data, cellDataAttrMatrix, DataObject::Type::DataArray).value();
-
-  std::array<int64, 3> dims = {
-      static_cast<int64>(udims[0]),
-      static_cast<int64>(udims[1]),
-      static_cast<int64>(udims[2]),
-  };
-
-  std::vector<int32_t> neighbors(totalPoints, -1);
-
-  int32 good = 1;
-  int32 current = 0;
-  int32 most = 0;
-  int64 neighpoint = 0;
-  usize numfeatures = numNeighborsArray.getNumberOfTuples();
-
-  int64 neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
-
-  usize counter = 1;
-  int64 count = 0;
-  int64 kstride = 0, jstride = 0;
-  int32 featurename = 0, feature = 0;
-  int32 neighbor = 0;
-  std::vector<int32> n(numfeatures + 1, 0);
-  std::vector<size_t> badFeatureIdIndexes;
-  while(counter != 0)
+  std::vector<IDataArray*> cellDataArrays;
+  for(const auto& cellArrayPath : cellDataArrayPaths)
   {
-    if(shouldCancel)
-    {
-      return;
-    }
-    counter = 0;
-    badFeatureIdIndexes.clear();
-    for(int64 k = 0; k < dims[2]; k++)
-    {
-      kstride = dims[0] * dims[1] * k;
-      for(int64 j = 0; j < dims[1]; j++)
-      {
-        jstride = dims[0] * j;
-        for(int64 i = 0; i < dims[0]; i++)
-        {
-          count = kstride + jstride + i;
-          featurename = featureIds[count];
-          if(featurename < 0)
-          {
-            badFeatureIdIndexes.push_back(count);
-            counter++;
-            current = 0;
-            most = 0;
-            for(int32 l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if(l == 0 && k == 0)
-              {
-                good = 0;
-              }
-              if(l == 5 && k == (dims[2] - 1))
-              {
-                good = 0;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = 0;
-              }
-              if(l == 4 && j == (dims[1] - 1))
-              {
-                good = 0;
-              }
-              if(l == 2 && i == 0)
-              {
-                good = 0;
-              }
-              if(l == 3 && i == (dims[0] - 1))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = featureIds[neighpoint];
-                if(feature >= 0)
-                {
-                  n[feature]++;
-                  current = n[feature];
-                  if(current > most)
-                  {
-                    most = current;
-                    neighbors[count] = neighpoint;
-                  }
-                }
-              }
-            }
-            for(int32 l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if(l == 0 && k == 0)
-              {
-                good = 0;
-              }
-              if(l == 5 && k == (dims[2] - 1))
-              {
-                good = 0;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = 0;
-              }
-              if(l == 4 && j == (dims[1] - 1))
-              {
-                good = 0;
-              }
-              if(l == 2 && i == 0)
-              {
-                good = 0;
-              }
-              if(l == 3 && i == (dims[0] - 1))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = featureIds[neighpoint];
-                if(feature >= 0)
-                {
-                  n[feature] = 0;
-                }
-              }
-            }
-          }
-        }
-      }
-    }
-
-    // TODO This can be parallelized much like NeighborOrientationCorrelation
-    // Only iterate over the cell data with a featureId = -1;
-    for(const auto& featureIdIndex : badFeatureIdIndexes)
-    {
-      featurename = featureIds[featureIdIndex];
-      neighbor = neighbors[featureIdIndex];
-      if(featurename < 0 && neighbor >= 0 && featureIds[neighbor] >= 0)
-      {
-        for(const auto& cellArrayPath : cellDataArrayPaths)
-        {
-          auto* voxelArray = data.getDataAs<IDataArray>(cellArrayPath);
-          dynamic_cast<IDataArray*>(voxelArray)->copyTuple(neighbor, featureIdIndex);
-        }
-      }
-    }
+    cellDataArrays.push_back(data.getDataAs<IDataArray>(cellArrayPath));
   }
+
+  FeatureCleanup::AssignBadPoints(udims, featureIdsArray, cellDataArrays, shouldCancel);
 }
 
 nonstd::expected<std::vector<bool>, Error> mergeContainedFeatures(DataStructure& data, const Arguments& args, const std::atomic_bool& shouldCancel)
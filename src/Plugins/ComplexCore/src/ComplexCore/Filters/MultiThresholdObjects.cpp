@@ -1,10 +1,17 @@
 #include "MultiThresholdObjects.hpp"
 
+#include "complex/DataStructure/BitDataStore.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
 #include "complex/Parameters/ArrayCreationParameter.hpp"
 #include "complex/Parameters/ArrayThresholdsParameter.hpp"
 #include "complex/Utilities/ArrayThreshold.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <type_traits>
 
 namespace complex
 {
@@ -15,317 +22,279 @@ constexpr StringLiteral k_CreatedDataPath_Key = "created_data_path";
 
 constexpr int64 k_PathNotFoundError = -178;
 
-class ThresholdFilterHelper
+using WordType = BitDataStore::WordType;
+constexpr usize k_BitsPerWord = BitDataStore::k_BitsPerWord;
+
+// Number of mask words evaluated together. Every threshold in the tree is
+// evaluated for one block before moving on to the next, so the intermediate
+// results of a block stay in cache.
+constexpr usize k_BlockWords = 64;
+constexpr usize k_BlockSize = k_BlockWords * k_BitsPerWord;
+
+/**
+ * @brief Evaluates one ArrayThreshold into mask words.
+ */
+class IThresholdKernel
 {
 public:
-  ThresholdFilterHelper(complex::ArrayThreshold::ComparisonType compType, complex::ArrayThreshold::ComparisonValue compValue, std::vector<bool>& output)
-  : m_ComparisonOperator(compType)
-  , m_ComparisonValue(compValue)
-  , m_Output(output)
-  {
-  }
-
-  ~ThresholdFilterHelper() = default;
+  virtual ~IThresholdKernel() = default;
 
   /**
-   * @brief
+   * @brief Writes the comparison results for numValues values starting at firstValue
+   * into words. firstValue must be word aligned. Bits past numValues are cleared.
+   * @param firstValue
+   * @param numValues
+   * @param words
    */
-  template <typename T>
-  void filterDataLessThan(const DataArray<T>& m_Input)
-  {
-    size_t m_NumValues = m_Input.getNumberOfTuples();
-    T value = static_cast<T>(m_ComparisonValue);
-    for(size_t i = 0; i < m_NumValues; ++i)
-    {
-      m_Output[i] = (m_Input[i] < value);
-    }
-  }
+  virtual void evaluate(usize firstValue, usize numValues, WordType* words) const = 0;
+};
 
-  /**
-   * @brief
-   */
-  template <typename T>
-  void filterDataGreaterThan(const DataArray<T>& m_Input)
+template <typename T, class CompareT>
+class ThresholdKernel : public IThresholdKernel
+{
+public:
+  ThresholdKernel(const AbstractDataStore<T>& store, T comparisonValue)
+  : m_Store(store)
+  , m_ComparisonValue(comparisonValue)
   {
-    size_t m_NumValues = m_Input.getNumberOfTuples();
-    T value = static_cast<T>(m_ComparisonValue);
-    for(size_t i = 0; i < m_NumValues; ++i)
-    {
-      m_Output[i] = (m_Input[i] > value);
-    }
   }
 
-  /**
-   * @brief
-   */
-  template <typename T>
-  void filterDataEqualTo(const DataArray<T>& m_Input)
+  ~ThresholdKernel() override = default;
+
+  void evaluate(usize firstValue, usize numValues, WordType* words) const override
   {
-    size_t m_NumValues = m_Input.getNumberOfTuples();
-    T value = static_cast<T>(m_ComparisonValue);
-    for(size_t i = 0; i < m_NumValues; ++i)
-    {
-      m_Output[i] = (m_Input[i] == value);
-    }
+    // Staged chunks start on word boundaries as long as the chunk size is a whole number of words
+    static_assert(AbstractDataStore<T>::k_VisitChunkSize % k_BitsPerWord == 0);
+
+    const T comparisonValue = m_ComparisonValue;
+    m_Store.visitConstChunks(firstValue, numValues, [firstValue, words, comparisonValue](usize startIndex, nonstd::span<const T> values) {
+      WordType* chunkWords = words + (startIndex - firstValue) / k_BitsPerWord;
+      const T* chunkValues = values.data();
+      const usize numFullWords = values.size() / k_BitsPerWord;
+      for(usize i = 0; i < numFullWords; i++)
+      {
+        chunkWords[i] = PackFullWord(chunkValues + i * k_BitsPerWord, comparisonValue);
+      }
+      const usize remainder = values.size() % k_BitsPerWord;
+      if(remainder != 0)
+      {
+        chunkWords[numFullWords] = PackPartialWord(chunkValues + numFullWords * k_BitsPerWord, remainder, comparisonValue);
+      }
+    });
   }
 
-  /**
-   * @brief
-   */
-  template <typename T>
-  void filterDataNotEqualTo(const DataArray<T>& m_Input)
+private:
+  // The fixed trip count and branch free body let the compiler vectorize the comparisons
+  static WordType PackFullWord(const T* values, T comparisonValue)
   {
-    size_t m_NumValues = m_Input.getNumberOfTuples();
-    T value = static_cast<T>(m_ComparisonValue);
-    for(size_t i = 0; i < m_NumValues; ++i)
+    CompareT compare;
+    WordType word = 0;
+    for(usize i = 0; i < k_BitsPerWord; i++)
     {
-      m_Output[i] = (m_Input[i] != value);
+      word |= static_cast<WordType>(compare(values[i], comparisonValue)) << i;
     }
+    return word;
   }
 
-  template <typename Type>
-  void filterData(const DataArray<Type>& input)
+  static WordType PackPartialWord(const T* values, usize count, T comparisonValue)
   {
-    if(m_ComparisonOperator == ArrayThreshold::ComparisonType::LessThan)
-    {
-      filterDataLessThan<Type>(input);
-    }
-    else if(m_ComparisonOperator == ArrayThreshold::ComparisonType::GreaterThan)
-    {
-      filterDataGreaterThan<Type>(input);
-    }
-    else if(m_ComparisonOperator == ArrayThreshold::ComparisonType::Operator_Equal)
-    {
-      filterDataEqualTo<Type>(input);
-    }
-    else if(m_ComparisonOperator == ArrayThreshold::ComparisonType::Operator_NotEqual)
+    CompareT compare;
+    WordType word = 0;
+    for(usize i = 0; i < count; i++)
     {
-      filterDataNotEqualTo<Type>(input);
-    }
-    else
-    {
-      std::string errorMessage = fmt::format("MultiThresholdObjects Comparison Operator not understood: '{}'", static_cast<int>(m_ComparisonOperator));
-      throw std::runtime_error(errorMessage);
+      word |= static_cast<WordType>(compare(values[i], comparisonValue)) << i;
     }
+    return word;
   }
 
-  /**
-   * @brief execute
-   * @param input
-   * @param output
-   * @return
-   */
-  void execute(DataStructure& dataStructure, DataPath& inputArrayDataPath)
-  {
-    const auto& dataArray = dataStructure.getDataRefAs<IDataArray>(inputArrayDataPath);
-
-    DataType type = dataArray.getDataType();
+  const AbstractDataStore<T>& m_Store;
+  T m_ComparisonValue;
+};
 
-    switch(type)
+struct CreateThresholdKernelFunctor
+{
+  template <typename T>
+  std::unique_ptr<IThresholdKernel> operator()(const IDataArray& dataArray, ArrayThreshold::ComparisonType comparisonType, ArrayThreshold::ComparisonValue comparisonValue)
+  {
+    const auto& store = dynamic_cast<const DataArray<T>&>(dataArray).getDataStoreRef();
+    const T value = static_cast<T>(comparisonValue);
+    switch(comparisonType)
     {
-    case DataType::int8: {
-      filterData<int8>(dynamic_cast<const DataArray<int8>&>(dataArray));
-      break;
-    }
-    case DataType::uint8: {
-      filterData<uint8>(dynamic_cast<const DataArray<uint8>&>(dataArray));
-      break;
-    }
-    case DataType::int16: {
-      filterData<int16>(dynamic_cast<const DataArray<int16>&>(dataArray));
-      break;
-    }
-    case DataType::uint16: {
-      filterData<uint16>(dynamic_cast<const DataArray<uint16>&>(dataArray));
-      break;
-    }
-    case DataType::int32: {
-      filterData<int32>(dynamic_cast<const DataArray<int32>&>(dataArray));
-      break;
+    case ArrayThreshold::ComparisonType::LessThan: {
+      return std::make_unique<ThresholdKernel<T, std::less<T>>>(store, value);
     }
-    case DataType::uint32: {
-      filterData<uint32>(dynamic_cast<const DataArray<uint32>&>(dataArray));
-      break;
+    case ArrayThreshold::ComparisonType::GreaterThan: {
+      return std::make_unique<ThresholdKernel<T, std::greater<T>>>(store, value);
     }
-    case DataType::int64: {
-      filterData<int64>(dynamic_cast<const DataArray<int64>&>(dataArray));
-      break;
+    case ArrayThreshold::ComparisonType::Operator_Equal: {
+      return std::make_unique<ThresholdKernel<T, std::equal_to<T>>>(store, value);
     }
-    case DataType::uint64: {
-      filterData<uint64>(dynamic_cast<const DataArray<uint64>&>(dataArray));
-      break;
+    case ArrayThreshold::ComparisonType::Operator_NotEqual: {
+      return std::make_unique<ThresholdKernel<T, std::not_equal_to<T>>>(store, value);
     }
-    case DataType::float32: {
-      filterData<float32>(dynamic_cast<const DataArray<float32>&>(dataArray));
-      break;
-    }
-    case DataType::float64: {
-      filterData<float64>(dynamic_cast<const DataArray<float64>&>(dataArray));
-      break;
-    }
-    case DataType::boolean: {
-      filterData<bool>(dynamic_cast<const DataArray<bool>&>(dataArray));
-      break;
+    default: {
+      std::string errorMessage = fmt::format("MultiThresholdObjects Comparison Operator not understood: '{}'", static_cast<int>(comparisonType));
+      throw std::runtime_error(errorMessage);
     }
     }
   }
-
-private:
-  complex::ArrayThreshold::ComparisonType m_ComparisonOperator;
-  complex::ArrayThreshold::ComparisonValue m_ComparisonValue;
-  std::vector<bool>& m_Output;
-
-public:
-  ThresholdFilterHelper(const ThresholdFilterHelper&) = delete;            // Copy Constructor Not Implemented
-  ThresholdFilterHelper(ThresholdFilterHelper&&) = delete;                 // Move Constructor Not Implemented
-  ThresholdFilterHelper& operator=(const ThresholdFilterHelper&) = delete; // Copy Assignment Not Implemented
-  ThresholdFilterHelper& operator=(ThresholdFilterHelper&&) = delete;      // Move Assignment Not Implemented
 };
 
 /**
- * @brief InsertThreshold
- * @param numItems
- * @param currentArrayPtr
- * @param unionOperator
- * @param newArrayPtr
- * @param inverse
+ * @brief A compiled ArrayThresholdSet. Leaves hold the kernel of an ArrayThreshold,
+ * inner nodes combine the results of their children in order.
  */
-void InsertThreshold(int64_t numItems, BoolArray& currentArray, complex::IArrayThreshold::UnionOperator unionOperator, std::vector<bool>& newArrayPtr, bool inverse)
+struct ThresholdNode
 {
+  std::unique_ptr<IThresholdKernel> kernel;
+  std::vector<ThresholdNode> children;
+  IArrayThreshold::UnionOperator unionOperator = IArrayThreshold::UnionOperator::And;
+  bool inverse = false;
+  usize depth = 0;
+};
+
+ThresholdNode CompileThresholdSet(const ArrayThresholdSet& thresholdSet, const DataStructure& dataStructure, bool invertMembers, bool& canParallelize);
 
-  for(int64_t i = 0; i < numItems; i++)
+/**
+ * @brief Compiles a member of a threshold set.
+ * @param threshold
+ * @param dataStructure
+ * @param inverse The result of the threshold is inverted before it is combined with the other members
+ * @param canParallelize Set to false if any of the input arrays is not held in memory
+ * @return
+ */
+ThresholdNode CompileThreshold(const IArrayThreshold& threshold, const DataStructure& dataStructure, bool inverse, bool& canParallelize)
+{
+  ThresholdNode node;
+  if(const auto* comparisonSet = dynamic_cast<const ArrayThresholdSet*>(&threshold))
+  {
+    node = CompileThresholdSet(*comparisonSet, dataStructure, false, canParallelize);
+  }
+  else if(const auto* comparisonValue = dynamic_cast<const ArrayThreshold*>(&threshold))
   {
-    // invert the current comparison if necessary
-    if(inverse)
+    const auto& dataArray = dataStructure.getDataRefAs<IDataArray>(comparisonValue->getArrayPath());
+    if(dataArray.getIDataStore()->getStoreType() != IDataStore::StoreType::InMemory)
     {
-      newArrayPtr[i] = !newArrayPtr[i];
+      canParallelize = false;
     }
+    node.kernel = ExecuteDataFunction(CreateThresholdKernelFunctor{}, dataArray.getDataType(), dataArray, comparisonValue->getComparisonType(), comparisonValue->getComparisonValue());
+  }
+  node.unionOperator = threshold.getUnionOperator();
+  node.inverse = inverse;
+  return node;
+}
 
-    if(complex::IArrayThreshold::UnionOperator::Or == unionOperator)
-    {
-      currentArray[i] = currentArray[i] || newArrayPtr[i];
-    }
-    else if(!currentArray[i] || !newArrayPtr[i])
+/**
+ * @brief Compiles a threshold set and all of its members.
+ * @param thresholdSet
+ * @param dataStructure
+ * @param invertMembers Each member is inverted before the members are combined
+ * @param canParallelize Set to false if any of the input arrays is not held in memory
+ * @return
+ */
+ThresholdNode CompileThresholdSet(const ArrayThresholdSet& thresholdSet, const DataStructure& dataStructure, bool invertMembers, bool& canParallelize)
+{
+  ThresholdNode node;
+  for(const std::shared_ptr<IArrayThreshold>& member : thresholdSet.getArrayThresholds())
+  {
+    if(member == nullptr)
     {
-      currentArray[i] = false;
+      continue;
     }
+    node.children.push_back(CompileThreshold(*member, dataStructure, invertMembers, canParallelize));
+    node.depth = std::max(node.depth, node.children.back().depth + 1);
   }
+  return node;
 }
 
 /**
- * @brief thresholdValue
- * @param comparisonValue
- * @param dataStructure
- * @param outputResultArrayPath
- * @param err
- * @param replaceInput
- * @param inverse
+ * @brief Evaluates a compiled threshold for one block of values.
+ * @param node
+ * @param firstValue
+ * @param numValues
+ * @param words Receives the result
+ * @param scratch node.depth * k_BlockWords words of temporary storage
  */
-void ThresholdValue(std::shared_ptr<ArrayThreshold>& comparisonValue, DataStructure& dataStructure, DataPath& outputResultArrayPath, int32_t& err, bool replaceInput, bool inverse)
+void EvaluateThreshold(const ThresholdNode& node, usize firstValue, usize numValues, WordType* words, WordType* scratch)
 {
-  if(nullptr == comparisonValue)
+  const usize numWords = BitDataStore::GetNumberOfWords(numValues);
+  if(node.kernel != nullptr)
   {
-    err = -1;
-    return;
+    node.kernel->evaluate(firstValue, numValues, words);
   }
-  // Traditionally we would do a check to ensure we get a valid pointer, I'm forgoing that check because it
-  // was essentially done in the preflight part.
-  BoolArray& outputResultArray = dataStructure.getDataRefAs<BoolArray>(outputResultArrayPath);
-
-  // Get the total number of tuples, create and initialize an array with FALSE to use for these results
-  size_t totalTuples = outputResultArray.getNumberOfTuples();
-  std::vector<bool> tempResultVector(totalTuples, false);
-
-  complex::ArrayThreshold::ComparisonType compOperator = comparisonValue->getComparisonType();
-  complex::ArrayThreshold::ComparisonValue compValue = comparisonValue->getComparisonValue();
-  complex::IArrayThreshold::UnionOperator unionOperator = comparisonValue->getUnionOperator();
-
-  DataPath inputDataArrayPath = comparisonValue->getArrayPath();
-
-  ThresholdFilterHelper filter(compOperator, compValue, tempResultVector);
-
-  filter.execute(dataStructure, inputDataArrayPath);
-
-  if(replaceInput)
+  else if(node.children.empty())
   {
-    if(inverse)
-    {
-      tempResultVector.flip();
-    }
-    // copy the temp uint8 vector to the final uint8 result array
-    for(size_t i = 0; i < totalTuples; i++)
-    {
-      outputResultArray[i] = tempResultVector[i];
-    }
+    std::fill_n(words, numWords, 0);
   }
   else
   {
-    // insert into current threshold
-    InsertThreshold(totalTuples, outputResultArray, unionOperator, tempResultVector, inverse);
+    WordType* memberWords = scratch;
+    WordType* memberScratch = scratch + k_BlockWords;
+    bool firstMember = true;
+    for(const ThresholdNode& member : node.children)
+    {
+      // The first member is evaluated in place, the others are combined with it
+      WordType* target = firstMember ? words : memberWords;
+      EvaluateThreshold(member, firstValue, numValues, target, memberScratch);
+      if(member.inverse)
+      {
+        std::transform(target, target + numWords, target, [](WordType word) { return ~word; });
+      }
+      if(firstMember)
+      {
+        firstMember = false;
+      }
+      else if(member.unionOperator == IArrayThreshold::UnionOperator::Or)
+      {
+        std::transform(words, words + numWords, memberWords, words, [](WordType lhs, WordType rhs) { return lhs | rhs; });
+      }
+      else
+      {
+        std::transform(words, words + numWords, memberWords, words, [](WordType lhs, WordType rhs) { return lhs & rhs; });
+      }
+    }
   }
 }
 
-void ThresholdSet(std::shared_ptr<ArrayThresholdSet>& inputComparisonSet, DataStructure& dataStructure, DataPath& outputResultArrayPath, int32_t& err, bool replaceInput, bool inverse)
+/**
+ * @brief Evaluates a compiled threshold tree over a range of blocks and writes
+ * the results into the mask. Every block covers its own mask values, so blocks
+ * can be evaluated in parallel if the mask is a DataStore.
+ */
+class EvaluateThresholdsImpl
 {
-  if(nullptr == inputComparisonSet)
+public:
+  EvaluateThresholdsImpl(const ThresholdNode& root, AbstractDataStore<bool>& maskStore)
+  : m_Root(root)
+  , m_MaskStore(maskStore)
   {
-    return;
   }
 
-  //  if(inverse)
-  //  {
-  //    inverse = !comparisonSet->getInvertComparison();
-  //  }
-  //  else
-  //  {
-  //    inverse = comparisonSet->getInvertComparison();
-  //  }
-
-  // Traditionally we would do a check to ensure we get a valid pointer, I'm forgoing that check because it
-  // was essentially done in the preflight part.
-  BoolArray& outputResultArray = dataStructure.getDataRefAs<BoolArray>(outputResultArrayPath);
-
-  // Get the total number of tuples, create and initialize an array with FALSE to use for these results
-  size_t totalTuples = outputResultArray.getNumberOfTuples();
-  std::vector<bool> tempResultVector(totalTuples, false);
-
-  bool firstValueFound = false;
-
-  ArrayThresholdSet::CollectionType thresholds = inputComparisonSet->getArrayThresholds();
-  for(const std::shared_ptr<IArrayThreshold>& threshold : thresholds)
+  void operator()(const Range& range) const
   {
-    if(std::dynamic_pointer_cast<ArrayThresholdSet>(threshold))
+    std::vector<WordType> words(k_BlockWords);
+    std::vector<WordType> scratch(m_Root.depth * k_BlockWords);
+    const usize totalValues = m_MaskStore.getSize();
+    for(usize block = range.min(); block < range.max(); block++)
     {
-      std::shared_ptr<ArrayThresholdSet> comparisonSet = std::dynamic_pointer_cast<ArrayThresholdSet>(threshold);
-      ThresholdSet(comparisonSet, dataStructure, outputResultArrayPath, err, !firstValueFound, false);
-      firstValueFound = true;
-    }
-    else if(std::dynamic_pointer_cast<ArrayThreshold>(threshold))
-    {
-      std::shared_ptr<ArrayThreshold> comparisonValue = std::dynamic_pointer_cast<ArrayThreshold>(threshold);
-      ThresholdValue(comparisonValue, dataStructure, outputResultArrayPath, err, !firstValueFound, false);
-      firstValueFound = true;
+      const usize firstValue = block * k_BlockSize;
+      const usize numValues = std::min(k_BlockSize, totalValues - firstValue);
+      EvaluateThreshold(m_Root, firstValue, numValues, words.data(), scratch.data());
+      m_MaskStore.visitChunks(firstValue, numValues, [firstValue, &words](usize startIndex, nonstd::span<bool> values) {
+        const usize firstBit = startIndex - firstValue;
+        for(usize i = 0; i < values.size(); i++)
+        {
+          const usize bit = firstBit + i;
+          values[i] = ((words[bit / k_BitsPerWord] >> (bit % k_BitsPerWord)) & 1u) != 0;
+        }
+      });
     }
   }
 
-  if(replaceInput)
-  {
-    if(inverse)
-    {
-      tempResultVector.flip();
-    }
-    // copy the temp uint8 vector to the final uint8 result array
-    for(size_t i = 0; i < totalTuples; i++)
-    {
-      outputResultArray[i] = tempResultVector[i];
-    }
-  }
-  else
-  {
-    // insert into current threshold
-    InsertThreshold(totalTuples, outputResultArray, inputComparisonSet->getUnionOperator(), tempResultVector, inverse);
-  }
-}
+private:
+  const ThresholdNode& m_Root;
+  AbstractDataStore<bool>& m_MaskStore;
+};
 
 } // namespace
 
@@ -435,7 +404,9 @@ IFilter::PreflightResult MultiThresholdObjects::preflightImpl(const DataStructur
     }
   }
 
-  // Create the output boolean array
+  // Create the output boolean array with one byte per value. Masks are read through the
+  // mutable DataArray accessors by most filters, which a bit packed store can only serve
+  // by unpacking blocks into windows.
   auto action = std::make_unique<CreateArrayAction>(DataType::boolean, dataArray->getIDataStore()->getTupleShape(), std::vector<usize>{1}, maskArrayPath);
 
   OutputActions actions;
@@ -451,25 +422,19 @@ Result<> MultiThresholdObjects::executeImpl(DataStructure& dataStructure, const
   auto thresholdsObject = args.value<ArrayThresholdSet>(k_ArrayThresholds_Key);
   auto maskArrayPath = args.value<DataPath>(k_CreatedDataPath_Key);
 
-  bool firstValueFound = false;
+  auto& maskArray = dataStructure.getDataRefAs<BoolArray>(maskArrayPath);
+  AbstractDataStore<bool>& maskStore = maskArray.getDataStoreRef();
 
-  int32_t err = 0;
-  ArrayThresholdSet::CollectionType thresholdSet = thresholdsObject.getArrayThresholds();
-  for(const std::shared_ptr<IArrayThreshold>& threshold : thresholdSet)
-  {
-    if(std::dynamic_pointer_cast<ArrayThresholdSet>(threshold))
-    {
-      std::shared_ptr<ArrayThresholdSet> comparisonSet = std::dynamic_pointer_cast<ArrayThresholdSet>(threshold);
-      ThresholdSet(comparisonSet, dataStructure, maskArrayPath, err, !firstValueFound, thresholdsObject.isInverted());
-      firstValueFound = true;
-    }
-    else if(std::dynamic_pointer_cast<ArrayThreshold>(threshold))
-    {
-      std::shared_ptr<ArrayThreshold> comparisonValue = std::dynamic_pointer_cast<ArrayThreshold>(threshold);
-      ThresholdValue(comparisonValue, dataStructure, maskArrayPath, err, !firstValueFound, thresholdsObject.isInverted());
-      firstValueFound = true;
-    }
-  }
+  // Compile the thresholds into typed kernels and evaluate the whole tree one
+  // block of mask words at a time. Each block is unpacked straight into the mask.
+  bool canParallelize = dynamic_cast<DataStore<bool>*>(&maskStore) != nullptr;
+  const ThresholdNode root = CompileThresholdSet(thresholdsObject, dataStructure, thresholdsObject.isInverted(), canParallelize);
+
+  const usize numValues = maskStore.getSize();
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, (numValues + k_BlockSize - 1) / k_BlockSize);
+  dataAlg.setParallelizationEnabled(canParallelize);
+  dataAlg.execute(EvaluateThresholdsImpl(root, maskStore));
 
   // thresholdsObject.applyMaskValues(data, maskArrayPath);
 
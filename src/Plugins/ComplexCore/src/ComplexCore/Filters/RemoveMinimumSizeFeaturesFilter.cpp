@@ -11,6 +11,7 @@
 #include "complex/Parameters/DataPathSelectionParameter.hpp"
 #include "complex/Parameters/NumberParameter.hpp"
 #include "complex/Utilities/DataGroupUtilities.hpp"
+#include "complex/Utilities/FeatureCleanup.hpp"
 
 namespace complex
 {
@@ -27,168 +28,22 @@ constexpr int32 k_ParentlessPathError = -5557;
 constexpr int32 k_NeighborListRemoval = -5558;
 constexpr int32 k_FetchChildArrayError = -5559;
 
-void assign_badpoints(DataStructure& dataStructure, const DataPath& featureIdsPath, SizeVec3 dimensions, const NumCellsArrayType& numCellsArrayRef)
+void assign_badpoints(DataStructure& dataStructure, const DataPath& featureIdsPath, SizeVec3 dimensions, const std::atomic_bool& shouldCancel)
 {
-  FeatureIdsArrayType* featureIdsPtr = dataStructure.getDataAs<FeatureIdsArrayType>(featureIdsPath);
-
-  usize totalPoints = featureIdsPtr->getNumberOfTuples();
-  FeatureIdsArrayType::store_type* featureIds = featureIdsPtr->getDataStore();
-
-  std::array<int64_t, 3> dims = {
-      static_cast<int64>(dimensions[0]),
-      static_cast<int64>(dimensions[1]),
-      static_cast<int64>(dimensions[2]),
-  };
-
-  std::vector<int32_t> neighbors(totalPoints * featureIdsPtr->getNumberOfComponents(), -1);
-
-  int32 good = 1;
-  int32 current = 0;
-  int32 most = 0;
-  int64 neighpoint = 0;
-
-  std::array<int64_t, 6> neighpoints = {-dims[0] * dims[1], -dims[0], -1, 1, dims[0], dims[0] * dims[1]};
-
-  usize counter = 1;
-  int64 count = 0;
-  int64 kstride = 0;
-  int64 jstride = 0;
-  int32 featurename = 0;
-  int32 feature = 0;
-  int32 neighbor = 0;
-  std::vector<int32> n(numCellsArrayRef.getNumberOfTuples(), 0);
+  FeatureIdsArrayType& featureIdsArrayRef = dataStructure.getDataRefAs<FeatureIdsArrayType>(featureIdsPath);
 
-  while(counter != 0)
+  DataPath attrMatPath = featureIdsPath.getParent();
+  BaseGroup* parentGroup = dataStructure.getDataAs<BaseGroup>(attrMatPath);
+  std::vector<IDataArray*> voxelArrays;
+  for(const auto& [id, sharedChild] : *parentGroup)
   {
-    counter = 0;
-    for(int64 k = 0; k < dims[2]; k++)
+    if(auto* voxelArray = dynamic_cast<IDataArray*>(sharedChild.get()); voxelArray != nullptr)
     {
-      kstride = dims[0] * dims[1] * k;
-      for(int64 j = 0; j < dims[1]; j++)
-      {
-        jstride = dims[0] * j;
-        for(int64 i = 0; i < dims[0]; i++)
-        {
-          count = kstride + jstride + i;
-          featurename = featureIds->getValue(count);
-          if(featurename < 0)
-          {
-            counter++;
-            most = 0;
-            for(size_t l = 0; l < neighpoints.size(); l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if(l == 0 && k == 0)
-              {
-                good = 0;
-              }
-              if(l == 5 && k == (dims[2] - 1))
-              {
-                good = 0;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = 0;
-              }
-              if(l == 4 && j == (dims[1] - 1))
-              {
-                good = 0;
-              }
-              if(l == 2 && i == 0)
-              {
-                good = 0;
-              }
-              if(l == 3 && i == (dims[0] - 1))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = featureIds->getValue(neighpoint);
-                if(feature >= 0)
-                {
-                  n[feature]++;
-                  current = n[feature];
-                  if(current > most)
-                  {
-                    most = current;
-                    neighbors[count] = neighpoint;
-                  }
-                }
-              }
-            }
-            for(int32 l = 0; l < neighpoints.size(); l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if(l == 0 && k == 0)
-              {
-                good = 0;
-              }
-              if(l == 5 && k == (dims[2] - 1))
-              {
-                good = 0;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = 0;
-              }
-              if(l == 4 && j == (dims[1] - 1))
-              {
-                good = 0;
-              }
-              if(l == 2 && i == 0)
-              {
-                good = 0;
-              }
-              if(l == 3 && i == (dims[0] - 1))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = featureIds->getValue(neighpoint);
-                if(feature >= 0)
-                {
-                  n[feature] = 0;
-                }
-              }
-            }
-          }
-        }
-      }
-    }
-    DataPath attrMatPath = featureIdsPath.getParent();
-    BaseGroup* parentGroup = dataStructure.getDataAs<BaseGroup>(attrMatPath);
-    std::vector<std::string> voxelArrayNames;
-    for(const auto& [id, sharedChild] : *parentGroup)
-    {
-      if(std::dynamic_pointer_cast<IDataArray>(sharedChild))
-      {
-        voxelArrayNames.push_back(sharedChild->getName());
-      }
-    }
-
-    // TODO: This loop could be parallelized. Look at NeighborOrientationCorrelation filter
-    for(size_t j = 0; j < totalPoints; j++)
-    {
-      featurename = featureIds->getValue(j);
-      neighbor = neighbors[j];
-      if(neighbor >= 0)
-      {
-        if(featurename < 0 && featureIds->getValue(neighbor) >= 0)
-        {
-          for(auto& voxelArrayName : voxelArrayNames)
-          {
-            auto arrayPath = attrMatPath.createChildPath(voxelArrayName);
-            IDataArray* arr = dataStructure.getDataAs<IDataArray>(arrayPath);
-            arr->copyTuple(neighbor, j);
-          }
-        }
-      }
+      voxelArrays.push_back(voxelArray);
     }
   }
+
+  FeatureCleanup::AssignBadPoints(dimensions, featureIdsArrayRef, voxelArrays, shouldCancel);
 }
 
 // -----------------------------------------------------------------------------
@@ -441,7 +296,7 @@ Result<> RemoveMinimumSizeFeaturesFilter::executeImpl(DataStructure& dataStructu
   }
 
   ImageGeom& imageGeom = dataStructure.getDataRefAs<ImageGeom>(imageGeomPath);
-  assign_badpoints(dataStructure, featureIdsPath, imageGeom.getDimensions(), numCellsArrayRef);
+  assign_badpoints(dataStructure, featureIdsPath, imageGeom.getDimensions(), shouldCancel);
 
   DataPath cellFeatureGroupPath = numCellsPath.getParent();
   size_t currentFeatureCount = numCellsStoreRef.getNumberOfTuples();
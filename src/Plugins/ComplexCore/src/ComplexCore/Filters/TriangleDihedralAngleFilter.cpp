@@ -180,7 +180,8 @@ IFilter::PreflightResult TriangleDihedralAngleFilter::preflightImpl(const DataSt
   }
 
   DataPath dihedralAnglesArrayPath = pTriangleGeometryDataPath.createChildPath(faceData->getName()).createChildPath(pSurfaceMeshTriangleDihedralAnglesName);
-  auto createArrayAction = std::make_unique<CreateArrayAction>(complex::DataType::float64, faceData->getShape(), std::vector<usize>{1}, dihedralAnglesArrayPath);
+  auto createArrayAction = std::make_unique<CreateArrayAction>(complex::DataType::float64, faceData->getShape(), std::vector<usize>{1}, dihedralAnglesArrayPath, false,
+                                                               AllocationPolicy::Uninitialized);
   resultOutputActions.value().actions.push_back(std::move(createArrayAction));
 
   return {std::move(resultOutputActions), std::move(preflightUpdatedValues)};
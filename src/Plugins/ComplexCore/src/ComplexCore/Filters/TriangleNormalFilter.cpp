@@ -133,7 +133,8 @@ IFilter::PreflightResult TriangleNormalFilter::preflightImpl(const DataStructure
   if(triangleGeom != nullptr)
   {
     auto createArrayAction =
-        std::make_unique<CreateArrayAction>(complex::DataType::float64, std::vector<usize>{triangleGeom->getNumberOfFaces()}, std::vector<usize>{3}, pSurfaceMeshTriangleNormalsArrayPath);
+        std::make_unique<CreateArrayAction>(complex::DataType::float64, std::vector<usize>{triangleGeom->getNumberOfFaces()}, std::vector<usize>{3}, pSurfaceMeshTriangleNormalsArrayPath, false,
+                                            AllocationPolicy::Uninitialized);
     resultOutputActions.value().actions.push_back(std::move(createArrayAction));
   }
 
@@ -29,9 +29,14 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #pragma once
 
-#include "complex/Common/Types.hpp"
+#include "complex/Common/TypesUtility.hpp"
 #include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataStore.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/Parsing/Text/TextIngestion.hpp"
+
+#include <string_view>
+#include <type_traits>
 
 using namespace complex;
 
@@ -60,7 +65,16 @@ public:
     return m_DataArray;
   }
 
-  virtual Result<> parse(const std::string& token, size_t index) = 0;
+  /**
+   * @brief Returns true if tokens for different tuples may be parsed from several threads at once.
+   * @return bool
+   */
+  bool canParseInParallel() const
+  {
+    return m_DataArray.getIDataStoreRef().getStoreType() == IDataStore::StoreType::InMemory;
+  }
+
+  virtual Result<> parse(std::string_view token, usize index) = 0;
 
 protected:
   AbstractDataParser(IDataArray& array, const std::string& columnName, usize columnIndex)
@@ -87,6 +101,10 @@ public:
   : AbstractDataParser(array, name, index)
   , m_Array(array)
   {
+    if(auto* dataStore = dynamic_cast<DataStore<T>*>(&array.getDataStoreRef()); dataStore != nullptr)
+    {
+      m_Values = dataStore->data();
+    }
   }
   ~CSVDataParser() override = default;
 
@@ -95,19 +113,36 @@ public:
   CSVDataParser& operator=(const CSVDataParser&) = delete; // Copy Assignment Not Implemented
   CSVDataParser& operator=(CSVDataParser&&) = delete;      // Move Assignment
 
-  Result<> parse(const std::string& token, size_t index) override
+  Result<> parse(std::string_view token, usize index) override
   {
-    Result<T> parseResult = ConvertTo<T>::convert(token);
-    if(parseResult.valid())
+    T value = {};
+    const std::errc errorCode = TextIngestion::ParseNumber(token, value);
+    if(errorCode == std::errc::result_out_of_range)
     {
-      m_Array[index] = parseResult.value();
+      return MakeErrorResult(-101, fmt::format("Overflow error trying to convert '{}' to type '{}' using function '{}'", token, DataTypeToString(GetDataType<T>()).view(), k_ConvertFunctionName));
+    }
+    if(errorCode != std::errc{})
+    {
+      return MakeErrorResult(-100, fmt::format("Error trying to convert '{}' to type '{}' using function '{}'", token, DataTypeToString(GetDataType<T>()).view(), k_ConvertFunctionName));
     }
 
-    return ConvertResult(std::move(parseResult));
+    if(m_Values != nullptr)
+    {
+      m_Values[index] = value;
+    }
+    else
+    {
+      m_Array[index] = value;
+    }
+    return {};
   }
 
 private:
+  // Error messages name the function ConvertTo<T> uses for T so they match the ones reported before tokens were parsed with TextIngestion::ParseNumber
+  static constexpr const char* k_ConvertFunctionName = std::is_same_v<T, float32> ? "std::stof" : std::is_same_v<T, float64> ? "std::stod" : std::is_signed_v<T> ? "std::stoll" : "std::stoull";
+
   ArrayType& m_Array;
+  T* m_Values = nullptr;
 };
 
 using Int8Parser = CSVDataParser<Int8Array, int8>;
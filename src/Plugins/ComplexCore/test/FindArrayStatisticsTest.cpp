@@ -1,6 +1,9 @@
 #include <catch2/catch.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <random>
 namespace fs = std::filesystem;
 
 #include "complex/UnitTest/UnitTestCommon.hpp"
@@ -13,6 +16,7 @@ namespace fs = std::filesystem;
 #include "complex/Parameters/DataGroupSelectionParameter.hpp"
 #include "complex/Parameters/Dream3dImportParameter.hpp"
 #include "complex/Parameters/NumberParameter.hpp"
+#include "complex/Utilities/Math/StatisticsCalculations.hpp"
 
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 #include "ComplexCore/Filters/FindArrayStatisticsFilter.hpp"
@@ -21,6 +25,89 @@ namespace fs = std::filesystem;
 using namespace complex;
 using namespace complex::Constants;
 
+namespace
+{
+template <typename T>
+std::vector<T> CreateRandomValues(usize count, float64 min, float64 max)
+{
+  std::mt19937_64 generator(count);
+  std::uniform_real_distribution<float64> distribution(min, max);
+  std::vector<T> values(count);
+  for(auto& value : values)
+  {
+    value = static_cast<T>(distribution(generator));
+  }
+  return values;
+}
+
+bool IsClose(float64 actual, float64 expected, float64 relativeTolerance)
+{
+  return std::fabs(actual - expected) <= relativeTolerance * std::max(std::fabs(expected), 1.0);
+}
+
+template <typename T>
+void RequireMatchingSpanStatistics(const std::vector<T>& values)
+{
+  INFO(fmt::format("{} values", values.size()));
+  nonstd::span<const T> span(values.data(), values.size());
+
+  const StaticicsCalculations::SpanSummary<T> summary = StaticicsCalculations::summarize(span);
+  REQUIRE(summary.Count == values.size());
+  REQUIRE(summary.Min == StaticicsCalculations::findMin(values));
+  REQUIRE(summary.Max == StaticicsCalculations::findMax(values));
+  REQUIRE(IsClose(static_cast<float64>(summary.Sum), static_cast<float64>(StaticicsCalculations::computeSum(values)), 1.0e-9));
+  REQUIRE(IsClose(StaticicsCalculations::findMean(span), StaticicsCalculations::findMean(values), 1.0e-4));
+  REQUIRE(IsClose(StaticicsCalculations::findStdDeviation(span), StaticicsCalculations::findStdDeviation(values), 1.0e-3));
+  REQUIRE(StaticicsCalculations::findMedian(span) == StaticicsCalculations::findMedian(values));
+
+  auto histogram = StaticicsCalculations::findHistogram(span, 0.0f, 0.0f, true, 16);
+  std::vector<T> copy = values;
+  REQUIRE(histogram == StaticicsCalculations::findHistogram(copy, 0.0f, 0.0f, true, 16));
+}
+} // namespace
+
+TEST_CASE("ComplexCore::FindArrayStatisticsFilter: Parallel Whole Array Statistics", "[ComplexCore][FindArrayStatisticsFilter]")
+{
+  // Sizes below, at and above the chunk size with odd and even counts
+  for(usize count : {1ULL, 2ULL, 1001ULL, 65536ULL, 300001ULL, 300002ULL})
+  {
+    RequireMatchingSpanStatistics(CreateRandomValues<float32>(count, -1000.0, 1000.0));
+    RequireMatchingSpanStatistics(CreateRandomValues<float64>(count, -1.0e6, 1.0e6));
+    RequireMatchingSpanStatistics(CreateRandomValues<int16>(count, -200.0, 200.0));
+    RequireMatchingSpanStatistics(CreateRandomValues<uint8>(count, 0.0, 255.0));
+    RequireMatchingSpanStatistics(CreateRandomValues<int64>(count, -1.0e9, 1.0e9));
+  }
+
+  // Every value is the same
+  RequireMatchingSpanStatistics(std::vector<int32>(100000, -7));
+}
+
+// Run explicitly with: ComplexCoreUnitTest "[benchmark]"
+TEST_CASE("ComplexCore::FindArrayStatisticsFilter: Whole Array Benchmark", "[.][benchmark]")
+{
+  const std::vector<float32> values = CreateRandomValues<float32>(1ULL << 27, -1000.0, 1000.0);
+  nonstd::span<const float32> span(values.data(), values.size());
+
+  auto start = std::chrono::steady_clock::now();
+  const float32 serialMean = StaticicsCalculations::findMean(values);
+  StaticicsCalculations::findStdDeviation(values);
+  const float32 serialMedian = StaticicsCalculations::findMedian(values);
+  const auto serialTime = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  const auto summary = StaticicsCalculations::summarize(span);
+  const float32 parallelMedian = StaticicsCalculations::findMedian(span);
+  const auto parallelTime = std::chrono::steady_clock::now() - start;
+
+  fmt::print("Statistics of {} float32 values: serial {} ms, parallel {} ms\n", values.size(), std::chrono::duration_cast<std::chrono::milliseconds>(serialTime).count(),
+             std::chrono::duration_cast<std::chrono::milliseconds>(parallelTime).count());
+  REQUIRE(IsClose(summary.Sum / static_cast<float64>(summary.Count), serialMean, 1.0e-2));
+  // The serial standard deviation sums its squares in single precision, which drifts for this many
+  // values, so the parallel one is checked against the standard deviation of the distribution
+  REQUIRE(IsClose(std::sqrt(summary.M2 / static_cast<float64>(summary.Count)), 2000.0 / std::sqrt(12.0), 1.0e-3));
+  REQUIRE(parallelMedian == serialMedian);
+}
+
 TEST_CASE("ComplexCore::FindArrayStatisticsFilter: Instantiate Filter", "[ComplexCore][FindArrayStatisticsFilter]")
 {
   // Instantiate the filter, a DataStructure object and an Arguments Object
@@ -465,3 +552,128 @@ TEST_CASE("ComplexCore::FindArrayStatisticsFilter: Test Algorithm By Index", "[C
     REQUIRE(std::fabs(hist3_5 - 1.0f) < UnitTest::EPSILON);
   }
 }
+
+TEST_CASE("ComplexCore::FindArrayStatisticsFilter: Parallel By Index Statistics", "[ComplexCore][FindArrayStatisticsFilter]")
+{
+  // Features of very different sizes in shuffled order. Every 17th feature has no values and the
+  // values of the last feature are all masked out, so empty features come from both cases.
+  constexpr int32 k_NumFeatures = 400;
+  std::vector<int32> featureIds;
+  for(int32 feature = 0; feature < k_NumFeatures; feature++)
+  {
+    const usize featureSize = feature % 17 == 0 ? 0 : (static_cast<usize>(feature) * feature * 7) % 1013 + 1;
+    featureIds.insert(featureIds.end(), feature == k_NumFeatures - 1 ? 5 : featureSize, feature);
+  }
+  std::mt19937_64 generator(featureIds.size());
+  std::shuffle(featureIds.begin(), featureIds.end(), generator);
+  const usize numValues = featureIds.size();
+  const std::vector<int32> values = CreateRandomValues<int32>(numValues, -500.0, 500.0);
+  std::bernoulli_distribution maskDistribution(0.9);
+  std::vector<bool> mask(numValues);
+  for(usize i = 0; i < numValues; i++)
+  {
+    mask[i] = featureIds[i] != k_NumFeatures - 1 && maskDistribution(generator);
+  }
+
+  DataStructure dataStructure;
+  DataGroup* topLevelGroup = DataGroup::Create(dataStructure, "TestData");
+  DataPath statsDataPath({"TestData", "Statistics"});
+  DataPath inputArrayPath({"TestData", "InputArray"});
+  auto* inputArray = Int32Array::CreateWithStore<DataStore<int32>>(dataStructure, "InputArray", {numValues}, {1}, topLevelGroup->getId());
+  auto* featureIdsArray = Int32Array::CreateWithStore<DataStore<int32>>(dataStructure, "FeatureIds", {numValues}, {1}, topLevelGroup->getId());
+  auto* maskArray = BoolArray::CreateWithStore<DataStore<bool>>(dataStructure, "Mask", {numValues}, {1}, topLevelGroup->getId());
+  for(usize i = 0; i < numValues; i++)
+  {
+    inputArray->getDataStoreRef()[i] = values[i];
+    featureIdsArray->getDataStoreRef()[i] = featureIds[i];
+    maskArray->getDataStoreRef()[i] = mask[i];
+  }
+
+  constexpr int32 k_NumBins = 7;
+  {
+    FindArrayStatisticsFilter filter;
+    Arguments args;
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindHistogram_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_MinRange_Key, std::make_any<float64>(0));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_MaxRange_Key, std::make_any<float64>(100));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_UseFullRange_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_NumBins_Key, std::make_any<int32>(k_NumBins));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindLength_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindMin_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindMax_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindMean_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindMedian_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindStdDeviation_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindSummation_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_UseMask_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_ComputeByIndex_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_StandardizeData_Key, std::make_any<bool>(false));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_SelectedArrayPath_Key, std::make_any<DataPath>(inputArrayPath));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FeatureIdsArrayPath_Key, std::make_any<DataPath>(DataPath({"TestData", "FeatureIds"})));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_MaskArrayPath_Key, std::make_any<DataPath>(DataPath({"TestData", "Mask"})));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_DestinationAttributeMatrix_Key, std::make_any<DataPath>(statsDataPath));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_HistogramArrayName_Key, std::make_any<std::string>("Histogram"));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_LengthArrayName_Key, std::make_any<std::string>("Length"));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_MinimumArrayName_Key, std::make_any<std::string>("Minimum"));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_MaximumArrayName_Key, std::make_any<std::string>("Maximum"));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_MeanArrayName_Key, std::make_any<std::string>("Mean"));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_MedianArrayName_Key, std::make_any<std::string>("Median"));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_StdDeviationArrayName_Key, std::make_any<std::string>("Standard Deviation"));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_SummationArrayName_Key, std::make_any<std::string>("Summation"));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_StandardizedArrayName_Key, std::make_any<std::string>("Standardization"));
+
+    auto preflightResult = filter.preflight(dataStructure, args);
+    REQUIRE(preflightResult.outputActions.valid());
+
+    auto executeResult = filter.execute(dataStructure, args);
+    REQUIRE(executeResult.result.valid());
+  }
+
+  const auto& lengthArray = dataStructure.getDataRefAs<UInt64Array>(statsDataPath.createChildPath("Length"));
+  const auto& minArray = dataStructure.getDataRefAs<Int32Array>(statsDataPath.createChildPath("Minimum"));
+  const auto& maxArray = dataStructure.getDataRefAs<Int32Array>(statsDataPath.createChildPath("Maximum"));
+  const auto& meanArray = dataStructure.getDataRefAs<Float32Array>(statsDataPath.createChildPath("Mean"));
+  const auto& medianArray = dataStructure.getDataRefAs<Float32Array>(statsDataPath.createChildPath("Median"));
+  const auto& stdArray = dataStructure.getDataRefAs<Float32Array>(statsDataPath.createChildPath("Standard Deviation"));
+  const auto& sumArray = dataStructure.getDataRefAs<Float32Array>(statsDataPath.createChildPath("Summation"));
+  const auto& histArray = dataStructure.getDataRefAs<Float32Array>(statsDataPath.createChildPath("Histogram"));
+  REQUIRE(lengthArray.getNumberOfTuples() == k_NumFeatures);
+  REQUIRE(histArray.getNumberOfComponents() == k_NumBins);
+
+  // Serial reference: the unmasked values of each feature in their original order
+  std::vector<std::vector<int32>> featureValues(k_NumFeatures);
+  for(usize i = 0; i < numValues; i++)
+  {
+    if(mask[i])
+    {
+      featureValues[featureIds[i]].push_back(values[i]);
+    }
+  }
+  usize numEmptyFeatures = 0;
+  for(int32 feature = 0; feature < k_NumFeatures; feature++)
+  {
+    INFO(fmt::format("Feature {}", feature));
+    std::vector<int32>& expected = featureValues[feature];
+    REQUIRE(lengthArray[feature] == expected.size());
+    REQUIRE(medianArray[feature] == StaticicsCalculations::findMedian(expected));
+    REQUIRE(IsClose(stdArray[feature], StaticicsCalculations::findStdDeviation(expected), 1.0e-3));
+    REQUIRE(IsClose(sumArray[feature], static_cast<float64>(StaticicsCalculations::computeSum(expected)), 1.0e-6));
+    const std::vector<float32> expectedHistogram = StaticicsCalculations::findHistogram(expected, 0.0f, 100.0f, true, k_NumBins);
+    for(usize bin = 0; bin < k_NumBins; bin++)
+    {
+      REQUIRE(histArray[feature * k_NumBins + bin] == expectedHistogram[bin]);
+    }
+    if(expected.empty())
+    {
+      numEmptyFeatures++;
+      REQUIRE(minArray[feature] == 0);
+      REQUIRE(maxArray[feature] == 0);
+      REQUIRE(meanArray[feature] == 0.0f);
+      continue;
+    }
+    REQUIRE(minArray[feature] == StaticicsCalculations::findMin(expected));
+    REQUIRE(maxArray[feature] == StaticicsCalculations::findMax(expected));
+    REQUIRE(IsClose(meanArray[feature], StaticicsCalculations::findMean(expected), 1.0e-4));
+  }
+  REQUIRE(numEmptyFeatures >= k_NumFeatures / 17 + 2);
+}
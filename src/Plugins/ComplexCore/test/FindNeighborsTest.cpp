@@ -2,15 +2,172 @@
 
 #include "ComplexCore/Filters/FindNeighbors.hpp"
 #include "complex/DataStructure/AttributeMatrix.hpp"
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
+#include "complex/DataStructure/NeighborList.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 
+#include <chrono>
+#include <map>
+#include <random>
+
 namespace fs = std::filesystem;
 
 using namespace complex;
 using namespace complex::Constants;
 
+namespace
+{
+const DataPath k_GeometryPath({"Image"});
+const DataPath k_CellDataPath = k_GeometryPath.createChildPath(ImageGeom::k_CellDataName);
+const DataPath k_CellFeatureDataPath = k_GeometryPath.createChildPath(k_CellFeatureData);
+const DataPath k_FeatureIdsPath = k_CellDataPath.createChildPath(k_FeatureIds);
+const std::string k_BoundaryCellsName = "BoundaryCells";
+const std::string k_SurfaceFeaturesName = "SurfaceFeatures";
+const std::string k_NumNeighborsName = "NumNeighbors";
+const std::string k_NeighborListName = "NeighborList";
+const std::string k_SharedSurfaceAreaListName = "SharedSurfaceAreaList";
+
+struct ExpectedNeighbors
+{
+  std::vector<int8> boundaryCells;
+  std::vector<bool> surfaceFeatures;
+  std::vector<std::map<int32, int32>> faceCounts;
+};
+
+// Features are boxes of blockDims cells with random ids, including unassigned (0) boxes
+DataStructure CreateFeatureMap(const SizeVec3& dims, const SizeVec3& blockDims, usize numFeatures)
+{
+  DataStructure dataStructure;
+  auto* imageGeom = ImageGeom::Create(dataStructure, k_GeometryPath.getTargetName());
+  imageGeom->setDimensions(dims);
+  imageGeom->setSpacing({0.5f, 0.25f, 2.0f});
+  const AttributeMatrix::ShapeType cellShape = {dims[2], dims[1], dims[0]};
+  auto* cellData = AttributeMatrix::Create(dataStructure, ImageGeom::k_CellDataName, imageGeom->getId());
+  cellData->setShape(cellShape);
+  imageGeom->setCellData(*cellData);
+  auto* featureData = AttributeMatrix::Create(dataStructure, k_CellFeatureData, imageGeom->getId());
+  featureData->setShape({numFeatures});
+
+  auto* featureIds = UnitTest::CreateTestDataArray<int32>(dataStructure, k_FeatureIds, cellShape, {1}, cellData->getId());
+  const SizeVec3 numBlocks = {(dims[0] + blockDims[0] - 1) / blockDims[0], (dims[1] + blockDims[1] - 1) / blockDims[1], (dims[2] + blockDims[2] - 1) / blockDims[2]};
+  std::vector<int32> blockFeatures(numBlocks[0] * numBlocks[1] * numBlocks[2]);
+  std::mt19937 generator(5489u);
+  std::uniform_int_distribution<int32> featureDistribution(0, static_cast<int32>(numFeatures - 1));
+  std::generate(blockFeatures.begin(), blockFeatures.end(), [&]() { return featureDistribution(generator); });
+  auto& featureIdsStore = featureIds->getDataStoreRef();
+  for(usize z = 0; z < dims[2]; z++)
+  {
+    for(usize y = 0; y < dims[1]; y++)
+    {
+      for(usize x = 0; x < dims[0]; x++)
+      {
+        const usize block = ((z / blockDims[2]) * numBlocks[1] + y / blockDims[1]) * numBlocks[0] + x / blockDims[0];
+        featureIdsStore.setValue((z * dims[1] + y) * dims[0] + x, blockFeatures[block]);
+      }
+    }
+  }
+  return dataStructure;
+}
+
+// Serial neighbor search with ordered maps, as the filter used to do it
+ExpectedNeighbors ReferenceFindNeighbors(const AbstractDataStore<int32>& featureIds, const SizeVec3& dims, usize numFeatures)
+{
+  ExpectedNeighbors expected;
+  expected.boundaryCells.resize(featureIds.getNumberOfTuples(), 0);
+  expected.surfaceFeatures.resize(numFeatures, false);
+  expected.faceCounts.resize(numFeatures);
+  const auto xDim = static_cast<int64>(dims[0]);
+  const auto yDim = static_cast<int64>(dims[1]);
+  const auto zDim = static_cast<int64>(dims[2]);
+  const std::array<int64, 6> offsets = {-xDim * yDim, -xDim, -1, 1, xDim, xDim * yDim};
+  for(int64 z = 0; z < zDim; z++)
+  {
+    for(int64 y = 0; y < yDim; y++)
+    {
+      for(int64 x = 0; x < xDim; x++)
+      {
+        const int64 cell = (z * yDim + y) * xDim + x;
+        const int32 feature = featureIds.getValue(cell);
+        if(feature <= 0)
+        {
+          continue;
+        }
+        const bool onEdge = x == 0 || x == xDim - 1 || y == 0 || y == yDim - 1;
+        if(onEdge || (zDim != 1 && (z == 0 || z == zDim - 1)))
+        {
+          expected.surfaceFeatures[feature] = true;
+        }
+        const std::array<bool, 6> valid = {z > 0, y > 0, x > 0, x < xDim - 1, y < yDim - 1, z < zDim - 1};
+        for(usize k = 0; k < 6; k++)
+        {
+          const int32 neighbor = valid[k] ? featureIds.getValue(cell + offsets[k]) : 0;
+          if(neighbor > 0 && neighbor != feature)
+          {
+            expected.boundaryCells[cell]++;
+            expected.faceCounts[feature][neighbor]++;
+          }
+        }
+      }
+    }
+  }
+  return expected;
+}
+
+void ExecuteFindNeighbors(DataStructure& dataStructure)
+{
+  FindNeighbors filter;
+  Arguments args;
+  args.insertOrAssign(FindNeighbors::k_ImageGeom_Key, std::make_any<DataPath>(k_GeometryPath));
+  args.insertOrAssign(FindNeighbors::k_FeatureIds_Key, std::make_any<DataPath>(k_FeatureIdsPath));
+  args.insertOrAssign(FindNeighbors::k_CellFeatures_Key, std::make_any<DataPath>(k_CellFeatureDataPath));
+  args.insertOrAssign(FindNeighbors::k_StoreBoundary_Key, std::make_any<bool>(true));
+  args.insertOrAssign(FindNeighbors::k_BoundaryCells_Key, std::make_any<std::string>(k_BoundaryCellsName));
+  args.insertOrAssign(FindNeighbors::k_StoreSurface_Key, std::make_any<bool>(true));
+  args.insertOrAssign(FindNeighbors::k_SurfaceFeatures_Key, std::make_any<std::string>(k_SurfaceFeaturesName));
+  args.insertOrAssign(FindNeighbors::k_NumNeighbors_Key, std::make_any<std::string>(k_NumNeighborsName));
+  args.insertOrAssign(FindNeighbors::k_NeighborList_Key, std::make_any<std::string>(k_NeighborListName));
+  args.insertOrAssign(FindNeighbors::k_SharedSurfaceArea_Key, std::make_any<std::string>(k_SharedSurfaceAreaListName));
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+}
+
+void RequireExpectedNeighbors(const DataStructure& dataStructure, const ExpectedNeighbors& expected)
+{
+  const auto& boundaryCells = dataStructure.getDataRefAs<Int8Array>(k_CellDataPath.createChildPath(k_BoundaryCellsName));
+  for(usize i = 0; i < expected.boundaryCells.size(); i++)
+  {
+    REQUIRE(boundaryCells[i] == expected.boundaryCells[i]);
+  }
+
+  const auto& surfaceFeatures = dataStructure.getDataRefAs<BoolArray>(k_CellFeatureDataPath.createChildPath(k_SurfaceFeaturesName));
+  const auto& numNeighbors = dataStructure.getDataRefAs<Int32Array>(k_CellFeatureDataPath.createChildPath(k_NumNeighborsName));
+  const auto& neighborList = dataStructure.getDataRefAs<Int32NeighborList>(k_CellFeatureDataPath.createChildPath(k_NeighborListName));
+  const auto& surfaceAreaList = dataStructure.getDataRefAs<Float32NeighborList>(k_CellFeatureDataPath.createChildPath(k_SharedSurfaceAreaListName));
+  const FloatVec3 spacing = dataStructure.getDataRefAs<ImageGeom>(k_GeometryPath).getSpacing();
+  for(usize feature = 1; feature < expected.faceCounts.size(); feature++)
+  {
+    REQUIRE(surfaceFeatures[feature] == expected.surfaceFeatures[feature]);
+    const auto& faceCounts = expected.faceCounts[feature];
+    REQUIRE(numNeighbors[feature] == faceCounts.size());
+    REQUIRE(neighborList.getListSize(feature) == faceCounts.size());
+    REQUIRE(surfaceAreaList.getListSize(feature) == faceCounts.size());
+    int32 index = 0;
+    for(const auto& [neighbor, count] : faceCounts)
+    {
+      bool ok = false;
+      REQUIRE(neighborList.getValue(feature, index, ok) == neighbor);
+      REQUIRE(surfaceAreaList.getValue(feature, index, ok) == static_cast<float32>(count) * spacing[0] * spacing[1]);
+      index++;
+    }
+  }
+}
+} // namespace
+
 TEST_CASE("ComplexCore::FindNeighbors", "[ComplexCore][FindNeighbors]")
 {
 
@@ -74,3 +231,47 @@ TEST_CASE("ComplexCore::FindNeighbors", "[ComplexCore][FindNeighbors]")
   // Write the DataStructure out to the file system
   UnitTest::WriteTestDataStructure(dataStructure, fs::path(fmt::format("{}/find_neighbors_test.dream3d", unit_test::k_BinaryTestOutputDir)));
 }
+
+TEST_CASE("ComplexCore::FindNeighbors: Synthetic Feature Map", "[ComplexCore][FindNeighbors]")
+{
+  // Several chunks of cells whose boundaries do not line up with the rows or planes
+  const SizeVec3 dims = {61, 47, 19};
+  const usize numFeatures = 40;
+  DataStructure dataStructure = CreateFeatureMap(dims, {5, 4, 3}, numFeatures);
+  const ExpectedNeighbors expected = ReferenceFindNeighbors(dataStructure.getDataRefAs<Int32Array>(k_FeatureIdsPath).getDataStoreRef(), dims, numFeatures);
+
+  ExecuteFindNeighbors(dataStructure);
+  RequireExpectedNeighbors(dataStructure, expected);
+}
+
+TEST_CASE("ComplexCore::FindNeighbors: Single Plane", "[ComplexCore][FindNeighbors]")
+{
+  const SizeVec3 dims = {130, 90, 1};
+  const usize numFeatures = 25;
+  DataStructure dataStructure = CreateFeatureMap(dims, {7, 6, 1}, numFeatures);
+  const ExpectedNeighbors expected = ReferenceFindNeighbors(dataStructure.getDataRefAs<Int32Array>(k_FeatureIdsPath).getDataStoreRef(), dims, numFeatures);
+
+  ExecuteFindNeighbors(dataStructure);
+  RequireExpectedNeighbors(dataStructure, expected);
+}
+
+// Run explicitly with: ComplexCoreUnitTest "[benchmark]"
+TEST_CASE("ComplexCore::FindNeighbors: 512^3 Benchmark", "[.][benchmark]")
+{
+  using Clock = std::chrono::steady_clock;
+
+  const SizeVec3 dims = {512, 512, 512};
+  const usize numFeatures = 200000;
+  DataStructure dataStructure = CreateFeatureMap(dims, {6, 8, 5}, numFeatures);
+
+  auto start = Clock::now();
+  const ExpectedNeighbors expected = ReferenceFindNeighbors(dataStructure.getDataRefAs<Int32Array>(k_FeatureIdsPath).getDataStoreRef(), dims, numFeatures);
+  const auto referenceTime = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+
+  start = Clock::now();
+  ExecuteFindNeighbors(dataStructure);
+  const auto filterTime = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+
+  std::cout << "FindNeighbors on " << dims[0] << "x" << dims[1] << "x" << dims[2] << " cells: serial map " << referenceTime << " ms, parallel face counts " << filterTime << " ms" << std::endl;
+  RequireExpectedNeighbors(dataStructure, expected);
+}
@@ -6,9 +6,12 @@
 #include "ComplexCore/Filters/CreateImageGeometry.hpp"
 #include "ComplexCore/Filters/FindSurfaceFeatures.hpp"
 #include "ComplexCore/Filters/RawBinaryReaderFilter.hpp"
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 #include "complex/Utilities/Parsing/DREAM3D/Dream3dIO.hpp"
 
+#include <random>
+
 using namespace complex;
 namespace fs = std::filesystem;
 
@@ -94,6 +97,37 @@ void test_impl(const std::vector<uint64>& geometryDims, const std::string& featu
     REQUIRE(static_cast<int8>(surfaceFeatures[i]) == surfaceFeaturesExemplary[i]);
   }
 }
+
+// Serial scan over the cells, as the filter used to do it
+std::vector<bool> ReferenceSurfaceFeatures(const SizeVec3& dims, const std::vector<int32>& featureIds, int32 maxFeature, bool markFeature0Neighbors)
+{
+  std::vector<bool> surfaceFeatures(maxFeature + 1, false);
+  const usize xyDim = dims[0] * dims[1];
+  for(usize index = 0; index < featureIds.size(); index++)
+  {
+    const int32 gnum = featureIds[index];
+    if(gnum == 0)
+    {
+      continue;
+    }
+    const usize x = index % dims[0];
+    const usize y = (index / dims[0]) % dims[1];
+    const usize z = index / xyDim;
+    if(x == 0 || x == dims[0] - 1 || y == 0 || y == dims[1] - 1 || z == 0 || z == dims[2] - 1)
+    {
+      surfaceFeatures[gnum] = true;
+      continue;
+    }
+    if(markFeature0Neighbors)
+    {
+      for(usize neighbor : {index - 1, index + 1, index - dims[0], index + dims[0], index - xyDim, index + xyDim})
+      {
+        surfaceFeatures[gnum] = surfaceFeatures[gnum] || featureIds[neighbor] == 0;
+      }
+    }
+  }
+  return surfaceFeatures;
+}
 } // namespace
 
 TEST_CASE("ComplexCore::FindSurfaceFeatures: Instantiation and Parameter Check", "[ComplexCore][FindSurfaceFeatures]")
@@ -177,3 +211,53 @@ TEST_CASE("ComplexCore::FindSurfaceFeatures: Valid filter execution in 2D - YZ P
 {
   test_impl(std::vector<uint64>({1, 100, 100}), k_FeatureIds2DFileName, 10000, k_SurfaceFeatures2DExemplaryFileName);
 }
+
+TEST_CASE("ComplexCore::FindSurfaceFeatures: Parallel Scan", "[ComplexCore][FindSurfaceFeatures]")
+{
+  const SizeVec3 dims = {61, 47, 33};
+  const usize totalPoints = dims[0] * dims[1] * dims[2];
+  constexpr int32 k_MaxFeature = 400;
+
+  // Features are boxes of 3x3x3 cells with random ids, including feature 0
+  std::mt19937 generator(5489u);
+  std::uniform_int_distribution<int32> featureDistribution(0, k_MaxFeature);
+  std::vector<int32> blockFeatures(21 * 16 * 11);
+  std::generate(blockFeatures.begin(), blockFeatures.end(), [&]() { return featureDistribution(generator); });
+  std::vector<int32> featureIdValues(totalPoints);
+  for(usize index = 0; index < totalPoints; index++)
+  {
+    const usize x = index % dims[0];
+    const usize y = (index / dims[0]) % dims[1];
+    const usize z = index / (dims[0] * dims[1]);
+    featureIdValues[index] = blockFeatures[((z / 3) * 16 + y / 3) * 21 + x / 3];
+  }
+  featureIdValues[totalPoints / 2] = k_MaxFeature;
+
+  for(bool markFeature0Neighbors : {false, true})
+  {
+    DataStructure ds;
+    auto* imageGeom = ImageGeom::Create(ds, k_FeatureGeometryPath.getTargetName());
+    imageGeom->setDimensions(dims);
+    auto* featureIds = UnitTest::CreateTestDataArray<int32>(ds, k_FeatureIDsPath.getTargetName(), {totalPoints}, {1});
+    std::copy(featureIdValues.cbegin(), featureIdValues.cend(), featureIds->begin());
+
+    FindSurfaceFeatures filter;
+    Arguments args;
+    args.insertOrAssign(FindSurfaceFeatures::k_MarkFeature0Neighbors, std::make_any<bool>(markFeature0Neighbors));
+    args.insertOrAssign(FindSurfaceFeatures::k_FeatureGeometryPath_Key, std::make_any<DataPath>(k_FeatureGeometryPath));
+    args.insertOrAssign(FindSurfaceFeatures::k_FeatureIdsArrayPath_Key, std::make_any<DataPath>(k_FeatureIDsPath));
+    args.insertOrAssign(FindSurfaceFeatures::k_SurfaceFeaturesArrayPath_Key, std::make_any<DataPath>(k_SurfaceFeaturesArrayPath));
+
+    auto executeResult = filter.execute(ds, args);
+    COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+    const std::vector<bool> expected = ReferenceSurfaceFeatures(dims, featureIdValues, k_MaxFeature, markFeature0Neighbors);
+    const auto& surfaceFeatures = ds.getDataRefAs<BoolArray>(k_SurfaceFeaturesArrayPath);
+    REQUIRE(surfaceFeatures.getNumberOfTuples() == expected.size());
+    REQUIRE(std::count(expected.cbegin(), expected.cend(), false) > 1);
+    for(usize i = 0; i < expected.size(); i++)
+    {
+      REQUIRE(surfaceFeatures[i] == expected[i]);
+    }
+  }
+}
@@ -4,8 +4,12 @@
 
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 
+#include "complex/DataStructure/BitDataStore.hpp"
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 
+#include <random>
+
 using namespace complex;
 
 TEST_CASE("ComplexCore::IdentifySample(Instantiate)", "[ComplexCore][IdentifySample]")
@@ -30,3 +34,171 @@ TEST_CASE("ComplexCore::IdentifySample(Instantiate)", "[ComplexCore][IdentifySam
   auto executeResult = filter.execute(dataGraph, args);
   REQUIRE(executeResult.result.valid());
 }
+
+namespace
+{
+const DataPath k_GeometryPath({"Image"});
+const DataPath k_MaskPath = k_GeometryPath.createChildPath("Mask");
+
+// Flood fills the components of cells equal to value in index order, as the filter used to do it
+std::vector<std::vector<usize>> ReferenceComponents(const SizeVec3& dims, const std::vector<bool>& good, bool value)
+{
+  const usize totalPoints = good.size();
+  std::vector<bool> checked(totalPoints, false);
+  std::vector<std::vector<usize>> components;
+  for(usize seed = 0; seed < totalPoints; seed++)
+  {
+    if(checked[seed] || good[seed] != value)
+    {
+      continue;
+    }
+    checked[seed] = true;
+    std::vector<usize> component = {seed};
+    for(usize count = 0; count < component.size(); count++)
+    {
+      const usize index = component[count];
+      const usize x = index % dims[0];
+      const usize y = (index / dims[0]) % dims[1];
+      const usize z = index / (dims[0] * dims[1]);
+      std::vector<usize> neighbors;
+      if(x > 0)
+      {
+        neighbors.push_back(index - 1);
+      }
+      if(x + 1 < dims[0])
+      {
+        neighbors.push_back(index + 1);
+      }
+      if(y > 0)
+      {
+        neighbors.push_back(index - dims[0]);
+      }
+      if(y + 1 < dims[1])
+      {
+        neighbors.push_back(index + dims[0]);
+      }
+      if(z > 0)
+      {
+        neighbors.push_back(index - dims[0] * dims[1]);
+      }
+      if(z + 1 < dims[2])
+      {
+        neighbors.push_back(index + dims[0] * dims[1]);
+      }
+      for(usize neighbor : neighbors)
+      {
+        if(!checked[neighbor] && good[neighbor] == value)
+        {
+          checked[neighbor] = true;
+          component.push_back(neighbor);
+        }
+      }
+    }
+    components.push_back(std::move(component));
+  }
+  return components;
+}
+
+std::vector<bool> ReferenceIdentifySample(const SizeVec3& dims, std::vector<bool> good, bool fillHoles)
+{
+  std::vector<std::vector<usize>> components = ReferenceComponents(dims, good, true);
+  usize sample = 0;
+  for(usize i = 0; i < components.size(); i++)
+  {
+    if(components[i].size() >= components[sample].size())
+    {
+      sample = i;
+    }
+  }
+  for(usize i = 0; i < components.size(); i++)
+  {
+    if(i == sample)
+    {
+      continue;
+    }
+    for(usize index : components[i])
+    {
+      good[index] = false;
+    }
+  }
+
+  if(fillHoles)
+  {
+    for(const auto& hole : ReferenceComponents(dims, good, false))
+    {
+      const bool touchesBoundary = std::any_of(hole.cbegin(), hole.cend(), [&dims](usize index) {
+        const usize x = index % dims[0];
+        const usize y = (index / dims[0]) % dims[1];
+        const usize z = index / (dims[0] * dims[1]);
+        return x == 0 || x == dims[0] - 1 || y == 0 || y == dims[1] - 1 || z == 0 || z == dims[2] - 1;
+      });
+      if(!touchesBoundary)
+      {
+        for(usize index : hole)
+        {
+          good[index] = true;
+        }
+      }
+    }
+  }
+  return good;
+}
+
+template <typename T>
+void TestLargestComponent(const SizeVec3& dims, bool packBits, bool fillHoles)
+{
+  const usize totalPoints = dims[0] * dims[1] * dims[2];
+  DataStructure dataStructure;
+  auto* imageGeom = ImageGeom::Create(dataStructure, k_GeometryPath.getTargetName());
+  imageGeom->setDimensions(dims);
+  DataArray<T>* maskArray = nullptr;
+  if constexpr(std::is_same_v<T, bool>)
+  {
+    if(packBits)
+    {
+      maskArray = BoolArray::Create(dataStructure, k_MaskPath.getTargetName(), std::make_shared<BitDataStore>(std::vector<usize>{totalPoints}, std::vector<usize>{1}, false), imageGeom->getId());
+    }
+  }
+  if(maskArray == nullptr)
+  {
+    maskArray = UnitTest::CreateTestDataArray<T>(dataStructure, k_MaskPath.getTargetName(), {totalPoints}, {1}, imageGeom->getId());
+  }
+
+  // Mostly good voxels with many small islands and holes
+  std::mt19937 generator(5489u);
+  std::bernoulli_distribution goodDistribution(0.6);
+  std::vector<bool> good(totalPoints);
+  for(usize i = 0; i < totalPoints; i++)
+  {
+    good[i] = goodDistribution(generator);
+    (*maskArray)[i] = static_cast<T>(good[i]);
+  }
+  const std::vector<bool> expected = ReferenceIdentifySample(dims, good, fillHoles);
+
+  IdentifySample filter;
+  Arguments args;
+  args.insert(IdentifySample::k_FillHoles_Key, std::make_any<bool>(fillHoles));
+  args.insert(IdentifySample::k_ImageGeom_Key, std::make_any<DataPath>(k_GeometryPath));
+  args.insert(IdentifySample::k_GoodVoxels_Key, std::make_any<DataPath>(k_MaskPath));
+
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  const auto& result = dataStructure.getDataRefAs<DataArray<T>>(k_MaskPath);
+  for(usize i = 0; i < totalPoints; i++)
+  {
+    REQUIRE(static_cast<bool>(result[i]) == expected[i]);
+  }
+}
+} // namespace
+
+TEST_CASE("ComplexCore::IdentifySample: Largest Component", "[ComplexCore][IdentifySample]")
+{
+  for(bool fillHoles : {false, true})
+  {
+    TestLargestComponent<bool>({37, 23, 19}, false, fillHoles);
+    TestLargestComponent<bool>({37, 23, 19}, true, fillHoles);
+    TestLargestComponent<uint8>({37, 23, 19}, false, fillHoles);
+    TestLargestComponent<uint8>({211, 173, 1}, false, fillHoles);
+  }
+}
@@ -363,3 +363,72 @@ TEST_CASE("ComplexCore::ImportCSVDataFilter (Case 4): Invalid filter execution -
   TestCase_TestPrimitives_Error<float32>(v, k_InvalidArgumentErrorCode);
   TestCase_TestPrimitives_Error<float64>(v, k_InvalidArgumentErrorCode);
 }
+
+TEST_CASE("ComplexCore::ImportCSVDataFilter (Case 5): Valid filter execution - Multiple chunks")
+{
+  // Create the parent directory path
+  fs::create_directories(k_TestInput.parent_path());
+
+  // Enough CRLF terminated lines that the file is parsed as several chunks
+  const usize numRows = 200000;
+  {
+    std::ofstream file(k_TestInput, std::ios_base::binary);
+    REQUIRE(file.is_open());
+    file << "Ids,Values\r\n";
+    for(usize i = 0; i < numRows; i++)
+    {
+      file << i << ", " << static_cast<float64>(i) * 0.5 << "\r\n";
+    }
+  }
+
+  std::string newGroupName = "New Group";
+  std::string dummyGroupName = "Dummy Group";
+
+  CSVWizardData data;
+  data.inputFilePath = k_TestInput.string();
+  data.dataHeaders = {"Ids", "Values"};
+  data.dataTypes = {DataType::int32, DataType::float64};
+  data.beginIndex = 2;
+  data.commaAsDelimiter = true;
+  data.delimiters = {','};
+  data.headerLine = 1;
+  data.numberOfLines = numRows + 1;
+
+  Arguments args;
+  args.insertOrAssign(ImportCSVDataFilter::k_WizardData_Key, std::make_any<CSVWizardData>(data));
+  args.insertOrAssign(ImportCSVDataFilter::k_TupleDims_Key, std::make_any<DynamicTableParameter::ValueType>(DynamicTableInfo::TableDataType{{{static_cast<float64>(numRows)}}}));
+  args.insertOrAssign(ImportCSVDataFilter::k_UseExistingGroup_Key, std::make_any<bool>(false));
+  args.insertOrAssign(ImportCSVDataFilter::k_CreatedDataGroup_Key, std::make_any<DataPath>(DataPath({newGroupName})));
+  args.insertOrAssign(ImportCSVDataFilter::k_SelectedDataGroup_Key, std::make_any<DataPath>(DataPath({dummyGroupName})));
+
+  ImportCSVDataFilter filter;
+  DataStructure dataStructure = createDataStructure(dummyGroupName);
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  const auto* ids = dataStructure.getDataAs<Int32Array>(DataPath({newGroupName, "Ids"}));
+  const auto* values = dataStructure.getDataAs<Float64Array>(DataPath({newGroupName, "Values"}));
+  REQUIRE(ids != nullptr);
+  REQUIRE(values != nullptr);
+  REQUIRE(ids->getSize() == numRows);
+  REQUIRE(values->getSize() == numRows);
+  for(usize i = 0; i < numRows; i++)
+  {
+    REQUIRE(ids->at(i) == static_cast<int32>(i));
+    REQUIRE(values->at(i) == static_cast<float64>(i) * 0.5);
+  }
+
+  // Asking for more lines than the file holds reports the first missing line
+  data.numberOfLines = numRows + 2;
+  args.insertOrAssign(ImportCSVDataFilter::k_WizardData_Key, std::make_any<CSVWizardData>(data));
+  args.insertOrAssign(ImportCSVDataFilter::k_TupleDims_Key, std::make_any<DynamicTableParameter::ValueType>(DynamicTableInfo::TableDataType{{{static_cast<float64>(numRows + 1)}}}));
+  DataStructure shortDataStructure = createDataStructure(dummyGroupName);
+  executeResult = filter.execute(shortDataStructure, args);
+  COMPLEX_RESULT_REQUIRE_INVALID(executeResult.result);
+  REQUIRE(executeResult.result.errors().size() == 1);
+  REQUIRE(executeResult.result.errors()[0].code == -104);
+}
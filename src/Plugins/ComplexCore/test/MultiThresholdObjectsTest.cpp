@@ -0,0 +1,120 @@
+#include <catch2/catch.hpp>
+
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataGroup.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/UnitTest/UnitTestCommon.hpp"
+#include "complex/Utilities/ArrayThreshold.hpp"
+#include "complex/Utilities/DataArrayUtilities.hpp"
+
+#include "ComplexCore/Filters/MultiThresholdObjects.hpp"
+
+using namespace complex;
+
+namespace
+{
+constexpr StringLiteral k_ArrayThresholds_Key = "array_thresholds";
+constexpr StringLiteral k_CreatedDataPath_Key = "created_data_path";
+
+// Spans several evaluation blocks and ends in a partial mask word
+constexpr usize k_NumTuples = 10007;
+
+const DataPath k_GroupPath({"Data"});
+const DataPath k_ArrayAPath = k_GroupPath.createChildPath("A");
+const DataPath k_ArrayBPath = k_GroupPath.createChildPath("B");
+const DataPath k_MaskPath = k_GroupPath.createChildPath("Mask");
+
+DataStructure CreateTestDataStructure()
+{
+  DataStructure dataStructure;
+  auto* group = DataGroup::Create(dataStructure, k_GroupPath.getTargetName());
+  auto* arrayA = UnitTest::CreateTestDataArray<int32>(dataStructure, k_ArrayAPath.getTargetName(), {k_NumTuples}, {1}, group->getId());
+  auto* arrayB = UnitTest::CreateTestDataArray<float32>(dataStructure, k_ArrayBPath.getTargetName(), {k_NumTuples}, {1}, group->getId());
+  for(usize i = 0; i < k_NumTuples; i++)
+  {
+    (*arrayA)[i] = static_cast<int32>(i);
+    (*arrayB)[i] = static_cast<float32>(i % 10);
+  }
+  return dataStructure;
+}
+
+std::shared_ptr<ArrayThreshold> CreateThreshold(const DataPath& path, ArrayThreshold::ComparisonType comparison, float64 value, IArrayThreshold::UnionOperator unionOperator)
+{
+  auto threshold = std::make_shared<ArrayThreshold>();
+  threshold->setArrayPath(path);
+  threshold->setComparisonType(comparison);
+  threshold->setComparisonValue(value);
+  threshold->setUnionOperator(unionOperator);
+  return threshold;
+}
+
+// A > 5000 and (B < 3 or B == 7)
+ArrayThresholdSet CreateThresholdSet()
+{
+  auto nestedSet = std::make_shared<ArrayThresholdSet>();
+  nestedSet->setUnionOperator(IArrayThreshold::UnionOperator::And);
+  nestedSet->setArrayThresholds({CreateThreshold(k_ArrayBPath, ArrayThreshold::ComparisonType::LessThan, 3.0, IArrayThreshold::UnionOperator::And),
+                                 CreateThreshold(k_ArrayBPath, ArrayThreshold::ComparisonType::Operator_Equal, 7.0, IArrayThreshold::UnionOperator::Or)});
+
+  ArrayThresholdSet thresholdSet;
+  thresholdSet.setArrayThresholds({CreateThreshold(k_ArrayAPath, ArrayThreshold::ComparisonType::GreaterThan, 5000.0, IArrayThreshold::UnionOperator::And), nestedSet});
+  return thresholdSet;
+}
+} // namespace
+
+TEST_CASE("ComplexCore::MultiThresholdObjects: Nested Threshold Sets", "[ComplexCore][MultiThresholdObjects]")
+{
+  MultiThresholdObjects filter;
+  DataStructure dataStructure = CreateTestDataStructure();
+  Arguments args;
+
+  ArrayThresholdSet thresholdSet = CreateThresholdSet();
+  args.insertOrAssign(k_ArrayThresholds_Key, std::make_any<ArrayThresholdSet>(thresholdSet));
+  args.insertOrAssign(k_CreatedDataPath_Key, std::make_any<DataPath>(k_MaskPath));
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  const auto& mask = dataStructure.getDataRefAs<BoolArray>(k_MaskPath);
+  REQUIRE(dynamic_cast<const DataStore<bool>*>(mask.getDataStore()) != nullptr);
+  for(usize i = 0; i < k_NumTuples; i++)
+  {
+    const usize b = i % 10;
+    const bool expected = i > 5000 && (b < 3 || b == 7);
+    REQUIRE(mask[i] == expected);
+  }
+}
+
+TEST_CASE("ComplexCore::MultiThresholdObjects: Inverted Thresholds", "[ComplexCore][MultiThresholdObjects]")
+{
+  MultiThresholdObjects filter;
+  DataStructure dataStructure = CreateTestDataStructure();
+  Arguments args;
+
+  // Inverting the set inverts each of its members before they are combined
+  ArrayThresholdSet thresholdSet = CreateThresholdSet();
+  thresholdSet.setInverted(true);
+  args.insertOrAssign(k_ArrayThresholds_Key, std::make_any<ArrayThresholdSet>(thresholdSet));
+  args.insertOrAssign(k_CreatedDataPath_Key, std::make_any<DataPath>(k_MaskPath));
+
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  const auto& mask = dataStructure.getDataRefAs<BoolArray>(k_MaskPath);
+  std::unique_ptr<MaskCompare> maskCompare = InstantiateMaskCompare(dataStructure, k_MaskPath);
+  usize numTrue = 0;
+  for(usize i = 0; i < k_NumTuples; i++)
+  {
+    const usize b = i % 10;
+    const bool expected = i <= 5000 && !(b < 3 || b == 7);
+    REQUIRE(mask[i] == expected);
+    REQUIRE(maskCompare->isTrue(i) == expected);
+    numTrue += expected ? 1 : 0;
+  }
+
+  // The unused bits of the last word must not be set by the inversion
+  REQUIRE(static_cast<usize>(std::count(mask.begin(), mask.end(), true)) == numTrue);
+}
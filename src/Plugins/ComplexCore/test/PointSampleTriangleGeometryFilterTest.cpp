@@ -1,5 +1,6 @@
 #include <catch2/catch.hpp>
 
+#include "complex/DataStructure/AttributeMatrix.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/DataStructure/Geometry/VertexGeom.hpp"
@@ -227,3 +228,77 @@ TEST_CASE("ComplexCore::PointSampleTriangleGeometryFilter", "[DREAM3DReview][Poi
     REQUIRE(minMaxVerts[5] <= 3.7f);
   }
 }
+
+TEST_CASE("ComplexCore::PointSampleTriangleGeometryFilter: Transfer Face Data", "[ComplexCore][PointSampleTriangleGeometryFilter]")
+{
+  constexpr usize k_NumTriangles = 6;
+  constexpr int32 k_NumSamples = 1000;
+  const DataPath triangleGeometryPath({"Triangles"});
+  const DataPath faceDataPath = triangleGeometryPath.createChildPath(INodeGeometry2D::k_FaceDataName);
+  const DataPath areasPath = faceDataPath.createChildPath("Areas");
+  const DataPath faceIdsPath = faceDataPath.createChildPath("Face Ids");
+  const DataPath vertexGeometryPath({"Samples"});
+  const std::string vertexDataName = "Vertex Data";
+
+  // Unit right triangles side by side along x, each with its own vertices
+  DataStructure dataStructure;
+  auto* triangleGeom = TriangleGeom::Create(dataStructure, triangleGeometryPath.getTargetName());
+  auto* faceData = AttributeMatrix::Create(dataStructure, INodeGeometry2D::k_FaceDataName, triangleGeom->getId());
+  faceData->setShape({k_NumTriangles});
+  triangleGeom->setFaceData(*faceData);
+  auto* vertices = UnitTest::CreateTestDataArray<float32>(dataStructure, "Vertices", {k_NumTriangles * 3}, {3}, triangleGeom->getId());
+  auto* faces = UnitTest::CreateTestDataArray<IGeometry::MeshIndexType>(dataStructure, "Faces", {k_NumTriangles}, {3}, triangleGeom->getId());
+  auto* areas = UnitTest::CreateTestDataArray<float64>(dataStructure, areasPath.getTargetName(), {k_NumTriangles}, {1}, faceData->getId());
+  auto* faceIds = UnitTest::CreateTestDataArray<int32>(dataStructure, faceIdsPath.getTargetName(), {k_NumTriangles}, {2}, faceData->getId());
+  for(usize t = 0; t < k_NumTriangles; t++)
+  {
+    const auto x = static_cast<float32>(2 * t);
+    const std::array<float32, 9> coords = {x, 0.0f, 0.0f, x + 1.0f, 0.0f, 0.0f, x, 1.0f, 0.0f};
+    for(usize i = 0; i < coords.size(); i++)
+    {
+      (*vertices)[t * 9 + i] = coords[i];
+    }
+    for(usize i = 0; i < 3; i++)
+    {
+      (*faces)[t * 3 + i] = t * 3 + i;
+    }
+    (*areas)[t] = 0.5;
+    (*faceIds)[t * 2] = static_cast<int32>(t);
+    (*faceIds)[t * 2 + 1] = static_cast<int32>(100 + t);
+  }
+  triangleGeom->setVertices(*vertices);
+  triangleGeom->setFaces(*faces);
+
+  PointSampleTriangleGeometryFilter filter;
+  Arguments args;
+  args.insertOrAssign(PointSampleTriangleGeometryFilter::k_NumberOfSamples_Key, std::make_any<int32>(k_NumSamples));
+  args.insertOrAssign(PointSampleTriangleGeometryFilter::k_UseMask_Key, std::make_any<bool>(false));
+  args.insertOrAssign(PointSampleTriangleGeometryFilter::k_TriangleGeometry_Key, std::make_any<DataPath>(triangleGeometryPath));
+  args.insertOrAssign(PointSampleTriangleGeometryFilter::k_TriangleAreasArrayPath_Key, std::make_any<DataPath>(areasPath));
+  args.insertOrAssign(PointSampleTriangleGeometryFilter::k_MaskArrayPath_Key, std::make_any<DataPath>(DataPath{}));
+  args.insertOrAssign(PointSampleTriangleGeometryFilter::k_SelectedDataArrayPaths_Key, std::make_any<MultiArraySelectionParameter::ValueType>(MultiArraySelectionParameter::ValueType{faceIdsPath}));
+  args.insertOrAssign(PointSampleTriangleGeometryFilter::k_VertexGeometryPath_Key, std::make_any<DataPath>(vertexGeometryPath));
+  args.insertOrAssign(PointSampleTriangleGeometryFilter::k_VertexDataGroupPath_Key, std::make_any<std::string>(vertexDataName));
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  // Every sample carries both components of the face it was drawn from
+  const auto& vertexGeom = dataStructure.getDataRefAs<VertexGeom>(vertexGeometryPath);
+  const IGeometry::SharedVertexList& samples = *vertexGeom.getVertices();
+  const auto& sampleIds = dataStructure.getDataRefAs<Int32Array>(vertexGeometryPath.createChildPath(vertexDataName).createChildPath(faceIdsPath.getTargetName()));
+  REQUIRE(sampleIds.getNumberOfTuples() == k_NumSamples);
+  REQUIRE(sampleIds.getNumberOfComponents() == 2);
+  for(usize v = 0; v < k_NumSamples; v++)
+  {
+    const int32 triangle = sampleIds[v * 2];
+    REQUIRE(triangle >= 0);
+    REQUIRE(triangle < static_cast<int32>(k_NumTriangles));
+    REQUIRE(sampleIds[v * 2 + 1] == 100 + triangle);
+    REQUIRE(samples[v * 3] >= static_cast<float32>(2 * triangle) - 1.0e-4f);
+    REQUIRE(samples[v * 3] <= static_cast<float32>(2 * triangle + 1) + 1.0e-4f);
+  }
+}
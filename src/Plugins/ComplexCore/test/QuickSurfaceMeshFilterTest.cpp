@@ -1,5 +1,7 @@
 #include <catch2/catch.hpp>
 
+#include "complex/DataStructure/AttributeMatrix.hpp"
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/Parameters/ArrayCreationParameter.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
@@ -11,10 +13,133 @@
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 #include "ComplexCore/Filters/QuickSurfaceMeshFilter.hpp"
 
+#include <random>
+#include <set>
+
 using namespace complex;
 using namespace complex::UnitTest;
 using namespace complex::Constants;
 
+namespace
+{
+struct ReferenceMesh
+{
+  std::vector<float32> vertices;
+  std::vector<IGeometry::MeshIndexType> triangles;
+  std::vector<int32> faceLabels;
+  std::vector<int8> nodeTypes;
+  std::vector<float32> faceValues;
+};
+
+// Serial mesher with a node id for every grid node, as the filter used to do it
+ReferenceMesh ReferenceQuickSurfaceMesh(const ImageGeom& imageGeom, const std::vector<int32>& featureIds, const std::vector<float32>& cellValues)
+{
+  using MeshIndexType = IGeometry::MeshIndexType;
+  const SizeVec3 dims = imageGeom.getDimensions();
+  const usize xP = dims[0];
+  const usize yP = dims[1];
+  const usize zP = dims[2];
+  std::vector<MeshIndexType> nodeIds((xP + 1) * (yP + 1) * (zP + 1), std::numeric_limits<MeshIndexType>::max());
+  std::vector<std::set<int32>> ownerLists;
+  ReferenceMesh mesh;
+
+  // Corner offsets of the four nodes of each face and the two triangle windings
+  using Corners = std::array<std::array<usize, 3>, 4>;
+  const std::array<std::array<usize, 3>, 2> forward = {{{0, 1, 2}, {1, 3, 2}}};
+  const std::array<std::array<usize, 3>, 2> reverse = {{{0, 2, 1}, {1, 2, 3}}};
+  const auto addFace = [&](usize i, usize j, usize k, const Corners& corners, const std::array<std::array<usize, 3>, 2>& winding, int32 label0, int32 label1, usize sourceCell) {
+    std::array<MeshIndexType, 4> ids = {};
+    for(usize n = 0; n < 4; n++)
+    {
+      const usize x = i + corners[n][0];
+      const usize y = j + corners[n][1];
+      const usize z = k + corners[n][2];
+      MeshIndexType& nodeId = nodeIds[(z * (yP + 1) + y) * (xP + 1) + x];
+      if(nodeId == std::numeric_limits<MeshIndexType>::max())
+      {
+        nodeId = ownerLists.size();
+        ownerLists.emplace_back();
+        Point3D<float32> coords = imageGeom.getPlaneCoordsf(x, y, z);
+        mesh.vertices.insert(mesh.vertices.end(), {coords[0], coords[1], coords[2]});
+      }
+      ids[n] = nodeId;
+      ownerLists[nodeId].insert(label0);
+      ownerLists[nodeId].insert(label1);
+    }
+    for(const auto& triangle : winding)
+    {
+      mesh.triangles.insert(mesh.triangles.end(), {ids[triangle[0]], ids[triangle[1]], ids[triangle[2]]});
+      mesh.faceLabels.insert(mesh.faceLabels.end(), {label0, label1});
+      mesh.faceValues.push_back(cellValues[sourceCell]);
+    }
+  };
+  const Corners xMin = {{{0, 0, 0}, {0, 1, 0}, {0, 0, 1}, {0, 1, 1}}};
+  const Corners yMin = {{{0, 0, 0}, {1, 0, 0}, {0, 0, 1}, {1, 0, 1}}};
+  const Corners zMin = {{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}}};
+  const Corners xMax = {{{1, 0, 0}, {1, 1, 0}, {1, 0, 1}, {1, 1, 1}}};
+  const Corners yMax = {{{1, 1, 0}, {0, 1, 0}, {1, 1, 1}, {0, 1, 1}}};
+  const Corners zMax = {{{1, 0, 1}, {0, 0, 1}, {1, 1, 1}, {0, 1, 1}}};
+
+  for(usize k = 0; k < zP; k++)
+  {
+    for(usize j = 0; j < yP; j++)
+    {
+      for(usize i = 0; i < xP; i++)
+      {
+        const usize point = (k * yP + j) * xP + i;
+        const int32 feature = featureIds[point];
+        if(i == 0)
+        {
+          addFace(i, j, k, xMin, reverse, -1, feature, point);
+        }
+        if(j == 0)
+        {
+          addFace(i, j, k, yMin, forward, -1, feature, point);
+        }
+        if(k == 0)
+        {
+          addFace(i, j, k, zMin, reverse, -1, feature, point);
+        }
+        if(i == xP - 1)
+        {
+          addFace(i, j, k, xMax, forward, -1, feature, point);
+        }
+        else if(feature != featureIds[point + 1])
+        {
+          const int32 neighbor = featureIds[point + 1];
+          feature < neighbor ? addFace(i, j, k, xMax, reverse, feature, neighbor, point + 1) : addFace(i, j, k, xMax, forward, neighbor, feature, point + 1);
+        }
+        if(j == yP - 1)
+        {
+          addFace(i, j, k, yMax, forward, -1, feature, point);
+        }
+        else if(feature != featureIds[point + xP])
+        {
+          const int32 neighbor = featureIds[point + xP];
+          feature < neighbor ? addFace(i, j, k, yMax, forward, feature, neighbor, point + xP) : addFace(i, j, k, yMax, reverse, neighbor, feature, point + xP);
+        }
+        if(k == zP - 1)
+        {
+          addFace(i, j, k, zMax, reverse, -1, feature, point);
+        }
+        else if(feature != featureIds[point + xP * yP])
+        {
+          const int32 neighbor = featureIds[point + xP * yP];
+          feature < neighbor ? addFace(i, j, k, zMax, reverse, feature, neighbor, point + xP * yP) : addFace(i, j, k, zMax, forward, neighbor, feature, point + xP * yP);
+        }
+      }
+    }
+  }
+
+  for(const auto& owners : ownerLists)
+  {
+    auto nodeType = static_cast<int8>(std::min<usize>(owners.size(), 4));
+    mesh.nodeTypes.push_back(owners.count(-1) != 0 ? nodeType + 10 : nodeType);
+  }
+  return mesh;
+}
+} // namespace
+
 TEST_CASE("ComplexCore::QuickSurfaceMeshFilter", "[ComplexCore][QuickSurfaceMeshFilter]")
 {
   // Read the Small IN100 Data set
@@ -104,3 +229,112 @@ TEST_CASE("ComplexCore::QuickSurfaceMeshFilter", "[ComplexCore][QuickSurfaceMesh
     REQUIRE(err >= 0);
   }
 }
+
+TEST_CASE("ComplexCore::QuickSurfaceMeshFilter: Slab Meshing", "[ComplexCore][QuickSurfaceMeshFilter]")
+{
+  const SizeVec3 dims = {13, 11, 37};
+  const usize numCells = dims[0] * dims[1] * dims[2];
+  const DataPath geometryPath({"Image"});
+  const DataPath cellDataPath = geometryPath.createChildPath(ImageGeom::k_CellDataName);
+  const DataPath featureIdsPath = cellDataPath.createChildPath(k_FeatureIds);
+  const DataPath valuesPath = cellDataPath.createChildPath("Values");
+  const DataPath vectorsPath = cellDataPath.createChildPath("Vectors");
+  const DataPath triangleGeometryPath({k_TriangleGeometryName});
+  const DataPath vertexGroupDataPath = triangleGeometryPath.createChildPath(k_VertexDataGroupName);
+  const DataPath faceGroupDataPath = triangleGeometryPath.createChildPath(k_FaceDataGroupName);
+  const DataPath nodeTypesPath = vertexGroupDataPath.createChildPath(k_NodeTypeArrayName);
+  const DataPath faceLabelsPath = faceGroupDataPath.createChildPath(k_FaceLabels);
+
+  DataStructure dataStructure;
+  auto* imageGeom = ImageGeom::Create(dataStructure, geometryPath.getTargetName());
+  imageGeom->setDimensions(dims);
+  imageGeom->setSpacing({0.5f, 0.25f, 2.0f});
+  imageGeom->setOrigin({-3.0f, 1.0f, 7.0f});
+  const AttributeMatrix::ShapeType cellShape = {dims[2], dims[1], dims[0]};
+  auto* cellData = AttributeMatrix::Create(dataStructure, ImageGeom::k_CellDataName, imageGeom->getId());
+  cellData->setShape(cellShape);
+  imageGeom->setCellData(*cellData);
+  auto* featureIdsArray = UnitTest::CreateTestDataArray<int32>(dataStructure, k_FeatureIds, cellShape, {1}, cellData->getId());
+  auto* valuesArray = UnitTest::CreateTestDataArray<float32>(dataStructure, "Values", cellShape, {1}, cellData->getId());
+  auto* vectorsArray = UnitTest::CreateTestDataArray<int32>(dataStructure, "Vectors", cellShape, {3}, cellData->getId());
+
+  // Boxes of 2x3x2 cells with random features, so nodes are shared by up to four features
+  std::mt19937 generator(5489u);
+  std::uniform_int_distribution<int32> featureDistribution(1, 9);
+  std::vector<int32> blockFeatures(7 * 4 * 19);
+  std::generate(blockFeatures.begin(), blockFeatures.end(), [&]() { return featureDistribution(generator); });
+  std::vector<int32> featureIds(numCells);
+  std::vector<float32> values(numCells);
+  for(usize index = 0; index < numCells; index++)
+  {
+    const usize x = index % dims[0];
+    const usize y = (index / dims[0]) % dims[1];
+    const usize z = index / (dims[0] * dims[1]);
+    featureIds[index] = blockFeatures[((z / 2) * 4 + y / 3) * 7 + x / 2];
+    values[index] = static_cast<float32>(index);
+    (*featureIdsArray)[index] = featureIds[index];
+    (*valuesArray)[index] = values[index];
+    for(usize component = 0; component < 3; component++)
+    {
+      (*vectorsArray)[index * 3 + component] = static_cast<int32>(index * 3 + component);
+    }
+  }
+  const ReferenceMesh expected = ReferenceQuickSurfaceMesh(*imageGeom, featureIds, values);
+
+  QuickSurfaceMeshFilter filter;
+  Arguments args;
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_GenerateTripleLines_Key, std::make_any<bool>(false));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_FixProblemVoxels_Key, std::make_any<bool>(false));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_GridGeometryDataPath_Key, std::make_any<DataPath>(geometryPath));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_FeatureIdsArrayPath_Key, std::make_any<DataPath>(featureIdsPath));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_SelectedDataArrayPaths_Key, std::make_any<MultiArraySelectionParameter::ValueType>(MultiArraySelectionParameter::ValueType{valuesPath, vectorsPath}));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_TriangleGeometryName_Key, std::make_any<DataPath>(triangleGeometryPath));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_VertexDataGroupName_Key, std::make_any<std::string>(k_VertexDataGroupName));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_NodeTypesArrayName_Key, std::make_any<DataPath>(nodeTypesPath));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_FaceDataGroupName_Key, std::make_any<std::string>(k_FaceDataGroupName));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_FaceLabelsArrayName_Key, std::make_any<DataPath>(faceLabelsPath));
+
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  const auto& triangleGeom = dataStructure.getDataRefAs<TriangleGeom>(triangleGeometryPath);
+  const IGeometry::SharedVertexList& vertices = *triangleGeom.getVertices();
+  const IGeometry::SharedTriList& triangles = *triangleGeom.getFaces();
+  const auto& faceLabels = dataStructure.getDataRefAs<Int32Array>(faceLabelsPath);
+  const auto& nodeTypes = dataStructure.getDataRefAs<Int8Array>(nodeTypesPath);
+  const auto& faceValues = dataStructure.getDataRefAs<Float32Array>(faceGroupDataPath.createChildPath("Values"));
+  const auto& faceVectors = dataStructure.getDataRefAs<Int32Array>(faceGroupDataPath.createChildPath("Vectors"));
+
+  REQUIRE(vertices.getSize() == expected.vertices.size());
+  REQUIRE(triangles.getSize() == expected.triangles.size());
+  REQUIRE(faceLabels.getSize() == expected.faceLabels.size());
+  REQUIRE(nodeTypes.getSize() == expected.nodeTypes.size());
+  REQUIRE(faceValues.getNumberOfTuples() == expected.faceValues.size());
+  REQUIRE(std::count(expected.nodeTypes.cbegin(), expected.nodeTypes.cend(), 4) > 0);
+  for(usize i = 0; i < expected.vertices.size(); i++)
+  {
+    REQUIRE(vertices[i] == expected.vertices[i]);
+  }
+  for(usize i = 0; i < expected.triangles.size(); i++)
+  {
+    REQUIRE(triangles[i] == expected.triangles[i]);
+  }
+  for(usize i = 0; i < expected.faceLabels.size(); i++)
+  {
+    REQUIRE(faceLabels[i] == expected.faceLabels[i]);
+  }
+  for(usize i = 0; i < expected.nodeTypes.size(); i++)
+  {
+    REQUIRE(nodeTypes[i] == expected.nodeTypes[i]);
+  }
+  for(usize i = 0; i < expected.faceValues.size(); i++)
+  {
+    REQUIRE(faceValues[i] == expected.faceValues[i]);
+    // The cell values are the cell indices, so each face copies every component of that cell
+    const auto sourceCell = static_cast<int32>(expected.faceValues[i]);
+    for(usize component = 0; component < 3; component++)
+    {
+      REQUIRE(faceVectors[i * 3 + component] == sourceCell * 3 + static_cast<int32>(component));
+    }
+  }
+}
@@ -9,6 +9,8 @@
  *  Case4: This tests when skipHeaderBytes is non-zero, and checks to see if the data read is the same as the data written.
  *
  *  Case5: This tests when skipHeaderBytes equals the file size
+ *
+ *  Case6: This tests reading data of the opposite endianness with a header that leaves the values unaligned.
  */
 
 /** we are going to use a fairly large array size because we want to exercise the
@@ -20,6 +22,7 @@
 
 #include "ComplexCore/Filters/RawBinaryReaderFilter.hpp"
 
+#include "complex/Common/Bit.hpp"
 #include "complex/Common/ScopeGuard.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStore.hpp"
@@ -50,7 +53,7 @@ constexpr int32 k_RbrWrongType = -393;
 constexpr int32 k_RbrSkippedTooMuch = -395;
 
 // -----------------------------------------------------------------------------
-Arguments CreateFilterArguments(NumericType scalarType, usize N, usize file_size, usize skipBytes)
+Arguments CreateFilterArguments(NumericType scalarType, usize N, usize file_size, usize skipBytes, endian dataEndian = endian::little)
 {
   Arguments args;
 
@@ -60,7 +63,7 @@ Arguments CreateFilterArguments(NumericType scalarType, usize N, usize file_size
   args.insertOrAssign(RawBinaryReaderFilter::k_TupleDims_Key, std::make_any<DynamicTableParameter::ValueType>(DynamicTableParameter::ValueType{{static_cast<float64>(file_size)}}));
 
   args.insertOrAssign(RawBinaryReaderFilter::k_NumberOfComponents_Key, std::make_any<uint64>(N));
-  args.insertOrAssign(RawBinaryReaderFilter::k_Endian_Key, std::make_any<ChoicesParameter::ValueType>(static_cast<uint64>(endian::little)));
+  args.insertOrAssign(RawBinaryReaderFilter::k_Endian_Key, std::make_any<ChoicesParameter::ValueType>(static_cast<uint64>(dataEndian)));
   args.insertOrAssign(RawBinaryReaderFilter::k_SkipHeaderBytes_Key, std::make_any<uint64>(skipBytes));
   args.insertOrAssign(RawBinaryReaderFilter::k_CreatedAttributeArrayPath_Key, k_CreatedArrayPath);
 
@@ -312,6 +315,58 @@ void TestCase5_TestPrimitives(NumericType scalarType)
   TestCase5_Execute<T, 3>(scalarType);
 }
 
+// -----------------------------------------------------------------------------
+// Case6: This tests reading data of the opposite endianness with a header that leaves the values unaligned.
+template <class T>
+void TestCase6_Execute(NumericType scalarType)
+{
+  constexpr usize tupleCount = 1000000;
+  constexpr usize skipHeaderBytes = 3;
+  constexpr endian k_OtherEndian = endian::native == endian::little ? endian::big : endian::little;
+
+  std::vector<T> exemplaryData(tupleCount);
+  std::iota(exemplaryData.begin(), exemplaryData.end(), static_cast<T>(0));
+
+  // Create scope guard to remove test file after this test goes out of scope
+  auto fileGuard = MakeScopeGuard([]() noexcept { fs::remove(k_TestOutput); });
+
+  {
+    std::ofstream file(k_TestOutput, std::ios::binary);
+    REQUIRE(file.is_open());
+    const std::array<char, skipHeaderBytes> header = {'R', 'A', 'W'};
+    file.write(header.data(), header.size());
+    for(T value : exemplaryData)
+    {
+      const T swappedValue = complex::byteswap(value);
+      file.write(reinterpret_cast<const char*>(&swappedValue), sizeof(T));
+    }
+  }
+
+  RawBinaryReaderFilter filter;
+  Arguments args = CreateFilterArguments(scalarType, 1, tupleCount, skipHeaderBytes, k_OtherEndian);
+
+  DataStructure ds;
+
+  auto preflightResult = filter.preflight(ds, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+
+  auto executeResult = filter.execute(ds, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  const DataArray<T>& createdData = ds.getDataRefAs<DataArray<T>>(k_CreatedArrayPath);
+  const DataStore<T>& store = createdData.template getIDataStoreRefAs<DataStore<T>>();
+  bool isSame = true;
+  for(usize i = 0; i < tupleCount; ++i)
+  {
+    if(store[i] != exemplaryData[i])
+    {
+      isSame = false;
+      break;
+    }
+  }
+  REQUIRE(isSame);
+}
+
 // -----------------------------------------------------------------------------
 template <class T>
 void TestCase4_TestPrimitives(NumericType scalarType)
@@ -393,3 +448,19 @@ TEST_CASE("ComplexCore::RawBinaryReaderFilter(Case5)", "[ComplexCore][RawBinaryR
   TestCase5_TestPrimitives<float32>(NumericType::float32);
   TestCase5_TestPrimitives<float64>(NumericType::float64);
 }
+
+// Case6: This tests reading data of the opposite endianness with a header that leaves the values unaligned.
+TEST_CASE("ComplexCore::RawBinaryReaderFilter(Case6)", "[ComplexCore][RawBinaryReaderFilter]")
+{
+  // Create the parent directory path
+  fs::create_directories(k_TestOutput.parent_path());
+
+  TestCase6_Execute<int16>(NumericType::int16);
+  TestCase6_Execute<uint16>(NumericType::uint16);
+  TestCase6_Execute<int32>(NumericType::int32);
+  TestCase6_Execute<uint32>(NumericType::uint32);
+  TestCase6_Execute<int64>(NumericType::int64);
+  TestCase6_Execute<uint64>(NumericType::uint64);
+  TestCase6_Execute<float32>(NumericType::float32);
+  TestCase6_Execute<float64>(NumericType::float64);
+}
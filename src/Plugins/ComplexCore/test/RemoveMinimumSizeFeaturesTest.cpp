@@ -1,14 +1,18 @@
 #include <catch2/catch.hpp>
 
 #include "complex/Core/Application.hpp"
+#include "complex/DataStructure/BitDataStore.hpp"
 #include "complex/Parameters/ArraySelectionParameter.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Parameters/Dream3dImportParameter.hpp"
 #include "complex/Parameters/GeometrySelectionParameter.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
+#include "complex/Utilities/FeatureCleanup.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5FileReader.hpp"
 
 #include <filesystem>
+#include <map>
+#include <random>
 namespace fs = std::filesystem;
 
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
@@ -16,6 +20,65 @@ namespace fs = std::filesystem;
 
 using namespace complex;
 
+namespace
+{
+// The serial sweep the filters used before FeatureCleanup::AssignBadPoints, kept as a reference
+void ReferenceAssignBadPoints(const SizeVec3& dims, std::vector<int32>& featureIds, std::vector<float32>& values, usize numComponents)
+{
+  const int64 xDim = dims[0];
+  const int64 yDim = dims[1];
+  const int64 zDim = dims[2];
+  const std::array<int64, 6> neighborOffsets = {-xDim * yDim, -xDim, -1, 1, xDim, xDim * yDim};
+  std::vector<int64> neighbors(featureIds.size(), -1);
+  std::map<int32, int32> votes;
+  bool assigned = true;
+  while(assigned)
+  {
+    assigned = false;
+    for(int64 z = 0; z < zDim; z++)
+    {
+      for(int64 y = 0; y < yDim; y++)
+      {
+        for(int64 x = 0; x < xDim; x++)
+        {
+          const int64 cell = (z * yDim + y) * xDim + x;
+          if(featureIds[cell] >= 0)
+          {
+            continue;
+          }
+          const std::array<bool, 6> valid = {z > 0, y > 0, x > 0, x < xDim - 1, y < yDim - 1, z < zDim - 1};
+          int32 most = 0;
+          votes.clear();
+          for(usize l = 0; l < 6; l++)
+          {
+            if(valid[l] && featureIds[cell + neighborOffsets[l]] >= 0)
+            {
+              int32 current = ++votes[featureIds[cell + neighborOffsets[l]]];
+              if(current > most)
+              {
+                most = current;
+                neighbors[cell] = cell + neighborOffsets[l];
+              }
+            }
+          }
+        }
+      }
+    }
+    std::vector<int32> previousIds = featureIds;
+    for(usize cell = 0; cell < featureIds.size(); cell++)
+    {
+      const int64 neighbor = neighbors[cell];
+      if(previousIds[cell] < 0 && neighbor >= 0 && previousIds[neighbor] >= 0)
+      {
+        featureIds[cell] = previousIds[neighbor];
+        std::copy_n(values.begin() + neighbor * numComponents, numComponents, values.begin() + cell * numComponents);
+        assigned = true;
+      }
+    }
+  }
+}
+} // namespace
+
 TEST_CASE("ComplexCore::RemoveMinimumSizeFeatures: Small IN100 Pipeline", "[ComplexCore][RemoveMinimumSizeFeatures]")
 {
   // Read Exemplar DREAM3D File Filter
@@ -153,3 +216,52 @@ TEST_CASE("ComplexCore::RemoveMinimumSizeFeatures: Small IN100 Pipeline", "[Comp
 
   UnitTest::WriteTestDataStructure(dataStructure, fmt::format("{}/7_0_min_size_output.dream3d", unit_test::k_BinaryTestOutputDir));
 }
+
+TEST_CASE("ComplexCore::RemoveMinimumSizeFeatures: Assign Bad Points", "[ComplexCore][RemoveMinimumSizeFeatures]")
+{
+  const SizeVec3 dims = {23, 17, 9};
+  const usize totalPoints = dims[0] * dims[1] * dims[2];
+  constexpr usize k_NumComponents = 3;
+
+  DataStructure dataStructure;
+  auto* featureIdsArray = UnitTest::CreateTestDataArray<int32>(dataStructure, "FeatureIds", {totalPoints}, {1});
+  auto* valuesArray = UnitTest::CreateTestDataArray<float32>(dataStructure, "Values", {totalPoints}, {k_NumComponents});
+  auto* maskArray = BoolArray::Create(dataStructure, "Mask", std::make_shared<BitDataStore>(std::vector<usize>{totalPoints}, std::vector<usize>{1}, false));
+
+  // Sparse features with large unassigned regions so that several passes are needed
+  std::mt19937 generator(5489u);
+  std::uniform_int_distribution<int32> featureDistribution(-12, 5);
+  std::vector<int32> expectedIds(totalPoints);
+  std::vector<float32> expectedValues(totalPoints * k_NumComponents);
+  for(usize i = 0; i < totalPoints; i++)
+  {
+    const int32 featureId = std::max(featureDistribution(generator), -1);
+    expectedIds[i] = featureId;
+    (*featureIdsArray)[i] = featureId;
+    (*maskArray)[i] = featureId % 2 == 0;
+    for(usize c = 0; c < k_NumComponents; c++)
+    {
+      expectedValues[i * k_NumComponents + c] = static_cast<float32>(i * k_NumComponents + c);
+      (*valuesArray)[i * k_NumComponents + c] = expectedValues[i * k_NumComponents + c];
+    }
+  }
+  REQUIRE(std::count(expectedIds.cbegin(), expectedIds.cend(), -1) > totalPoints / 2);
+
+  // Each cell's source is remembered through the values, so the mask can be checked against them
+  ReferenceAssignBadPoints(dims, expectedIds, expectedValues, k_NumComponents);
+  REQUIRE(FeatureCleanup::AssignBadPoints(dims, *featureIdsArray, {valuesArray, maskArray}, false) == 0);
+
+  for(usize i = 0; i < totalPoints; i++)
+  {
+    REQUIRE((*featureIdsArray)[i] == expectedIds[i]);
+    for(usize c = 0; c < k_NumComponents; c++)
+    {
+      REQUIRE((*valuesArray)[i * k_NumComponents + c] == expectedValues[i * k_NumComponents + c]);
+    }
+    REQUIRE((*maskArray)[i] == (expectedIds[i] % 2 == 0));
+  }
+
+  // Cells that are not connected to any feature are left unassigned
+  featureIdsArray->fill(-1);
+  REQUIRE(FeatureCleanup::AssignBadPoints(dims, *featureIdsArray, {}, false) == totalPoints);
+}
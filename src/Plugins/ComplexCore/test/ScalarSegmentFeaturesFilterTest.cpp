@@ -1,6 +1,7 @@
 
 #include <catch2/catch.hpp>
 
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
 #include "complex/Parameters/ArrayCreationParameter.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
@@ -11,6 +12,11 @@
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 #include "ComplexCore/Filters/ScalarSegmentFeaturesFilter.hpp"
 
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
 using namespace complex;
 using namespace complex::UnitTest;
 using namespace complex::Constants;
@@ -77,3 +83,90 @@ TEST_CASE("ComplexCore::ScalarSegmentFeatures", "[Reconstruction][ScalarSegmentF
     REQUIRE(err >= 0);
   }
 }
+
+TEST_CASE("ComplexCore::ScalarSegmentFeatures: Matches Serial Flood Fill", "[Reconstruction][ScalarSegmentFeatures]")
+{
+  const SizeVec3 imageDims = {13, 11, 9};
+  const std::vector<usize> tupleDims = {imageDims[2], imageDims[1], imageDims[0]};
+  const usize totalPoints = imageDims[0] * imageDims[1] * imageDims[2];
+  const int32 tolerance = 1;
+
+  DataStructure dataStructure;
+  ImageGeom* imageGeom = ImageGeom::Create(dataStructure, "ImageGeom");
+  imageGeom->setDimensions(imageDims);
+  auto* inputArray = Int32Array::CreateWithStore<Int32DataStore>(dataStructure, "Input", tupleDims, {1}, imageGeom->getId());
+  auto* maskArray = BoolArray::CreateWithStore<BoolDataStore>(dataStructure, "Mask", tupleDims, {1}, imageGeom->getId());
+
+  std::mt19937 generator(5489U);
+  std::uniform_int_distribution<int32> valueDistribution(0, 6);
+  for(usize i = 0; i < totalPoints; i++)
+  {
+    (*inputArray)[i] = valueDistribution(generator);
+    (*maskArray)[i] = (generator() % 8) != 0;
+  }
+
+  // Reference result from a serial flood fill that seeds in index order
+  std::vector<int32> expectedFeatureIds(totalPoints, 0);
+  int32 numExpectedFeatures = 0;
+  const int64 xDim = imageDims[0];
+  const int64 yDim = imageDims[1];
+  const int64 zDim = imageDims[2];
+  for(usize seed = 0; seed < totalPoints; seed++)
+  {
+    if(!(*maskArray)[seed] || expectedFeatureIds[seed] != 0)
+    {
+      continue;
+    }
+    numExpectedFeatures++;
+    expectedFeatureIds[seed] = numExpectedFeatures;
+    std::vector<int64> stack = {static_cast<int64>(seed)};
+    while(!stack.empty())
+    {
+      int64 current = stack.back();
+      stack.pop_back();
+      const int64 col = current % xDim;
+      const int64 row = (current / xDim) % yDim;
+      const int64 plane = current / (xDim * yDim);
+      const std::array<std::pair<bool, int64>, 6> neighbors = {{{plane > 0, current - xDim * yDim},
+                                                                {row > 0, current - xDim},
+                                                                {col > 0, current - 1},
+                                                                {col < xDim - 1, current + 1},
+                                                                {row < yDim - 1, current + xDim},
+                                                                {plane < zDim - 1, current + xDim * yDim}}};
+      for(const auto& [valid, neighbor] : neighbors)
+      {
+        if(valid && (*maskArray)[neighbor] && expectedFeatureIds[neighbor] == 0 && std::abs((*inputArray)[neighbor] - (*inputArray)[current]) <= tolerance)
+        {
+          expectedFeatureIds[neighbor] = numExpectedFeatures;
+          stack.push_back(neighbor);
+        }
+      }
+    }
+  }
+
+  Arguments args;
+  ScalarSegmentFeaturesFilter filter;
+  const DataPath geomPath({"ImageGeom"});
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_GridGeomPath_Key, std::make_any<DataPath>(geomPath));
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_UseGoodVoxelsKey, std::make_any<bool>(true));
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_GoodVoxelsPath_Key, std::make_any<DataPath>(geomPath.createChildPath("Mask")));
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_InputArrayPathKey, std::make_any<DataPath>(geomPath.createChildPath("Input")));
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_ScalarToleranceKey, std::make_any<int>(tolerance));
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_FeatureIdsPathKey, std::make_any<std::string>("FeatureIds"));
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_CellFeaturePathKey, std::make_any<std::string>("CellFeatureData"));
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_ActiveArrayPathKey, std::make_any<std::string>(k_ActiveName));
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_RandomizeFeatures_Key, std::make_any<bool>(false));
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions)
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result)
+
+  const auto& featureIds = dataStructure.getDataRefAs<Int32Array>(geomPath.createChildPath("FeatureIds"));
+  for(usize i = 0; i < totalPoints; i++)
+  {
+    REQUIRE(featureIds[i] == expectedFeatureIds[i]);
+  }
+  const auto& actives = dataStructure.getDataRefAs<UInt8Array>(geomPath.createChildPath("CellFeatureData").createChildPath(k_ActiveName));
+  REQUIRE(actives.getNumberOfTuples() == static_cast<usize>(numExpectedFeatures + 1));
+}
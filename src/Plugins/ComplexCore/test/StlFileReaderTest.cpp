@@ -9,8 +9,11 @@
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 #include "ComplexCore/Filters/StlFileReaderFilter.hpp"
 
+#include <array>
 #include <filesystem>
+#include <fstream>
 #include <string>
+#include <vector>
 namespace fs = std::filesystem;
 
 using namespace complex;
@@ -49,3 +52,121 @@ TEST_CASE("ComplexCore::StlFileReaderFilter", "[ComplexCore][StlFileReaderFilter
   herr_t err = dataGraph.writeHdf5(fileWriter);
   REQUIRE(err >= 0);
 }
+
+TEST_CASE("ComplexCore::StlFileReaderFilter: ASCII", "[ComplexCore][StlFileReaderFilter]")
+{
+  DataStructure dataGraph;
+  Arguments args;
+  StlFileReaderFilter filter;
+
+  DataPath triangleGeomDataPath({"[Triangle Geometry]"});
+
+  // A tetrahedron whose 4 corners are each shared by 3 facets
+  const std::string inputFile = fmt::format("{}/StlFileReaderTest_ascii.stl", unit_test::k_BinaryDir);
+  {
+    std::ofstream outputFile(inputFile, std::ios_base::binary);
+    outputFile << "solid tetrahedron\n"
+                  "  facet normal 0 0 -1\n    outer loop\n      vertex 0 0 0\n      vertex 0 1 0\n      vertex 1 0 0\n    endloop\n  endfacet\n"
+                  "  facet normal 0 -1 0\n    outer loop\n      vertex 0 0 0\n      vertex 1 0 0\n      vertex 0 0 1\n    endloop\n  endfacet\n"
+                  "  facet normal -1 0 0\n    outer loop\n      vertex 0 0 0\n      vertex 0 0 1\n      vertex 0 1 0\n    endloop\n  endfacet\n"
+                  "  facet normal 0.577350 0.577350 0.577350\n    outer loop\n      vertex 1.0e+0 0 0\n      vertex 0 1 0\n      vertex 0 0 1\n    endloop\n  endfacet\n"
+                  "endsolid tetrahedron\n";
+  }
+
+  args.insertOrAssign(StlFileReaderFilter::k_StlFilePath_Key, std::make_any<FileSystemPathParameter::ValueType>(fs::path(inputFile)));
+  args.insertOrAssign(StlFileReaderFilter::k_GeometryDataPath_Key, std::make_any<DataPath>(triangleGeomDataPath));
+
+  auto preflightResult = filter.preflight(dataGraph, args);
+  REQUIRE(preflightResult.outputActions.valid());
+
+  auto executeResult = filter.execute(dataGraph, args);
+  REQUIRE(executeResult.result.valid());
+
+  TriangleGeom& triangleGeom = dataGraph.getDataRefAs<TriangleGeom>(triangleGeomDataPath);
+  REQUIRE(triangleGeom.getNumberOfFaces() == 4);
+  REQUIRE(triangleGeom.getNumberOfVertices() == 4);
+
+  // Nodes are numbered in the order they first appear
+  const auto& faces = triangleGeom.getFaces()->getDataStoreRef();
+  const std::vector<IGeometry::MeshIndexType> expectedFaces = {0, 1, 2, 0, 2, 3, 0, 3, 1, 2, 1, 3};
+  for(usize i = 0; i < expectedFaces.size(); i++)
+  {
+    REQUIRE(faces[i] == expectedFaces[i]);
+  }
+  const auto& vertices = triangleGeom.getVertices()->getDataStoreRef();
+  REQUIRE(vertices[9] == 0.0F);
+  REQUIRE(vertices[10] == 0.0F);
+  REQUIRE(vertices[11] == 1.0F);
+}
+
+TEST_CASE("ComplexCore::StlFileReaderFilter: Duplicate Nodes", "[ComplexCore][StlFileReaderFilter]")
+{
+  DataStructure dataGraph;
+  Arguments args;
+  StlFileReaderFilter filter;
+
+  DataPath triangleGeomDataPath({"[Triangle Geometry]"});
+
+  // A grid of quads split into two triangles each, so every interior corner is shared by 6 facets.
+  // Every other facet writes the corners on the y axis with x = -0, which must be welded to x = 0.
+  // One extra facet has a corner at x = 1e-30, which is close to 0 but must stay a separate node.
+  constexpr usize k_GridSize = 40;
+  const auto xCoord = [](usize x, bool negativeZero) { return x == 0 && negativeZero ? std::string("-0") : std::to_string(x); };
+  const std::string inputFile = fmt::format("{}/StlFileReaderTest_duplicates.stl", unit_test::k_BinaryDir);
+  std::vector<std::array<float32, 3>> expectedCorners;
+  {
+    std::ofstream outputFile(inputFile, std::ios_base::binary);
+    outputFile << "solid grid\n";
+    const auto writeFacet = [&](const std::array<std::array<usize, 2>, 3>& corners, bool negativeZero) {
+      outputFile << "  facet normal 0 0 1\n    outer loop\n";
+      for(const auto& corner : corners)
+      {
+        outputFile << "      vertex " << xCoord(corner[0], negativeZero) << " " << corner[1] << " 0\n";
+        expectedCorners.push_back({static_cast<float32>(corner[0]), static_cast<float32>(corner[1]), 0.0F});
+      }
+      outputFile << "    endloop\n  endfacet\n";
+    };
+    for(usize y = 0; y < k_GridSize; y++)
+    {
+      for(usize x = 0; x < k_GridSize; x++)
+      {
+        writeFacet({{{x, y}, {x + 1, y}, {x + 1, y + 1}}}, (x + y) % 2 == 0);
+        writeFacet({{{x, y}, {x + 1, y + 1}, {x, y + 1}}}, (x + y) % 2 == 1);
+      }
+    }
+    outputFile << "  facet normal 0 0 1\n    outer loop\n      vertex 1.0e-30 0 0\n      vertex 1 0 0\n      vertex 0 1 0\n    endloop\n  endfacet\n";
+    expectedCorners.push_back({1.0e-30F, 0.0F, 0.0F});
+    expectedCorners.push_back({1.0F, 0.0F, 0.0F});
+    expectedCorners.push_back({0.0F, 1.0F, 0.0F});
+    outputFile << "endsolid grid\n";
+  }
+
+  args.insertOrAssign(StlFileReaderFilter::k_StlFilePath_Key, std::make_any<FileSystemPathParameter::ValueType>(fs::path(inputFile)));
+  args.insertOrAssign(StlFileReaderFilter::k_GeometryDataPath_Key, std::make_any<DataPath>(triangleGeomDataPath));
+
+  auto preflightResult = filter.preflight(dataGraph, args);
+  REQUIRE(preflightResult.outputActions.valid());
+
+  auto executeResult = filter.execute(dataGraph, args);
+  REQUIRE(executeResult.result.valid());
+
+  TriangleGeom& triangleGeom = dataGraph.getDataRefAs<TriangleGeom>(triangleGeomDataPath);
+  REQUIRE(triangleGeom.getNumberOfFaces() == 2 * k_GridSize * k_GridSize + 1);
+  REQUIRE(triangleGeom.getNumberOfVertices() == (k_GridSize + 1) * (k_GridSize + 1) + 1);
+
+  // Every corner still has its coordinates and every node is used by the first corner that refers to it
+  const auto& faces = triangleGeom.getFaces()->getDataStoreRef();
+  const auto& vertices = triangleGeom.getVertices()->getDataStoreRef();
+  IGeometry::MeshIndexType nextNode = 0;
+  for(usize corner = 0; corner < expectedCorners.size(); corner++)
+  {
+    const IGeometry::MeshIndexType node = faces[corner];
+    REQUIRE(node <= nextNode);
+    nextNode = std::max(nextNode, node + 1);
+    for(usize k = 0; k < 3; k++)
+    {
+      REQUIRE(vertices[node * 3 + k] == expectedCorners[corner][k]);
+    }
+  }
+  REQUIRE(nextNode == triangleGeom.getNumberOfVertices());
+}
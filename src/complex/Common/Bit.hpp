@@ -40,6 +40,42 @@ inline constexpr uint64 byteswap64(uint64 value) noexcept
           ((value & 0x00000000FF000000ull) << 8) | ((value & 0x0000000000FF0000ull) << 24) | ((value & 0x000000000000FF00ull) << 40) | ((value & 0x00000000000000FFull) << 56));
 }
 
+/**
+ * @brief Returns the number of set bits in value.
+ * @param value
+ * @return usize
+ */
+inline constexpr usize popcount64(uint64 value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<usize>(__builtin_popcountll(value));
+#else
+  value = value - ((value >> 1) & 0x5555555555555555ull);
+  value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+  value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+  return static_cast<usize>((value * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+/**
+ * @brief Returns the number of consecutive zero bits starting from the least
+ * significant bit. Returns 64 if value is 0.
+ * @param value
+ * @return usize
+ */
+inline constexpr usize countr_zero64(uint64 value) noexcept
+{
+  if(value == 0)
+  {
+    return 64;
+  }
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<usize>(__builtin_ctzll(value));
+#else
+  return popcount64((value & (~value + 1)) - 1);
+#endif
+}
+
 template <class T, endian Endianness = endian::native, usize Size = sizeof(T)>
 inline constexpr T bit_cast_int(const std::byte* data) noexcept
 {
@@ -53,6 +53,15 @@ enum class DataType : uint8
   boolean
 };
 
+/**
+ * @brief How the memory of a new in memory DataStore is initialized.
+ */
+enum class AllocationPolicy : uint8
+{
+  Zeroed = 0,       // Every value is set to 0 by a parallel first touch fill
+  Uninitialized = 1 // Values are left uninitialized because the creator overwrites all of them
+};
+
 enum class RunState
 {
   Idle = 0,
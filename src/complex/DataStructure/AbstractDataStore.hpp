@@ -3,20 +3,20 @@
 #include "complex/DataStructure/DataObject.hpp"
 #include "complex/DataStructure/IDataStore.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DatasetWriter.hpp"
 
 #include <nonstd/span.hpp>
 
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
 
 namespace complex
 {
-namespace H5
-{
-class DatasetWriter;
-} // namespace H5
-
 /**
  * @class AbstractDataStore
  * @brief The AbstractDataStore class serves as an interface class for the
@@ -34,6 +34,13 @@ public:
   using const_reference = const T&;
   using ShapeType = typename IDataStore::ShapeType;
   using index_type = uint64;
+  using ChunkVisitor = std::function<void(usize, nonstd::span<T>)>;
+  using ConstChunkVisitor = std::function<void(usize, nonstd::span<const T>)>;
+
+  /**
+   * @brief The maximum number of values staged per call by the default visitChunks() implementations.
+   */
+  static constexpr usize k_VisitChunkSize = 65536;
 
   /////////////////////////////////
   // Begin std::iterator support //
@@ -378,6 +385,97 @@ public:
    */
   virtual reference operator[](usize index) = 0;
 
+  /**
+   * @brief Copies buffer.size() values starting at startIndex into the provided buffer.
+   * The default implementation copies one value at a time. Subclasses that can
+   * provide contiguous access should override this with a block copy.
+   *
+   * If the requested range extends past the end of the DataStore, this method throws a runtime_error.
+   * @param startIndex
+   * @param buffer
+   * @throw std::runtime_error
+   */
+  virtual void copyIntoBuffer(usize startIndex, nonstd::span<T> buffer) const
+  {
+    checkRange(startIndex, buffer.size());
+    for(usize i = 0; i < buffer.size(); i++)
+    {
+      buffer[i] = getValue(startIndex + i);
+    }
+  }
+
+  /**
+   * @brief Copies all values from the provided buffer into the DataStore starting at startIndex.
+   * The default implementation copies one value at a time. Subclasses that can
+   * provide contiguous access should override this with a block copy.
+   *
+   * If the requested range extends past the end of the DataStore, this method throws a runtime_error.
+   * @param startIndex
+   * @param buffer
+   * @throw std::runtime_error
+   */
+  virtual void copyFromBuffer(usize startIndex, nonstd::span<const T> buffer)
+  {
+    checkRange(startIndex, buffer.size());
+    for(usize i = 0; i < buffer.size(); i++)
+    {
+      setValue(startIndex + i, buffer[i]);
+    }
+  }
+
+  /**
+   * @brief Calls the visitor with contiguous, writable spans that together cover
+   * count values starting at startIndex. The first argument passed to the visitor
+   * is the DataStore index of the first value in the span.
+   *
+   * The default implementation stages the values through a temporary buffer of
+   * at most k_VisitChunkSize values and writes them back after each call.
+   * Subclasses with contiguous storage should override this to expose their memory directly.
+   * @param startIndex
+   * @param count
+   * @param visitor
+   * @throw std::runtime_error
+   */
+  virtual void visitChunks(usize startIndex, usize count, const ChunkVisitor& visitor)
+  {
+    checkRange(startIndex, count);
+    const usize bufferSize = std::min(count, k_VisitChunkSize);
+    auto buffer = std::make_unique<T[]>(bufferSize);
+    for(usize offset = 0; offset < count; offset += bufferSize)
+    {
+      nonstd::span<T> values(buffer.get(), std::min(bufferSize, count - offset));
+      copyIntoBuffer(startIndex + offset, values);
+      visitor(startIndex + offset, values);
+      copyFromBuffer(startIndex + offset, values);
+    }
+  }
+
+  /**
+   * @brief Calls the visitor with contiguous, read-only spans that together cover
+   * count values starting at startIndex. The first argument passed to the visitor
+   * is the DataStore index of the first value in the span.
+   *
+   * The default implementation stages the values through a temporary buffer of
+   * at most k_VisitChunkSize values. Subclasses with contiguous storage should
+   * override this to expose their memory directly.
+   * @param startIndex
+   * @param count
+   * @param visitor
+   * @throw std::runtime_error
+   */
+  virtual void visitConstChunks(usize startIndex, usize count, const ConstChunkVisitor& visitor) const
+  {
+    checkRange(startIndex, count);
+    const usize bufferSize = std::min(count, k_VisitChunkSize);
+    auto buffer = std::make_unique<T[]>(bufferSize);
+    for(usize offset = 0; offset < count; offset += bufferSize)
+    {
+      nonstd::span<T> values(buffer.get(), std::min(bufferSize, count - offset));
+      copyIntoBuffer(startIndex + offset, values);
+      visitor(startIndex + offset, nonstd::span<const T>(values.data(), values.size()));
+    }
+  }
+
   /**
    * @brief Returns an Iterator to the begining of the DataStore.
    * @return Iterator
@@ -438,7 +536,7 @@ public:
    */
   virtual void fill(value_type value)
   {
-    std::fill(begin(), end(), value);
+    visitChunks(0, getSize(), [value](usize, nonstd::span<T> values) { std::fill(values.begin(), values.end(), value); });
   }
 
   /**
@@ -497,10 +595,32 @@ public:
       return false;
     }
 
-    auto srcBegin = source.begin() + (srcTupleOffset * sourceNumComponents);
-    auto srcEnd = srcBegin + (totalSrcTuples * sourceNumComponents);
-    auto dstBegin = begin() + (destTupleOffset * numComponents);
-    std::copy(srcBegin, srcEnd, dstBegin);
+    if((srcTupleOffset + totalSrcTuples) * sourceNumComponents > source.getSize())
+    {
+      return false;
+    }
+
+    const usize srcBegin = srcTupleOffset * sourceNumComponents;
+    const usize dstBegin = destTupleOffset * numComponents;
+    const usize count = totalSrcTuples * sourceNumComponents;
+    if(&source == this && dstBegin > srcBegin && dstBegin < srcBegin + count)
+    {
+      // Copy the blocks back to front so that no value is overwritten before it has been read
+      const usize bufferSize = std::min(count, k_VisitChunkSize);
+      auto buffer = std::make_unique<T[]>(bufferSize);
+      usize remaining = count;
+      while(remaining > 0)
+      {
+        const usize blockSize = std::min(bufferSize, remaining);
+        remaining -= blockSize;
+        nonstd::span<T> values(buffer.get(), blockSize);
+        copyIntoBuffer(srcBegin + remaining, values);
+        copyFromBuffer(dstBegin + remaining, values);
+      }
+      return true;
+    }
+    source.visitConstChunks(srcBegin, count,
+                            [this, srcBegin, dstBegin](usize index, nonstd::span<const T> values) { copyFromBuffer(dstBegin + (index - srcBegin), values); });
     return true;
   }
 
@@ -512,7 +632,7 @@ public:
   void fillTuple(index_type i, T value)
   {
     usize numComponents = getNumberOfComponents();
-    std::fill_n(begin() + (i * numComponents), numComponents, value);
+    visitChunks(i * numComponents, numComponents, [value](usize, nonstd::span<T> values) { std::fill(values.begin(), values.end(), value); });
   }
 
   /**
@@ -561,7 +681,7 @@ public:
 
     index_type numComponents = getNumberOfComponents();
     index_type offset = tupleIndex * numComponents;
-    std::copy(values.begin(), values.end(), begin() + offset);
+    copyFromBuffer(offset, values);
   }
 
   /**
@@ -623,6 +743,92 @@ protected:
   AbstractDataStore()
   {
   }
+
+  /**
+   * @brief Throws a runtime_error if count values starting at startIndex do not fit in the DataStore.
+   * @param startIndex
+   * @param count
+   * @throw std::runtime_error
+   */
+  void checkRange(usize startIndex, usize count) const
+  {
+    if(startIndex + count > getSize() || startIndex + count < startIndex)
+    {
+      throw std::runtime_error(fmt::format("Range [{}, {}) is outside of the DataStore with size ({})", startIndex, startIndex + count, getSize()));
+    }
+  }
+
+  /**
+   * @brief Creates the dataset with the given dimensions and writes the values
+   * into it as hyperslabs of at most blockSize values, staged through
+   * copyIntoBuffer(). This lets stores that do not keep their values as a
+   * contiguous T array be written without materializing the whole array.
+   * Returns the HDF5 error code should one be encountered. Otherwise, returns 0.
+   * @param datasetWriter
+   * @param h5dims
+   * @param blockSize
+   * @return H5::ErrorType
+   */
+  H5::ErrorType writeHdf5InBlocks(H5::DatasetWriter& datasetWriter, const std::vector<hsize_t>& h5dims, usize blockSize) const
+  {
+    herr_t err = datasetWriter.createEmptyDataset<T>(h5dims);
+    if(err < 0)
+    {
+      return err;
+    }
+
+    if(this->getSize() > 0)
+    {
+      // Find the slowest axis whose trailing block still fits in a chunk. Every
+      // run of rows along that axis is then a contiguous range of values that
+      // can be written as a single hyperslab.
+      const usize rank = h5dims.size();
+      std::vector<usize> trailingSize(rank, 1);
+      for(usize i = rank - 1; i > 0; i--)
+      {
+        trailingSize[i - 1] = trailingSize[i] * h5dims[i];
+      }
+      usize axis = 0;
+      while(trailingSize[axis] > blockSize && axis < rank - 1)
+      {
+        axis++;
+      }
+      const usize rowsPerBlock = std::max(blockSize / trailingSize[axis], static_cast<usize>(1));
+      const usize numOuter = std::accumulate(h5dims.cbegin(), h5dims.cbegin() + axis, static_cast<usize>(1), std::multiplies<>());
+
+      auto buffer = std::make_unique<T[]>(rowsPerBlock * trailingSize[axis]);
+      std::vector<hsize_t> start(rank, 0);
+      std::vector<hsize_t> count(h5dims);
+      std::fill(count.begin(), count.begin() + axis, 1);
+      for(usize outer = 0; outer < numOuter; outer++)
+      {
+        usize remainder = outer;
+        for(usize i = axis; i > 0; i--)
+        {
+          start[i - 1] = remainder % h5dims[i - 1];
+          remainder /= h5dims[i - 1];
+        }
+        for(usize row = 0; row < h5dims[axis]; row += rowsPerBlock)
+        {
+          const usize numRows = std::min(rowsPerBlock, static_cast<usize>(h5dims[axis]) - row);
+          const usize numValues = numRows * trailingSize[axis];
+          const usize offset = (outer * h5dims[axis] + row) * trailingSize[axis];
+          start[axis] = row;
+          count[axis] = numRows;
+          nonstd::span<T> values(buffer.get(), numValues);
+          this->copyIntoBuffer(offset, values);
+          err = datasetWriter.writeHyperslab<T>(start, count, nonstd::span<const T>(values.data(), values.size()));
+          if(err < 0)
+          {
+            return err;
+          }
+        }
+      }
+    }
+
+
+    return err;
+  }
 };
 
 template <typename Iter>
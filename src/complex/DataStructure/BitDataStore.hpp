@@ -0,0 +1,750 @@
+#pragma once
+
+#include "complex/Common/Bit.hpp"
+#include "complex/DataStructure/AbstractDataStore.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DatasetWriter.hpp"
+
+#include <fmt/core.h>
+
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace complex
+{
+/**
+ * @class BitDataStore
+ * @brief The BitDataStore class stores boolean values packed into 64-bit words,
+ * using one eighth of the memory of a DataStore<bool>. It is meant for masks and
+ * threshold results, which can then be combined a whole word at a time through
+ * andWith(), orWith(), xorWith() and flip(), counted with countTrue() and scanned
+ * with findNextTrue().
+ *
+ * Since individual bits cannot be referenced, the mutable operator[] unpacks the
+ * surrounding block of values into one of k_NumWindows small bool buffers and
+ * returns a reference into it. Such a reference is invalidated once the window
+ * is flushed back into the words: when k_NumWindows other blocks have been
+ * accessed through operator[], or by reshapeTuples(), copyFromBuffer(), words(),
+ * fill() and the word-wise bulk operations. Callers should not hold on to them.
+ * getValue(), setValue() and the const accessors work on the bits directly. The
+ * const methods only read the windows, so any number of threads may read the
+ * store at the same time.
+ *
+ * The windows are shared by all threads without synchronization, so operator[],
+ * the mutable iterators and visitChunks() must not be used from several threads
+ * at once. Keep this store out of ParallelDataAlgorithm writers. Like
+ * std::vector<bool>, values that share a word cannot be set from different
+ * threads at the same time, so parallel code may only call setValue() on ranges
+ * that are multiples of k_BitsPerWord values and must not open windows.
+ */
+class BitDataStore final : public AbstractDataStore<bool>
+{
+public:
+  using value_type = typename AbstractDataStore<bool>::value_type;
+  using reference = typename AbstractDataStore<bool>::reference;
+  using const_reference = typename AbstractDataStore<bool>::const_reference;
+  using ShapeType = typename IDataStore::ShapeType;
+  using WordType = uint64;
+
+  static constexpr usize k_BitsPerWord = 64;
+  static constexpr usize k_WindowSize = 4096;
+  static constexpr usize k_NumWindows = 8;
+  static constexpr usize k_NotFound = std::numeric_limits<usize>::max();
+
+  /**
+   * @brief Constructs a BitDataStore with a single tuple dimension of numTuples
+   * and a single component dimension of {1}.
+   * @param numTuples
+   * @param initValue
+   */
+  BitDataStore(usize numTuples, std::optional<bool> initValue = false)
+  : BitDataStore({numTuples}, {1}, initValue)
+  {
+  }
+
+  /**
+   * @brief Constructs a BitDataStore with the specified tuple and component shapes.
+   * @param tupleShape The dimensions of the tuples
+   * @param componentShape The dimensions of the component at each tuple
+   * @param initValue Values are false when not provided
+   */
+  BitDataStore(const ShapeType& tupleShape, const ShapeType& componentShape, std::optional<bool> initValue = false)
+  : m_ComponentShape(componentShape)
+  , m_TupleShape(tupleShape)
+  , m_NumComponents(std::accumulate(m_ComponentShape.cbegin(), m_ComponentShape.cend(), static_cast<usize>(1), std::multiplies<>()))
+  , m_NumTuples(std::accumulate(m_TupleShape.cbegin(), m_TupleShape.cend(), static_cast<usize>(1), std::multiplies<>()))
+  {
+    m_NumWords = GetNumberOfWords(this->getSize());
+    m_Words = std::make_unique<WordType[]>(m_NumWords);
+    fill(initValue.value_or(false));
+  }
+
+  /**
+   * @brief Copy constructor. Values still held in the other store's windows are
+   * copied from the windows, which are left open.
+   * @param other
+   */
+  BitDataStore(const BitDataStore& other)
+  : m_ComponentShape(other.m_ComponentShape)
+  , m_TupleShape(other.m_TupleShape)
+  , m_NumComponents(other.m_NumComponents)
+  , m_NumTuples(other.m_NumTuples)
+  , m_NumWords(other.m_NumWords)
+  {
+    m_Words = std::make_unique<WordType[]>(m_NumWords);
+    for(usize i = 0; i < m_NumWords; i++)
+    {
+      m_Words[i] = other.getWord(i);
+    }
+  }
+
+  BitDataStore(BitDataStore&& other) = delete;
+  BitDataStore& operator=(const BitDataStore& rhs) = delete;
+  BitDataStore& operator=(BitDataStore&& rhs) = delete;
+
+  ~BitDataStore() override = default;
+
+  /**
+   * @brief Returns the number of words needed to store numValues bits.
+   * @param numValues
+   * @return usize
+   */
+  static constexpr usize GetNumberOfWords(usize numValues)
+  {
+    return (numValues + k_BitsPerWord - 1) / k_BitsPerWord;
+  }
+
+  /**
+   * @brief Returns the number of tuples in the DataStore.
+   * @return usize
+   */
+  usize getNumberOfTuples() const override
+  {
+    return m_NumTuples;
+  }
+
+  /**
+   * @brief Returns the number of elements in each Tuple.
+   * @return usize
+   */
+  usize getNumberOfComponents() const override
+  {
+    return m_NumComponents;
+  }
+
+  /**
+   * @brief Returns the dimensions of the Tuples
+   * @return
+   */
+  const ShapeType& getTupleShape() const override
+  {
+    return m_TupleShape;
+  }
+
+  /**
+   * @brief Returns the dimensions of the Components
+   * @return
+   */
+  const ShapeType& getComponentShape() const override
+  {
+    return m_ComponentShape;
+  }
+
+  /**
+   * @brief Returns the store type e.g. in memory, out of core, etc.
+   * @return StoreType
+   */
+  IDataStore::StoreType getStoreType() const override
+  {
+    return IDataStore::StoreType::InMemory;
+  }
+
+  /**
+   * @brief Returns the number of bytes held by the packed words and any open windows.
+   * @return usize
+   */
+  usize getMemoryUsage() const override
+  {
+    return getNumberOfWords() * sizeof(WordType) + m_NumOpenWindows * k_WindowSize * sizeof(bool);
+  }
+
+  /**
+   * @brief Resizes the store to the new tuple shape, keeping as many of the
+   * existing values as fit. Any added values are false.
+   * @param tupleShape
+   */
+  void reshapeTuples(const std::vector<usize>& tupleShape) override
+  {
+    flushWindows();
+    m_TupleShape = tupleShape;
+    m_NumTuples = std::accumulate(m_TupleShape.cbegin(), m_TupleShape.cend(), static_cast<usize>(1), std::multiplies<>());
+    const usize numWords = GetNumberOfWords(this->getSize());
+    if(numWords != m_NumWords)
+    {
+      auto words = std::make_unique<WordType[]>(numWords);
+      std::copy_n(m_Words.get(), std::min(numWords, m_NumWords), words.get());
+      m_Words = std::move(words);
+      m_NumWords = numWords;
+    }
+    clearPaddingBits();
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * @param index
+   * @return value_type
+   */
+  value_type getValue(usize index) const override
+  {
+    if(m_NumOpenWindows != 0)
+    {
+      const Window* window = findWindow(index);
+      if(window != nullptr)
+      {
+        return window->values[index - window->firstIndex];
+      }
+    }
+    return ((m_Words[index / k_BitsPerWord] >> (index % k_BitsPerWord)) & 1u) != 0;
+  }
+
+  /**
+   * @brief Sets the value stored at the specified index.
+   * @param index
+   * @param value
+   */
+  void setValue(usize index, value_type value) override
+  {
+    if(m_NumOpenWindows != 0)
+    {
+      Window* window = findWindow(index);
+      if(window != nullptr)
+      {
+        window->values[index - window->firstIndex] = value;
+        window->modified = true;
+        return;
+      }
+    }
+    const WordType mask = static_cast<WordType>(1) << (index % k_BitsPerWord);
+    WordType& word = m_Words[index / k_BitsPerWord];
+    word = value ? (word | mask) : (word & ~mask);
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * The returned reference does not point into the store.
+   * @param index
+   * @return const_reference
+   */
+  const_reference operator[](usize index) const override
+  {
+    return getValue(index) ? k_TrueValue : k_FalseValue;
+  }
+
+  /**
+   * @brief Returns a reference to the value found at the specified index of the
+   * DataStore. The reference points into an unpacked window and is invalidated
+   * when the window is flushed, i.e. once k_NumWindows other blocks have been
+   * accessed or a bulk operation is run. Not safe to call from several threads.
+   * @param index
+   * @return reference
+   */
+  reference operator[](usize index) override
+  {
+    Window& window = openWindow(index);
+    window.modified = true;
+    return window.values[index - window.firstIndex];
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * Throws if the index is out of bounds.
+   * @param index
+   * @return const_reference
+   */
+  const_reference at(usize index) const override
+  {
+    if(index >= this->getSize())
+    {
+      throw std::runtime_error(fmt::format("BitDataStore::at: Index ({}) is greater than or equal to the size ({})", index, this->getSize()));
+    }
+    return (*this)[index];
+  }
+
+  /**
+   * @brief Copies buffer.size() values starting at startIndex into the given buffer.
+   * @param startIndex
+   * @param buffer
+   * @throw std::runtime_error
+   */
+  void copyIntoBuffer(usize startIndex, nonstd::span<bool> buffer) const override
+  {
+    this->checkRange(startIndex, buffer.size());
+    for(usize i = 0; i < buffer.size(); i++)
+    {
+      const usize index = startIndex + i;
+      buffer[i] = ((m_Words[index / k_BitsPerWord] >> (index % k_BitsPerWord)) & 1u) != 0;
+    }
+    if(m_NumOpenWindows == 0)
+    {
+      return;
+    }
+    // Values held in windows overwrite the possibly stale bits
+    const usize endIndex = startIndex + buffer.size();
+    for(const Window& window : m_Windows)
+    {
+      if(window.firstIndex == k_NotFound)
+      {
+        continue;
+      }
+      const usize first = std::max(startIndex, window.firstIndex);
+      const usize last = std::min(endIndex, window.firstIndex + k_WindowSize);
+      if(first < last)
+      {
+        std::copy(window.values.get() + (first - window.firstIndex), window.values.get() + (last - window.firstIndex), buffer.begin() + (first - startIndex));
+      }
+    }
+  }
+
+  /**
+   * @brief Copies all values from the given buffer into the store starting at startIndex.
+   * Whole words are assembled before being stored.
+   * @param startIndex
+   * @param buffer
+   * @throw std::runtime_error
+   */
+  void copyFromBuffer(usize startIndex, nonstd::span<const bool> buffer) override
+  {
+    this->checkRange(startIndex, buffer.size());
+    flushWindows();
+    usize offset = 0;
+    while(offset < buffer.size())
+    {
+      const usize index = startIndex + offset;
+      const usize bit = index % k_BitsPerWord;
+      const usize count = std::min(buffer.size() - offset, k_BitsPerWord - bit);
+      WordType bits = 0;
+      for(usize i = 0; i < count; i++)
+      {
+        bits |= static_cast<WordType>(buffer[offset + i]) << (bit + i);
+      }
+      const WordType mask = (count == k_BitsPerWord) ? ~static_cast<WordType>(0) : (((static_cast<WordType>(1) << count) - 1) << bit);
+      WordType& word = m_Words[index / k_BitsPerWord];
+      word = (word & ~mask) | bits;
+      offset += count;
+    }
+  }
+
+  /**
+   * @brief Sets every value in the store to the given value.
+   * @param value
+   */
+  void fill(value_type value) override
+  {
+    discardWindows();
+    std::fill_n(m_Words.get(), m_NumWords, value ? ~static_cast<WordType>(0) : static_cast<WordType>(0));
+    clearPaddingBits();
+  }
+
+  /**
+   * @brief Returns the number of words used to store the values.
+   * @return usize
+   */
+  usize getNumberOfWords() const
+  {
+    return m_NumWords;
+  }
+
+  /**
+   * @brief Returns a pointer to the packed words. Value i is stored in bit
+   * (i % k_BitsPerWord) of word (i / k_BitsPerWord). Bits past the end of the
+   * store are always zero and must be kept zero by anyone writing through this
+   * pointer. Values held in windows are written back first. The pointer is
+   * invalidated by reshapeTuples().
+   * @return WordType*
+   */
+  WordType* words()
+  {
+    flushWindows();
+    return m_Words.get();
+  }
+
+  /**
+   * @brief Returns the packed word at wordIndex, including any values held in
+   * windows. The windows are only read, unlike words().
+   * @param wordIndex
+   * @return WordType
+   */
+  WordType getWord(usize wordIndex) const
+  {
+    if(m_NumOpenWindows != 0)
+    {
+      const Window* window = findWindow(wordIndex * k_BitsPerWord);
+      if(window != nullptr && window->modified)
+      {
+        return packWord(*window, wordIndex);
+      }
+    }
+    return m_Words[wordIndex];
+  }
+
+  /**
+   * @brief Sets each value to the logical and of itself and the matching value in other.
+   * Throws if the stores have different sizes.
+   * @param other
+   * @throw std::runtime_error
+   */
+  void andWith(const BitDataStore& other)
+  {
+    checkSize(other);
+    WordType* thisWords = words();
+    for(usize i = 0; i < m_NumWords; i++)
+    {
+      thisWords[i] &= other.getWord(i);
+    }
+  }
+
+  /**
+   * @brief Sets each value to the logical or of itself and the matching value in other.
+   * Throws if the stores have different sizes.
+   * @param other
+   * @throw std::runtime_error
+   */
+  void orWith(const BitDataStore& other)
+  {
+    checkSize(other);
+    WordType* thisWords = words();
+    for(usize i = 0; i < m_NumWords; i++)
+    {
+      thisWords[i] |= other.getWord(i);
+    }
+  }
+
+  /**
+   * @brief Sets each value to the exclusive or of itself and the matching value in other.
+   * Throws if the stores have different sizes.
+   * @param other
+   * @throw std::runtime_error
+   */
+  void xorWith(const BitDataStore& other)
+  {
+    checkSize(other);
+    WordType* thisWords = words();
+    for(usize i = 0; i < m_NumWords; i++)
+    {
+      thisWords[i] ^= other.getWord(i);
+    }
+  }
+
+  /**
+   * @brief Inverts every value in the store.
+   */
+  void flip()
+  {
+    WordType* thisWords = words();
+    for(usize i = 0; i < m_NumWords; i++)
+    {
+      thisWords[i] = ~thisWords[i];
+    }
+    clearPaddingBits();
+  }
+
+  /**
+   * @brief Returns the number of true values in the store.
+   * @return usize
+   */
+  usize countTrue() const
+  {
+    usize count = 0;
+    for(usize i = 0; i < m_NumWords; i++)
+    {
+      count += popcount64(getWord(i));
+    }
+    return count;
+  }
+
+  /**
+   * @brief Returns the index of the first true value at or after startIndex.
+   * Returns k_NotFound if there is none.
+   * @param startIndex
+   * @return usize
+   */
+  usize findNextTrue(usize startIndex) const
+  {
+    const usize size = this->getSize();
+    if(startIndex >= size)
+    {
+      return k_NotFound;
+    }
+    usize wordIndex = startIndex / k_BitsPerWord;
+    WordType word = getWord(wordIndex) & (~static_cast<WordType>(0) << (startIndex % k_BitsPerWord));
+    while(word == 0)
+    {
+      wordIndex++;
+      if(wordIndex >= m_NumWords)
+      {
+        return k_NotFound;
+      }
+      word = getWord(wordIndex);
+    }
+    return wordIndex * k_BitsPerWord + countr_zero64(word);
+  }
+
+  /**
+   * @brief Returns a deep copy of the data store and all its data.
+   * @return std::unique_ptr<IDataStore>
+   */
+  std::unique_ptr<IDataStore> deepCopy() const override
+  {
+    return std::make_unique<BitDataStore>(*this);
+  }
+
+  /**
+   * @brief Returns a data store of the same type as this but with all values false.
+   * @return std::unique_ptr<IDataStore>
+   */
+  std::unique_ptr<IDataStore> createNewInstance() const override
+  {
+    return std::make_unique<BitDataStore>(this->getTupleShape(), this->getComponentShape(), false);
+  }
+
+  /**
+   * @brief Writes the data store to HDF5 as one byte per value, the same layout
+   * as a DataStore<bool>, unpacking one block at a time. Returns the HDF5 error
+   * code should one be encountered. Otherwise, returns 0.
+   * @param datasetWriter
+   * @return H5::ErrorType
+   */
+  H5::ErrorType writeHdf5(H5::DatasetWriter& datasetWriter) const override
+  {
+    if(!datasetWriter.isValid())
+    {
+      return -1;
+    }
+
+    std::vector<hsize_t> h5dims;
+    for(const auto& value : m_TupleShape)
+    {
+      h5dims.push_back(static_cast<hsize_t>(value));
+    }
+    for(const auto& value : m_ComponentShape)
+    {
+      h5dims.push_back(static_cast<hsize_t>(value));
+    }
+
+    herr_t err = this->writeHdf5InBlocks(datasetWriter, h5dims, k_VisitChunkSize);
+    if(err < 0)
+    {
+      return err;
+    }
+
+    // Write shape attributes to the dataset
+    auto tupleAttribute = datasetWriter.createAttribute(complex::H5::k_TupleShapeTag);
+    err = tupleAttribute.writeVector({m_TupleShape.size()}, m_TupleShape);
+    if(err < 0)
+    {
+      return err;
+    }
+
+    auto componentAttribute = datasetWriter.createAttribute(complex::H5::k_ComponentShapeTag);
+    err = componentAttribute.writeVector({m_ComponentShape.size()}, m_ComponentShape);
+
+    return err;
+  }
+
+private:
+  struct Window
+  {
+    usize firstIndex = k_NotFound;
+    bool modified = false;
+    std::unique_ptr<bool[]> values;
+  };
+
+  static constexpr bool k_TrueValue = true;
+  static constexpr bool k_FalseValue = false;
+
+  /**
+   * @brief Throws if the other store does not have the same size as this one.
+   * @param other
+   * @throw std::runtime_error
+   */
+  void checkSize(const BitDataStore& other) const
+  {
+    if(other.getSize() != this->getSize())
+    {
+      throw std::runtime_error(fmt::format("BitDataStore: Size ({}) does not match the other store's size ({})", this->getSize(), other.getSize()));
+    }
+  }
+
+  /**
+   * @brief Zeroes the unused bits of the last word.
+   */
+  void clearPaddingBits()
+  {
+    const usize usedBits = this->getSize() % k_BitsPerWord;
+    if(usedBits != 0)
+    {
+      m_Words[m_NumWords - 1] &= (static_cast<WordType>(1) << usedBits) - 1;
+    }
+  }
+
+  /**
+   * @brief Returns the window holding the given index or nullptr if the index is not in an open window.
+   * @param index
+   * @return Window*
+   */
+  const Window* findWindow(usize index) const
+  {
+    const usize firstIndex = index - (index % k_WindowSize);
+    if(m_LastWindow != nullptr && m_LastWindow->firstIndex == firstIndex)
+    {
+      return m_LastWindow;
+    }
+    for(const Window& window : m_Windows)
+    {
+      if(window.firstIndex == firstIndex)
+      {
+        return &window;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * @brief Returns the window holding the given index or nullptr if the index is not in an open window.
+   * @param index
+   * @return Window*
+   */
+  Window* findWindow(usize index)
+  {
+    return const_cast<Window*>(static_cast<const BitDataStore*>(this)->findWindow(index));
+  }
+
+  /**
+   * @brief Packs the values of the window that belong to the word at wordIndex.
+   * @param window
+   * @param wordIndex
+   * @return WordType
+   */
+  WordType packWord(const Window& window, usize wordIndex) const
+  {
+    const usize offset = wordIndex * k_BitsPerWord - window.firstIndex;
+    const usize numBits = std::min(k_BitsPerWord, this->getSize() - wordIndex * k_BitsPerWord);
+    WordType word = 0;
+    for(usize i = 0; i < numBits; i++)
+    {
+      word |= static_cast<WordType>(window.values[offset + i]) << i;
+    }
+    return word;
+  }
+
+  /**
+   * @brief Returns the window holding the given index, unpacking its block into
+   * the next window in turn if it is not open yet.
+   * @param index
+   * @return Window&
+   */
+  Window& openWindow(usize index)
+  {
+    Window* window = findWindow(index);
+    if(window == nullptr)
+    {
+      window = &m_Windows[m_NextWindow];
+      m_NextWindow = (m_NextWindow + 1) % k_NumWindows;
+      if(window->firstIndex == k_NotFound)
+      {
+        m_NumOpenWindows++;
+      }
+      else
+      {
+        closeWindow(*window);
+      }
+      if(window->values == nullptr)
+      {
+        window->values = std::make_unique<bool[]>(k_WindowSize);
+      }
+      window->firstIndex = index - (index % k_WindowSize);
+      const usize count = std::min(k_WindowSize, this->getSize() - window->firstIndex);
+      for(usize i = 0; i < count; i++)
+      {
+        const usize valueIndex = window->firstIndex + i;
+        window->values[i] = ((m_Words[valueIndex / k_BitsPerWord] >> (valueIndex % k_BitsPerWord)) & 1u) != 0;
+      }
+    }
+    m_LastWindow = window;
+    return *window;
+  }
+
+  /**
+   * @brief Packs a modified window back into the words and marks the window as unused.
+   * @param window
+   */
+  void closeWindow(Window& window)
+  {
+    if(window.modified)
+    {
+      const usize count = std::min(k_WindowSize, this->getSize() - window.firstIndex);
+      const usize firstWord = window.firstIndex / k_BitsPerWord;
+      const usize lastWord = firstWord + GetNumberOfWords(count);
+      for(usize wordIndex = firstWord; wordIndex < lastWord; wordIndex++)
+      {
+        m_Words[wordIndex] = packWord(window, wordIndex);
+      }
+    }
+    window.firstIndex = k_NotFound;
+    window.modified = false;
+  }
+
+  /**
+   * @brief Writes every modified window back into the words and closes all windows.
+   */
+  void flushWindows()
+  {
+    if(m_NumOpenWindows == 0)
+    {
+      return;
+    }
+    for(Window& window : m_Windows)
+    {
+      if(window.firstIndex != k_NotFound)
+      {
+        closeWindow(window);
+      }
+    }
+    m_NumOpenWindows = 0;
+    m_LastWindow = nullptr;
+  }
+
+  /**
+   * @brief Closes all windows without writing them back.
+   */
+  void discardWindows()
+  {
+    for(Window& window : m_Windows)
+    {
+      window.firstIndex = k_NotFound;
+      window.modified = false;
+    }
+    m_NumOpenWindows = 0;
+    m_LastWindow = nullptr;
+  }
+
+  ShapeType m_ComponentShape;
+  ShapeType m_TupleShape;
+  usize m_NumComponents = {0};
+  usize m_NumTuples = {0};
+  usize m_NumWords = {0};
+  std::unique_ptr<WordType[]> m_Words;
+  std::array<Window, k_NumWindows> m_Windows;
+  usize m_NumOpenWindows = 0;
+  usize m_NextWindow = 0;
+  Window* m_LastWindow = nullptr;
+};
+} // namespace complex
@@ -6,6 +6,9 @@
 #include "complex/DataStructure/IDataArray.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5GroupWriter.hpp"
 
+#include <atomic>
+#include <mutex>
+
 namespace complex
 {
 template <typename T>
@@ -17,6 +20,11 @@ class NeighborList;
  * retrieve array data within the DataStructure. The DataArray is designed to
  * allow expandability into multiple sources of data, including out-of-core data,
  * through the use of derived DataStore classes.
+ *
+ * Copying a DataArray (e.g. through shallowCopy() when a DataStructure is
+ * copied) shares the DataStore between both arrays. The store is shared
+ * copy-on-write: the first mutable access through either array detaches it
+ * by deep copying the store, so the other array never observes the change.
  */
 template <class T>
 class DataArray : public IDataArray
@@ -139,13 +147,16 @@ public:
   /**
    * @brief Creates a copy of the specified tuple getSize, count, and smart
    * pointer to the target DataStore. This copy is not added to the
-   * DataStructure.
+   * DataStructure. Both arrays share the DataStore until either one is
+   * detached by a mutable access (see detachDataStore()).
    * @param other
    */
   DataArray(const DataArray<T>& other)
   : IDataArray(other)
   , m_DataStore(other.m_DataStore)
+  , m_IsStoreShared(true)
   {
+    other.m_IsStoreShared = true;
   }
 
   /**
@@ -155,6 +166,7 @@ public:
   DataArray(DataArray<T>&& other)
   : IDataArray(std::move(other))
   , m_DataStore(std::move(other.m_DataStore))
+  , m_IsStoreShared(other.m_IsStoreShared.load())
   {
   }
 
@@ -189,7 +201,7 @@ public:
    */
   DataObject* deepCopy() override
   {
-    std::shared_ptr<IDataStore> sharedStore = getDataStore()->deepCopy();
+    std::shared_ptr<IDataStore> sharedStore = m_DataStore->deepCopy();
     std::shared_ptr<store_type> datastore = std::dynamic_pointer_cast<store_type>(sharedStore);
     return new DataArray(*getDataStructure(), getName(), getId(), datastore);
   }
@@ -224,7 +236,7 @@ public:
   /**
    * @brief Returns a reference to the value found at the specified index of
    * the data array. This can be used to edit the value found at the specified
-   * index.
+   * index. Detaches a shared DataStore first.
    *
    * Throws an exception if the DataStore has not been allocated.
    * @param index
@@ -237,6 +249,7 @@ public:
       throw std::runtime_error("DataArray::operator[] requires a valid DataStore");
     }
 
+    detachDataStore();
     return (*m_DataStore.get())[index];
   }
 
@@ -247,6 +260,7 @@ public:
    */
   void initializeTuple(usize tupleIndex, T value)
   {
+    detachDataStore();
     m_DataStore->fillTuple(tupleIndex, value);
   }
 
@@ -256,6 +270,7 @@ public:
    */
   void fill(T value)
   {
+    detachDataStore();
     m_DataStore->fill(value);
   }
 
@@ -272,6 +287,7 @@ public:
     {
       return;
     }
+    detachDataStore();
     const auto numComponents = getNumberOfComponents();
     for(usize i = 0; i < numComponents; i++)
     {
@@ -287,6 +303,7 @@ public:
    */
   void byteSwapElements()
   {
+    detachDataStore();
     for(auto& value : *this)
     {
       value = complex::byteswap(value);
@@ -309,7 +326,7 @@ public:
       throw std::runtime_error("DataArray::operator[] requires a valid DataStore");
     }
 
-    return (*m_DataStore.get())[index];
+    return static_cast<const store_type&>(*m_DataStore)[index];
   }
 
   /**
@@ -328,7 +345,7 @@ public:
       throw std::runtime_error("");
     }
 
-    return (*m_DataStore.get())[index];
+    return static_cast<const store_type&>(*m_DataStore)[index];
   }
 
   /**
@@ -342,20 +359,24 @@ public:
   }
 
   /**
-   * @brief Returns a raw pointer to the DataStore.
+   * @brief Returns a raw pointer to the DataStore for writing. Detaches a
+   * shared DataStore first.
    * @return DataStore<T>*
    */
   store_type* getDataStore()
   {
+    detachDataStore();
     return m_DataStore.get();
   }
 
   /**
-   * @brief Returns a pointer to the array's IDataStore.
-   * @return const IDataStore*
+   * @brief Returns a pointer to the array's IDataStore for writing. Detaches
+   * a shared DataStore first.
+   * @return IDataStore*
    */
   IDataStore* getIDataStore() override
   {
+    detachDataStore();
     return m_DataStore.get();
   }
 
@@ -369,7 +390,8 @@ public:
   }
 
   /**
-   * @brief Returns a reference to the DataStore.
+   * @brief Returns a reference to the DataStore for writing. Detaches a
+   * shared DataStore first.
    * @return DataStore<T>&
    */
   store_type& getDataStoreRef()
@@ -378,6 +400,7 @@ public:
     {
       throw std::runtime_error("DataArray: Null DataStore");
     }
+    detachDataStore();
     return *m_DataStore;
   }
 
@@ -421,12 +444,52 @@ public:
   void setDataStore(std::shared_ptr<store_type> store)
   {
     m_DataStore = std::move(store);
+    m_IsStoreShared = false;
     if(m_DataStore == nullptr)
     {
       m_DataStore = std::make_shared<EmptyDataStore<T>>();
     }
   }
 
+  /**
+   * @brief Returns true if the DataStore is currently shared copy-on-write
+   * with another DataArray.
+   * @return bool
+   */
+  bool isDataStoreShared() const
+  {
+    return m_IsStoreShared && m_DataStore.use_count() > 1;
+  }
+
+  /**
+   * @brief Ensures this DataArray is the sole owner of its DataStore. If the
+   * DataStore is still shared with a copy of this DataArray, it is replaced
+   * with a deep copy. Every non-const accessor calls this before handing out
+   * a reference, pointer or iterator, so const access never copies the store.
+   * Concurrent detaches are serialized, but references obtained before a
+   * detach point into the old store: take them after the first mutable
+   * access on the calling thread, e.g. before a parallel section.
+   */
+  void detachDataStore() override
+  {
+    if(!m_IsStoreShared.load(std::memory_order_acquire))
+    {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(m_DetachMutex);
+    if(!m_IsStoreShared.load(std::memory_order_relaxed))
+    {
+      return;
+    }
+    // The other owner may already have detached or been destroyed
+    if(m_DataStore.use_count() > 1)
+    {
+      std::shared_ptr<IDataStore> sharedStore = m_DataStore->deepCopy();
+      m_DataStore = std::dynamic_pointer_cast<store_type>(sharedStore);
+    }
+    m_IsStoreShared.store(false, std::memory_order_release);
+  }
+
   /**
    * @brief Returns the first item in the array.
    *
@@ -526,6 +589,8 @@ public:
   DataArray& operator=(const DataArray& rhs)
   {
     m_DataStore = rhs.m_DataStore;
+    m_IsStoreShared = true;
+    rhs.m_IsStoreShared = true;
     return *this;
   }
 
@@ -537,6 +602,7 @@ public:
   DataArray& operator=(DataArray&& rhs) noexcept
   {
     m_DataStore = std::move(rhs.m_DataStore);
+    m_IsStoreShared = rhs.m_IsStoreShared.load();
     return *this;
   }
 
@@ -655,6 +721,8 @@ protected:
 
 private:
   std::shared_ptr<store_type> m_DataStore = nullptr;
+  mutable std::atomic_bool m_IsStoreShared = false;
+  std::mutex m_DetachMutex;
 };
 
 // Declare extern templates
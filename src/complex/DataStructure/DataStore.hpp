@@ -289,6 +289,66 @@ public:
     return m_Data[index];
   }
 
+  /**
+   * @brief Copies buffer.size() values starting at startIndex into the provided buffer.
+   * @param startIndex
+   * @param buffer
+   * @throw std::runtime_error
+   */
+  void copyIntoBuffer(usize startIndex, nonstd::span<T> buffer) const override
+  {
+    this->checkRange(startIndex, buffer.size());
+    std::copy_n(data() + startIndex, buffer.size(), buffer.data());
+  }
+
+  /**
+   * @brief Copies all values from the provided buffer into the DataStore starting at startIndex.
+   * The buffer may overlap the DataStore's own memory.
+   * @param startIndex
+   * @param buffer
+   * @throw std::runtime_error
+   */
+  void copyFromBuffer(usize startIndex, nonstd::span<const T> buffer) override
+  {
+    this->checkRange(startIndex, buffer.size());
+    std::memmove(data() + startIndex, buffer.data(), buffer.size() * sizeof(T));
+  }
+
+  /**
+   * @brief Calls the visitor once with a span over the requested range of the DataStore's memory.
+   * @param startIndex
+   * @param count
+   * @param visitor
+   * @throw std::runtime_error
+   */
+  void visitChunks(usize startIndex, usize count, const typename AbstractDataStore<T>::ChunkVisitor& visitor) override
+  {
+    this->checkRange(startIndex, count);
+    visitor(startIndex, nonstd::span<T>(data() + startIndex, count));
+  }
+
+  /**
+   * @brief Calls the visitor once with a read-only span over the requested range of the DataStore's memory.
+   * @param startIndex
+   * @param count
+   * @param visitor
+   * @throw std::runtime_error
+   */
+  void visitConstChunks(usize startIndex, usize count, const typename AbstractDataStore<T>::ConstChunkVisitor& visitor) const override
+  {
+    this->checkRange(startIndex, count);
+    visitor(startIndex, nonstd::span<const T>(data() + startIndex, count));
+  }
+
+  /**
+   * @brief Fills the DataStore with the specified value.
+   * @param value
+   */
+  void fill(value_type value) override
+  {
+    std::fill_n(data(), this->getSize(), value);
+  }
+
   /**
    * @brief Returns a deep copy of the data store and all its data.
    * @return std::unique_ptr<IDataStore>
@@ -9,6 +9,7 @@
 #include "complex/DataStructure/Messaging/DataRemovedMessage.hpp"
 #include "complex/DataStructure/Messaging/DataReparentedMessage.hpp"
 #include "complex/DataStructure/Observers/AbstractDataStructureObserver.hpp"
+#include "complex/DataStructure/StringArray.hpp"
 #include "complex/Filter/DataParameter.hpp"
 #include "complex/Filter/ValueParameter.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5DataStructureReader.hpp"
@@ -18,6 +19,7 @@
 
 #include <numeric>
 #include <stdexcept>
+#include <unordered_set>
 
 #include <fmt/core.h>
 
@@ -97,6 +99,37 @@ size_t DataStructure::getSize() const
   return m_DataObjects.size();
 }
 
+usize DataStructure::getMemoryUsage() const
+{
+  std::unordered_set<const IDataStore*> visitedStores;
+  usize memoryUsage = 0;
+  for(const auto& [id, weakPtr] : m_DataObjects)
+  {
+    auto sharedPtr = weakPtr.lock();
+    if(const auto* neighborList = dynamic_cast<const INeighborList*>(sharedPtr.get()); neighborList != nullptr)
+    {
+      memoryUsage += neighborList->getMemoryUsage();
+      continue;
+    }
+    if(const auto* stringArray = dynamic_cast<const StringArray*>(sharedPtr.get()); stringArray != nullptr)
+    {
+      memoryUsage += stringArray->getMemoryUsage();
+      continue;
+    }
+    auto* dataArray = dynamic_cast<const IDataArray*>(sharedPtr.get());
+    if(dataArray == nullptr)
+    {
+      continue;
+    }
+    const IDataStore* dataStore = dataArray->getIDataStore();
+    if(dataStore != nullptr && visitedStores.insert(dataStore).second)
+    {
+      memoryUsage += dataStore->getMemoryUsage();
+    }
+  }
+  return memoryUsage;
+}
+
 void DataStructure::clear()
 {
   auto topDataIds = m_RootGroup.getKeys();
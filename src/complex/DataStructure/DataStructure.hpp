@@ -98,6 +98,15 @@ public:
    */
   usize getSize() const;
 
+  /**
+   * @brief Returns the number of bytes held by the DataStores of all DataArrays, the
+   * NeighborLists and the StringArrays in the DataStructure. DataStores shared between
+   * arrays are only counted once. Preflight DataStores report the memory they are
+   * projected to hold, while NeighborLists and StringArrays report what they hold now.
+   * @return usize
+   */
+  usize getMemoryUsage() const;
+
   /**
    * @brief Clears the DataStructure by removing all DataObjects. The next
    * DataObject ID remains unchanged after the operation.
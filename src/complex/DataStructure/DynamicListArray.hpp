@@ -4,11 +4,23 @@
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "complex/DataStructure/DataObject.hpp"
 
 namespace complex
 {
+/**
+ * @brief The DynamicListArray class stores a variable length list of K values
+ * for every entry, such as the elements that contain each vertex of a mesh.
+ *
+ * The lists are kept in compressed sparse row form: all values live in a
+ * single flat buffer and the entry offsets mark where each list starts. The
+ * lists are allocated at once from their counts and then filled in place,
+ * which allows them to be filled concurrently.
+ * @tparam T Type used to report the number of values in a list
+ * @tparam K Value type
+ */
 template <typename T, typename K>
 class DynamicListArray : public DataObject
 {
@@ -78,8 +90,8 @@ public:
    */
   DynamicListArray(const DynamicListArray& other)
   : DataObject(other)
-  , m_Array(other.m_Array)
-  , m_Size(other.m_Size)
+  , m_Offsets(other.m_Offsets)
+  , m_Cells(other.m_Cells)
   {
   }
 
@@ -90,30 +102,12 @@ public:
    */
   DynamicListArray(DynamicListArray&& other)
   : DataObject(std::move(other))
-  , m_Array(std::move(other.m_Array))
-  , m_Size(std::move(other.m_Size))
+  , m_Offsets(std::move(other.m_Offsets))
+  , m_Cells(std::move(other.m_Cells))
   {
   }
 
-  // -----------------------------------------------------------------------------
-  //
-  // -----------------------------------------------------------------------------
-  ~DynamicListArray() override
-  {
-    // This makes sure we deallocate any lists that have been created
-    for(usize i = 0; i < this->m_Size; i++)
-    {
-      if(this->m_Array[i].cells != nullptr)
-      {
-        delete[] this->m_Array[i].cells;
-      }
-    }
-    // Now delete all the "ElementList" structures
-    if(this->m_Array != nullptr)
-    {
-      delete[] this->m_Array;
-    }
-  }
+  ~DynamicListArray() override = default;
 
   DataObject::Type getDataObjectType() const override
   {
@@ -135,7 +129,27 @@ public:
    */
   usize size() const
   {
-    return m_Size;
+    return m_Offsets.size() - 1;
+  }
+
+  /**
+   * @brief Returns the total number of values across all lists.
+   * @return usize
+   */
+  usize getTotalNumberOfElements() const
+  {
+    return m_Cells.size();
+  }
+
+  /**
+   * @brief Returns the offset of each list into the flat value buffer. The
+   * vector holds size() + 1 entries with the last one equal to the total
+   * number of values.
+   * @return const std::vector<usize>&
+   */
+  const std::vector<usize>& getOffsets() const
+  {
+    return m_Offsets;
   }
 
   /**
@@ -145,23 +159,7 @@ public:
    */
   DataObject* deepCopy() override
   {
-    DynamicListArray* copy = new DynamicListArray(*this);
-    std::vector<T> linkCounts(m_Size, 0);
-
-    // Figure out how many entries, and for each entry, how many cells
-    for(usize pointId = 0; pointId < m_Size; pointId++)
-    {
-      linkCounts[pointId] = this->m_Array[pointId].numCells;
-    }
-    // Allocate all that in the copy
-    copy->allocateLists(linkCounts);
-    // Copy the data from the original to the new
-    for(usize ptId = 0; ptId < m_Size; ptId++)
-    {
-      ElementList& elementList = getElementList(ptId);
-      copy->setElementList(ptId, elementList);
-    }
-    return copy;
+    return new DynamicListArray(*this);
   }
 
   /**
@@ -181,70 +179,71 @@ public:
    */
   inline void insertCellReference(usize pointId, usize pos, usize cellId)
   {
-    this->m_Array[pointId].cells[pos] = cellId;
+    m_Cells[m_Offsets[pointId] + pos] = static_cast<K>(cellId);
   }
 
   /**
-   * @brief Get a link structure given a point id.
+   * @brief Get a link structure given a point id. The returned list points
+   * into the array and is invalidated when the lists are reallocated. It is
+   * returned by value since the lists are stored contiguously.
    * @param pointId
-   * @return ElementList&
+   * @return ElementList
    */
-  ElementList& getElementList(usize pointId) const
+  ElementList getElementList(usize pointId) const
   {
-    return this->m_Array[pointId];
+    // ElementList::cells stays mutable, as it was when this returned a reference from a const method
+    return {getNumberOfElements(pointId), const_cast<K*>(getElementListPointer(pointId))};
   }
 
   /**
-   * @brief setElementList
+   * @brief Replaces the list of the given point. Resizing a list moves every
+   * value after it, so lists should be allocated with their final counts
+   * through allocateLists() whenever possible.
    * @param pointId
    * @param numCells
    * @param data
    * @return bool
    */
-  bool setElementList(usize pointId, T numCells, K* data)
+  bool setElementList(usize pointId, T numCells, const K* data)
   {
-    if(pointId >= m_Size)
+    if(pointId >= size())
     {
       return false;
     }
-    if(m_Array[pointId].cells != nullptr && m_Array[pointId].numCells > 0)
+    const usize begin = m_Offsets[pointId];
+    const usize oldCount = m_Offsets[pointId + 1] - begin;
+    const usize newCount = static_cast<usize>(numCells);
+    if(newCount != oldCount)
     {
-      delete[] this->m_Array[pointId].cells;
-      m_Array[pointId].cells = nullptr;
-      m_Array[pointId].numCells = 0;
+      if(newCount > oldCount)
+      {
+        m_Cells.insert(m_Cells.begin() + begin + oldCount, newCount - oldCount, K{});
+      }
+      else
+      {
+        m_Cells.erase(m_Cells.begin() + begin + newCount, m_Cells.begin() + begin + oldCount);
+      }
+      for(usize i = pointId + 1; i < m_Offsets.size(); i++)
+      {
+        m_Offsets[i] = m_Offsets[i] + newCount - oldCount;
+      }
+    }
+    if(newCount > 0)
+    {
+      std::memcpy(m_Cells.data() + begin, data, sizeof(K) * newCount);
     }
-    m_Array[pointId].numCells = numCells;
-    // If numCells is huge then there could be problems with this
-    this->m_Array[pointId].cells = new K[numCells];
-    std::memcpy(m_Array[pointId].cells, data, sizeof(K) * numCells);
     return true;
   }
 
   /**
-   * @brief setElementList
+   * @brief Replaces the list of the given point.
    * @param pointId
    * @param list
    * @return bool
    */
-  bool setElementList(usize pointId, ElementList& list)
+  bool setElementList(usize pointId, const ElementList& list)
   {
-    T nCells = list.numCells;
-    K* data = list.cells;
-    if(pointId >= m_Size)
-    {
-      return false;
-    }
-    if(m_Array[pointId].cells != nullptr && m_Array[pointId].numCells > 0)
-    {
-      delete[] this->m_Array[pointId].cells;
-      m_Array[pointId].cells = nullptr;
-      m_Array[pointId].numCells = 0;
-    }
-    m_Array[pointId].numCells = nCells;
-    // If numCells is huge then there could be problems with this
-    this->m_Array[pointId].cells = new K[nCells];
-    std::memcpy(m_Array[pointId].cells, data, sizeof(K) * nCells);
-    return true;
+    return setElementList(pointId, list.numCells, list.cells);
   }
 
   /**
@@ -254,7 +253,7 @@ public:
    */
   T getNumberOfElements(usize pointId) const
   {
-    return this->m_Array[pointId].numCells;
+    return static_cast<T>(m_Offsets[pointId + 1] - m_Offsets[pointId]);
   }
 
   /**
@@ -262,9 +261,19 @@ public:
    * @param pointId
    * @return K*
    */
-  K* getElementListPointer(usize pointId) const
+  K* getElementListPointer(usize pointId)
   {
-    return this->m_Array[pointId].cells;
+    return m_Cells.data() + m_Offsets[pointId];
+  }
+
+  /**
+   * @brief Return a list of cell ids using the point.
+   * @param pointId
+   * @return const K*
+   */
+  const K* getElementListPointer(usize pointId) const
+  {
+    return m_Cells.data() + m_Offsets[pointId];
   }
 
   /**
@@ -274,40 +283,43 @@ public:
    */
   void deserializeLinks(std::vector<uint8>& buffer, usize numElements)
   {
+    // Each list is stored as its count followed by its values
+    std::vector<T> linkCounts(numElements, 0);
     usize offset = 0;
-    allocate(numElements); // Allocate all the links with 0 and nullptr;
-    uint8* bufPtr = &(buffer.front());
+    for(usize i = 0; i < numElements; ++i)
+    {
+      std::memcpy(&linkCounts[i], buffer.data() + offset, sizeof(T));
+      offset += sizeof(T) + linkCounts[i] * sizeof(K);
+    }
+    allocateLists(linkCounts);
 
-    // Walk the array and allocate all the array links to Zero and nullptr
-    T* numCells = nullptr;
-    // int32* cells = nullptr;
+    offset = 0;
     for(usize i = 0; i < numElements; ++i)
     {
-      numCells = reinterpret_cast<T*>(bufPtr + offset);
-      this->m_Array[i].numCells = *numCells; // Set the number of cells in this link
-      offset += 2;
-      this->m_Array[i].cells = new K[(*numCells)];                                   // Allocate a new chunk of memory to store the list
-      std::memcpy(this->m_Array[i].cells, bufPtr + offset, (*numCells) * sizeof(K)); // Copy from the buffer into the new list memory
-      offset += (*numCells) * sizeof(K);                                             // Increment the offset
+      offset += sizeof(T);
+      const usize numBytes = linkCounts[i] * sizeof(K);
+      if(numBytes > 0)
+      {
+        std::memcpy(getElementListPointer(i), buffer.data() + offset, numBytes);
+      }
+      offset += numBytes;
     }
   }
 
   /**
-   * @brief
+   * @brief Allocates one list per entry of linkCounts with the given number
+   * of values. Any previous lists are discarded and the new values are zero.
    * @param linkCounts
    */
   template <typename Container>
   void allocateLists(const Container& linkCounts)
   {
-    allocate(linkCounts.size());
-    for(typename std::vector<T>::size_type i = 0; i < linkCounts.size(); i++)
+    m_Offsets.assign(linkCounts.size() + 1, 0);
+    for(usize i = 0; i < linkCounts.size(); i++)
     {
-      this->m_Array[i].numCells = linkCounts[i];
-      if(linkCounts[i] > 0)
-      {
-        this->m_Array[i].cells = new K[this->m_Array[i].numCells];
-      }
+      m_Offsets[i + 1] = m_Offsets[i] + static_cast<usize>(linkCounts[i]);
     }
+    m_Cells.assign(m_Offsets.back(), K{});
   }
 
 protected:
@@ -332,38 +344,6 @@ protected:
   {
   }
 
-  //----------------------------------------------------------------------------
-  // This will allocate memory to hold all the NeighborList structures where each
-  // structure is initialized to Zero Entries and a nullptr Pointer
-  void allocate(usize size)
-  {
-    static typename DynamicListArray<T, K>::ElementList linkInit = {0, nullptr};
-
-    // This makes sure we deallocate any lists that have been created
-    for(usize i = 0; i < this->m_Size; i++)
-    {
-      if(this->m_Array[i].cells != nullptr)
-      {
-        delete[] this->m_Array[i].cells;
-      }
-    }
-    // Now delete all the "ElementList" structures
-    if(this->m_Array != nullptr)
-    {
-      delete[] this->m_Array;
-    }
-
-    this->m_Size = size;
-    // Allocate a whole new set of structures
-    this->m_Array = new typename DynamicListArray<T, K>::ElementList[size];
-
-    // Initialize each structure to have 0 entries and nullptr pointer.
-    for(usize i = 0; i < size; i++)
-    {
-      this->m_Array[i] = linkInit;
-    }
-  }
-
   /**
    * @brief Writes the DataArray to HDF5 using the provided group ID.
    * @param parentGroupWriter
@@ -376,8 +356,8 @@ protected:
   }
 
 private:
-  ElementList* m_Array = nullptr; // pointer to data
-  usize m_Size = 0;
+  std::vector<usize> m_Offsets = {0};
+  std::vector<K> m_Cells;
 };
 
 using Int32Int32DynamicListArray = DynamicListArray<int32, int32>;
@@ -7,6 +7,7 @@
 #include <fmt/format.h>
 
 #include <numeric>
+#include <optional>
 #include <stdexcept>
 #include <vector>
 
@@ -55,6 +56,7 @@ public:
   , m_TupleShape(other.m_TupleShape)
   , m_NumComponents(other.m_NumComponents)
   , m_NumTuples(other.m_NumTuples)
+  , m_ProjectedMemoryUsage(other.m_ProjectedMemoryUsage)
   {
   }
 
@@ -67,6 +69,7 @@ public:
   , m_TupleShape(std::move(other.m_TupleShape))
   , m_NumComponents(std::move(other.m_NumComponents))
   , m_NumTuples(std::move(other.m_NumTuples))
+  , m_ProjectedMemoryUsage(other.m_ProjectedMemoryUsage)
   {
   }
 
@@ -117,6 +120,27 @@ public:
     return IDataStore::StoreType::Empty;
   }
 
+  /**
+   * @brief Returns the number of bytes of memory the store is projected to hold
+   * once its values are allocated during execution. Defaults to one value of
+   * type T per element.
+   * @return usize
+   */
+  usize getMemoryUsage() const override
+  {
+    return m_ProjectedMemoryUsage.value_or(this->getSize() * sizeof(T));
+  }
+
+  /**
+   * @brief Sets the number of bytes of memory the store is projected to hold
+   * during execution, e.g. for stores that will be bit packed or out of core.
+   * @param numBytes
+   */
+  void setProjectedMemoryUsage(usize numBytes)
+  {
+    m_ProjectedMemoryUsage = numBytes;
+  }
+
   /**
    * @brief Throws an exception because this should never be called. The
    * EmptyDataStore class contains no data other than its target size.
@@ -230,5 +254,6 @@ private:
   ShapeType m_TupleShape;
   size_t m_NumComponents = {0};
   size_t m_NumTuples = {0};
+  std::optional<usize> m_ProjectedMemoryUsage;
 };
 } // namespace complex
@@ -4,7 +4,10 @@
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/DataStructure.hpp"
+#include "complex/DataStructure/EmptyDataStore.hpp"
+#include "complex/DataStructure/H5ProxyDataStore.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DatasetReadScheduler.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5DataStructureReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5GroupReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5IDataFactory.hpp"
@@ -46,15 +49,49 @@ public:
    * @param err
    * @param parentId
    * @param preflight
+   * @param lazy Creates a proxy that reads the values on first access
+   * @param readScheduler Reads the values once the DataStructure has been walked
    */
   template <typename K>
   void importDataArray(DataStructure& dataStructure, const H5::DatasetReader& datasetReader, const std::string dataArrayName, DataObject::IdType importId, H5::ErrorType& err,
-                       const std::optional<DataObject::IdType>& parentId, bool preflight)
+                       const std::optional<DataObject::IdType>& parentId, bool preflight, bool lazy, H5::DatasetReadScheduler& readScheduler)
   {
-    std::unique_ptr<AbstractDataStore<K>> dataStore =
-        preflight ? std::unique_ptr<AbstractDataStore<K>>(EmptyDataStore<K>::ReadHdf5(datasetReader)) : std::unique_ptr<AbstractDataStore<K>>(DataStore<K>::ReadHdf5(datasetReader));
+    std::unique_ptr<AbstractDataStore<K>> dataStore;
+    const bool scheduleRead = !preflight && !lazy;
+    if(preflight)
+    {
+      dataStore = EmptyDataStore<K>::ReadHdf5(datasetReader);
+    }
+    else if(lazy)
+    {
+      dataStore = H5ProxyDataStore<K>::ReadHdf5(datasetReader);
+    }
+    else
+    {
+      auto tupleShape = IDataStore::ReadTupleShape(datasetReader);
+      auto componentShape = IDataStore::ReadComponentShape(datasetReader);
+      dataStore = std::make_unique<DataStore<K>>(tupleShape, componentShape, std::nullopt);
+    }
     DataArray<K>* data = DataArray<K>::Import(dataStructure, dataArrayName, importId, std::move(dataStore), parentId);
-    err = (data == nullptr) ? -400 : 0;
+    if(data == nullptr)
+    {
+      err = -400;
+      return;
+    }
+    err = 0;
+
+    // The values are only scheduled once the array owns the store, so that a failed
+    // import never leaves the scheduler with a view into a destroyed store
+    if(scheduleRead)
+    {
+      auto* newDataStore = dynamic_cast<DataStore<K>*>(data->getDataStore());
+      if(newDataStore == nullptr)
+      {
+        err = -400;
+        return;
+      }
+      readScheduler.enqueue(datasetReader, newDataStore->createSpan());
+    }
   }
 
   /**
@@ -93,6 +130,7 @@ public:
 
     std::string dataArrayName = datasetReader.getName();
     DataObject::IdType importId = ReadObjectId(datasetReader);
+    const bool lazy = dataStructureReader.isLazyLoading();
 
     auto dataTypeAttribute = datasetReader.getAttribute(complex::Constants::k_ObjectTypeTag);
     const bool isBoolArray = (dataTypeAttribute.isValid() && dataTypeAttribute.readAsString().compare("DataArray<bool>") == 0);
@@ -107,41 +145,41 @@ public:
     switch(type)
     {
     case H5::Type::float32:
-      importDataArray<float32>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<float32>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, lazy, dataStructureReader.getReadScheduler());
       break;
     case H5::Type::float64:
-      importDataArray<float64>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<float64>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, lazy, dataStructureReader.getReadScheduler());
       break;
     case H5::Type::int8:
-      importDataArray<int8>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<int8>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, lazy, dataStructureReader.getReadScheduler());
       break;
     case H5::Type::int16:
-      importDataArray<int16>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<int16>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, lazy, dataStructureReader.getReadScheduler());
       break;
     case H5::Type::int32:
-      importDataArray<int32>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<int32>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, lazy, dataStructureReader.getReadScheduler());
       break;
     case H5::Type::int64:
-      importDataArray<int64>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<int64>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, lazy, dataStructureReader.getReadScheduler());
       break;
     case H5::Type::uint8:
       if(isBoolArray)
       {
-        importDataArray<bool>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+        importDataArray<bool>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, lazy, dataStructureReader.getReadScheduler());
       }
       else
       {
-        importDataArray<uint8>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+        importDataArray<uint8>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, lazy, dataStructureReader.getReadScheduler());
       }
       break;
     case H5::Type::uint16:
-      importDataArray<uint16>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<uint16>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, lazy, dataStructureReader.getReadScheduler());
       break;
     case H5::Type::uint32:
-      importDataArray<uint32>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<uint32>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, lazy, dataStructureReader.getReadScheduler());
       break;
     case H5::Type::uint64:
-      importDataArray<uint64>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<uint64>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, lazy, dataStructureReader.getReadScheduler());
       break;
     default:
       err = -777;
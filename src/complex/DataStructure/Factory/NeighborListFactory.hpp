@@ -53,8 +53,8 @@ public:
                                  DataObject::IdType importId, const std::optional<DataObject::IdType>& parentId = {}, bool preflight = false)
   {
     using NeighborListType = NeighborList<K>;
-    auto dataVector = NeighborListType::ReadHdf5Data(parentReader, datasetReader);
-    NeighborListType::Import(dataStructure, dataArrayName, importId, dataVector, parentId);
+    auto [offsets, values] = NeighborListType::ReadHdf5CompactData(parentReader, datasetReader);
+    NeighborListType::Import(dataStructure, dataArrayName, importId, std::move(offsets), std::move(values), parentId);
   }
 
   /**
@@ -48,7 +48,7 @@ void INodeGeometry0D::setVertices(const INodeGeometry0D::SharedVertexList& verti
 
 void INodeGeometry0D::resizeVertexList(usize size)
 {
-  getVerticesRef().getIDataStoreRef().reshapeTuples({size});
+  getVerticesRef().reshapeTuples({size});
 }
 
 usize INodeGeometry0D::getNumberOfVertices() const
@@ -47,7 +47,7 @@ void INodeGeometry1D::setEdges(const SharedEdgeList& edges)
 
 void INodeGeometry1D::resizeEdgeList(usize size)
 {
-  getEdgesRef().getIDataStoreRef().reshapeTuples({size});
+  getEdgesRef().reshapeTuples({size});
 }
 
 usize INodeGeometry1D::getNumberOfEdges() const
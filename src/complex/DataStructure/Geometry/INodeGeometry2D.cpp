@@ -47,7 +47,7 @@ void INodeGeometry2D::setFaces(const SharedFaceList& faces)
 
 void INodeGeometry2D::resizeFaceList(usize size)
 {
-  getFacesRef().getIDataStoreRef().reshapeTuples({size});
+  getFacesRef().reshapeTuples({size});
 }
 
 usize INodeGeometry2D::getNumberOfFaces() const
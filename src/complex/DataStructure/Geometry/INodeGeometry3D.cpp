@@ -47,7 +47,7 @@ void INodeGeometry3D::setPolyhedra(const SharedFaceList& polyhedra)
 
 void INodeGeometry3D::resizePolyhedronList(usize size)
 {
-  getPolyhedraRef().getIDataStoreRef().reshapeTuples({size});
+  getPolyhedraRef().reshapeTuples({size});
 }
 
 usize INodeGeometry3D::getNumberOfPolyhedra() const
@@ -0,0 +1,442 @@
+#pragma once
+
+#include "complex/DataStructure/AbstractDataStore.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DatasetReader.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5FileReader.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5Support.hpp"
+
+#include <fmt/core.h>
+
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace complex
+{
+/**
+ * @class H5ProxyDataStore
+ * @brief The H5ProxyDataStore class stands in for an array stored in an HDF5
+ * file without reading it. The values are read into an in-memory DataStore
+ * the first time they are accessed, so importing a file only reads the arrays
+ * that are actually used.
+ *
+ * The proxy can be limited to a hyperslab of the dataset, which allows a
+ * sub-volume of an array to be imported without reading the rest of it.
+ * deepCopy() reads the selected values into a new DataStore without keeping
+ * them in the proxy.
+ *
+ * The HDF5 file must not be modified or removed before the values are read.
+ * @tparam T
+ */
+template <typename T>
+class H5ProxyDataStore : public AbstractDataStore<T>
+{
+public:
+  using value_type = typename AbstractDataStore<T>::value_type;
+  using reference = typename AbstractDataStore<T>::reference;
+  using const_reference = typename AbstractDataStore<T>::const_reference;
+  using ShapeType = typename IDataStore::ShapeType;
+  using ChunkVisitor = typename AbstractDataStore<T>::ChunkVisitor;
+  using ConstChunkVisitor = typename AbstractDataStore<T>::ConstChunkVisitor;
+  using DimsType = std::vector<hsize_t>;
+
+  /**
+   * @brief Constructs a proxy for the dataset at datasetPath inside the HDF5
+   * file at filePath. If start and count are empty the whole dataset is used.
+   * Otherwise they describe the hyperslab of the dataset that holds the values
+   * and the product of count must match the size of the given shapes.
+   * @param filePath
+   * @param datasetPath
+   * @param tupleShape
+   * @param componentShape
+   * @param start = {}
+   * @param count = {}
+   */
+  H5ProxyDataStore(const std::filesystem::path& filePath, const std::string& datasetPath, const ShapeType& tupleShape, const ShapeType& componentShape, const DimsType& start = {},
+                   const DimsType& count = {})
+  : m_ComponentShape(componentShape)
+  , m_TupleShape(tupleShape)
+  , m_NumComponents(std::accumulate(m_ComponentShape.cbegin(), m_ComponentShape.cend(), static_cast<usize>(1), std::multiplies<>()))
+  , m_NumTuples(std::accumulate(m_TupleShape.cbegin(), m_TupleShape.cend(), static_cast<usize>(1), std::multiplies<>()))
+  , m_FilePath(filePath)
+  , m_DatasetPath(datasetPath)
+  , m_Start(start)
+  , m_Count(count)
+  {
+  }
+
+  H5ProxyDataStore(const H5ProxyDataStore& other) = delete;
+  H5ProxyDataStore(H5ProxyDataStore&& other) = delete;
+  H5ProxyDataStore& operator=(const H5ProxyDataStore& rhs) = delete;
+  H5ProxyDataStore& operator=(H5ProxyDataStore&& rhs) = delete;
+
+  ~H5ProxyDataStore() override = default;
+
+  /**
+   * @brief Returns the number of tuples in the DataStore.
+   * @return usize
+   */
+  usize getNumberOfTuples() const override
+  {
+    return m_NumTuples;
+  }
+
+  /**
+   * @brief Returns the number of elements in each Tuple.
+   * @return usize
+   */
+  usize getNumberOfComponents() const override
+  {
+    return m_NumComponents;
+  }
+
+  /**
+   * @brief Returns the dimensions of the Tuples
+   * @return
+   */
+  const ShapeType& getTupleShape() const override
+  {
+    return m_TupleShape;
+  }
+
+  /**
+   * @brief Returns the dimensions of the Components
+   * @return
+   */
+  const ShapeType& getComponentShape() const override
+  {
+    return m_ComponentShape;
+  }
+
+  /**
+   * @brief Returns the store type e.g. in memory, out of core, etc.
+   * @return StoreType
+   */
+  IDataStore::StoreType getStoreType() const override
+  {
+    return IDataStore::StoreType::Proxy;
+  }
+
+  /**
+   * @brief Returns the number of bytes held by the values once they have been
+   * read from the file. Returns 0 before then.
+   * @return usize
+   */
+  usize getMemoryUsage() const override
+  {
+    return m_Loaded.load() == nullptr ? 0 : this->getSize() * sizeof(T);
+  }
+
+  /**
+   * @brief Returns the path to the HDF5 file holding the values.
+   * @return const std::filesystem::path&
+   */
+  const std::filesystem::path& getFilePath() const
+  {
+    return m_FilePath;
+  }
+
+  /**
+   * @brief Returns the path of the dataset inside the HDF5 file.
+   * @return const std::string&
+   */
+  const std::string& getDatasetPath() const
+  {
+    return m_DatasetPath;
+  }
+
+  /**
+   * @brief Returns true if the values have been read from the file.
+   * @return bool
+   */
+  bool isLoaded() const
+  {
+    return m_Loaded.load(std::memory_order_acquire) != nullptr;
+  }
+
+  /**
+   * @brief Creates a proxy for a box of tuples of this proxy without reading
+   * any values. The tuple shape of the array must have the same rank as
+   * tupleStart and tupleCount, which are given slowest to fastest dimension.
+   * Every component of the selected tuples is included.
+   * @param tupleStart
+   * @param tupleCount
+   * @return std::shared_ptr<H5ProxyDataStore>
+   */
+  std::shared_ptr<H5ProxyDataStore> createSubVolume(const ShapeType& tupleStart, const ShapeType& tupleCount) const
+  {
+    const usize rank = m_TupleShape.size() + m_ComponentShape.size();
+    if(tupleStart.size() != m_TupleShape.size() || tupleCount.size() != m_TupleShape.size())
+    {
+      throw std::runtime_error(fmt::format("H5ProxyDataStore::createSubVolume: The sub-volume rank ({}) does not match the tuple rank ({})", tupleStart.size(), m_TupleShape.size()));
+    }
+    DimsType start = m_Start.empty() ? DimsType(rank, 0) : m_Start;
+    DimsType count(rank, 0);
+    for(usize i = 0; i < m_TupleShape.size(); i++)
+    {
+      if(tupleStart[i] + tupleCount[i] > m_TupleShape[i])
+      {
+        throw std::runtime_error(fmt::format("H5ProxyDataStore::createSubVolume: The sub-volume exceeds dimension {} of the array", i));
+      }
+      start[i] += tupleStart[i];
+      count[i] = tupleCount[i];
+    }
+    std::copy(m_ComponentShape.cbegin(), m_ComponentShape.cend(), count.begin() + m_TupleShape.size());
+    return std::make_shared<H5ProxyDataStore>(m_FilePath, m_DatasetPath, tupleCount, m_ComponentShape, start, count);
+  }
+
+  /**
+   * @brief Reads the values and resizes them to the new tuple shape. Values
+   * that fit in both the old and the new size are preserved.
+   * @param tupleShape
+   */
+  void reshapeTuples(const ShapeType& tupleShape) override
+  {
+    load().reshapeTuples(tupleShape);
+    m_TupleShape = tupleShape;
+    m_NumTuples = std::accumulate(m_TupleShape.cbegin(), m_TupleShape.cend(), static_cast<usize>(1), std::multiplies<>());
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * @param index
+   * @return value_type
+   */
+  value_type getValue(usize index) const override
+  {
+    return load().getValue(index);
+  }
+
+  /**
+   * @brief Sets the value stored at the specified index.
+   * @param index
+   * @param value
+   */
+  void setValue(usize index, value_type value) override
+  {
+    load().setValue(index, value);
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * @param index
+   * @return const_reference
+   */
+  const_reference operator[](usize index) const override
+  {
+    return load()[index];
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * @param index
+   * @return reference
+   */
+  reference operator[](usize index) override
+  {
+    return load()[index];
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * Throws if the index is out of bounds.
+   * @param index
+   * @return const_reference
+   */
+  const_reference at(usize index) const override
+  {
+    return load().at(index);
+  }
+
+  /**
+   * @brief Fills the store with the given value without reading the file.
+   * @param value
+   */
+  void fill(value_type value) override
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if(m_Store == nullptr)
+    {
+      m_Store = std::make_unique<DataStore<T>>(m_TupleShape, m_ComponentShape, value);
+      m_Loaded.store(m_Store.get(), std::memory_order_release);
+      return;
+    }
+    m_Store->fill(value);
+  }
+
+  /**
+   * @brief Copies buffer.size() values starting at startIndex into the given buffer.
+   * @param startIndex
+   * @param buffer
+   * @throw std::runtime_error
+   */
+  void copyIntoBuffer(usize startIndex, nonstd::span<T> buffer) const override
+  {
+    load().copyIntoBuffer(startIndex, buffer);
+  }
+
+  /**
+   * @brief Copies all values from the given buffer into the store starting at startIndex.
+   * @param startIndex
+   * @param buffer
+   * @throw std::runtime_error
+   */
+  void copyFromBuffer(usize startIndex, nonstd::span<const T> buffer) override
+  {
+    load().copyFromBuffer(startIndex, buffer);
+  }
+
+  /**
+   * @brief Calls the visitor with the contiguous runs of values of the loaded store.
+   * @param startIndex
+   * @param count
+   * @param visitor
+   */
+  void visitChunks(usize startIndex, usize count, const ChunkVisitor& visitor) override
+  {
+    load().visitChunks(startIndex, count, visitor);
+  }
+
+  /**
+   * @brief Calls the visitor with the contiguous runs of values of the loaded store.
+   * @param startIndex
+   * @param count
+   * @param visitor
+   */
+  void visitConstChunks(usize startIndex, usize count, const ConstChunkVisitor& visitor) const override
+  {
+    load().visitConstChunks(startIndex, count, visitor);
+  }
+
+  /**
+   * @brief Returns an in-memory copy of the values. If the values have not
+   * been read yet, they are read into the copy only and the proxy stays
+   * unloaded.
+   * @return std::unique_ptr<IDataStore>
+   */
+  std::unique_ptr<IDataStore> deepCopy() const override
+  {
+    if(const DataStore<T>* store = m_Loaded.load(std::memory_order_acquire); store != nullptr)
+    {
+      return store->deepCopy();
+    }
+    return readDataStore();
+  }
+
+  /**
+   * @brief Returns an in-memory data store of the same shape with default initialized data.
+   * @return std::unique_ptr<IDataStore>
+   */
+  std::unique_ptr<IDataStore> createNewInstance() const override
+  {
+    return std::make_unique<DataStore<T>>(m_TupleShape, m_ComponentShape, static_cast<T>(0));
+  }
+
+  /**
+   * @brief Reads the values and writes them to HDF5. Returns the HDF5 error
+   * code should one be encountered. Otherwise, returns 0.
+   * @param datasetWriter
+   * @return H5::ErrorType
+   */
+  H5::ErrorType writeHdf5(H5::DatasetWriter& datasetWriter) const override
+  {
+    return load().writeHdf5(datasetWriter);
+  }
+
+  /**
+   * @brief Creates a proxy for the dataset read by the given DatasetReader
+   * without reading its values.
+   * @param datasetReader
+   * @return std::unique_ptr<H5ProxyDataStore>
+   */
+  static std::unique_ptr<H5ProxyDataStore> ReadHdf5(const H5::DatasetReader& datasetReader)
+  {
+    auto tupleShape = IDataStore::ReadTupleShape(datasetReader);
+    auto componentShape = IDataStore::ReadComponentShape(datasetReader);
+    return std::make_unique<H5ProxyDataStore>(GetFilePath(datasetReader), "/" + H5::Support::GetObjectPath(datasetReader.getId()), tupleShape, componentShape);
+  }
+
+  /**
+   * @brief Returns the path of the HDF5 file the DatasetReader belongs to.
+   * @param datasetReader
+   * @return std::filesystem::path
+   */
+  static std::filesystem::path GetFilePath(const H5::DatasetReader& datasetReader)
+  {
+    const ssize_t nameSize = H5Fget_name(datasetReader.getId(), nullptr, 0);
+    if(nameSize <= 0)
+    {
+      return {};
+    }
+    std::vector<char> fileName(nameSize + 1, 0);
+    H5Fget_name(datasetReader.getId(), fileName.data(), fileName.size());
+    return std::filesystem::path(fileName.data());
+  }
+
+private:
+  /**
+   * @brief Returns the in-memory store, reading the values on first use.
+   * @return DataStore<T>&
+   */
+  DataStore<T>& load() const
+  {
+    if(DataStore<T>* store = m_Loaded.load(std::memory_order_acquire); store != nullptr)
+    {
+      return *store;
+    }
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if(m_Store == nullptr)
+    {
+      m_Store = readDataStore();
+      m_Loaded.store(m_Store.get(), std::memory_order_release);
+    }
+    return *m_Store;
+  }
+
+  /**
+   * @brief Reads the selected values from the file into a new DataStore.
+   * @return std::unique_ptr<DataStore<T>>
+   * @throw std::runtime_error
+   */
+  std::unique_ptr<DataStore<T>> readDataStore() const
+  {
+    // Proxies are loaded from whichever thread first touches them, so the
+    // read is serialized with every other HDF5 call in the process
+    std::lock_guard<std::recursive_mutex> libraryLock(H5::GetLibraryMutex());
+    H5::FileReader fileReader(m_FilePath);
+    if(!fileReader.isValid())
+    {
+      throw std::runtime_error(fmt::format("H5ProxyDataStore: Unable to open '{}' for reading", m_FilePath.string()));
+    }
+    H5::DatasetReader datasetReader = fileReader.openDataset(m_DatasetPath);
+    auto dataStore = std::make_unique<DataStore<T>>(m_TupleShape, m_ComponentShape, static_cast<T>(0));
+    const bool success = m_Start.empty() ? datasetReader.readIntoSpan(dataStore->createSpan()) : datasetReader.readHyperslabIntoSpan(m_Start, m_Count, dataStore->createSpan());
+    if(!success)
+    {
+      throw std::runtime_error(fmt::format("H5ProxyDataStore: Error reading data array from HDF5 at {}:{}", m_FilePath.string(), m_DatasetPath));
+    }
+    return dataStore;
+  }
+
+  ShapeType m_ComponentShape;
+  ShapeType m_TupleShape;
+  usize m_NumComponents = 0;
+  usize m_NumTuples = 0;
+  std::filesystem::path m_FilePath;
+  std::string m_DatasetPath;
+  DimsType m_Start;
+  DimsType m_Count;
+  mutable std::mutex m_Mutex;
+  mutable std::unique_ptr<DataStore<T>> m_Store;
+  mutable std::atomic<DataStore<T>*> m_Loaded = nullptr;
+};
+} // namespace complex
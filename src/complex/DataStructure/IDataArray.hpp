@@ -51,6 +51,13 @@ public:
    */
   virtual const IDataStore* getIDataStore() const = 0;
 
+  /**
+   * @brief Makes the array the sole owner of its IDataStore by copying it if
+   * it is shared with a copy of the array. Must be called before writing
+   * through getIDataStore().
+   */
+  virtual void detachDataStore() = 0;
+
   /**
    * @brief Returns a reference to the array's IDataStore.
    * @return IDataStore&
@@ -137,6 +144,7 @@ public:
    */
   void reshapeTuples(const std::vector<usize>& tupleShape) override
   {
+    detachDataStore();
     getIDataStoreRef().reshapeTuples(tupleShape);
   }
 
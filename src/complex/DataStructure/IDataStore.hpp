@@ -34,6 +34,8 @@ public:
     Unknown = -1,
     InMemory = 0,
     Empty,
+    OutOfCore,
+    Proxy,
   };
 
   virtual ~IDataStore() = default;
@@ -94,6 +96,16 @@ public:
    */
   virtual usize getTypeSize() const = 0;
 
+  /**
+   * @brief Returns the number of bytes of memory held by the stored values.
+   * Stores that keep their values elsewhere only count what is currently in memory.
+   * @return usize
+   */
+  virtual usize getMemoryUsage() const
+  {
+    return getSize() * getTypeSize();
+  }
+
   /**
    * @brief Returns a deep copy of the data store and all its data.
    * @return std::unique_ptr<IDataStore>
@@ -67,6 +67,12 @@ public:
    */
   virtual DataType getDataType() const = 0;
 
+  /**
+   * @brief Returns the number of bytes held by the lists.
+   * @return usize
+   */
+  virtual usize getMemoryUsage() const = 0;
+
   /**
    * @brief Returns an enumeration of the class or subclass. Used for quick comparison or type deduction
    * @return
@@ -26,6 +26,30 @@ NeighborList<T>::NeighborList(DataStructure& dataStructure, const std::string& n
 {
 }
 
+template <typename T>
+NeighborList<T>::NeighborList(DataStructure& dataStructure, const std::string& name, std::vector<usize> offsets, std::vector<T> values, IdType importId)
+: INeighborList(dataStructure, name, offsets.empty() ? 0 : offsets.size() - 1, importId)
+, m_Offsets(std::move(offsets))
+, m_Values(std::move(values))
+, m_IsCompact(true)
+, m_IsAllocated(true)
+, m_InitValue(static_cast<T>(0.0))
+{
+}
+
+template <typename T>
+NeighborList<T>::NeighborList(const NeighborList& other)
+: INeighborList(other)
+, m_IsAllocated(other.m_IsAllocated)
+, m_InitValue(other.m_InitValue)
+{
+  auto lock = other.lockCompactData();
+  m_Array = other.m_Array;
+  m_Offsets = other.m_Offsets;
+  m_Values = other.m_Values;
+  m_IsCompact = other.m_IsCompact.load();
+}
+
 template <typename T>
 NeighborList<T>* NeighborList<T>::Create(DataStructure& ds, const std::string& name, usize numTuples, const std::optional<IdType>& parentId)
 {
@@ -49,6 +73,67 @@ NeighborList<T>* NeighborList<T>::Import(DataStructure& ds, const std::string& n
   return data.get();
 }
 
+template <typename T>
+NeighborList<T>* NeighborList<T>::Import(DataStructure& ds, const std::string& name, IdType importId, std::vector<usize> offsets, std::vector<T> values, const std::optional<IdType>& parentId)
+{
+  auto data = std::shared_ptr<NeighborList>(new NeighborList(ds, name, std::move(offsets), std::move(values), importId));
+  if(!AttemptToAddObject(ds, data, parentId))
+  {
+    return nullptr;
+  }
+  return data.get();
+}
+
+template <typename T>
+void NeighborList<T>::unpack() const
+{
+  if(!m_IsCompact.load(std::memory_order_acquire))
+  {
+    return;
+  }
+  std::unique_lock<std::shared_mutex> lock(m_UnpackMutex);
+  if(!m_IsCompact.load(std::memory_order_relaxed))
+  {
+    return;
+  }
+  const usize numLists = m_Offsets.empty() ? 0 : m_Offsets.size() - 1;
+  m_Array.resize(numLists);
+  for(usize i = 0; i < numLists; i++)
+  {
+    m_Array[i] = std::make_shared<VectorType>(m_Values.begin() + m_Offsets[i], m_Values.begin() + m_Offsets[i + 1]);
+  }
+  // Readers of the compact form hold the lock, so the buffers can be freed here
+  m_Offsets = {};
+  m_Values = {};
+  m_IsCompact.store(false, std::memory_order_release);
+}
+
+template <typename T>
+std::shared_lock<std::shared_mutex> NeighborList<T>::lockCompactData() const
+{
+  std::shared_lock<std::shared_mutex> lock(m_UnpackMutex, std::defer_lock);
+  if(m_IsCompact.load(std::memory_order_acquire))
+  {
+    lock.lock();
+  }
+  return lock;
+}
+
+template <typename T>
+nonstd::span<const T> NeighborList<T>::listSpan(int32 grainId) const
+{
+  if(m_IsCompact.load(std::memory_order_relaxed))
+  {
+    return {m_Values.data() + m_Offsets[grainId], m_Offsets[grainId + 1] - m_Offsets[grainId]};
+  }
+  const SharedVectorType& list = m_Array[grainId];
+  if(list == nullptr)
+  {
+    return {};
+  }
+  return {list->data(), list->size()};
+}
+
 template <typename T>
 DataObject* NeighborList<T>::shallowCopy()
 {
@@ -87,7 +172,7 @@ int32 NeighborList<T>::eraseTuples(const std::vector<usize>& idxs)
     return 0;
   }
 
-  usize arraySize = m_Array.size();
+  usize arraySize = static_cast<usize>(getNumberOfLists());
   // Sanity Check the Indices in the vector to make sure we are not trying to remove any indices that are
   // off the end of the array and return an error code.
   for(usize idx : idxs)
@@ -98,6 +183,33 @@ int32 NeighborList<T>::eraseTuples(const std::vector<usize>& idxs)
     }
   }
 
+  if(m_IsCompact)
+  {
+    // Slide the kept lists down over the erased ones
+    usize idxsIndex = 0;
+    usize numKept = 0;
+    usize valueEnd = 0;
+    for(usize dIdx = 0; dIdx < arraySize; ++dIdx)
+    {
+      if(idxsIndex < idxsSize && dIdx == idxs[idxsIndex])
+      {
+        ++idxsIndex;
+        continue;
+      }
+      const usize listBegin = m_Offsets[dIdx];
+      const usize listEnd = m_Offsets[dIdx + 1];
+      std::copy(m_Values.begin() + listBegin, m_Values.begin() + listEnd, m_Values.begin() + valueEnd);
+      m_Offsets[numKept] = valueEnd;
+      valueEnd += listEnd - listBegin;
+      ++numKept;
+    }
+    m_Offsets[numKept] = valueEnd;
+    m_Offsets.resize(numKept + 1);
+    m_Values.resize(valueEnd);
+    setNumberOfTuples(numKept);
+    return err;
+  }
+
   std::vector<SharedVectorType> replacement(arraySize - idxsSize);
 
   usize idxsIndex = 0;
@@ -126,12 +238,18 @@ int32 NeighborList<T>::eraseTuples(const std::vector<usize>& idxs)
 template <typename T>
 void NeighborList<T>::copyTuple(usize currentPos, usize newPos)
 {
+  unpack();
   m_Array[newPos] = m_Array[currentPos];
 }
 
 template <typename T>
 usize NeighborList<T>::getSize() const
 {
+  auto lock = lockCompactData();
+  if(m_IsCompact)
+  {
+    return m_Values.size();
+  }
   usize total = 0;
   for(usize dIdx = 0; dIdx < m_Array.size(); ++dIdx)
   {
@@ -155,14 +273,26 @@ template <typename T>
 void NeighborList<T>::initializeWithZeros()
 {
   m_Array.clear();
+  m_Offsets.clear();
+  m_Values.clear();
+  m_IsCompact = false;
   m_IsAllocated = false;
 }
 
 template <typename T>
 int32 NeighborList<T>::resizeTotalElements(usize size)
 {
-  usize old = m_Array.size();
-  m_Array.resize(size);
+  if(m_IsCompact)
+  {
+    // New lists are empty
+    const usize lastOffset = m_Offsets.empty() ? 0 : m_Offsets.back();
+    m_Offsets.resize(size + 1, lastOffset);
+    m_Values.resize(m_Offsets.back());
+  }
+  else
+  {
+      m_Array.resize(size);
+  }
   setNumberOfTuples(size);
   if(size == 0)
   {
@@ -184,6 +314,7 @@ void NeighborList<T>::resizeTuples(usize numTuples)
 template <typename T>
 void NeighborList<T>::addEntry(int32 grainId, value_type value)
 {
+  unpack();
   if(grainId >= static_cast<int32>(m_Array.size()))
   {
     usize old = m_Array.size();
@@ -203,12 +334,16 @@ template <typename T>
 void NeighborList<T>::clearAllLists()
 {
   m_Array.clear();
+  m_Offsets.clear();
+  m_Values.clear();
+  m_IsCompact = false;
   m_IsAllocated = false;
 }
 
 template <typename T>
 void NeighborList<T>::setList(int32 grainId, const SharedVectorType& neighborList)
 {
+  unpack();
   if(grainId >= static_cast<int32>(m_Array.size()))
   {
     usize old = m_Array.size();
@@ -223,58 +358,151 @@ void NeighborList<T>::setList(int32 grainId, const SharedVectorType& neighborLis
   m_Array[grainId] = neighborList;
 }
 
+template <typename T>
+void NeighborList<T>::setLists(std::vector<usize> offsets, std::vector<T> values)
+{
+  const usize numLists = offsets.empty() ? 0 : offsets.size() - 1;
+  m_Array = {};
+  m_Offsets = std::move(offsets);
+  m_Values = std::move(values);
+  m_IsCompact = true;
+  m_IsAllocated = numLists > 0;
+  setNumberOfTuples(numLists);
+}
+
+template <typename T>
+void NeighborList<T>::compact()
+{
+  if(m_IsCompact)
+  {
+    return;
+  }
+  std::vector<usize> offsets(m_Array.size() + 1, 0);
+  for(usize i = 0; i < m_Array.size(); i++)
+  {
+    offsets[i + 1] = offsets[i] + (m_Array[i] == nullptr ? 0 : m_Array[i]->size());
+  }
+  std::vector<T> values(offsets.back());
+  for(usize i = 0; i < m_Array.size(); i++)
+  {
+    if(m_Array[i] != nullptr)
+    {
+      std::copy(m_Array[i]->cbegin(), m_Array[i]->cend(), values.begin() + offsets[i]);
+    }
+  }
+  m_Array = {};
+  m_Offsets = std::move(offsets);
+  m_Values = std::move(values);
+  m_IsCompact = true;
+}
+
+template <typename T>
+bool NeighborList<T>::isCompact() const
+{
+  return m_IsCompact;
+}
+
+template <typename T>
+const std::vector<usize>& NeighborList<T>::getOffsets()
+{
+  compact();
+  return m_Offsets;
+}
+
+template <typename T>
+const std::vector<T>& NeighborList<T>::getValues()
+{
+  compact();
+  return m_Values;
+}
+
+template <typename T>
+nonstd::span<const T> NeighborList<T>::getListSpan(int32 grainId) const
+{
+  auto lock = lockCompactData();
+  return listSpan(grainId);
+}
+
 template <typename T>
 T NeighborList<T>::getValue(int32 grainId, int32 index, bool& ok) const
 {
-  SharedVectorType vec = m_Array[grainId];
-  if(index < 0 || static_cast<usize>(index) >= vec->size())
+  auto lock = lockCompactData();
+  nonstd::span<const T> list = listSpan(grainId);
+  if(index < 0 || static_cast<usize>(index) >= list.size())
   {
     ok = false;
     return static_cast<T>(-1);
   }
-  return (*vec)[index];
+  return list[index];
 }
 
 template <typename T>
 int32 NeighborList<T>::getNumberOfLists() const
 {
+  auto lock = lockCompactData();
+  if(m_IsCompact)
+  {
+    return static_cast<int32>(m_Offsets.empty() ? 0 : m_Offsets.size() - 1);
+  }
   return static_cast<int32>(m_Array.size());
 }
 
+template <typename T>
+usize NeighborList<T>::getMemoryUsage() const
+{
+  auto lock = lockCompactData();
+  usize memoryUsage = m_Offsets.size() * sizeof(usize) + m_Values.size() * sizeof(T);
+  for(const auto& list : m_Array)
+  {
+    if(list != nullptr)
+    {
+      memoryUsage += list->size() * sizeof(T);
+    }
+  }
+  return memoryUsage;
+}
+
 template <typename T>
 int32 NeighborList<T>::getListSize(int32 grainId) const
 {
-  return static_cast<int32>(m_Array[grainId]->size());
+  auto lock = lockCompactData();
+  return static_cast<int32>(listSpan(grainId).size());
 }
 
 template <typename T>
 typename NeighborList<T>::VectorType& NeighborList<T>::getListReference(int32 grainId) const
 {
+  unpack();
   return *(m_Array[grainId]);
 }
 
 template <typename T>
 typename NeighborList<T>::SharedVectorType NeighborList<T>::getList(int32 grainId) const
 {
+  unpack();
   return m_Array[grainId];
 }
 
 template <typename T>
 typename NeighborList<T>::VectorType NeighborList<T>::copyOfList(int32 grainId) const
 {
-  VectorType copy(*(m_Array[grainId]));
+  auto lock = lockCompactData();
+  nonstd::span<const T> list = listSpan(grainId);
+  VectorType copy(list.begin(), list.end());
   return copy;
 }
 
 template <typename T>
 typename NeighborList<T>::VectorType& NeighborList<T>::operator[](int32 grainId)
 {
+  unpack();
   return *(m_Array[grainId]);
 }
 
 template <typename T>
 typename NeighborList<T>::VectorType& NeighborList<T>::operator[](usize grainId)
 {
+  unpack();
   return *(m_Array[grainId]);
 }
 
@@ -362,16 +590,18 @@ DataType COMPLEX_EXPORT NeighborList<float64>::getDataType() const
 template <typename T>
 H5::ErrorType NeighborList<T>::writeHdf5(H5::DataStructureWriter& dataStructureWriter, H5::GroupWriter& parentGroupWriter, bool importable) const
 {
+  // The compact buffers are written directly, so they must not be freed by an unpack meanwhile
+  auto lock = lockCompactData();
   DataStructure tmp;
 
   // Create NumNeighbors DataStore
-  const usize arraySize = m_Array.size();
+  const usize arraySize = m_IsCompact ? (m_Offsets.empty() ? 0 : m_Offsets.size() - 1) : m_Array.size();
   auto* numNeighborsArray = Int32Array::CreateWithStore<Int32DataStore>(tmp, getNumNeighborsArrayName(), {arraySize}, {1});
   auto& numNeighborsStore = numNeighborsArray->getDataStoreRef();
   usize totalItems = 0;
   for(usize i = 0; i < arraySize; i++)
   {
-    const auto numNeighbors = m_Array[i]->size();
+    const auto numNeighbors = listSpan(static_cast<int32>(i)).size();
     numNeighborsStore[i] = static_cast<int32>(numNeighbors);
     totalItems += numNeighbors;
   }
@@ -383,27 +613,43 @@ H5::ErrorType NeighborList<T>::writeHdf5(H5::DataStructureWriter& dataStructureW
     return error;
   }
 
-  // Create flattened neighbor DataStore
-  DataStore<T> flattenedData(totalItems, static_cast<T>(0));
-  usize offset = 0;
-  for(const auto& segment : m_Array)
+  // The compact values are written as they are. Separate lists are flattened first.
+  std::vector<T> flattenedData;
+  nonstd::span<const T> values;
+  if(m_IsCompact)
   {
-    usize numElements = segment->size();
-    if(numElements == 0)
-    {
-      continue;
-    }
-    T* start = segment->data();
-    for(usize i = 0; i < numElements; i++)
+    values = {m_Values.data(), m_Values.size()};
+  }
+  else
+  {
+    flattenedData.reserve(totalItems);
+    for(const auto& segment : m_Array)
     {
-      flattenedData[offset + i] = start[i];
+      if(segment != nullptr)
+      {
+        flattenedData.insert(flattenedData.end(), segment->cbegin(), segment->cend());
+      }
     }
-    offset += numElements;
+    values = {flattenedData.data(), flattenedData.size()};
   }
 
-  // Write flattened array to HDF5 as a separate array
+  // Write flattened array to HDF5 as a separate array with the same layout as a DataStore
   auto datasetWriter = parentGroupWriter.createDatasetWriter(getName());
-  H5::ErrorType err = flattenedData.writeHdf5(datasetWriter);
+  H5::ErrorType err = datasetWriter.writeSpan({static_cast<hsize_t>(totalItems), 1}, values);
+  if(err < 0)
+  {
+    return err;
+  }
+  const std::vector<usize> tupleShape = {totalItems};
+  const std::vector<usize> componentShape = {1};
+  auto tupleAttribute = datasetWriter.createAttribute(complex::H5::k_TupleShapeTag);
+  err = tupleAttribute.writeVector({tupleShape.size()}, tupleShape);
+  if(err < 0)
+  {
+    return err;
+  }
+  auto componentAttribute = datasetWriter.createAttribute(complex::H5::k_ComponentShapeTag);
+  err = componentAttribute.writeVector({componentShape.size()}, componentShape);
   if(err < 0)
   {
     return err;
@@ -418,7 +664,7 @@ H5::ErrorType NeighborList<T>::writeHdf5(H5::DataStructureWriter& dataStructureW
 }
 
 template <typename T>
-std::vector<typename NeighborList<T>::SharedVectorType> NeighborList<T>::ReadHdf5Data(const H5::GroupReader& parentGroup, const H5::DatasetReader& dataReader)
+std::pair<std::vector<usize>, std::vector<T>> NeighborList<T>::ReadHdf5CompactData(const H5::GroupReader& parentGroup, const H5::DatasetReader& dataReader)
 {
   auto numNeighborsAttributeName = dataReader.getAttribute("Linked NumNeighbors Dataset");
   auto numNeighborsName = numNeighborsAttributeName.readAsString();
@@ -428,26 +674,37 @@ std::vector<typename NeighborList<T>::SharedVectorType> NeighborList<T>::ReadHdf
   auto numNeighborsPtr = Int32DataStore::ReadHdf5(numNeighborsReader);
   auto& numNeighborsStore = *numNeighborsPtr.get();
 
-  std::vector<T> flatDataStore = dataReader.template readAsVector<T>();
-  if(flatDataStore.empty())
+  std::vector<T> values = dataReader.template readAsVector<T>();
+  if(values.empty())
   {
     throw std::runtime_error(fmt::format("Error reading neighbor list from DataStore from HDF5 at {}/{}", H5::Support::GetObjectPath(dataReader.getParentId()), dataReader.getName()));
   }
 
-  std::vector<SharedVectorType> dataVector;
-  usize offset = 0;
   const auto numTuples = numNeighborsStore.getNumberOfTuples();
+  std::vector<usize> offsets(numTuples + 1, 0);
   for(usize i = 0; i < numTuples; i++)
   {
-    const auto numNeighbors = numNeighborsStore[i];
-    auto sharedVector = std::make_shared<std::vector<T>>(numNeighbors);
-    std::vector<T>& vector = *sharedVector.get();
+    offsets[i + 1] = offsets[i] + static_cast<usize>(numNeighborsStore[i]);
+  }
+  if(offsets.back() > values.size())
+  {
+    throw std::runtime_error(fmt::format("Error reading neighbor list from HDF5 at {}/{}: {} holds more neighbors than the {} stored values", H5::Support::GetObjectPath(dataReader.getParentId()),
+                                         dataReader.getName(), numNeighborsName, values.size()));
+  }
 
-    size_t neighborListStart = offset;
-    size_t neighborListEnd = offset + numNeighbors;
-    sharedVector->assign(flatDataStore.begin() + neighborListStart, flatDataStore.begin() + neighborListEnd);
-    offset += numNeighbors;
-    dataVector.push_back(sharedVector);
+  return {std::move(offsets), std::move(values)};
+}
+
+template <typename T>
+std::vector<typename NeighborList<T>::SharedVectorType> NeighborList<T>::ReadHdf5Data(const H5::GroupReader& parentGroup, const H5::DatasetReader& dataReader)
+{
+  auto [offsets, values] = ReadHdf5CompactData(parentGroup, dataReader);
+
+  const usize numTuples = offsets.size() - 1;
+  std::vector<SharedVectorType> dataVector(numTuples);
+  for(usize i = 0; i < numTuples; i++)
+  {
+    dataVector[i] = std::make_shared<std::vector<T>>(values.begin() + offsets[i], values.begin() + offsets[i + 1]);
   }
 
   return dataVector;
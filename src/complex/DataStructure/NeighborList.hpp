@@ -2,6 +2,12 @@
 
 #include "complex/DataStructure/INeighborList.hpp"
 
+#include <nonstd/span.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+
 namespace complex
 {
 namespace H5
@@ -20,7 +26,14 @@ constexpr StringLiteral NumNeighborsTag = "_NumNeighbors";
 
 /**
  * @class NeighborList
- * @brief
+ * @brief Stores a variable length list of values for each tuple.
+ *
+ * The lists are either held as one shared vector per tuple or in a compact
+ * form where every list is a range of a single value vector described by an
+ * offsets vector (compressed sparse row). Lists filled through setLists() or
+ * read from HDF5 are compact. The compact form can be read through
+ * getListSpan() and written to HDF5 without copying. Accessors that hand
+ * out a vector per list first unpack the compact form into separate vectors.
  * @tparam T
  */
 template <class T>
@@ -57,6 +70,21 @@ public:
    */
   static NeighborList* Import(DataStructure& ds, const std::string& name, IdType importId, const std::vector<SharedVectorType>& data, const std::optional<IdType>& parentId = {});
 
+  /**
+   * @brief Imports a NeighborList from compact offsets and values. The vectors are
+   * adopted without copying. See setLists() for their layout.
+   * @param ds
+   * @param name
+   * @param importId
+   * @param offsets
+   * @param values
+   * @param parentId
+   * @return NeighborList<T>*
+   */
+  static NeighborList* Import(DataStructure& ds, const std::string& name, IdType importId, std::vector<usize> offsets, std::vector<T> values, const std::optional<IdType>& parentId = {});
+
+  NeighborList(const NeighborList& other);
+
   ~NeighborList() override = default;
 
   /**
@@ -152,6 +180,49 @@ public:
    */
   void setList(int32 grainId, const SharedVectorType& neighborList);
 
+  /**
+   * @brief Replaces all lists at once with the compact form. List i holds the values
+   * from values[offsets[i]] up to values[offsets[i + 1]]. Both vectors are adopted
+   * without copying.
+   * @param offsets Ascending offsets into values, one more than the number of lists
+   * @param values
+   */
+  void setLists(std::vector<usize> offsets, std::vector<T> values);
+
+  /**
+   * @brief Moves all lists into the compact form. Does nothing if the lists are
+   * already compact.
+   */
+  void compact();
+
+  /**
+   * @brief Returns true if the lists are held in the compact form.
+   * @return bool
+   */
+  bool isCompact() const;
+
+  /**
+   * @brief Returns the offsets of the compact form. The lists are compacted first if needed.
+   * @return const std::vector<usize>&
+   */
+  const std::vector<usize>& getOffsets();
+
+  /**
+   * @brief Returns the values of the compact form. The lists are compacted first if needed.
+   * @return const std::vector<T>&
+   */
+  const std::vector<T>& getValues();
+
+  /**
+   * @brief Returns a read only view of the target grain ID's list. This works
+   * with either storage form and never unpacks the compact form. The view is
+   * invalidated by any change to the lists, including an unpack of the compact
+   * form by an accessor that hands out vectors on another thread.
+   * @param grainId
+   * @return nonstd::span<const T>
+   */
+  nonstd::span<const T> getListSpan(int32 grainId) const;
+
   /**
    * @brief getValue
    * @param grainId
@@ -167,6 +238,12 @@ public:
    */
   int32 getNumberOfLists() const;
 
+  /**
+   * @brief Returns the number of bytes held by the lists in their current form.
+   * @return usize
+   */
+  usize getMemoryUsage() const override;
+
   /**
    * @brief getListSize
    * @param grainId
@@ -175,14 +252,14 @@ public:
   int32 getListSize(int32 grainId) const;
 
   /**
-   * @brief Returns a reference to the target grain ID's data.
+   * @brief Returns a reference to the target grain ID's data. Unpacks the compact form.
    * @param grainId
    * @return VectorType&
    */
   VectorType& getListReference(int32 grainId) const;
 
   /**
-   * @brief getList
+   * @brief Returns the target grain ID's list. Unpacks the compact form.
    * @param grainId
    * @return SharedVectorType
    */
@@ -307,6 +384,15 @@ public:
    */
   static std::vector<SharedVectorType> ReadHdf5Data(const H5::GroupReader& parentGroup, const H5::DatasetReader& dataReader);
 
+  /**
+   * @brief Reads the lists from HDF5 in the compact form. The values are read
+   * straight into the returned vector.
+   * @param parentGroup
+   * @param dataReader
+   * @return std::pair<std::vector<usize>, std::vector<T>> Offsets and values
+   */
+  static std::pair<std::vector<usize>, std::vector<T>> ReadHdf5CompactData(const H5::GroupReader& parentGroup, const H5::DatasetReader& dataReader);
+
 protected:
   /**
    * @brief NeighborList
@@ -318,8 +404,43 @@ protected:
    */
   NeighborList(DataStructure& dataStructure, const std::string& name, const std::vector<SharedVectorType>& dataVector, IdType importId);
 
+  /**
+   * @brief NeighborList
+   */
+  NeighborList(DataStructure& dataStructure, const std::string& name, std::vector<usize> offsets, std::vector<T> values, IdType importId);
+
 private:
-  std::vector<SharedVectorType> m_Array;
+  /**
+   * @brief Copies the compact form into one vector per list and frees the compact
+   * buffers. This is called by every accessor that hands out a vector and is safe to
+   * call from several threads. It holds m_UnpackMutex exclusively while the buffers
+   * are replaced.
+   */
+  void unpack() const;
+
+  /**
+   * @brief Locks m_UnpackMutex for reading if the lists are compact, so that an unpack
+   * on another thread cannot free the compact buffers while they are read. The
+   * unpacked lists are not replaced by const accessors and are read without the lock.
+   * @return std::shared_lock<std::shared_mutex>
+   */
+  std::shared_lock<std::shared_mutex> lockCompactData() const;
+
+  /**
+   * @brief Returns a view of the target grain ID's list. The caller holds the lock
+   * returned by lockCompactData().
+   * @param grainId
+   * @return nonstd::span<const T>
+   */
+  nonstd::span<const T> listSpan(int32 grainId) const;
+
+  // m_IsCompact tells which of the two forms holds the lists. The members are mutable
+  // so that the const accessors returning vectors can unpack the compact form.
+  mutable std::vector<SharedVectorType> m_Array;
+  mutable std::vector<usize> m_Offsets;
+  mutable std::vector<T> m_Values;
+  mutable std::atomic_bool m_IsCompact = false;
+  mutable std::shared_mutex m_UnpackMutex;
   bool m_IsAllocated;
   value_type m_InitValue;
 };
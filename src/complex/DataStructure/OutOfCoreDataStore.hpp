@@ -0,0 +1,756 @@
+#pragma once
+
+#include "complex/DataStructure/AbstractDataStore.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DatasetWriter.hpp"
+
+#include <fmt/core.h>
+
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace complex
+{
+/**
+ * @class OutOfCoreDataStore
+ * @brief The OutOfCoreDataStore class stores its values in a raw binary file
+ * on disk instead of in memory. Values are paged in and out of memory in
+ * fixed-size chunks through a bounded least-recently-used cache so that arrays
+ * larger than the available memory can be processed.
+ *
+ * References returned by operator[] point into a cached chunk. The chunks of
+ * the two most recent operator[] calls of each thread are pinned in the cache,
+ * so a reference stays valid until the same thread has taken references into
+ * two other chunks, no matter what other threads access. The cache can exceed
+ * maxCachedChunks by the chunks pinned this way. fill() and reshapeTuples()
+ * drop the cache and invalidate every reference.
+ *
+ * The backing file is created inside the given directory and deleted when the
+ * store is destroyed.
+ * @tparam T
+ */
+template <typename T>
+class OutOfCoreDataStore : public AbstractDataStore<T>
+{
+public:
+  using value_type = typename AbstractDataStore<T>::value_type;
+  using reference = typename AbstractDataStore<T>::reference;
+  using const_reference = typename AbstractDataStore<T>::const_reference;
+  using ShapeType = typename IDataStore::ShapeType;
+
+  static constexpr usize k_DefaultChunkSize = 1048576;
+  static constexpr usize k_DefaultMaxCachedChunks = 64;
+
+  /**
+   * @brief Constructs an OutOfCoreDataStore with the specified tuple and component shapes.
+   * The backing file is created lazily, chunks that were never written read back as initValue.
+   * @param tupleShape The dimensions of the tuples
+   * @param componentShape The dimensions of the component at each tuple
+   * @param initValue
+   * @param directory The directory to create the backing file in
+   * @param chunkSize The number of values in each chunk
+   * @param maxCachedChunks The maximum number of chunks held in memory at once
+   */
+  OutOfCoreDataStore(const ShapeType& tupleShape, const ShapeType& componentShape, std::optional<T> initValue, const std::filesystem::path& directory = std::filesystem::temp_directory_path(),
+                     usize chunkSize = k_DefaultChunkSize, usize maxCachedChunks = k_DefaultMaxCachedChunks)
+  : m_ComponentShape(componentShape)
+  , m_TupleShape(tupleShape)
+  , m_NumComponents(std::accumulate(m_ComponentShape.cbegin(), m_ComponentShape.cend(), static_cast<usize>(1), std::multiplies<>()))
+  , m_NumTuples(std::accumulate(m_TupleShape.cbegin(), m_TupleShape.cend(), static_cast<usize>(1), std::multiplies<>()))
+  , m_ChunkSize(std::max(chunkSize, static_cast<usize>(1)))
+  , m_MaxCachedChunks(std::max(maxCachedChunks, static_cast<usize>(1)))
+  , m_InitValue(initValue.value_or(static_cast<T>(0)))
+  , m_FilePath(CreateUniqueFilePath(directory))
+  {
+    m_ChunkOnDisk.resize(getNumberOfChunks(), false);
+    openFile();
+  }
+
+  /**
+   * @brief Copy constructor. Copies all values into a new backing file in the
+   * same directory as the source store.
+   * @param other
+   */
+  OutOfCoreDataStore(const OutOfCoreDataStore& other)
+  : m_ComponentShape(other.m_ComponentShape)
+  , m_TupleShape(other.m_TupleShape)
+  , m_NumComponents(other.m_NumComponents)
+  , m_NumTuples(other.m_NumTuples)
+  , m_ChunkSize(other.m_ChunkSize)
+  , m_MaxCachedChunks(other.m_MaxCachedChunks)
+  , m_InitValue(other.m_InitValue)
+  , m_FilePath(CreateUniqueFilePath(other.m_FilePath.parent_path()))
+  {
+    std::lock_guard<std::mutex> lock(other.m_Mutex);
+    other.flushChunks();
+    other.m_File.flush();
+    std::filesystem::copy_file(other.m_FilePath, m_FilePath, std::filesystem::copy_options::overwrite_existing);
+    m_ChunkOnDisk = other.m_ChunkOnDisk;
+    openFile(false);
+  }
+
+  OutOfCoreDataStore(OutOfCoreDataStore&& other) = delete;
+  OutOfCoreDataStore& operator=(const OutOfCoreDataStore& rhs) = delete;
+  OutOfCoreDataStore& operator=(OutOfCoreDataStore&& rhs) = delete;
+
+  ~OutOfCoreDataStore() override
+  {
+    m_File.close();
+    std::error_code errorCode;
+    std::filesystem::remove(m_FilePath, errorCode);
+  }
+
+  /**
+   * @brief Returns the number of tuples in the DataStore.
+   * @return usize
+   */
+  usize getNumberOfTuples() const override
+  {
+    return m_NumTuples;
+  }
+
+  /**
+   * @brief Returns the number of elements in each Tuple.
+   * @return usize
+   */
+  usize getNumberOfComponents() const override
+  {
+    return m_NumComponents;
+  }
+
+  /**
+   * @brief Returns the dimensions of the Tuples
+   * @return
+   */
+  const ShapeType& getTupleShape() const override
+  {
+    return m_TupleShape;
+  }
+
+  /**
+   * @brief Returns the dimensions of the Components
+   * @return
+   */
+  const ShapeType& getComponentShape() const override
+  {
+    return m_ComponentShape;
+  }
+
+  /**
+   * @brief Returns the store type e.g. in memory, out of core, etc.
+   * @return StoreType
+   */
+  IDataStore::StoreType getStoreType() const override
+  {
+    return IDataStore::StoreType::OutOfCore;
+  }
+
+  /**
+   * @brief Returns the number of bytes held by the chunks currently cached in memory.
+   * @return usize
+   */
+  usize getMemoryUsage() const override
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Cache.size() * m_ChunkSize * sizeof(T);
+  }
+
+  /**
+   * @brief Returns the path to the backing file.
+   * @return const std::filesystem::path&
+   */
+  const std::filesystem::path& getFilePath() const
+  {
+    return m_FilePath;
+  }
+
+  /**
+   * @brief Returns the number of values in each chunk.
+   * @return usize
+   */
+  usize getChunkSize() const
+  {
+    return m_ChunkSize;
+  }
+
+  /**
+   * @brief Returns the maximum number of chunks held in memory at once.
+   * @return usize
+   */
+  usize getMaxCachedChunks() const
+  {
+    return m_MaxCachedChunks;
+  }
+
+  /**
+   * @brief Resizes the store to the new tuple shape. Values that fit in both
+   * the old and the new size are preserved, values added by growing read back
+   * as the initial value.
+   * @param tupleShape
+   */
+  void reshapeTuples(const ShapeType& tupleShape) override
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    flushChunks();
+    clearCache();
+
+    const usize oldSize = m_NumTuples * m_NumComponents;
+    m_TupleShape = tupleShape;
+    m_NumTuples = std::accumulate(m_TupleShape.cbegin(), m_TupleShape.cend(), static_cast<usize>(1), std::multiplies<>());
+    m_ChunkOnDisk.resize(getNumberOfChunks(), false);
+
+    // The chunk that the new end cuts through keeps the removed values on disk, which growing again would read back
+    const usize newSize = m_NumTuples * m_NumComponents;
+    const usize lastChunkIndex = newSize / m_ChunkSize;
+    if(newSize < oldSize && newSize % m_ChunkSize != 0 && m_ChunkOnDisk[lastChunkIndex])
+    {
+      const usize count = std::min((lastChunkIndex + 1) * m_ChunkSize, oldSize) - newSize;
+      auto initValues = std::make_unique<T[]>(count);
+      std::fill_n(initValues.get(), count, m_InitValue);
+      m_File.seekp(static_cast<std::streamoff>(newSize * sizeof(T)));
+      m_File.write(reinterpret_cast<const char*>(initValues.get()), static_cast<std::streamsize>(count * sizeof(T)));
+      if(!m_File.good())
+      {
+        throw std::runtime_error(fmt::format("OutOfCoreDataStore: Error clearing chunk {} in '{}'", lastChunkIndex, m_FilePath.string()));
+      }
+    }
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * @param index
+   * @return value_type
+   */
+  value_type getValue(usize index) const override
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return *findValue(index, false);
+  }
+
+  /**
+   * @brief Sets the value stored at the specified index.
+   * @param index
+   * @param value
+   */
+  void setValue(usize index, value_type value) override
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    *findValue(index, true) = value;
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * The chunk stays pinned until the calling thread has referenced two other chunks.
+   * @param index
+   * @return const_reference
+   */
+  const_reference operator[](usize index) const override
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    T* value = findValue(index, false);
+    pinForThread(index / m_ChunkSize);
+    return *value;
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * The chunk stays pinned until the calling thread has referenced two other
+   * chunks. It is marked as modified and written back to disk on eviction.
+   * @param index
+   * @return reference
+   */
+  reference operator[](usize index) override
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    T* value = findValue(index, true);
+    pinForThread(index / m_ChunkSize);
+    return *value;
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * Throws if the index is out of bounds.
+   * @param index
+   * @return const_reference
+   */
+  const_reference at(usize index) const override
+  {
+    if(index >= this->getSize())
+    {
+      throw std::runtime_error(fmt::format("OutOfCoreDataStore::at: Index ({}) is greater than or equal to the size ({})", index, this->getSize()));
+    }
+    return (*this)[index];
+  }
+
+  /**
+   * @brief Fills the store with the given value without reading any existing
+   * chunks back from disk.
+   * @param value
+   */
+  void fill(value_type value) override
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    clearCache();
+    std::fill(m_ChunkOnDisk.begin(), m_ChunkOnDisk.end(), false);
+    m_InitValue = value;
+  }
+
+  /**
+   * @brief Writes all modified chunks back to the backing file.
+   */
+  void flush() const
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    flushChunks();
+    m_File.flush();
+  }
+
+  /**
+   * @brief Copies buffer.size() values starting at startIndex into the given buffer.
+   * This only locks and looks up each chunk once instead of once per value.
+   * @param startIndex
+   * @param buffer
+   * @throw std::runtime_error
+   */
+  void copyIntoBuffer(usize startIndex, nonstd::span<T> buffer) const override
+  {
+    this->checkRange(startIndex, buffer.size());
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    usize offset = 0;
+    while(offset < buffer.size())
+    {
+      const usize index = startIndex + offset;
+      const usize count = std::min(buffer.size() - offset, m_ChunkSize - (index % m_ChunkSize));
+      const T* values = findValue(index, false);
+      std::copy(values, values + count, buffer.begin() + offset);
+      offset += count;
+    }
+  }
+
+  /**
+   * @brief Copies all values from the given buffer into the store starting at startIndex.
+   * Each affected chunk is looked up once and marked as modified.
+   * @param startIndex
+   * @param buffer
+   * @throw std::runtime_error
+   */
+  void copyFromBuffer(usize startIndex, nonstd::span<const T> buffer) override
+  {
+    this->checkRange(startIndex, buffer.size());
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    usize offset = 0;
+    while(offset < buffer.size())
+    {
+      const usize index = startIndex + offset;
+      const usize count = std::min(buffer.size() - offset, m_ChunkSize - (index % m_ChunkSize));
+      T* values = findValue(index, true);
+      // The buffer may be a span of this store's cached memory
+      std::memmove(values, buffer.data() + offset, count * sizeof(T));
+      offset += count;
+    }
+  }
+
+  /**
+   * @brief Calls the visitor with the cached memory of each chunk that the
+   * range covers. The chunk is pinned and marked as modified while the visitor
+   * runs, so the visitor may access this store as well.
+   * @param startIndex
+   * @param count
+   * @param visitor
+   * @throw std::runtime_error
+   */
+  void visitChunks(usize startIndex, usize count, const typename AbstractDataStore<T>::ChunkVisitor& visitor) override
+  {
+    this->checkRange(startIndex, count);
+    usize offset = 0;
+    while(offset < count)
+    {
+      const usize index = startIndex + offset;
+      const usize valueCount = std::min(count - offset, m_ChunkSize - (index % m_ChunkSize));
+      Chunk& chunk = pinChunk(index / m_ChunkSize, true);
+      try
+      {
+        visitor(index, nonstd::span<T>(chunk.values.get() + (index % m_ChunkSize), valueCount));
+      } catch(...)
+      {
+        unpinChunk(chunk);
+        throw;
+      }
+      unpinChunk(chunk);
+      offset += valueCount;
+    }
+  }
+
+  /**
+   * @brief Calls the visitor with the cached memory of each chunk that the
+   * range covers. The chunk is pinned while the visitor runs, so the visitor
+   * may access this store as well.
+   * @param startIndex
+   * @param count
+   * @param visitor
+   * @throw std::runtime_error
+   */
+  void visitConstChunks(usize startIndex, usize count, const typename AbstractDataStore<T>::ConstChunkVisitor& visitor) const override
+  {
+    this->checkRange(startIndex, count);
+    usize offset = 0;
+    while(offset < count)
+    {
+      const usize index = startIndex + offset;
+      const usize valueCount = std::min(count - offset, m_ChunkSize - (index % m_ChunkSize));
+      Chunk& chunk = pinChunk(index / m_ChunkSize, false);
+      try
+      {
+        visitor(index, nonstd::span<const T>(chunk.values.get() + (index % m_ChunkSize), valueCount));
+      } catch(...)
+      {
+        unpinChunk(chunk);
+        throw;
+      }
+      unpinChunk(chunk);
+      offset += valueCount;
+    }
+  }
+
+  /**
+   * @brief Returns a deep copy of the data store and all its data.
+   * @return std::unique_ptr<IDataStore>
+   */
+  std::unique_ptr<IDataStore> deepCopy() const override
+  {
+    return std::make_unique<OutOfCoreDataStore<T>>(*this);
+  }
+
+  /**
+   * @brief Returns a data store of the same type as this but with default initialized data.
+   * @return std::unique_ptr<IDataStore>
+   */
+  std::unique_ptr<IDataStore> createNewInstance() const override
+  {
+    return std::make_unique<OutOfCoreDataStore<T>>(this->getTupleShape(), this->getComponentShape(), static_cast<T>(0), m_FilePath.parent_path(), m_ChunkSize, m_MaxCachedChunks);
+  }
+
+  /**
+   * @brief Writes the data store to HDF5 one block at a time so that the
+   * whole array never has to be held in memory. Returns the HDF5 error code
+   * should one be encountered. Otherwise, returns 0.
+   * @param datasetWriter
+   * @return H5::ErrorType
+   */
+  H5::ErrorType writeHdf5(H5::DatasetWriter& datasetWriter) const override
+  {
+    if(!datasetWriter.isValid())
+    {
+      return -1;
+    }
+
+    std::vector<hsize_t> h5dims;
+    for(const auto& value : m_TupleShape)
+    {
+      h5dims.push_back(static_cast<hsize_t>(value));
+    }
+    for(const auto& value : m_ComponentShape)
+    {
+      h5dims.push_back(static_cast<hsize_t>(value));
+    }
+
+    herr_t err = this->writeHdf5InBlocks(datasetWriter, h5dims, m_ChunkSize);
+    if(err < 0)
+    {
+      return err;
+    }
+
+    // Write shape attributes to the dataset
+    auto tupleAttribute = datasetWriter.createAttribute(complex::H5::k_TupleShapeTag);
+    err = tupleAttribute.writeVector({m_TupleShape.size()}, m_TupleShape);
+    if(err < 0)
+    {
+      return err;
+    }
+
+    auto componentAttribute = datasetWriter.createAttribute(complex::H5::k_ComponentShapeTag);
+    err = componentAttribute.writeVector({m_ComponentShape.size()}, m_ComponentShape);
+
+    return err;
+  }
+
+private:
+  static constexpr usize k_NoChunk = std::numeric_limits<usize>::max();
+
+  struct Chunk
+  {
+    std::unique_ptr<T[]> values;
+    bool modified = false;
+    // Pinned chunks are never evicted
+    usize pinCount = 0;
+    typename std::list<usize>::iterator lruPosition;
+  };
+
+  /**
+   * @brief The chunks that a thread's two most recent operator[] calls referenced.
+   */
+  struct ThreadChunks
+  {
+    usize recent = k_NoChunk;
+    usize previous = k_NoChunk;
+  };
+
+  /**
+   * @brief Returns a unique file path inside the given directory.
+   * @param directory
+   * @return std::filesystem::path
+   */
+  static std::filesystem::path CreateUniqueFilePath(const std::filesystem::path& directory)
+  {
+    static const uint32 s_ProcessTag = std::random_device{}();
+    static std::atomic<uint64> s_FileCounter = 0;
+    std::filesystem::path filePath;
+    do
+    {
+      filePath = directory / fmt::format("complex_ooc_{:08x}_{}.bin", s_ProcessTag, s_FileCounter++);
+    } while(std::filesystem::exists(filePath));
+    return filePath;
+  }
+
+  /**
+   * @brief Opens the backing file. Throws if it cannot be opened.
+   * @param truncate
+   */
+  void openFile(bool truncate = true)
+  {
+    auto mode = std::ios::in | std::ios::out | std::ios::binary;
+    if(truncate)
+    {
+      mode |= std::ios::trunc;
+    }
+    m_File.open(m_FilePath, mode);
+    if(!m_File.is_open())
+    {
+      throw std::runtime_error(fmt::format("OutOfCoreDataStore: Unable to open backing file '{}'", m_FilePath.string()));
+    }
+  }
+
+  /**
+   * @brief Returns the number of chunks needed for the current size.
+   * @return usize
+   */
+  usize getNumberOfChunks() const
+  {
+    return (m_NumTuples * m_NumComponents + m_ChunkSize - 1) / m_ChunkSize;
+  }
+
+  /**
+   * @brief Returns the number of values stored in the given chunk. Only the
+   * last chunk can be smaller than the chunk size.
+   * @param chunkIndex
+   * @return usize
+   */
+  usize getChunkValueCount(usize chunkIndex) const
+  {
+    const usize size = m_NumTuples * m_NumComponents;
+    return std::min(m_ChunkSize, size - chunkIndex * m_ChunkSize);
+  }
+
+  /**
+   * @brief Writes the chunk back to the backing file.
+   * @param chunkIndex
+   * @param chunk
+   */
+  void writeChunk(usize chunkIndex, const Chunk& chunk) const
+  {
+    const usize count = getChunkValueCount(chunkIndex);
+    m_File.seekp(static_cast<std::streamoff>(chunkIndex * m_ChunkSize * sizeof(T)));
+    m_File.write(reinterpret_cast<const char*>(chunk.values.get()), static_cast<std::streamsize>(count * sizeof(T)));
+    if(!m_File.good())
+    {
+      throw std::runtime_error(fmt::format("OutOfCoreDataStore: Error writing chunk {} to '{}'", chunkIndex, m_FilePath.string()));
+    }
+    m_ChunkOnDisk[chunkIndex] = true;
+  }
+
+  /**
+   * @brief Drops every cached chunk without writing it back. The caller must hold m_Mutex.
+   */
+  void clearCache() const
+  {
+    m_Cache.clear();
+    m_LruList.clear();
+    m_ThreadChunks.clear();
+    m_LastChunk = nullptr;
+  }
+
+  /**
+   * @brief Pins the given cached chunk for the calling thread and unpins the
+   * chunk the thread referenced before the previous one. The caller must hold m_Mutex.
+   * @param chunkIndex
+   */
+  void pinForThread(usize chunkIndex) const
+  {
+    ThreadChunks& threadChunks = m_ThreadChunks[std::this_thread::get_id()];
+    if(threadChunks.recent == chunkIndex)
+    {
+      return;
+    }
+    if(threadChunks.previous != chunkIndex)
+    {
+      if(auto iter = m_Cache.find(threadChunks.previous); iter != m_Cache.end())
+      {
+        iter->second.pinCount--;
+      }
+      m_Cache.at(chunkIndex).pinCount++;
+    }
+    threadChunks.previous = threadChunks.recent;
+    threadChunks.recent = chunkIndex;
+  }
+
+  /**
+   * @brief Loads the given chunk if necessary and pins it until unpinChunk() is called.
+   * @param chunkIndex
+   * @param markModified
+   * @return Chunk&
+   */
+  Chunk& pinChunk(usize chunkIndex, bool markModified) const
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    findValue(chunkIndex * m_ChunkSize, markModified);
+    Chunk& chunk = *m_LastChunk;
+    chunk.pinCount++;
+    return chunk;
+  }
+
+  /**
+   * @brief Releases a pin taken by pinChunk().
+   * @param chunk
+   */
+  void unpinChunk(Chunk& chunk) const
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    chunk.pinCount--;
+  }
+
+  /**
+   * @brief Writes every modified chunk in the cache back to the backing file.
+   * The caller must hold m_Mutex.
+   */
+  void flushChunks() const
+  {
+    for(auto& [chunkIndex, chunk] : m_Cache)
+    {
+      if(chunk.modified)
+      {
+        writeChunk(chunkIndex, chunk);
+        chunk.modified = false;
+      }
+    }
+  }
+
+  /**
+   * @brief Returns a pointer to the value at the given index, loading its
+   * chunk into the cache if necessary. The caller must hold m_Mutex.
+   * @param index
+   * @param markModified
+   * @return T*
+   */
+  T* findValue(usize index, bool markModified) const
+  {
+    const usize chunkIndex = index / m_ChunkSize;
+    Chunk* chunk = nullptr;
+    if(chunkIndex == m_LastChunkIndex && m_LastChunk != nullptr)
+    {
+      chunk = m_LastChunk;
+    }
+    else
+    {
+      auto iter = m_Cache.find(chunkIndex);
+      if(iter != m_Cache.end())
+      {
+        chunk = &iter->second;
+        m_LruList.splice(m_LruList.begin(), m_LruList, chunk->lruPosition);
+      }
+      else
+      {
+        chunk = &loadChunk(chunkIndex);
+      }
+      m_LastChunkIndex = chunkIndex;
+      m_LastChunk = chunk;
+    }
+    chunk->modified = chunk->modified || markModified;
+    return chunk->values.get() + (index % m_ChunkSize);
+  }
+
+  /**
+   * @brief Reads the given chunk into the cache, evicting the least recently
+   * used chunk that is not pinned if the cache is full. The caller must hold m_Mutex.
+   * @param chunkIndex
+   * @return Chunk&
+   */
+  Chunk& loadChunk(usize chunkIndex) const
+  {
+    if(m_Cache.size() >= m_MaxCachedChunks)
+    {
+      auto lruPosition = std::find_if(m_LruList.rbegin(), m_LruList.rend(), [this](usize index) { return m_Cache.at(index).pinCount == 0; });
+      if(lruPosition != m_LruList.rend())
+      {
+        auto evicted = m_Cache.find(*lruPosition);
+        if(evicted->second.modified)
+        {
+          writeChunk(evicted->first, evicted->second);
+        }
+        if(m_LastChunk == &evicted->second)
+        {
+          m_LastChunk = nullptr;
+        }
+        m_LruList.erase(std::next(lruPosition).base());
+        m_Cache.erase(evicted);
+      }
+    }
+
+    Chunk chunk;
+    chunk.values = std::make_unique<T[]>(m_ChunkSize);
+    const usize count = getChunkValueCount(chunkIndex);
+    std::fill_n(chunk.values.get(), m_ChunkSize, m_InitValue);
+    if(m_ChunkOnDisk[chunkIndex])
+    {
+      m_File.seekg(static_cast<std::streamoff>(chunkIndex * m_ChunkSize * sizeof(T)));
+      m_File.read(reinterpret_cast<char*>(chunk.values.get()), static_cast<std::streamsize>(count * sizeof(T)));
+      // A chunk that grew through reshapeTuples() may extend past the end of the file
+      m_File.clear();
+    }
+    m_LruList.push_front(chunkIndex);
+    chunk.lruPosition = m_LruList.begin();
+    return m_Cache.emplace(chunkIndex, std::move(chunk)).first->second;
+  }
+
+  ShapeType m_ComponentShape;
+  ShapeType m_TupleShape;
+  usize m_NumComponents = {0};
+  usize m_NumTuples = {0};
+  usize m_ChunkSize = k_DefaultChunkSize;
+  usize m_MaxCachedChunks = k_DefaultMaxCachedChunks;
+  T m_InitValue = {};
+  std::filesystem::path m_FilePath;
+  mutable std::fstream m_File;
+  mutable std::vector<bool> m_ChunkOnDisk;
+  mutable std::unordered_map<usize, Chunk> m_Cache;
+  mutable std::list<usize> m_LruList;
+  mutable usize m_LastChunkIndex = 0;
+  mutable Chunk* m_LastChunk = nullptr;
+  mutable std::unordered_map<std::thread::id, ThreadChunks> m_ThreadChunks;
+  mutable std::mutex m_Mutex;
+};
+} // namespace complex
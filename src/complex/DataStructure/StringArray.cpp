@@ -158,6 +158,16 @@ usize StringArray::getSize() const
   return size();
 }
 
+usize StringArray::getMemoryUsage() const
+{
+  usize memoryUsage = m_Strings.size() * sizeof(value_type);
+  for(const auto& string : m_Strings)
+  {
+    memoryUsage += string.size();
+  }
+  return memoryUsage;
+}
+
 IArray::ShapeType StringArray::getTupleShape() const
 {
   return {size()};
@@ -60,6 +60,12 @@ public:
    */
   usize getSize() const override;
 
+  /**
+   * @brief Returns the number of bytes held by the strings.
+   * @return usize
+   */
+  usize getMemoryUsage() const;
+
   /**
    * @brief Returns the tuple shape.
    * @return
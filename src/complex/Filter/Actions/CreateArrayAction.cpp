@@ -5,16 +5,32 @@
 #include "complex/Common/TypeTraits.hpp"
 #include "complex/DataStructure/EmptyDataStore.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
 
 using namespace complex;
 
+namespace
+{
+struct ProjectMemoryUsageFunctor
+{
+  template <typename T>
+  usize operator()(const std::vector<usize>& tDims, const std::vector<usize>& cDims, bool packBits)
+  {
+    return ProjectDataStoreMemoryUsage<T>(tDims, cDims, packBits);
+  }
+};
+} // namespace
+
 namespace complex
 {
-CreateArrayAction::CreateArrayAction(DataType type, const std::vector<usize>& tDims, const std::vector<usize>& cDims, const DataPath& path)
+CreateArrayAction::CreateArrayAction(DataType type, const std::vector<usize>& tDims, const std::vector<usize>& cDims, const DataPath& path, bool packBits,
+                                     AllocationPolicy allocationPolicy)
 : IDataCreationAction(path)
 , m_Type(type)
 , m_Dims(tDims)
 , m_CDims(cDims)
+, m_PackBits(packBits)
+, m_AllocationPolicy(allocationPolicy)
 {
 }
 
@@ -25,37 +41,37 @@ Result<> CreateArrayAction::apply(DataStructure& dataStructure, Mode mode) const
   switch(m_Type)
   {
   case DataType::int8: {
-    return CreateArray<int8>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode);
+    return CreateArray<int8>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode, false, m_AllocationPolicy);
   }
   case DataType::uint8: {
-    return CreateArray<uint8>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode);
+    return CreateArray<uint8>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode, false, m_AllocationPolicy);
   }
   case DataType::int16: {
-    return CreateArray<int16>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode);
+    return CreateArray<int16>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode, false, m_AllocationPolicy);
   }
   case DataType::uint16: {
-    return CreateArray<uint16>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode);
+    return CreateArray<uint16>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode, false, m_AllocationPolicy);
   }
   case DataType::int32: {
-    return CreateArray<int32>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode);
+    return CreateArray<int32>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode, false, m_AllocationPolicy);
   }
   case DataType::uint32: {
-    return CreateArray<uint32>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode);
+    return CreateArray<uint32>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode, false, m_AllocationPolicy);
   }
   case DataType::int64: {
-    return CreateArray<int64>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode);
+    return CreateArray<int64>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode, false, m_AllocationPolicy);
   }
   case DataType::uint64: {
-    return CreateArray<uint64>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode);
+    return CreateArray<uint64>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode, false, m_AllocationPolicy);
   }
   case DataType::float32: {
-    return CreateArray<float32>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode);
+    return CreateArray<float32>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode, false, m_AllocationPolicy);
   }
   case DataType::float64: {
-    return CreateArray<float64>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode);
+    return CreateArray<float64>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode, false, m_AllocationPolicy);
   }
   case DataType::boolean: {
-    return CreateArray<bool>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode);
+    return CreateArray<bool>(dataStructure, m_Dims, m_CDims, getCreatedPath(), mode, m_PackBits, m_AllocationPolicy);
   }
   default: {
     throw std::runtime_error(fmt::format("CreateArrayAction: Invalid DataType '{}'", to_underlying(m_Type)));
@@ -78,6 +94,21 @@ const std::vector<usize>& CreateArrayAction::componentDims() const
   return m_CDims;
 }
 
+bool CreateArrayAction::packBits() const
+{
+  return m_PackBits;
+}
+
+AllocationPolicy CreateArrayAction::allocationPolicy() const
+{
+  return m_AllocationPolicy;
+}
+
+usize CreateArrayAction::projectedMemoryUsage() const
+{
+  return ExecuteDataFunction(ProjectMemoryUsageFunctor{}, m_Type, m_Dims, m_CDims, m_PackBits);
+}
+
 DataPath CreateArrayAction::path() const
 {
   return getCreatedPath();
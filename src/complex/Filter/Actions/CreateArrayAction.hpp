@@ -13,7 +13,17 @@ class COMPLEX_EXPORT CreateArrayAction : public IDataCreationAction
 public:
   CreateArrayAction() = delete;
 
-  CreateArrayAction(DataType type, const std::vector<usize>& tDims, const std::vector<usize>& cDims, const DataPath& path);
+  /**
+   * @brief Constructs a CreateArrayAction.
+   * @param type
+   * @param tDims
+   * @param cDims
+   * @param path
+   * @param packBits Boolean arrays are stored one bit per value instead of one byte. Ignored for other types.
+   * @param allocationPolicy Use AllocationPolicy::Uninitialized when the filter overwrites every value
+   */
+  CreateArrayAction(DataType type, const std::vector<usize>& tDims, const std::vector<usize>& cDims, const DataPath& path, bool packBits = false,
+                    AllocationPolicy allocationPolicy = AllocationPolicy::Zeroed);
 
   ~CreateArrayAction() noexcept override;
 
@@ -54,6 +64,25 @@ public:
    */
   DataPath path() const;
 
+  /**
+   * @brief Returns true if a boolean array is created with one bit per value.
+   * @return bool
+   */
+  bool packBits() const;
+
+  /**
+   * @brief Returns how the values of the DataArray to be created are initialized.
+   * @return AllocationPolicy
+   */
+  AllocationPolicy allocationPolicy() const;
+
+  /**
+   * @brief Returns the number of bytes of memory the created DataArray is projected
+   * to hold during execution. Bit packing and out of core storage are taken into account.
+   * @return usize
+   */
+  usize projectedMemoryUsage() const;
+
   /**
    * @brief Returns all of the DataPaths to be created.
    * @return std::vector<DataPath>
@@ -64,5 +93,7 @@ private:
   DataType m_Type;
   std::vector<usize> m_Dims;
   std::vector<usize> m_CDims;
+  bool m_PackBits = false;
+  AllocationPolicy m_AllocationPolicy = AllocationPolicy::Zeroed;
 };
 } // namespace complex
@@ -1,13 +1,18 @@
 #include "ImportH5ObjectPathsAction.hpp"
 
 #include <algorithm>
+#include <utility>
 
 #include <fmt/core.h>
 
+#include "complex/DataStructure/AttributeMatrix.hpp"
 #include "complex/DataStructure/BaseGroup.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/EmptyDataStore.hpp"
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
+#include "complex/DataStructure/H5ProxyDataStore.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
 #include "complex/Utilities/Parsing/DREAM3D/Dream3dIO.hpp"
 
 using namespace complex;
@@ -15,6 +20,8 @@ using namespace complex;
 namespace
 {
 constexpr complex::int32 k_InsertFailureError = -2;
+constexpr complex::int32 k_InvalidSubVolumeError = -3;
+constexpr complex::int32 k_SubVolumeOutOfBoundsError = -4;
 
 void sortImportPaths(std::vector<DataPath>& importPaths)
 {
@@ -27,14 +34,132 @@ std::vector<DataPath> getImportPaths(const DataStructure& importStructure, const
   sortImportPaths(paths);
   return paths;
 }
+
+struct CropCellArrayFunctor
+{
+  /**
+   * @brief Replaces the DataStore of the array with one holding the tuples
+   * inside the box. Proxies only narrow the hyperslab that will be read and
+   * preflight stores only change shape.
+   * @param array
+   * @param volumeShape Volume size in Z, Y, X order
+   * @param start Box start in Z, Y, X order
+   * @param count Box size in Z, Y, X order
+   */
+  template <typename T>
+  void operator()(IDataArray& array, const std::vector<usize>& volumeShape, const std::vector<usize>& start, const std::vector<usize>& count)
+  {
+    auto& dataArray = dynamic_cast<DataArray<T>&>(array);
+    const auto& oldStore = std::as_const(dataArray).getDataStoreRef();
+    const auto componentShape = oldStore.getComponentShape();
+
+    if(const auto* proxyStore = dynamic_cast<const H5ProxyDataStore<T>*>(&oldStore); proxyStore != nullptr && oldStore.getTupleShape() == volumeShape)
+    {
+      dataArray.setDataStore(proxyStore->createSubVolume(start, count));
+      return;
+    }
+    if(oldStore.getStoreType() == IDataStore::StoreType::Empty)
+    {
+      dataArray.setDataStore(std::make_shared<EmptyDataStore<T>>(count, componentShape));
+      return;
+    }
+
+    const usize numComponents = oldStore.getNumberOfComponents();
+    const usize rowSize = count[2] * numComponents;
+    auto newStore = std::make_shared<DataStore<T>>(count, componentShape, static_cast<T>(0));
+    auto row = std::make_unique<T[]>(rowSize);
+    usize destIndex = 0;
+    for(usize z = 0; z < count[0]; z++)
+    {
+      for(usize y = 0; y < count[1]; y++)
+      {
+        const usize srcTuple = ((start[0] + z) * volumeShape[1] + (start[1] + y)) * volumeShape[2] + start[2];
+        oldStore.copyIntoBuffer(srcTuple * numComponents, nonstd::span<T>(row.get(), rowSize));
+        newStore->copyFromBuffer(destIndex, nonstd::span<const T>(row.get(), rowSize));
+        destIndex += rowSize;
+      }
+    }
+    dataArray.setDataStore(std::move(newStore));
+  }
+};
+
+/**
+ * @brief Crops the cell data of each ImageGeom in the DataStructure to the
+ * sub-volume and updates the geometry's dimensions and origin to match.
+ * @param dataStructure
+ * @param subVolume
+ * @return Result<>
+ */
+Result<> cropImageGeometries(DataStructure& dataStructure, const ImportH5ObjectPathsAction::SubVolume& subVolume)
+{
+  const auto& minVoxel = subVolume.MinVoxel;
+  const auto& maxVoxel = subVolume.MaxVoxel;
+  if(minVoxel.size() != 3 || maxVoxel.size() != 3)
+  {
+    return MakeErrorResult(k_InvalidSubVolumeError, "The sub-volume bounds must have exactly 3 values each (X, Y, Z)");
+  }
+  for(usize i = 0; i < 3; i++)
+  {
+    if(minVoxel[i] > maxVoxel[i])
+    {
+      return MakeErrorResult(k_InvalidSubVolumeError, fmt::format("The sub-volume min voxel ({}) is greater than the max voxel ({}) for dimension {}", minVoxel[i], maxVoxel[i], i));
+    }
+  }
+
+  for(const auto& path : dataStructure.getAllDataPaths())
+  {
+    auto* imageGeom = dataStructure.getDataAs<ImageGeom>(path);
+    if(imageGeom == nullptr)
+    {
+      continue;
+    }
+    const SizeVec3 dims = imageGeom->getDimensions();
+    for(usize i = 0; i < 3; i++)
+    {
+      if(maxVoxel[i] >= dims[i])
+      {
+        return MakeErrorResult(k_SubVolumeOutOfBoundsError,
+                               fmt::format("The sub-volume max voxel ({}) is outside of the Image Geometry '{}' extent ({}) for dimension {}", maxVoxel[i], path.toString(), dims[i], i));
+      }
+    }
+
+    const std::vector<usize> volumeShape = {dims[2], dims[1], dims[0]};
+    const std::vector<usize> start = {static_cast<usize>(minVoxel[2]), static_cast<usize>(minVoxel[1]), static_cast<usize>(minVoxel[0])};
+    const std::vector<usize> count = {static_cast<usize>(maxVoxel[2] - minVoxel[2] + 1), static_cast<usize>(maxVoxel[1] - minVoxel[1] + 1), static_cast<usize>(maxVoxel[0] - minVoxel[0] + 1)};
+    const usize numCells = dims[0] * dims[1] * dims[2];
+
+    AttributeMatrix* cellData = imageGeom->getCellData();
+    if(cellData != nullptr)
+    {
+      for(const auto& [id, object] : *cellData)
+      {
+        auto* dataArray = dynamic_cast<IDataArray*>(object.get());
+        if(dataArray == nullptr || dataArray->getNumberOfTuples() != numCells)
+        {
+          continue;
+        }
+        ExecuteDataFunction(CropCellArrayFunctor{}, dataArray->getDataType(), *dataArray, volumeShape, start, count);
+      }
+      cellData->setShape(count);
+    }
+
+    const FloatVec3 origin = imageGeom->getOrigin();
+    const FloatVec3 spacing = imageGeom->getSpacing();
+    imageGeom->setDimensions(SizeVec3(count[2], count[1], count[0]));
+    imageGeom->setOrigin(origin[0] + static_cast<float32>(minVoxel[0]) * spacing[0], origin[1] + static_cast<float32>(minVoxel[1]) * spacing[1],
+                         origin[2] + static_cast<float32>(minVoxel[2]) * spacing[2]);
+  }
+  return {};
+}
 } // namespace
 
 namespace complex
 {
-ImportH5ObjectPathsAction::ImportH5ObjectPathsAction(const std::filesystem::path& importFile, const PathsType& paths)
+ImportH5ObjectPathsAction::ImportH5ObjectPathsAction(const std::filesystem::path& importFile, const PathsType& paths, const std::optional<SubVolume>& subVolume)
 : IDataCreationAction({})
 , m_H5FilePath(importFile)
 , m_Paths(paths)
+, m_SubVolume(subVolume)
 {
   if(m_Paths.has_value())
   {
@@ -48,8 +173,9 @@ Result<> ImportH5ObjectPathsAction::apply(DataStructure& dataStructure, Mode mod
 {
   bool preflighting = (mode == Mode::Preflight);
 
+  // Arrays are read lazily so that only the imported paths and sub-volume are read from the file
   H5::FileReader fileReader(m_H5FilePath);
-  Result<DataStructure> dataStructureResult = DREAM3D::ImportDataStructureFromFile(fileReader, preflighting);
+  Result<DataStructure> dataStructureResult = DREAM3D::ImportDataStructureFromFile(fileReader, preflighting, !preflighting);
   if(dataStructureResult.invalid())
   {
     return ConvertResult(std::move(dataStructureResult));
@@ -59,9 +185,19 @@ Result<> ImportH5ObjectPathsAction::apply(DataStructure& dataStructure, Mode mod
   DataStructure importStructure = std::move(dataStructureResult.value());
   importStructure.resetIds(dataStructure.getNextId());
 
+  if(m_SubVolume.has_value())
+  {
+    Result<> cropResult = cropImageGeometries(importStructure, *m_SubVolume);
+    if(cropResult.invalid())
+    {
+      return cropResult;
+    }
+  }
+
   auto importPaths = getImportPaths(importStructure, m_Paths);
   for(const auto& targetPath : importPaths)
   {
+    // Copying a DataArray reads its proxied values into memory
     auto importObject = importStructure.getSharedData(targetPath);
     auto importData = std::shared_ptr<DataObject>(importObject->deepCopy());
     // Clear all children before inserting into the DataStructure
@@ -11,15 +11,28 @@ namespace complex
 {
 /**
  * @brief Action for importing DataObjects from an HDF5 file.
+ *
+ * When executing, the file is imported lazily so only the DataArrays under the
+ * requested paths are read. An optional sub-volume crops the cell data of every
+ * ImageGeom in the file while reading, so voxels outside of it are never read.
  */
 class COMPLEX_EXPORT ImportH5ObjectPathsAction : public IDataCreationAction
 {
 public:
   using PathsType = std::optional<std::vector<DataPath>>;
 
+  /**
+   * @brief Inclusive voxel bounds given in X, Y, Z order.
+   */
+  struct SubVolume
+  {
+    std::vector<uint64> MinVoxel;
+    std::vector<uint64> MaxVoxel;
+  };
+
   ImportH5ObjectPathsAction() = delete;
 
-  ImportH5ObjectPathsAction(const std::filesystem::path& importFile, const PathsType& paths);
+  ImportH5ObjectPathsAction(const std::filesystem::path& importFile, const PathsType& paths, const std::optional<SubVolume>& subVolume = {});
 
   ~ImportH5ObjectPathsAction() noexcept override;
 
@@ -46,5 +59,6 @@ public:
 private:
   std::filesystem::path m_H5FilePath;
   PathsType m_Paths;
+  std::optional<SubVolume> m_SubVolume;
 };
 } // namespace complex
@@ -190,47 +190,83 @@ IFilter::PreflightResult IFilter::preflight(const DataStructure& data, const Arg
 IFilter::ExecuteResult IFilter::execute(DataStructure& data, const Arguments& args, const PipelineFilter* pipelineFilter, const MessageHandler& messageHandler,
                                         const std::atomic_bool& shouldCancel) const
 {
+  PreparedExecute prepared = prepareExecute(data, args, messageHandler, shouldCancel);
+  applyPreparedActions(data, prepared);
+  executePrepared(data, prepared, pipelineFilter, messageHandler, shouldCancel);
+  return finishExecute(data, std::move(prepared), shouldCancel);
+}
+
+IFilter::PreparedExecute IFilter::prepareExecute(const DataStructure& data, const Arguments& args, const MessageHandler& messageHandler, const std::atomic_bool& shouldCancel) const
+{
+  PreparedExecute prepared;
   PreflightResult preflightResult = preflight(data, args, messageHandler, shouldCancel);
+  prepared.outputValues = std::move(preflightResult.outputValues);
   if(preflightResult.outputActions.invalid())
   {
-    return ExecuteResult{ConvertResult(std::move(preflightResult.outputActions)), std::move(preflightResult.outputValues)};
+    prepared.result = ConvertResult(std::move(preflightResult.outputActions));
+    return prepared;
   }
 
-  OutputActions outputActions = std::move(preflightResult.outputActions.value());
+  prepared.outputActions = std::move(preflightResult.outputActions.value());
+  prepared.result = ConvertResult(std::move(preflightResult.outputActions));
+  prepared.args = args;
+  return prepared;
+}
 
-  Result<> outputActionsResult = ConvertResult(std::move(preflightResult.outputActions));
+void IFilter::applyPreparedActions(DataStructure& data, PreparedExecute& prepared) const
+{
+  if(prepared.result.invalid())
+  {
+    return;
+  }
 
-  Result<> actionsResult = outputActions.applyRegular(data, IDataAction::Mode::Execute);
+  Result<> actionsResult = prepared.outputActions.applyRegular(data, IDataAction::Mode::Execute);
 
-  Result<> preflightActionsResult = MergeResults(std::move(outputActionsResult), std::move(actionsResult));
+  prepared.result = MergeResults(std::move(prepared.result), std::move(actionsResult));
 
-  if(preflightActionsResult.invalid())
+  if(prepared.result.invalid())
   {
-    return ExecuteResult{std::move(preflightActionsResult), std::move(preflightResult.outputValues)};
+    return;
   }
 
   Parameters params = parameters();
   // We can discard the warnings since they're already reported in preflight
-  auto [resolvedArgs, warnings] = GetResolvedArgs(args, params, *this);
+  auto [resolvedArgs, warnings] = GetResolvedArgs(prepared.args, params, *this);
+  prepared.args = std::move(resolvedArgs);
+  prepared.actionsApplied = true;
+}
 
-  Result<> executeImplResult = executeImpl(data, resolvedArgs, pipelineFilter, messageHandler, shouldCancel);
-  if(shouldCancel)
+void IFilter::executePrepared(DataStructure& data, PreparedExecute& prepared, const PipelineFilter* pipelineNode, const MessageHandler& messageHandler,
+                              const std::atomic_bool& shouldCancel) const
+{
+  if(!prepared.actionsApplied)
   {
-    return {MakeErrorResult(-1, "Filter cancelled")};
+    return;
   }
 
-  Result<> preflightActionsExecuteResult = MergeResults(std::move(preflightActionsResult), std::move(executeImplResult));
+  Result<> executeImplResult = executeImpl(data, prepared.args, pipelineNode, messageHandler, shouldCancel);
+  prepared.executed = true;
+
+  prepared.result = MergeResults(std::move(prepared.result), std::move(executeImplResult));
+}
+
+IFilter::ExecuteResult IFilter::finishExecute(DataStructure& data, PreparedExecute&& prepared, const std::atomic_bool& shouldCancel) const
+{
+  if(prepared.executed && shouldCancel)
+  {
+    return {MakeErrorResult(-1, "Filter cancelled")};
+  }
 
-  if(preflightActionsExecuteResult.invalid())
+  if(prepared.result.invalid())
   {
-    return ExecuteResult{std::move(preflightActionsExecuteResult), std::move(preflightResult.outputValues)};
+    return ExecuteResult{std::move(prepared.result), std::move(prepared.outputValues)};
   }
 
-  Result<> deferredActionsResult = outputActions.applyDeferred(data, IDataAction::Mode::Execute);
+  Result<> deferredActionsResult = prepared.outputActions.applyDeferred(data, IDataAction::Mode::Execute);
 
-  Result<> finalResult = MergeResults(std::move(preflightActionsExecuteResult), std::move(deferredActionsResult));
+  Result<> finalResult = MergeResults(std::move(prepared.result), std::move(deferredActionsResult));
 
-  return ExecuteResult{std::move(finalResult), std::move(preflightResult.outputValues)};
+  return ExecuteResult{std::move(finalResult), std::move(prepared.outputValues)};
 }
 
 nlohmann::json IFilter::toJson(const Arguments& args) const
@@ -94,6 +94,21 @@ public:
     std::vector<PreflightValue> outputValues;
   };
 
+  /**
+   * @brief Holds the state of an execution that has been split into stages.
+   * Calling prepareExecute, applyPreparedActions, executePrepared and
+   * finishExecute in order is equivalent to calling execute.
+   */
+  struct PreparedExecute
+  {
+    Result<> result;
+    std::vector<PreflightValue> outputValues;
+    OutputActions outputActions;
+    Arguments args;
+    bool actionsApplied = false;
+    bool executed = false;
+  };
+
   virtual ~IFilter() noexcept;
 
   IFilter(const IFilter&) = delete;
@@ -169,6 +184,50 @@ public:
   ExecuteResult execute(DataStructure& data, const Arguments& args, const PipelineFilter* pipelineNode = nullptr, const MessageHandler& messageHandler = {},
                         const std::atomic_bool& shouldCancel = false) const;
 
+  /**
+   * @brief First stage of a staged execution. Preflights the filter without
+   * modifying the DataStructure. The returned OutputActions describe what the
+   * execution will change.
+   * @param data
+   * @param args
+   * @param messageHandler = {}
+   * @param shouldCancel
+   * @return PreparedExecute
+   */
+  PreparedExecute prepareExecute(const DataStructure& data, const Arguments& args, const MessageHandler& messageHandler = {}, const std::atomic_bool& shouldCancel = false) const;
+
+  /**
+   * @brief Second stage of a staged execution. Applies the regular OutputActions
+   * to the DataStructure. Does nothing if a previous stage failed.
+   * @param data
+   * @param prepared
+   */
+  void applyPreparedActions(DataStructure& data, PreparedExecute& prepared) const;
+
+  /**
+   * @brief Third stage of a staged execution. Runs the filter's algorithm.
+   * Does nothing if a previous stage failed. This stage does not add or remove
+   * DataObjects, so it may run concurrently with the same stage of filters
+   * that use different DataObjects.
+   * @param data
+   * @param prepared
+   * @param pipelineNode = nullptr
+   * @param messageHandler = {}
+   * @param shouldCancel
+   */
+  void executePrepared(DataStructure& data, PreparedExecute& prepared, const PipelineFilter* pipelineNode = nullptr, const MessageHandler& messageHandler = {},
+                       const std::atomic_bool& shouldCancel = false) const;
+
+  /**
+   * @brief Last stage of a staged execution. Applies the deferred OutputActions
+   * and returns the combined result of all stages.
+   * @param data
+   * @param prepared
+   * @param shouldCancel
+   * @return ExecuteResult
+   */
+  ExecuteResult finishExecute(DataStructure& data, PreparedExecute&& prepared, const std::atomic_bool& shouldCancel = false) const;
+
   /**
    * @brief Converts the given arguments to a JSON representation using the filter's parameters.
    * @param args
@@ -15,6 +15,10 @@
 
 #include <nlohmann/json.hpp>
 
+#ifdef COMPLEX_ENABLE_MULTICORE
+#include <tbb/task_group.h>
+#endif
+
 using namespace complex;
 
 namespace
@@ -35,6 +39,8 @@ Pipeline::Pipeline(const Pipeline& other)
 , m_Name(other.m_Name)
 , m_Collection(other.m_Collection)
 , m_FilterList(other.m_FilterList)
+, m_ConcurrentExecution(other.m_ConcurrentExecution)
+, m_MemoryBudget(other.m_MemoryBudget)
 {
   resetCollectionParent();
 }
@@ -44,6 +50,8 @@ Pipeline::Pipeline(Pipeline&& other) noexcept
 , m_Name(std::move(other.m_Name))
 , m_Collection(std::move(other.m_Collection))
 , m_FilterList(std::move(other.m_FilterList))
+, m_ConcurrentExecution(other.m_ConcurrentExecution)
+, m_MemoryBudget(other.m_MemoryBudget)
 {
   resetCollectionParent();
 }
@@ -61,6 +69,8 @@ Pipeline& Pipeline::operator=(const Pipeline& rhs) noexcept
   m_Name = rhs.m_Name;
   m_Collection = rhs.m_Collection;
   m_FilterList = rhs.m_FilterList;
+  m_ConcurrentExecution = rhs.m_ConcurrentExecution;
+  m_MemoryBudget = rhs.m_MemoryBudget;
   resetCollectionParent();
   return *this;
 }
@@ -70,6 +80,8 @@ Pipeline& Pipeline::operator=(Pipeline&& rhs) noexcept
   m_Name = std::move(rhs.m_Name);
   m_Collection = std::move(rhs.m_Collection);
   m_FilterList = std::move(rhs.m_FilterList);
+  m_ConcurrentExecution = rhs.m_ConcurrentExecution;
+  m_MemoryBudget = rhs.m_MemoryBudget;
   resetCollectionParent();
   return *this;
 }
@@ -286,12 +298,86 @@ bool Pipeline::executeFrom(index_type index, DataStructure& ds, const std::atomi
   }
 
   clearFaultState();
+
+#ifdef COMPLEX_ENABLE_MULTICORE
+  const bool groupFilters = m_ConcurrentExecution;
+#else
+  const bool groupFilters = false;
+#endif
+
   // Loop over each filter and execute the filter.
-  for(auto iter = begin() + index; iter != end(); iter++)
+  auto iter = begin() + index;
+  while(iter != end())
   {
     auto* filter = iter->get();
     if(filter->isDisabled())
     {
+      iter++;
+      continue;
+    }
+
+    if(groupFilters && dynamic_cast<PipelineFilter*>(filter) != nullptr)
+    {
+      std::vector<PipelineFilter::DataAccess> groupAccess;
+      std::optional<DataStructure> groupInput;
+      std::vector<PipelineFilter*> filterGroup = prepareFilterGroup(iter, ds, shouldCancel, groupAccess, groupInput);
+
+#ifdef COMPLEX_ENABLE_MULTICORE
+      // The first filter runs on the calling thread, so it sends its messages
+      // from there as it would outside of a group
+      tbb::task_group taskGroup;
+      for(usize i = 1; i < filterGroup.size(); i++)
+      {
+        auto* groupFilter = filterGroup[i];
+        taskGroup.run([groupFilter, &ds, &shouldCancel]() { groupFilter->runExecution(ds, shouldCancel); });
+      }
+      if(!filterGroup.empty())
+      {
+        filterGroup.front()->runExecution(ds, shouldCancel);
+      }
+      taskGroup.wait();
+#endif
+
+      // Report the results in pipeline order. Filters after the first failure
+      // are dropped along with their messages and outputs as if they never ran.
+      bool stop = false;
+      for(usize i = 0; i < filterGroup.size(); i++)
+      {
+        if(stop)
+        {
+          filterGroup[i]->discardExecution();
+          const std::vector<DataPath>& createdPaths = groupAccess[i].createdPaths;
+          for(auto createdPath = createdPaths.crbegin(); createdPath != createdPaths.crend(); ++createdPath)
+          {
+            ds.removeData(*createdPath);
+          }
+          if(groupInput.has_value())
+          {
+            groupAccess[i].restoreInputs(ds, *groupInput);
+          }
+          continue;
+        }
+        bool success = filterGroup[i]->finishExecution(ds, shouldCancel);
+        // Check if the filter was cancelled, and send out signal if it was.
+        if(shouldCancel)
+        {
+          sendCancelledMessage();
+          stop = true;
+          continue;
+        }
+
+        setHasWarnings(filterGroup[i]->hasWarnings());
+        if(!success)
+        {
+          setHasErrors();
+          returnValue = false;
+          stop = true;
+        }
+      }
+      if(stop)
+      {
+        break;
+      }
       continue;
     }
 
@@ -310,6 +396,7 @@ bool Pipeline::executeFrom(index_type index, DataStructure& ds, const std::atomi
       returnValue = false;
       break;
     }
+    iter++;
   }
 
   setDataStructure(ds);
@@ -320,6 +407,80 @@ bool Pipeline::executeFrom(index_type index, DataStructure& ds, const std::atomi
   return returnValue;
 }
 
+std::vector<PipelineFilter*> Pipeline::prepareFilterGroup(iterator& iter, DataStructure& ds, const std::atomic_bool& shouldCancel, std::vector<PipelineFilter::DataAccess>& groupAccess,
+                                                          std::optional<DataStructure>& groupInput)
+{
+  std::vector<PipelineFilter*> filterGroup;
+  groupAccess.clear();
+  groupInput.reset();
+  for(; iter != end(); iter++)
+  {
+    if(iter->get()->isDisabled())
+    {
+      continue;
+    }
+    auto* filter = dynamic_cast<PipelineFilter*>(iter->get());
+    if(filter == nullptr || (shouldCancel && !filterGroup.empty()))
+    {
+      break;
+    }
+
+    // Only the first filter of the group reports its messages as they happen.
+    // The others hold them back until the filters before them have finished.
+    // A filter that fails to preflight here may depend on the deferred actions
+    // of the group. It is prepared again once the group has finished.
+    if(!filter->prepareExecution(ds, shouldCancel, !filterGroup.empty()))
+    {
+      if(filterGroup.empty())
+      {
+        filterGroup.push_back(filter);
+        groupAccess.emplace_back();
+        iter++;
+      }
+      else
+      {
+        filter->discardExecution();
+      }
+      break;
+    }
+
+    // The filters after the first one may have to be dropped when a filter before
+    // them fails, so their actions may only create DataObjects and any change to
+    // their inputs must be undone from a copy of the DataStructure
+    PipelineFilter::DataAccess access = filter->getExecutionAccess();
+    const bool conflicts = std::any_of(groupAccess.cbegin(), groupAccess.cend(), [&access](const PipelineFilter::DataAccess& other) { return access.conflictsWith(other); });
+    if(conflicts || (!filterGroup.empty() && (!access.droppable || !access.canRestoreInputs(ds))))
+    {
+      filter->discardExecution();
+      break;
+    }
+
+    // The copy shares its DataStores with ds. The DataObjects the group already
+    // created or may modify without being dropped are removed from it, so that
+    // writing to them does not copy their DataStores.
+    if(!filterGroup.empty() && !access.inputPaths.empty() && !groupInput.has_value())
+    {
+      groupInput.emplace(ds);
+      for(const auto& groupMemberAccess : groupAccess)
+      {
+        for(const auto& path : groupMemberAccess.createdPaths)
+        {
+          groupInput->removeData(path);
+        }
+        for(const auto& path : groupMemberAccess.inputPaths)
+        {
+          groupInput->removeData(path);
+        }
+      }
+    }
+
+    filter->applyExecutionActions(ds);
+    filterGroup.push_back(filter);
+    groupAccess.push_back(std::move(access));
+  }
+  return filterGroup;
+}
+
 bool Pipeline::executeFrom(index_type index, const std::atomic_bool& shouldCancel)
 {
   if(index == 0)
@@ -360,6 +521,47 @@ bool Pipeline::hasErrorsBeforeIndex(index_type index) const
   return false;
 }
 
+bool Pipeline::isConcurrentExecutionEnabled() const
+{
+  return m_ConcurrentExecution;
+}
+
+void Pipeline::setConcurrentExecutionEnabled(bool enabled)
+{
+  m_ConcurrentExecution = enabled;
+}
+
+std::optional<uint64> Pipeline::getMemoryBudget() const
+{
+  return m_MemoryBudget;
+}
+
+void Pipeline::setMemoryBudget(std::optional<uint64> budget)
+{
+  m_MemoryBudget = budget;
+}
+
+std::vector<usize> Pipeline::getProjectedMemoryUsage() const
+{
+  std::vector<usize> memoryUsage;
+  memoryUsage.reserve(m_Collection.size());
+  for(const auto& node : m_Collection)
+  {
+    memoryUsage.push_back(node->getPreflightStructure().getMemoryUsage());
+  }
+  return memoryUsage;
+}
+
+usize Pipeline::getProjectedPeakMemoryUsage() const
+{
+  std::vector<usize> memoryUsage = getProjectedMemoryUsage();
+  if(memoryUsage.empty())
+  {
+    return 0;
+  }
+  return *std::max_element(memoryUsage.cbegin(), memoryUsage.cend());
+}
+
 usize Pipeline::size() const
 {
   return m_Collection.size();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <vector>
 
 #include "complex/Common/Result.hpp"
@@ -7,6 +8,7 @@
 #include "complex/Filter/IFilter.hpp"
 #include "complex/Pipeline/AbstractPipelineNode.hpp"
 #include "complex/Pipeline/Messaging/PipelineNodeObserver.hpp"
+#include "complex/Pipeline/PipelineFilter.hpp"
 
 namespace complex
 {
@@ -251,6 +253,51 @@ public:
    */
   bool executeFrom(index_type index, const std::atomic_bool& shouldCancel = false);
 
+  /**
+   * @brief Returns true if consecutive filters that use different DataObjects
+   * and files are executed concurrently. Filters are always executed one at
+   * a time when complex is built without multicore support.
+   * @return bool
+   */
+  bool isConcurrentExecutionEnabled() const;
+
+  /**
+   * @brief Sets whether consecutive filters that use different DataObjects and
+   * files are executed concurrently.
+   * @param enabled
+   */
+  void setConcurrentExecutionEnabled(bool enabled);
+
+  /**
+   * @brief Returns the maximum number of bytes the DataStructure may hold after
+   * any filter in the pipeline. An empty optional means no budget is enforced.
+   * @return std::optional<uint64>
+   */
+  std::optional<uint64> getMemoryBudget() const;
+
+  /**
+   * @brief Sets the maximum number of bytes the DataStructure may hold after any
+   * filter in the pipeline. Filters whose preflight would exceed the budget fail
+   * during preflight instead of running out of memory during execution. Nested
+   * pipelines without their own budget use the budget of their parent.
+   * @param budget
+   */
+  void setMemoryBudget(std::optional<uint64> budget);
+
+  /**
+   * @brief Returns the number of bytes the DataStructure is projected to hold
+   * after each node in the pipeline. Requires the pipeline to have been preflighted.
+   * @return std::vector<usize>
+   */
+  std::vector<usize> getProjectedMemoryUsage() const;
+
+  /**
+   * @brief Returns the largest number of bytes the DataStructure is projected to
+   * hold after any node in the pipeline. Requires the pipeline to have been preflighted.
+   * @return usize
+   */
+  usize getProjectedPeakMemoryUsage() const;
+
   /**
    * @brief Returns the getSize of the pipeline segment.
    * @return usize
@@ -598,10 +645,29 @@ private:
    */
   bool hasErrorsBeforeIndex(index_type index) const;
 
+  /**
+   * @brief Prepares the execution of the consecutive filters starting at iter
+   * that can run concurrently and applies their actions to the DataStructure.
+   * A filter joins the group if its DataAccess does not conflict with any
+   * filter already in the group and, unless it is the first filter, its
+   * results can be dropped. Advances iter past the group.
+   * @param iter
+   * @param ds
+   * @param shouldCancel
+   * @param groupAccess Set to the DataAccess of each filter in the group
+   * @param groupInput Set to a copy of ds taken before the group ran if a
+   * filter after the first one has inputs to restore when it is dropped
+   * @return std::vector<PipelineFilter*>
+   */
+  std::vector<PipelineFilter*> prepareFilterGroup(iterator& iter, DataStructure& ds, const std::atomic_bool& shouldCancel, std::vector<PipelineFilter::DataAccess>& groupAccess,
+                                                  std::optional<DataStructure>& groupInput);
+
   ////////////
   // Variables
   std::string m_Name;
   collection_type m_Collection;
   FilterList* m_FilterList = nullptr;
+  bool m_ConcurrentExecution = true;
+  std::optional<uint64> m_MemoryBudget;
 };
 } // namespace complex
@@ -3,11 +3,23 @@
 #include <algorithm>
 
 #include "complex/Core/Application.hpp"
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/Filter/Actions/CopyGroupAction.hpp"
+#include "complex/Filter/Actions/DeleteDataAction.hpp"
+#include "complex/Filter/Actions/EmptyAction.hpp"
+#include "complex/Filter/Actions/MoveDataAction.hpp"
+#include "complex/Filter/Actions/RenameDataAction.hpp"
+#include "complex/Filter/Actions/UpdateImageGeomAction.hpp"
 #include "complex/Filter/FilterList.hpp"
+#include "complex/Parameters/FileSystemPathParameter.hpp"
 #include "complex/Pipeline/Messaging/FilterPreflightMessage.hpp"
 #include "complex/Pipeline/Messaging/OutputRenamedMessage.hpp"
 #include "complex/Pipeline/Messaging/PipelineFilterMessage.hpp"
+#include "complex/Pipeline/Pipeline.hpp"
+#include "complex/Utilities/ArrayThreshold.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
 
+#include <fmt/core.h>
 #include <nlohmann/json.hpp>
 
 using namespace complex;
@@ -18,6 +30,25 @@ constexpr StringLiteral k_ArgsKey = "args";
 constexpr StringLiteral k_FilterKey = "filter";
 constexpr StringLiteral k_FilterNameKey = "name";
 constexpr StringLiteral k_FilterUuidKey = "uuid";
+
+constexpr int32 k_MemoryBudgetExceededError = -6100;
+
+/**
+ * @brief Returns the memory budget of the closest pipeline that has one.
+ * @param pipeline
+ * @return std::optional<uint64>
+ */
+std::optional<uint64> FindMemoryBudget(const Pipeline* pipeline)
+{
+  for(; pipeline != nullptr; pipeline = pipeline->getParentPipeline())
+  {
+    if(std::optional<uint64> budget = pipeline->getMemoryBudget(); budget.has_value())
+    {
+      return budget;
+    }
+  }
+  return {};
+}
 } // namespace
 
 std::unique_ptr<PipelineFilter> PipelineFilter::Create(const FilterHandle& handle, const Arguments& args, FilterList* filterList)
@@ -129,6 +160,22 @@ bool PipelineFilter::preflight(DataStructure& data, RenamedPaths& renamedPaths,
     return false;
   }
 
+  // Preflight stores report the memory they will hold, so exceeding the budget is caught before anything is allocated
+  if(std::optional<uint64> memoryBudget = FindMemoryBudget(getParentPipeline()); memoryBudget.has_value())
+  {
+    const usize projectedMemoryUsage = data.getMemoryUsage();
+    if(projectedMemoryUsage > *memoryBudget)
+    {
+      m_Errors = {Error{k_MemoryBudgetExceededError,
+                        fmt::format("The data is projected to use {} bytes after this filter which exceeds the pipeline memory budget of {} bytes", projectedMemoryUsage, *memoryBudget)}};
+      setPreflightStructure(data, false);
+      setHasErrors();
+      sendFilterFaultMessage(m_Index, getFaultState());
+      sendFilterFaultDetailMessage(m_Index, m_Warnings, m_Errors);
+      return false;
+    }
+  }
+
   std::vector<DataPath> newCreatedPaths;
   for(const auto& action : result.outputActions.value().actions)
   {
@@ -170,16 +217,53 @@ bool PipelineFilter::preflight(DataStructure& data, RenamedPaths& renamedPaths,
 // -----------------------------------------------------------------------------
 bool PipelineFilter::execute(DataStructure& data, const std::atomic_bool& shouldCancel)
 {
-  this->sendFilterRunStateMessage(m_Index, complex::RunState::Executing);
-  this->sendFilterUpdateMessage(m_Index, "Starting Execution...");
+  prepareExecution(data, shouldCancel, false);
+  applyExecutionActions(data);
+  runExecution(data, shouldCancel);
+  return finishExecution(data, shouldCancel);
+}
+
+// -----------------------------------------------------------------------------
+bool PipelineFilter::prepareExecution(const DataStructure& data, const std::atomic_bool& shouldCancel, bool deferMessages)
+{
+  discardExecution();
+  m_DeferMessages = deferMessages;
+
+  postMessage([this]() { this->sendFilterRunStateMessage(m_Index, complex::RunState::Executing); });
+  postMessage([this]() { this->sendFilterUpdateMessage(m_Index, "Starting Execution..."); });
+
+  m_PreparedExecute = m_Filter->prepareExecute(data, getArguments(), createMessageHandler(), shouldCancel);
+  return m_PreparedExecute->result.valid();
+}
+
+// -----------------------------------------------------------------------------
+void PipelineFilter::applyExecutionActions(DataStructure& data)
+{
+  m_Filter->applyPreparedActions(data, *m_PreparedExecute);
+}
+
+// -----------------------------------------------------------------------------
+void PipelineFilter::runExecution(DataStructure& data, const std::atomic_bool& shouldCancel)
+{
+  m_Filter->executePrepared(data, *m_PreparedExecute, this, createMessageHandler(), shouldCancel);
+}
+
+// -----------------------------------------------------------------------------
+bool PipelineFilter::finishExecution(DataStructure& data, const std::atomic_bool& shouldCancel)
+{
+  m_DeferMessages = false;
+  for(const auto& sendMessage : m_DeferredMessages)
+  {
+    sendMessage();
+  }
+  m_DeferredMessages.clear();
 
   m_Warnings.clear();
   m_Errors.clear();
   clearFaultState();
 
-  IFilter::MessageHandler messageHandler{[this](const IFilter::Message& message) { this->notifyFilterMessage(message); }};
-
-  IFilter::ExecuteResult result = m_Filter->execute(data, getArguments(), this, messageHandler, shouldCancel);
+  IFilter::ExecuteResult result = m_Filter->finishExecute(data, std::move(*m_PreparedExecute), shouldCancel);
+  m_PreparedExecute.reset();
   m_PreflightValues = std::move(result.outputValues);
 
   m_Warnings = result.result.warnings();
@@ -204,6 +288,43 @@ bool PipelineFilter::execute(DataStructure& data, const std::atomic_bool& should
   return result.result.valid();
 }
 
+// -----------------------------------------------------------------------------
+void PipelineFilter::discardExecution()
+{
+  m_PreparedExecute.reset();
+  m_DeferMessages = false;
+  m_DeferredMessages.clear();
+}
+
+// -----------------------------------------------------------------------------
+void PipelineFilter::postMessage(std::function<void()> sendMessage)
+{
+  if(!m_DeferMessages)
+  {
+    sendMessage();
+    return;
+  }
+  // Filters may send messages from several threads while executing
+  std::lock_guard<std::mutex> lock(m_DeferredMessagesMutex);
+  m_DeferredMessages.push_back(std::move(sendMessage));
+}
+
+// -----------------------------------------------------------------------------
+IFilter::MessageHandler PipelineFilter::createMessageHandler()
+{
+  return IFilter::MessageHandler{[this](const IFilter::Message& message) {
+    if(message.type == IFilter::Message::Type::Progress)
+    {
+      IFilter::ProgressMessage progressMessage = static_cast<const IFilter::ProgressMessage&>(message);
+      this->postMessage([this, progressMessage]() { this->notifyFilterMessage(progressMessage); });
+    }
+    else
+    {
+      this->postMessage([this, message]() { this->notifyFilterMessage(message); });
+    }
+  }};
+}
+
 std::vector<DataPath> PipelineFilter::getCreatedPaths() const
 {
   return m_CreatedPaths;
@@ -528,3 +649,286 @@ void PipelineFilter::renamePathArgs(const RenamedPaths& renamedPaths)
     }
   }
 }
+
+namespace
+{
+/**
+ * @brief Returns true if the ancestor path is the same as or a parent of the given path.
+ * @param ancestor
+ * @param path
+ * @return bool
+ */
+bool isSameOrAncestor(const DataPath& ancestor, const DataPath& path)
+{
+  if(ancestor.getLength() > path.getLength())
+  {
+    return false;
+  }
+  for(usize i = 0; i < ancestor.getLength(); i++)
+  {
+    if(ancestor[i] != path[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Appends the DataPaths held by a data argument. Returns false if the
+ * argument type is unknown.
+ * @param value
+ * @param paths
+ * @return bool
+ */
+bool appendArgumentPaths(const std::any& value, std::vector<DataPath>& paths)
+{
+  if(isDataPath(value))
+  {
+    paths.push_back(std::any_cast<DataPath>(value));
+  }
+  else if(value.type() == typeid(std::vector<DataPath>))
+  {
+    const auto& argumentPaths = std::any_cast<const std::vector<DataPath>&>(value);
+    paths.insert(paths.end(), argumentPaths.cbegin(), argumentPaths.cend());
+  }
+  else if(value.type() == typeid(ArrayThresholdSet))
+  {
+    const auto argumentPaths = std::any_cast<const ArrayThresholdSet&>(value).getRequiredPaths();
+    paths.insert(paths.end(), argumentPaths.cbegin(), argumentPaths.cend());
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+struct RestoreDataStoreFunctor
+{
+  template <class T>
+  void operator()(IDataArray& dataArray, const IDataArray& snapshotArray)
+  {
+    dynamic_cast<DataArray<T>&>(dataArray) = dynamic_cast<const DataArray<T>&>(snapshotArray);
+  }
+};
+
+void addDataPath(PipelineFilter::DataAccess& access, const DataPath& path)
+{
+  // Unused optional selections are left empty
+  if(!path.empty())
+  {
+    access.dataPaths.push_back(path);
+  }
+}
+
+/**
+ * @brief Adds the DataPaths changed by the action. Returns false if the action
+ * type is unknown.
+ * @param access
+ * @param action
+ * @return bool
+ */
+bool addActionPaths(PipelineFilter::DataAccess& access, const IDataAction* action)
+{
+  if(const auto* creationAction = dynamic_cast<const IDataCreationAction*>(action); creationAction != nullptr)
+  {
+    for(const auto& path : creationAction->getAllCreatedPaths())
+    {
+      addDataPath(access, path);
+    }
+    return true;
+  }
+  if(const auto* deleteAction = dynamic_cast<const DeleteDataAction*>(action); deleteAction != nullptr)
+  {
+    addDataPath(access, deleteAction->path());
+    return true;
+  }
+  if(const auto* moveAction = dynamic_cast<const MoveDataAction*>(action); moveAction != nullptr)
+  {
+    addDataPath(access, moveAction->path());
+    addDataPath(access, moveAction->newParentPath());
+    return true;
+  }
+  if(const auto* renameAction = dynamic_cast<const RenameDataAction*>(action); renameAction != nullptr)
+  {
+    addDataPath(access, renameAction->path());
+    addDataPath(access, renameAction->path().getParent().createChildPath(renameAction->newName()));
+    return true;
+  }
+  if(const auto* copyAction = dynamic_cast<const CopyGroupAction*>(action); copyAction != nullptr)
+  {
+    addDataPath(access, copyAction->path());
+    addDataPath(access, copyAction->newPath());
+    return true;
+  }
+  if(const auto* updateAction = dynamic_cast<const UpdateImageGeomAction*>(action); updateAction != nullptr)
+  {
+    addDataPath(access, updateAction->path());
+    return true;
+  }
+  return dynamic_cast<const EmptyAction*>(action) != nullptr;
+}
+} // namespace
+
+bool PipelineFilter::DataAccess::conflictsWith(const DataAccess& other) const
+{
+  if(unbounded || other.unbounded)
+  {
+    return true;
+  }
+  for(const auto& path : dataPaths)
+  {
+    for(const auto& otherPath : other.dataPaths)
+    {
+      if(isSameOrAncestor(path, otherPath) || isSameOrAncestor(otherPath, path))
+      {
+        return true;
+      }
+    }
+  }
+  for(const auto& filePath : filePaths)
+  {
+    if(std::find(other.filePaths.cbegin(), other.filePaths.cend(), filePath) != other.filePaths.cend())
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool PipelineFilter::DataAccess::canRestoreInputs(const DataStructure& data) const
+{
+  if(inputPaths.empty())
+  {
+    return true;
+  }
+  for(const auto& path : data.getAllDataPaths())
+  {
+    if(std::none_of(inputPaths.cbegin(), inputPaths.cend(), [&path](const DataPath& inputPath) { return isSameOrAncestor(inputPath, path); }))
+    {
+      continue;
+    }
+    const DataObject* dataObject = data.getData(path);
+    if(dynamic_cast<const IDataArray*>(dataObject) == nullptr && dataObject->getDataObjectType() != DataObject::Type::DataGroup)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void PipelineFilter::DataAccess::restoreInputs(DataStructure& data, const DataStructure& snapshot) const
+{
+  if(inputPaths.empty())
+  {
+    return;
+  }
+  for(const auto& path : snapshot.getAllDataPaths())
+  {
+    if(std::none_of(inputPaths.cbegin(), inputPaths.cend(), [&path](const DataPath& inputPath) { return isSameOrAncestor(inputPath, path); }))
+    {
+      continue;
+    }
+    const auto* snapshotArray = snapshot.getDataAs<IDataArray>(path);
+    auto* dataArray = data.getDataAs<IDataArray>(path);
+    if(snapshotArray == nullptr || dataArray == nullptr || dataArray->getDataType() != snapshotArray->getDataType())
+    {
+      continue;
+    }
+    ExecuteDataFunction(RestoreDataStoreFunctor{}, dataArray->getDataType(), *dataArray, *snapshotArray);
+  }
+}
+
+PipelineFilter::DataAccess PipelineFilter::getExecutionAccess() const
+{
+  DataAccess access;
+
+  // Selected DataObjects may be modified in place, so every data argument counts
+  bool hasDataParameter = false;
+  bool writesFiles = false;
+  std::vector<DataPath> argumentPaths;
+  Parameters params = getParameters();
+  for(const auto& [name, parameter] : params)
+  {
+    if(!m_Arguments.contains(name))
+    {
+      continue;
+    }
+    const std::any& value = m_Arguments.at(name);
+    if(parameter->type() == IParameter::Type::Data)
+    {
+      hasDataParameter = true;
+      if(!appendArgumentPaths(value, argumentPaths))
+      {
+        access.unbounded = true;
+      }
+    }
+    else if(value.type() == typeid(std::filesystem::path))
+    {
+      access.filePaths.push_back(std::any_cast<const std::filesystem::path&>(value).lexically_normal());
+      const auto* pathParameter = dynamic_cast<const FileSystemPathParameter*>(parameter.get());
+      writesFiles = writesFiles || pathParameter == nullptr || pathParameter->getPathType() == FileSystemPathParameter::PathType::OutputFile ||
+                    pathParameter->getPathType() == FileSystemPathParameter::PathType::OutputDir;
+    }
+  }
+  for(const auto& path : argumentPaths)
+  {
+    addDataPath(access, path);
+  }
+
+  // Filters without data arguments, such as file readers and writers, may use the entire DataStructure
+  if(!hasDataParameter)
+  {
+    access.unbounded = true;
+  }
+
+  bool onlyCreates = true;
+  if(m_PreparedExecute.has_value())
+  {
+    for(const auto& action : m_PreparedExecute->outputActions.actions)
+    {
+      if(!addActionPaths(access, action.get()))
+      {
+        access.unbounded = true;
+      }
+      if(const auto* creationAction = dynamic_cast<const IDataCreationAction*>(action.get()); creationAction != nullptr)
+      {
+        for(const auto& path : creationAction->getAllCreatedPaths())
+        {
+          if(!path.empty())
+          {
+            access.createdPaths.push_back(path);
+          }
+        }
+      }
+      else if(dynamic_cast<const EmptyAction*>(action.get()) == nullptr)
+      {
+        onlyCreates = false;
+      }
+    }
+    for(const auto& action : m_PreparedExecute->outputActions.deferredActions)
+    {
+      if(!addActionPaths(access, action.get()))
+      {
+        access.unbounded = true;
+      }
+    }
+  }
+
+  // Selected DataObjects that neither are nor contain a created one are inputs
+  for(const auto& path : argumentPaths)
+  {
+    const bool isCreated =
+        std::any_of(access.createdPaths.cbegin(), access.createdPaths.cend(), [&path](const DataPath& createdPath) { return isSameOrAncestor(path, createdPath); });
+    if(!path.empty() && !isCreated)
+    {
+      access.inputPaths.push_back(path);
+    }
+  }
+
+  // Deferred actions are only applied once the execution is kept
+  access.droppable = !access.unbounded && onlyCreates && !writesFiles;
+
+  return access;
+}
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+
 #include "nod/nod.hpp"
 
 #include "complex/Filter/IFilter.hpp"
@@ -22,6 +27,54 @@ public:
   using WarningsChangedSignal = nod::signal<void(std::vector<complex::Warning>)>;
   using ErrorsChangedSignal = nod::signal<void(std::vector<complex::Error>)>;
 
+  /**
+   * @brief Describes the DataObjects and files that executing the filter may
+   * read or write.
+   */
+  struct COMPLEX_EXPORT DataAccess
+  {
+    std::vector<DataPath> dataPaths;
+    std::vector<std::filesystem::path> filePaths;
+    bool unbounded = false;
+    // DataObjects that the execution's actions create before it runs
+    std::vector<DataPath> createdPaths;
+    // Selected DataObjects that exist before the execution. The filter reads
+    // them and may modify them in place.
+    std::vector<DataPath> inputPaths;
+    // True if the execution's actions only create DataObjects and it writes
+    // to no files, so that its results can be removed as if it never ran once
+    // the DataObjects at inputPaths are restored
+    bool droppable = false;
+
+    /**
+     * @brief Returns true if both executions may use the same DataObject or
+     * file. A DataObject is also used by any execution that uses one of its
+     * parents or children.
+     * @param other
+     * @return bool
+     */
+    bool conflictsWith(const DataAccess& other) const;
+
+    /**
+     * @brief Returns true if every DataObject at or below inputPaths is a
+     * DataArray or a DataGroup, so that restoreInputs can undo changes made
+     * to them in place.
+     * @param data
+     * @return bool
+     */
+    bool canRestoreInputs(const DataStructure& data) const;
+
+    /**
+     * @brief Shares the DataStores of the DataArrays at or below inputPaths
+     * with the matching DataArrays of a copy of the DataStructure taken before
+     * the execution ran. Writes to those arrays detach them from the copy, so
+     * this undoes any change the execution made to them.
+     * @param data
+     * @param snapshot
+     */
+    void restoreInputs(DataStructure& data, const DataStructure& snapshot) const;
+  };
+
   /**
    * @brief Attempts to construct a PipelineFilter based on the specified
    * FilterHandle. Returns nullptr if the corresponding filter could not be
@@ -129,6 +182,59 @@ public:
    */
   bool execute(DataStructure& data, const std::atomic_bool& shouldCancel) override;
 
+  /**
+   * @brief Starts a staged execution by preflighting the filter without
+   * modifying the DataStructure. Messages are held back until
+   * finishExecution() is called unless deferMessages is false. Returns false
+   * if the filter cannot be executed.
+   *
+   * Calling prepareExecution, applyExecutionActions, runExecution and
+   * finishExecution in order is equivalent to calling execute.
+   * @param data
+   * @param shouldCancel
+   * @param deferMessages = true
+   * @return bool
+   */
+  bool prepareExecution(const DataStructure& data, const std::atomic_bool& shouldCancel, bool deferMessages = true);
+
+  /**
+   * @brief Returns the DataObjects and files the prepared execution may use.
+   * These come from the filter's data and file path arguments and the actions
+   * returned by its preflight. Filters without data arguments or with unknown
+   * actions may use anything.
+   * @return DataAccess
+   */
+  DataAccess getExecutionAccess() const;
+
+  /**
+   * @brief Applies the prepared execution's actions to the DataStructure.
+   * @param data
+   */
+  void applyExecutionActions(DataStructure& data);
+
+  /**
+   * @brief Runs the filter's algorithm for the prepared execution. This can
+   * run concurrently with other filters whose DataAccess does not conflict.
+   * @param data
+   * @param shouldCancel
+   */
+  void runExecution(DataStructure& data, const std::atomic_bool& shouldCancel);
+
+  /**
+   * @brief Sends the held back messages, applies the deferred actions and
+   * reports the result of the staged execution. Returns true if execution
+   * succeeded. Otherwise, this returns false.
+   * @param data
+   * @param shouldCancel
+   * @return bool
+   */
+  bool finishExecution(DataStructure& data, const std::atomic_bool& shouldCancel);
+
+  /**
+   * @brief Drops a staged execution along with its held back messages.
+   */
+  void discardExecution();
+
   /**
    * @brief Returns a vector of DataPaths created when preflighting the node.
    * @return std::vector<DataPath>
@@ -200,6 +306,20 @@ protected:
    */
   RenamedPaths checkForRenamedPaths(std::vector<DataPath> oldCreatedPaths) const;
 
+  /**
+   * @brief Sends a message right away or holds it back during a staged
+   * execution.
+   * @param sendMessage
+   */
+  void postMessage(std::function<void()> sendMessage);
+
+  /**
+   * @brief Returns a MessageHandler that forwards filter messages through
+   * postMessage.
+   * @return IFilter::MessageHandler
+   */
+  IFilter::MessageHandler createMessageHandler();
+
 private:
   IFilter::UniquePointer m_Filter;
   Arguments m_Arguments;
@@ -209,5 +329,10 @@ private:
   std::vector<complex::Error> m_Errors;
   std::vector<IFilter::PreflightValue> m_PreflightValues;
   std::vector<DataPath> m_CreatedPaths;
+
+  std::optional<IFilter::PreparedExecute> m_PreparedExecute;
+  bool m_DeferMessages = false;
+  std::vector<std::function<void()>> m_DeferredMessages;
+  std::mutex m_DeferredMessagesMutex;
 };
 } // namespace complex
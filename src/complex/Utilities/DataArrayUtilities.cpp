@@ -1,11 +1,60 @@
 #include "DataArrayUtilities.hpp"
 
 #include "complex/Common/TypesUtility.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <cstring>
+#include <mutex>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
 
 using namespace complex;
 
 namespace
 {
+std::mutex s_OutOfCoreOptionsMutex;
+OutOfCoreOptions s_OutOfCoreOptions;
+
+std::mutex s_AllocationOptionsMutex;
+AllocationOptions s_AllocationOptions;
+
+constexpr usize k_HugePageSize = 2ULL * 1024ULL * 1024ULL;
+
+// Parallel zero fill block size. The buffer is not aligned to huge pages, so the first
+// block ends at the first huge page boundary and every later block covers whole huge
+// pages. That way no huge page is touched by two threads.
+constexpr usize k_ZeroFillBlockSize = k_HugePageSize;
+
+class ZeroFillImpl
+{
+public:
+  ZeroFillImpl(uint8* buffer, usize numBytes, usize firstBlockBytes)
+  : m_Buffer(buffer)
+  , m_NumBytes(numBytes)
+  , m_FirstBlockBytes(firstBlockBytes)
+  {
+  }
+
+  void operator()(const Range& range) const
+  {
+    const usize start = blockStart(range.min());
+    const usize end = blockStart(range.max());
+    std::memset(m_Buffer + start, 0, end - start);
+  }
+
+private:
+  usize blockStart(usize block) const
+  {
+    return block == 0 ? 0 : std::min(m_FirstBlockBytes + (block - 1) * k_ZeroFillBlockSize, m_NumBytes);
+  }
+
+  uint8* m_Buffer;
+  usize m_NumBytes;
+  usize m_FirstBlockBytes;
+};
+
 template <class T>
 Result<> ReplaceArray(DataStructure& dataStructure, const DataPath& dataPath, const std::vector<usize>& tupleShape, IDataAction::Mode mode, const IDataArray& inputDataArray)
 {
@@ -18,6 +67,61 @@ Result<> ReplaceArray(DataStructure& dataStructure, const DataPath& dataPath, co
 
 namespace complex
 {
+//-----------------------------------------------------------------------------
+OutOfCoreOptions GetOutOfCoreOptions()
+{
+  std::lock_guard<std::mutex> lock(s_OutOfCoreOptionsMutex);
+  return s_OutOfCoreOptions;
+}
+
+//-----------------------------------------------------------------------------
+void SetOutOfCoreOptions(const OutOfCoreOptions& options)
+{
+  std::lock_guard<std::mutex> lock(s_OutOfCoreOptionsMutex);
+  s_OutOfCoreOptions = options;
+}
+
+//-----------------------------------------------------------------------------
+AllocationOptions GetAllocationOptions()
+{
+  std::lock_guard<std::mutex> lock(s_AllocationOptionsMutex);
+  return s_AllocationOptions;
+}
+
+//-----------------------------------------------------------------------------
+void SetAllocationOptions(const AllocationOptions& options)
+{
+  std::lock_guard<std::mutex> lock(s_AllocationOptionsMutex);
+  s_AllocationOptions = options;
+}
+
+//-----------------------------------------------------------------------------
+void AdviseHugePages(void* buffer, usize numBytes)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  const auto address = reinterpret_cast<uintptr_t>(buffer);
+  const uintptr_t alignedStart = (address + k_HugePageSize - 1) / k_HugePageSize * k_HugePageSize;
+  const uintptr_t alignedEnd = (address + numBytes) / k_HugePageSize * k_HugePageSize;
+  if(alignedEnd > alignedStart)
+  {
+    // The advice is only a hint, failures leave the buffer on regular pages
+    madvise(reinterpret_cast<void*>(alignedStart), alignedEnd - alignedStart, MADV_HUGEPAGE);
+  }
+#endif
+}
+
+//-----------------------------------------------------------------------------
+void ParallelZeroFill(void* buffer, usize numBytes, uint64 parallelFillBytes)
+{
+  const usize misalignment = reinterpret_cast<uintptr_t>(buffer) % k_HugePageSize;
+  const usize firstBlockBytes = std::min(misalignment == 0 ? k_ZeroFillBlockSize : k_HugePageSize - misalignment, numBytes);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, 1 + (numBytes - firstBlockBytes + k_ZeroFillBlockSize - 1) / k_ZeroFillBlockSize);
+  dataAlg.setParallelizationEnabled(numBytes >= parallelFillBytes);
+  dataAlg.execute(ZeroFillImpl(static_cast<uint8*>(buffer), numBytes, firstBlockBytes));
+}
+
 //-----------------------------------------------------------------------------
 Result<> CheckValueConverts(const std::string& value, NumericType numericType)
 {
@@ -283,7 +387,12 @@ std::unique_ptr<MaskCompare> InstantiateMaskCompare(IDataArray& maskArray)
   switch(maskArray.getDataType())
   {
   case DataType::boolean: {
-    return std::make_unique<BoolMaskCompare>(dynamic_cast<BoolArray&>(maskArray));
+    auto& boolArray = dynamic_cast<BoolArray&>(maskArray);
+    if(auto* bitStore = dynamic_cast<BitDataStore*>(boolArray.getDataStore()); bitStore != nullptr)
+    {
+      return std::make_unique<BitMaskCompare>(*bitStore);
+    }
+    return std::make_unique<BoolMaskCompare>(boolArray);
   }
   case DataType::uint8: {
     return std::make_unique<UInt8MaskCompare>(dynamic_cast<UInt8Array&>(maskArray));
@@ -2,17 +2,21 @@
 
 #include "complex/Common/Result.hpp"
 #include "complex/DataStructure/AttributeMatrix.hpp"
+#include "complex/DataStructure/BitDataStore.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/EmptyDataStore.hpp"
 #include "complex/DataStructure/IDataStore.hpp"
 #include "complex/DataStructure/NeighborList.hpp"
+#include "complex/DataStructure/OutOfCoreDataStore.hpp"
 #include "complex/Filter/Output.hpp"
 #include "complex/Utilities/TemplateHelpers.hpp"
 #include "complex/complex_export.hpp"
 
 #include <filesystem>
 #include <iostream>
+#include <limits>
+#include <numeric>
 #include <string>
 
 namespace fs = std::filesystem;
@@ -274,24 +278,167 @@ Result<> ConditionalReplaceValueInArrayFromString(const std::string& valueAsStr,
  */
 COMPLEX_EXPORT Result<> ConditionalReplaceValueInArray(const std::string& valueAsStr, DataObject& inputDataObject, const IDataArray& conditionalDataArray);
 
+/**
+ * @brief Settings that control when CreateDataStore() creates an OutOfCoreDataStore
+ * instead of an in memory DataStore.
+ */
+struct COMPLEX_EXPORT OutOfCoreOptions
+{
+  /**
+   * @brief Arrays whose size in bytes is greater than or equal to this value are stored out of core.
+   * The default value disables out of core storage.
+   */
+  uint64 thresholdBytes = std::numeric_limits<uint64>::max();
+  usize chunkSize = OutOfCoreDataStore<uint8>::k_DefaultChunkSize;
+  usize maxCachedChunks = OutOfCoreDataStore<uint8>::k_DefaultMaxCachedChunks;
+  fs::path directory = fs::temp_directory_path();
+};
+
+/**
+ * @brief Returns the current out of core settings.
+ * @return OutOfCoreOptions
+ */
+COMPLEX_EXPORT OutOfCoreOptions GetOutOfCoreOptions();
+
+/**
+ * @brief Replaces the out of core settings used by CreateDataStore().
+ * @param options
+ */
+COMPLEX_EXPORT void SetOutOfCoreOptions(const OutOfCoreOptions& options);
+
+/**
+ * @brief Settings that control how CreateDataStore() allocates in memory DataStores.
+ */
+struct COMPLEX_EXPORT AllocationOptions
+{
+  /**
+   * @brief Zeroed buffers of at least this many bytes are filled in parallel. Each page
+   * is then first touched, and on NUMA systems placed, by one of the worker threads
+   * instead of all pages ending up on the allocating thread's node.
+   */
+  uint64 parallelFillBytes = 16ULL * 1024ULL * 1024ULL;
+  /**
+   * @brief Advise the kernel to back large buffers with transparent huge pages.
+   * Only has an effect on Linux.
+   */
+  bool hugePages = false;
+};
+
+/**
+ * @brief Returns the current allocation settings.
+ * @return AllocationOptions
+ */
+COMPLEX_EXPORT AllocationOptions GetAllocationOptions();
+
+/**
+ * @brief Replaces the allocation settings used by CreateDataStore().
+ * @param options
+ */
+COMPLEX_EXPORT void SetAllocationOptions(const AllocationOptions& options);
+
+/**
+ * @brief Advises the kernel to back the given buffer with transparent huge pages.
+ * Only the 2 MiB aligned part of the buffer is affected. Must be called before the
+ * buffer is first touched. Does nothing on platforms other than Linux.
+ * @param buffer
+ * @param numBytes
+ */
+COMPLEX_EXPORT void AdviseHugePages(void* buffer, usize numBytes);
+
+/**
+ * @brief Sets every byte of the buffer to 0. Large buffers are split into blocks
+ * that are cleared in parallel. Blocks after the first start on 2 MiB boundaries,
+ * so that each huge page is cleared by a single thread.
+ * @param buffer
+ * @param numBytes
+ * @param parallelFillBytes Buffers smaller than this are cleared on the calling thread
+ */
+COMPLEX_EXPORT void ParallelZeroFill(void* buffer, usize numBytes, uint64 parallelFillBytes);
+
+/**
+ * @brief Returns the number of bytes of memory the DataStore created by CreateDataStore()
+ * in execute mode would hold. Out of core stores only count their chunk cache.
+ * @tparam T Primitive Type (int, float, ...)
+ * @param tupleShape The Tuple Dimensions
+ * @param componentShape The component dimensions
+ * @param packBits Boolean arrays are stored one bit per value in a BitDataStore. Ignored for other types.
+ * @return usize
+ */
+template <class T>
+usize ProjectDataStoreMemoryUsage(const typename IDataStore::ShapeType& tupleShape, const typename IDataStore::ShapeType& componentShape, bool packBits = false)
+{
+  uint64 numValues = std::accumulate(tupleShape.cbegin(), tupleShape.cend(), static_cast<uint64>(1), std::multiplies<>()) *
+                     std::accumulate(componentShape.cbegin(), componentShape.cend(), static_cast<uint64>(1), std::multiplies<>());
+  if constexpr(std::is_same_v<T, bool>)
+  {
+    if(packBits)
+    {
+      return BitDataStore::GetNumberOfWords(numValues) * sizeof(BitDataStore::WordType);
+    }
+  }
+  OutOfCoreOptions options = GetOutOfCoreOptions();
+  if(numValues * sizeof(T) >= options.thresholdBytes)
+  {
+    const uint64 chunkSize = std::max(options.chunkSize, static_cast<usize>(1));
+    const uint64 numChunks = (numValues + chunkSize - 1) / chunkSize;
+    return std::min<uint64>(numChunks, std::max(options.maxCachedChunks, static_cast<usize>(1))) * chunkSize * sizeof(T);
+  }
+  return numValues * sizeof(T);
+}
+
 /**
  * @brief Creates a DataStore with the given properties
  * @tparam T Primitive Type (int, float, ...)
  * @param tupleShape The Tuple Dimensions
  * @param componentShape The component dimensions
- * @param mode The mode to assume: PREFLIGHT or EXECUTE. Preflight will NOT allocate any storage. EXECUTE will allocate the memory/storage
+ * @param mode The mode to assume: PREFLIGHT or EXECUTE. Preflight will NOT allocate any storage. EXECUTE will allocate the memory/storage.
+ * Arrays at or above the out of core threshold are backed by a file on disk instead of memory. Preflight stores report the
+ * memory the execute store is projected to hold.
+ * @param packBits Boolean arrays are stored one bit per value in a BitDataStore. Ignored for other types.
+ * @param allocationPolicy Whether the values of an in memory DataStore are zeroed or left uninitialized
  * @return
  */
 template <class T>
-std::unique_ptr<AbstractDataStore<T>> CreateDataStore(const typename IDataStore::ShapeType& tupleShape, const typename IDataStore::ShapeType& componentShape, IDataAction::Mode mode)
+std::unique_ptr<AbstractDataStore<T>> CreateDataStore(const typename IDataStore::ShapeType& tupleShape, const typename IDataStore::ShapeType& componentShape, IDataAction::Mode mode,
+                                                      bool packBits = false, AllocationPolicy allocationPolicy = AllocationPolicy::Zeroed)
 {
   switch(mode)
   {
   case IDataAction::Mode::Preflight: {
-    return std::make_unique<EmptyDataStore<T>>(tupleShape, componentShape);
+    auto store = std::make_unique<EmptyDataStore<T>>(tupleShape, componentShape);
+    store->setProjectedMemoryUsage(ProjectDataStoreMemoryUsage<T>(tupleShape, componentShape, packBits));
+    return store;
   }
   case IDataAction::Mode::Execute: {
-    return std::make_unique<DataStore<T>>(tupleShape, componentShape, static_cast<T>(0));
+    if constexpr(std::is_same_v<T, bool>)
+    {
+      if(packBits)
+      {
+        return std::make_unique<BitDataStore>(tupleShape, componentShape, false);
+      }
+    }
+    OutOfCoreOptions options = GetOutOfCoreOptions();
+    uint64 numValues = std::accumulate(tupleShape.cbegin(), tupleShape.cend(), static_cast<uint64>(1), std::multiplies<>()) *
+                       std::accumulate(componentShape.cbegin(), componentShape.cend(), static_cast<uint64>(1), std::multiplies<>());
+    if(numValues * sizeof(T) >= options.thresholdBytes)
+    {
+      return std::make_unique<OutOfCoreDataStore<T>>(tupleShape, componentShape, static_cast<T>(0), options.directory, options.chunkSize, options.maxCachedChunks);
+    }
+
+    // The buffer is allocated without touching its pages so that huge page advice
+    // and the parallel fill happen before any page is faulted in
+    AllocationOptions allocationOptions = GetAllocationOptions();
+    const usize numBytes = static_cast<usize>(numValues) * sizeof(T);
+    std::unique_ptr<T[]> buffer(new T[numValues]);
+    if(allocationOptions.hugePages)
+    {
+      AdviseHugePages(buffer.get(), numBytes);
+    }
+    if(allocationPolicy == AllocationPolicy::Zeroed)
+    {
+      ParallelZeroFill(buffer.get(), numBytes, allocationOptions.parallelFillBytes);
+    }
+    return std::make_unique<DataStore<T>>(std::move(buffer), tupleShape, componentShape);
   }
   default: {
     throw std::runtime_error("Invalid mode");
@@ -307,10 +454,13 @@ std::unique_ptr<AbstractDataStore<T>> CreateDataStore(const typename IDataStore:
  * @param nComp The number of components in the DataArray
  * @param path The DataPath to where the data will be stored.
  * @param mode The mode to assume: PREFLIGHT or EXECUTE. Preflight will NOT allocate any storage. EXECUTE will allocate the memory/storage
+ * @param packBits Boolean arrays are stored one bit per value. Ignored for other types.
+ * @param allocationPolicy Whether the values of an in memory DataStore are zeroed or left uninitialized
  * @return
  */
 template <class T>
-Result<> CreateArray(DataStructure& dataStructure, const std::vector<usize>& tupleShape, const std::vector<usize>& compShape, const DataPath& path, IDataAction::Mode mode)
+Result<> CreateArray(DataStructure& dataStructure, const std::vector<usize>& tupleShape, const std::vector<usize>& compShape, const DataPath& path, IDataAction::Mode mode, bool packBits = false,
+                     AllocationPolicy allocationPolicy = AllocationPolicy::Zeroed)
 {
   auto parentPath = path.getParent();
 
@@ -353,7 +503,7 @@ Result<> CreateArray(DataStructure& dataStructure, const std::vector<usize>& tup
 
   std::string name = path[last];
 
-  auto store = CreateDataStore<T>(tupleShape, compShape, mode);
+  auto store = CreateDataStore<T>(tupleShape, compShape, mode, packBits, allocationPolicy);
   auto dataArray = DataArray<T>::Create(dataStructure, name, std::move(store), dataObjectId);
   if(dataArray == nullptr)
   {
@@ -625,6 +775,32 @@ struct BoolMaskCompare : public MaskCompare
   }
 };
 
+struct BitMaskCompare : public MaskCompare
+{
+  BitMaskCompare(BitDataStore& store)
+  : m_Store(store)
+  {
+  }
+  ~BitMaskCompare() noexcept override = default;
+  BitDataStore& m_Store;
+  bool bothTrue(size_t indexA, size_t indexB) const override
+  {
+    return m_Store.getValue(indexA) && m_Store.getValue(indexB);
+  }
+  bool bothFalse(size_t indexA, size_t indexB) const override
+  {
+    return !m_Store.getValue(indexA) && !m_Store.getValue(indexB);
+  }
+  bool isTrue(size_t index) const override
+  {
+    return m_Store.getValue(index);
+  }
+  void setValue(size_t index, bool val) override
+  {
+    m_Store.setValue(index, val);
+  }
+};
+
 struct UInt8MaskCompare : public MaskCompare
 {
   UInt8MaskCompare(UInt8Array& array)
@@ -670,7 +846,8 @@ struct UInt8MaskCompare : public MaskCompare
 COMPLEX_EXPORT std::unique_ptr<MaskCompare> InstantiateMaskCompare(DataStructure& dataStructure, const DataPath& maskArrayPath);
 
 /**
- * @brief Convenience method to create an instance of the MaskCompare subclass
+ * @brief Convenience method to create an instance of the MaskCompare subclass. Bit packed
+ * `bool` arrays are read and written through their bits directly.
  * @param maskArrayPtr A Pointer to the mask array which can be of either `bool` or `uint8` type.
  * @return
  */
@@ -0,0 +1,250 @@
+#include "FeatureCleanup.hpp"
+
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <algorithm>
+#include <array>
+
+using namespace complex;
+
+namespace
+{
+/**
+ * @brief Returns the face neighbors of the cell in -z, -y, -x, +x, +y, +z order.
+ * Neighbors outside of the geometry are -1.
+ * @param dims
+ * @param index
+ * @return std::array<int64, 6>
+ */
+std::array<int64, 6> FindFaceNeighbors(const SizeVec3& dims, usize index)
+{
+  const usize xDim = dims[0];
+  const usize xyDim = dims[0] * dims[1];
+  const usize x = index % xDim;
+  const usize y = (index / xDim) % dims[1];
+  const usize z = index / xyDim;
+  const auto cell = static_cast<int64>(index);
+  return {z > 0 ? cell - static_cast<int64>(xyDim) : -1,
+          y > 0 ? cell - static_cast<int64>(xDim) : -1,
+          x > 0 ? cell - 1 : -1,
+          x + 1 < xDim ? cell + 1 : -1,
+          y + 1 < dims[1] ? cell + static_cast<int64>(xDim) : -1,
+          z + 1 < dims[2] ? cell + static_cast<int64>(xyDim) : -1};
+}
+
+/**
+ * @brief Finds the cell each unassigned cell copies its data from. The first neighbor
+ * to bring its feature's count above all others wins, so ties go to the feature
+ * that was seen first.
+ */
+class FindSourceCellsImpl
+{
+public:
+  FindSourceCellsImpl(const AbstractDataStore<int32>& featureIds, const SizeVec3& dims, const std::vector<usize>& cells, std::vector<int64>& sourceCells)
+  : m_FeatureIds(featureIds)
+  , m_Dims(dims)
+  , m_Cells(cells)
+  , m_SourceCells(sourceCells)
+  {
+  }
+
+  void operator()(const Range& range) const
+  {
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      m_SourceCells[i] = findSourceCell(m_Cells[i]);
+    }
+  }
+
+private:
+  int64 findSourceCell(usize cell) const
+  {
+    std::array<int32, 6> features = {};
+    std::array<int32, 6> votes = {};
+    usize numFeatures = 0;
+    int32 most = 0;
+    int64 sourceCell = -1;
+    for(int64 neighbor : FindFaceNeighbors(m_Dims, cell))
+    {
+      if(neighbor < 0)
+      {
+        continue;
+      }
+      const int32 feature = m_FeatureIds.getValue(neighbor);
+      if(feature < 0)
+      {
+        continue;
+      }
+      usize featureIndex = std::find(features.begin(), features.begin() + numFeatures, feature) - features.begin();
+      if(featureIndex == numFeatures)
+      {
+        features[numFeatures] = feature;
+        votes[numFeatures] = 0;
+        numFeatures++;
+      }
+      votes[featureIndex]++;
+      if(votes[featureIndex] > most)
+      {
+        most = votes[featureIndex];
+        sourceCell = neighbor;
+      }
+    }
+    return sourceCell;
+  }
+
+  const AbstractDataStore<int32>& m_FeatureIds;
+  const SizeVec3 m_Dims;
+  const std::vector<usize>& m_Cells;
+  std::vector<int64>& m_SourceCells;
+};
+
+template <typename T>
+class CopyTuplesImpl
+{
+public:
+  CopyTuplesImpl(T* data, usize numComponents, const std::vector<usize>& sources, const std::vector<usize>& targets)
+  : m_Data(data)
+  , m_NumComponents(numComponents)
+  , m_Sources(sources)
+  , m_Targets(targets)
+  {
+  }
+
+  void operator()(const Range& range) const
+  {
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      const T* source = m_Data + m_Sources[i] * m_NumComponents;
+      std::copy(source, source + m_NumComponents, m_Data + m_Targets[i] * m_NumComponents);
+    }
+  }
+
+private:
+  T* m_Data = nullptr;
+  usize m_NumComponents = 0;
+  const std::vector<usize>& m_Sources;
+  const std::vector<usize>& m_Targets;
+};
+
+struct CopyTuplesFunctor
+{
+  template <typename T>
+  void operator()(IDataArray* cellArray, const std::vector<usize>& sources, const std::vector<usize>& targets)
+  {
+    auto& dataStore = dynamic_cast<DataArray<T>&>(*cellArray).getDataStoreRef();
+    const usize numComponents = dataStore.getNumberOfComponents();
+    if(auto* inMemoryStore = dynamic_cast<DataStore<T>*>(&dataStore); inMemoryStore != nullptr)
+    {
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, targets.size());
+      dataAlg.execute(CopyTuplesImpl<T>(inMemoryStore->data(), numComponents, sources, targets));
+      return;
+    }
+
+    // Out of core and bit packed stores are not safe to write from several threads
+    for(usize i = 0; i < targets.size(); i++)
+    {
+      for(usize component = 0; component < numComponents; component++)
+      {
+        dataStore.setValue(targets[i] * numComponents + component, dataStore.getValue(sources[i] * numComponents + component));
+      }
+    }
+  }
+};
+} // namespace
+
+namespace complex
+{
+void FeatureCleanup::CopyTuples(const std::vector<IDataArray*>& cellArrays, const std::vector<usize>& sources, const std::vector<usize>& targets)
+{
+  for(IDataArray* cellArray : cellArrays)
+  {
+    ExecuteDataFunction(CopyTuplesFunctor{}, cellArray->getDataType(), cellArray, sources, targets);
+  }
+}
+
+usize FeatureCleanup::AssignBadPoints(const SizeVec3& dims, Int32Array& featureIdsArray, const std::vector<IDataArray*>& cellArrays, const std::atomic_bool& shouldCancel)
+{
+  std::vector<IDataArray*> copiedArrays = cellArrays;
+  if(std::find(copiedArrays.cbegin(), copiedArrays.cend(), &featureIdsArray) == copiedArrays.cend())
+  {
+    copiedArrays.push_back(&featureIdsArray);
+  }
+
+  AbstractDataStore<int32>& featureIds = featureIdsArray.getDataStoreRef();
+  const usize totalPoints = featureIds.getNumberOfTuples();
+
+  // Every unassigned cell is visited in the first pass
+  std::vector<usize> frontier;
+  featureIds.visitConstChunks(0, totalPoints, [&frontier](usize index, nonstd::span<const int32> values) {
+    for(usize i = 0; i < values.size(); i++)
+    {
+      if(values[i] < 0)
+      {
+        frontier.push_back(index + i);
+      }
+    }
+  });
+  usize numUnassigned = frontier.size();
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setParallelizationEnabled(featureIds.getStoreType() == IDataStore::StoreType::InMemory);
+
+  std::vector<int64> sourceCells;
+  std::vector<usize> sources;
+  std::vector<usize> targets;
+  std::vector<uint8> queued(totalPoints, 0);
+  while(!frontier.empty())
+  {
+    if(shouldCancel)
+    {
+      return numUnassigned;
+    }
+
+    sourceCells.assign(frontier.size(), -1);
+    dataAlg.setRange(0, frontier.size());
+    dataAlg.execute(FindSourceCellsImpl(featureIds, dims, frontier, sourceCells));
+
+    sources.clear();
+    targets.clear();
+    for(usize i = 0; i < frontier.size(); i++)
+    {
+      if(sourceCells[i] >= 0)
+      {
+        sources.push_back(static_cast<usize>(sourceCells[i]));
+        targets.push_back(frontier[i]);
+      }
+    }
+    // The remaining cells are not connected to any feature
+    if(targets.empty())
+    {
+      break;
+    }
+
+    // Source cells already belong to a feature so no cell is both a source and a target
+    CopyTuples(copiedArrays, sources, targets);
+    numUnassigned -= targets.size();
+
+    // Only cells next to a newly assigned cell can have gained an assigned neighbor
+    frontier.clear();
+    for(usize target : targets)
+    {
+      for(int64 neighbor : FindFaceNeighbors(dims, target))
+      {
+        if(neighbor >= 0 && queued[neighbor] == 0 && featureIds.getValue(neighbor) < 0)
+        {
+          queued[neighbor] = 1;
+          frontier.push_back(static_cast<usize>(neighbor));
+        }
+      }
+    }
+    for(usize cell : frontier)
+    {
+      queued[cell] = 0;
+    }
+  }
+  return numUnassigned;
+}
+} // namespace complex
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "complex/Common/Array.hpp"
+#include "complex/Common/Types.hpp"
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/IDataArray.hpp"
+#include "complex/complex_export.hpp"
+
+#include <atomic>
+#include <vector>
+
+namespace complex
+{
+namespace FeatureCleanup
+{
+/**
+ * @brief Copies tuple sources[i] to tuple targets[i] of each array. Every array
+ * is updated in a single pass over the assignments, in parallel for in memory
+ * DataStores. No tuple may be both a source and a target.
+ * @param cellArrays
+ * @param sources
+ * @param targets
+ */
+COMPLEX_EXPORT void CopyTuples(const std::vector<IDataArray*>& cellArrays, const std::vector<usize>& sources, const std::vector<usize>& targets);
+
+/**
+ * @brief Grows the surrounding features into every cell of an image geometry that has
+ * a negative feature id. In each pass an unassigned cell takes all of its cell data
+ * from the face neighbor whose feature is most common among its face neighbors, so
+ * features grow one cell layer per pass. Only cells that border a cell assigned in
+ * the previous pass are revisited.
+ *
+ * The feature ids are updated even if featureIds is not one of the cellArrays.
+ * @param dims Dimensions of the image geometry
+ * @param featureIds
+ * @param cellArrays Cell arrays whose tuples are copied along with the feature ids
+ * @param shouldCancel
+ * @return usize Number of cells that could not be assigned because no feature is connected to them
+ */
+COMPLEX_EXPORT usize AssignBadPoints(const SizeVec3& dims, Int32Array& featureIds, const std::vector<IDataArray*>& cellArrays, const std::atomic_bool& shouldCancel);
+} // namespace FeatureCleanup
+} // namespace complex
@@ -7,6 +7,14 @@
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/Geometry/IGeometry.hpp"
 #include "complex/Utilities/Math/GeometryMath.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <vector>
 
 namespace complex
 {
@@ -17,7 +25,9 @@ using ErrorCode = int32;
 namespace Connectivity
 {
 /**
- * @brief
+ * @brief Finds the elements that contain each vertex. The lists are built with a parallel
+ * count, prefix sum and scatter into the flat buffer of the DynamicListArray and hold the
+ * element indices in ascending order.
  * @tparam T
  * @tparam K
  * @param elemList
@@ -27,48 +37,62 @@ namespace Connectivity
 template <typename T, typename K>
 void FindElementsContainingVert(const DataArray<K>* elemList, DynamicListArray<T, K>* dynamicList, usize numVerts)
 {
-  DataStructure* dataStructure = dynamicList->getDataStructure();
-  auto parentId = dynamicList->getParentIds().front();
-
-  auto& elems = *elemList;
+  const AbstractDataStore<K>& elems = elemList->getDataStoreRef();
   const usize numElems = elemList->getNumberOfTuples();
   const usize numVertsPerElem = elemList->getNumberOfComponents();
 
-  // Allocate the basic structures
-  std::vector<T> linkCount(numVerts, 0);
-
-  // Fill out lists with number of references to cells
-  auto dataStore = std::make_unique<DataStore<K>>(numVerts, static_cast<K>(0));
-  DataArray<K>* linkLocPtr = DataArray<K>::Create(*dataStructure, "_INTERNAL_USE_ONLY_Vertices", std::move(dataStore), parentId);
-  auto linkLoc = *linkLocPtr;
-  K* verts = nullptr;
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numElems);
 
-  // vtkPolyData *pdata = static_cast<vtkPolyData *>(data);
-  // Traverse data to determine number of uses of each point
-  for(usize elemId = 0; elemId < numElems; elemId++)
-  {
-    usize offset = elemId * numVertsPerElem;
-    for(usize j = 0; j < numVertsPerElem; j++)
+  // Count the number of elements using each vertex
+  std::vector<std::atomic<usize>> linkCount(numVerts);
+  dataAlg.execute([&](const Range& range) {
+    std::vector<K> elem(numVertsPerElem);
+    for(usize elemId = range.min(); elemId < range.max(); elemId++)
     {
-      linkCount[elems[offset + j]]++;
+      elems.copyIntoBuffer(elemId * numVertsPerElem, nonstd::span<K>(elem.data(), numVertsPerElem));
+      for(usize j = 0; j < numVertsPerElem; j++)
+      {
+        linkCount[elem[j]].fetch_add(1, std::memory_order_relaxed);
+      }
     }
-  }
+  });
 
-  // Now allocate storage for the links
+  // Now allocate storage for the links and reuse the counts as insertion cursors
   dynamicList->allocateLists(linkCount);
-
-  for(usize elemId = 0; elemId < numElems; elemId++)
+  for(auto& cursor : linkCount)
   {
-    usize offset = elemId * numVertsPerElem;
-    for(usize j = 0; j < numVertsPerElem; j++)
+    cursor.store(0, std::memory_order_relaxed);
+  }
+
+  dataAlg.execute([&](const Range& range) {
+    std::vector<K> elem(numVertsPerElem);
+    for(usize elemId = range.min(); elemId < range.max(); elemId++)
+    {
+      elems.copyIntoBuffer(elemId * numVertsPerElem, nonstd::span<K>(elem.data(), numVertsPerElem));
+      for(usize j = 0; j < numVertsPerElem; j++)
+      {
+        dynamicList->insertCellReference(elem[j], linkCount[elem[j]].fetch_add(1, std::memory_order_relaxed), elemId);
+      }
+    }
+  });
+
+  // The scatter order depends on the thread scheduling so restore the element order
+  dataAlg.setRange(0, numVerts);
+  dataAlg.execute([&](const Range& range) {
+    for(usize vert = range.min(); vert < range.max(); vert++)
     {
-      dynamicList->insertCellReference(elems[offset + j], (linkLoc[elems[offset + j]])++, elemId);
+      K* cells = dynamicList->getElementListPointer(vert);
+      std::sort(cells, cells + dynamicList->getNumberOfElements(vert));
     }
-  }
+  });
 }
 
 /**
- * @brief
+ * @brief Finds the neighbors of each element, which are the elements that share numSharedVerts
+ * vertices with it (a vertex for edges, an edge for triangles and quads and a face for tetrahedra
+ * and hexahedra). Each element is processed independently in parallel: the neighbors are counted,
+ * the lists are allocated at once and then filled in ascending order.
  * @tparam T
  * @tparam K
  * @param elemList
@@ -80,14 +104,10 @@ void FindElementsContainingVert(const DataArray<K>* elemList, DynamicListArray<T
 template <typename T, typename K>
 ErrorCode FindElementNeighbors(const DataArray<K>* elemList, const DynamicListArray<T, K>* elemsContainingVert, DynamicListArray<T, K>* dynamicList, IGeometry::Type geometryType)
 {
-  DataStructure* dataStructure = dynamicList->getDataStructure();
-  auto parentId = dynamicList->getParentIds().front();
-  auto& elems = *elemList;
+  const AbstractDataStore<K>& elems = elemList->getDataStoreRef();
   const usize numElems = elemList->getNumberOfTuples();
   const usize numVertsPerElem = elemList->getNumberOfComponents();
   usize numSharedVerts = 0;
-  std::vector<T> linkCount(numElems, 0);
-  ErrorCode err = 0;
 
   switch(geometryType)
   {
@@ -126,131 +146,242 @@ ErrorCode FindElementNeighbors(const DataArray<K>* elemList, const DynamicListAr
     return -1;
   }
 
-  dynamicList->allocateLists(linkCount);
+  // Collects the neighbors of the element in ascending order. The candidates are the other
+  // elements that contain any of its vertices.
+  auto findNeighbors = [&](usize elemId, std::vector<K>& elem, std::vector<K>& other, std::vector<K>& neighbors) {
+    neighbors.clear();
+    elems.copyIntoBuffer(elemId * numVertsPerElem, nonstd::span<K>(elem.data(), numVertsPerElem));
+    for(usize v = 0; v < numVertsPerElem; v++)
+    {
+      const K* vertIdxs = elemsContainingVert->getElementListPointer(elem[v]);
+      const T numElemsWithVert = elemsContainingVert->getNumberOfElements(elem[v]);
+      for(T i = 0; i < numElemsWithVert; i++)
+      {
+        if(vertIdxs[i] != static_cast<K>(elemId))
+        {
+          neighbors.push_back(vertIdxs[i]);
+        }
+      }
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
 
-  // Allocate an array of bools that we use each iteration so that we don't put duplicates into the array
-  auto visitedDataStore = std::make_unique<DataStore<uint8>>(numElems, 0);
-  DataArray<uint8>* visitedPtr = DataArray<uint8>::Create(*dataStructure, "_INTERNAL_USE_ONLY_Visited", std::move(visitedDataStore), parentId);
-  auto& visited = *visitedPtr;
+    auto isNeighbor = [&](K candidate) {
+      elems.copyIntoBuffer(static_cast<usize>(candidate) * numVertsPerElem, nonstd::span<K>(other.data(), numVertsPerElem));
+      usize vCount = 0;
+      for(usize i = 0; i < numVertsPerElem; i++)
+      {
+        vCount += static_cast<usize>(std::count(other.begin(), other.end(), elem[i]));
+      }
+      return vCount == numSharedVerts;
+    };
+    neighbors.erase(std::remove_if(neighbors.begin(), neighbors.end(), [&](K candidate) { return !isNeighbor(candidate); }), neighbors.end());
+  };
 
-  // Reuse this vector for each loop. Avoids re-allocating the memory each time through the loop
-  std::vector<K> loop_neighbors(32, 0);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numElems);
 
-  // Build up the element adjacency list now that we have the element links
-  for(usize t = 0; t < numElems; ++t)
-  {
-    //   qDebug() << "Analyzing Cell " << t << "\n";
-    const usize offset = t * numVertsPerElem;
-    for(usize v = 0; v < numVertsPerElem; ++v)
+  std::vector<T> linkCount(numElems, 0);
+  dataAlg.execute([&](const Range& range) {
+    std::vector<K> elem(numVertsPerElem);
+    std::vector<K> other(numVertsPerElem);
+    std::vector<K> neighbors;
+    for(usize elemId = range.min(); elemId < range.max(); elemId++)
     {
-      //   qDebug() << " vert " << v << "\n";
-      T nEs = elemsContainingVert->getNumberOfElements(elems[offset + v]);
-      K* vertIdxs = elemsContainingVert->getElementListPointer(elems[offset + v]);
+      findNeighbors(elemId, elem, other, neighbors);
+      linkCount[elemId] = static_cast<T>(neighbors.size());
+    }
+  });
 
-      for(T vt = 0; vt < nEs; ++vt)
-      {
-        if(vertIdxs[vt] == static_cast<K>(t))
-        {
-          continue;
-        } // This is the same element as our "source"
-        if(visited[vertIdxs[vt]])
-        {
-          continue;
-        } // We already added this element so loop again
-        //      qDebug() << "   Comparing Element " << vertIdxs[vt] << "\n";
-        usize vCount = 0;
-        // Loop over all the vertex indices of this element and try to match numSharedVerts of them to the current loop element
-        // If there is numSharedVerts match then that element is a neighbor of the source. If there are more than numVertsPerElem
-        // matches then there is a real problem with the mesh and the program is going to return an error.
-        for(usize i = 0; i < numVertsPerElem; i++)
-        {
-          for(usize j = 0; j < numVertsPerElem; j++)
-          {
-            if(elems[offset + i] == elems[offset + j])
-            {
-              vCount++;
-            }
-          }
-        }
+  dynamicList->allocateLists(linkCount);
+
+  dataAlg.execute([&](const Range& range) {
+    std::vector<K> elem(numVertsPerElem);
+    std::vector<K> other(numVertsPerElem);
+    std::vector<K> neighbors;
+    for(usize elemId = range.min(); elemId < range.max(); elemId++)
+    {
+      findNeighbors(elemId, elem, other, neighbors);
+      std::copy(neighbors.begin(), neighbors.end(), dynamicList->getElementListPointer(elemId));
+    }
+  });
+
+  return 0;
+}
 
-        // So if our vertex match count is numSharedVerts and we have not visited the element in question then add this element index
-        // into the list of vertex indices as neighbors for the source element.
-        if(vCount == numSharedVerts)
+namespace detail
+{
+/**
+ * @brief Builds the sorted vertex key of every sub-element (edge or face) of every element
+ * in parallel and returns the keys in ascending order so that duplicates end up next to each
+ * other. Each entry of localIndices lists the element-local vertex indices of one sub-element.
+ *
+ * The keys are first distributed into one bucket per smallest vertex with a counting sort.
+ * The buckets are then sorted independently, which keeps every comparison sort tiny.
+ * @tparam T
+ * @tparam N Number of vertices per sub-element
+ * @param elemList
+ * @param localIndices
+ * @return std::vector<std::array<T, N>>
+ */
+template <typename T, usize N>
+std::vector<std::array<T, N>> FindSortedSubElementKeys(const DataArray<T>& elemList, const std::vector<std::array<usize, N>>& localIndices)
+{
+  const usize numElems = elemList.getNumberOfTuples();
+  const usize numVertsPerElem = elemList.getNumberOfComponents();
+  const usize numKeysPerElem = localIndices.size();
+  const usize numKeys = numElems * numKeysPerElem;
+  const AbstractDataStore<T>& elems = elemList.getDataStoreRef();
+
+  std::vector<std::array<T, N>> keys(numKeys);
+  std::atomic<usize> numBuckets = 0;
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numElems);
+  dataAlg.execute([&](const Range& range) {
+    std::vector<T> elem(numVertsPerElem);
+    usize rangeBuckets = 0;
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      elems.copyIntoBuffer(i * numVertsPerElem, nonstd::span<T>(elem.data(), numVertsPerElem));
+      for(usize j = 0; j < numKeysPerElem; j++)
+      {
+        std::array<T, N>& key = keys[i * numKeysPerElem + j];
+        for(usize k = 0; k < N; k++)
         {
-          // qDebug() << "       Neighbor: " << vertIdxs[vt] << "\n";
-          // Use the current count of neighbors as the index
-          // into the loop_neighbors vector and place the value of the vertex element at that index
-          loop_neighbors[linkCount[t]] = vertIdxs[vt];
-          linkCount[t]++; // Increment the count for the next time through
-          if(linkCount[t] >= loop_neighbors.size())
-          {
-            loop_neighbors.resize(loop_neighbors.size() + 10);
-          }
-          visited[vertIdxs[vt]] = true; // Set this element as visited so we do NOT add it again
+          key[k] = elem[localIndices[j][k]];
         }
+        std::sort(key.begin(), key.end());
+        rangeBuckets = std::max(rangeBuckets, static_cast<usize>(key[0]) + 1);
       }
     }
-    // Reset all the visited cell indexs back to false (zero)
-    for(int64 k = 0; k < linkCount[t]; ++k)
+    usize current = numBuckets.load();
+    while(current < rangeBuckets && !numBuckets.compare_exchange_weak(current, rangeBuckets))
+    {
+    }
+  });
+
+  // Count the keys of every bucket and turn the counts into bucket offsets
+  std::vector<std::atomic<usize>> bucketCursors(numBuckets.load());
+  dataAlg.setRange(0, numKeys);
+  dataAlg.execute([&](const Range& range) {
+    for(usize i = range.min(); i < range.max(); i++)
     {
-      visited[loop_neighbors[k]] = false;
+      bucketCursors[static_cast<usize>(keys[i][0])].fetch_add(1, std::memory_order_relaxed);
     }
-    // Allocate the array storage for the current edge to hold its vertex list
-    dynamicList->setElementList(t, linkCount[t], &(loop_neighbors[0]));
+  });
+  std::vector<usize> bucketOffsets(bucketCursors.size() + 1, 0);
+  for(usize bucket = 0; bucket < bucketCursors.size(); bucket++)
+  {
+    bucketOffsets[bucket + 1] = bucketOffsets[bucket] + bucketCursors[bucket].load(std::memory_order_relaxed);
+    bucketCursors[bucket].store(bucketOffsets[bucket], std::memory_order_relaxed);
   }
 
-  return err;
+  std::vector<std::array<T, N>> sortedKeys(numKeys);
+  dataAlg.execute([&](const Range& range) {
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      sortedKeys[bucketCursors[static_cast<usize>(keys[i][0])].fetch_add(1, std::memory_order_relaxed)] = keys[i];
+    }
+  });
+  keys.clear();
+  keys.shrink_to_fit();
+
+  // The order inside a bucket depends on the scheduling of the scatter, sorting restores it
+  dataAlg.setRange(0, bucketCursors.size());
+  dataAlg.execute([&](const Range& range) {
+    for(usize bucket = range.min(); bucket < range.max(); bucket++)
+    {
+      std::sort(sortedKeys.begin() + bucketOffsets[bucket], sortedKeys.begin() + bucketOffsets[bucket + 1]);
+    }
+  });
+
+  return sortedKeys;
 }
 
 /**
- * @brief
+ * @brief Compacts the sorted keys and writes them into the output list, which is resized to
+ * the number of keys that remain. Either every distinct key is kept or, if unsharedOnly is
+ * true, only the keys that occur exactly once.
  * @tparam T
- * @param tetList
- * @param edgeList
+ * @tparam N Number of vertices per sub-element
+ * @param keys
+ * @param outputList
+ * @param unsharedOnly
  */
-template <typename T>
-void FindTetEdges(const DataArray<T>* tetList, DataArray<T>* edgeList)
+template <typename T, usize N>
+void WriteSubElementKeys(std::vector<std::array<T, N>>& keys, DataArray<T>* outputList, bool unsharedOnly)
 {
-  const usize numElems = tetList->getNumberOfTuples();
-  const usize numVertsPerTet = tetList->getNumberOfComponents();
-  auto& tets = *tetList;
-
-  std::set<std::pair<T, T>> edgeSet;
+  static_assert(sizeof(std::array<T, N>) == N * sizeof(T), "Keys must be tightly packed to be copied into the output list");
 
-  for(usize i = 0; i < numElems; i++)
+  usize numKept = 0;
+  if(unsharedOnly)
   {
-    const usize offset = i * numVertsPerTet;
-
-    std::vector<T> edge0 = {tets[offset + 0], tets[offset + 1]};
-    std::vector<T> edge1 = {tets[offset + 0], tets[offset + 2]};
-    std::vector<T> edge2 = {tets[offset + 1], tets[offset + 2]};
-    std::vector<T> edge3 = {tets[offset + 0], tets[offset + 3]};
-    std::vector<T> edge4 = {tets[offset + 1], tets[offset + 3]};
-    std::vector<T> edge5 = {tets[offset + 2], tets[offset + 3]};
-    std::list<std::vector<T>> edgeVecList = {edge0, edge1, edge2, edge3, edge4, edge5};
-
-    for(auto&& uEdge : edgeVecList)
+    for(usize start = 0; start < keys.size();)
     {
-      std::sort(uEdge.begin(), uEdge.end());
-      std::pair<T, T> edge = std::make_pair(uEdge[0], uEdge[1]);
-      edgeSet.insert(edge);
+      usize end = start + 1;
+      while(end < keys.size() && keys[end] == keys[start])
+      {
+        end++;
+      }
+      if(end - start == 1)
+      {
+        keys[numKept] = keys[start];
+        numKept++;
+      }
+      start = end;
     }
   }
+  else
+  {
+    numKept = static_cast<usize>(std::unique(keys.begin(), keys.end()) - keys.begin());
+  }
 
-  edgeList->getDataStore()->reshapeTuples({edgeSet.size()});
-  auto& uEdges = *edgeList;
-  T index = 0;
+  outputList->getDataStore()->reshapeTuples({numKept});
+  if(numKept > 0)
+  {
+    outputList->getDataStoreRef().copyFromBuffer(0, nonstd::span<const T>(keys.front().data(), numKept * N));
+  }
+}
 
-  for(auto& edge : edgeSet)
+/**
+ * @brief Returns the element-local vertex indices of the edges of a polygon with the given number of vertices.
+ * @param numVertsPerElem
+ * @return std::vector<std::array<usize, 2>>
+ */
+inline std::vector<std::array<usize, 2>> PolygonEdgeIndices(usize numVertsPerElem)
+{
+  std::vector<std::array<usize, 2>> edges(numVertsPerElem);
+  for(usize j = 0; j < numVertsPerElem; j++)
   {
-    uEdges[2 * index] = edge.first;
-    uEdges[2 * index + 1] = edge.second;
-    ++index;
+    edges[j] = {j, (j + 1) % numVertsPerElem};
   }
+  return edges;
 }
 
+inline const std::vector<std::array<usize, 2>> k_TetEdgeIndices = {{0, 1}, {0, 2}, {1, 2}, {0, 3}, {1, 3}, {2, 3}};
+inline const std::vector<std::array<usize, 3>> k_TetFaceIndices = {{0, 1, 2}, {1, 2, 3}, {0, 2, 3}, {0, 1, 3}};
+inline const std::vector<std::array<usize, 2>> k_HexEdgeIndices = {{0, 1}, {1, 2}, {2, 3}, {3, 0}, {0, 4}, {1, 5}, {2, 6}, {3, 7}, {4, 5}, {5, 6}, {6, 7}, {7, 4}};
+inline const std::vector<std::array<usize, 4>> k_HexFaceIndices = {{0, 1, 5, 4}, {1, 2, 6, 5}, {2, 3, 7, 6}, {3, 0, 4, 7}, {0, 1, 2, 3}, {4, 5, 6, 7}};
+} // namespace detail
+
 /**
- * @brief
+ * @brief Finds the unique edges of a tetrahedral mesh. The edges are written in
+ * ascending order with the smaller vertex index first.
+ * @tparam T
+ * @param tetList
+ * @param edgeList
+ */
+template <typename T>
+void FindTetEdges(const DataArray<T>* tetList, DataArray<T>* edgeList)
+{
+  auto keys = detail::FindSortedSubElementKeys<T, 2>(*tetList, detail::k_TetEdgeIndices);
+  detail::WriteSubElementKeys<T, 2>(keys, edgeList, false);
+}
+
+/**
+ * @brief Finds the unique edges of a hexahedral mesh. The edges are written in
+ * ascending order with the smaller vertex index first.
  * @tparam T
  * @param hexList
  * @param edge_List
@@ -258,57 +389,13 @@ void FindTetEdges(const DataArray<T>* tetList, DataArray<T>* edgeList)
 template <typename T>
 void FindHexEdges(const DataArray<T>* hexList, DataArray<T>* edge_List)
 {
-  const usize numElems = hexList->getNumberOfTuples();
-  const usize numVertsPerHex = hexList->getNumberOfComponents();
-
-  auto& hexas = *hexList;
-
-  std::set<std::pair<T, T>> edgeSet;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerHex;
-
-    std::vector<T> edge0 = {hexas[offset + 0], hexas[offset + 1]};
-    std::vector<T> edge1 = {hexas[offset + 1], hexas[offset + 2]};
-    std::vector<T> edge2 = {hexas[offset + 2], hexas[offset + 3]};
-    std::vector<T> edge3 = {hexas[offset + 3], hexas[offset + 0]};
-
-    std::vector<T> edge4 = {hexas[offset + 0], hexas[offset + 4]};
-    std::vector<T> edge5 = {hexas[offset + 1], hexas[offset + 5]};
-    std::vector<T> edge6 = {hexas[offset + 2], hexas[offset + 6]};
-    std::vector<T> edge7 = {hexas[offset + 3], hexas[offset + 7]};
-
-    std::vector<T> edge8 = {hexas[offset + 4], hexas[offset + 5]};
-    std::vector<T> edge9 = {hexas[offset + 5], hexas[offset + 6]};
-    std::vector<T> edge10 = {hexas[offset + 6], hexas[offset + 7]};
-    std::vector<T> edge11 = {hexas[offset + 7], hexas[offset + 4]};
-
-    std::list<std::vector<T>> edgeList = {edge0, edge1, edge2, edge3, edge4, edge5, edge6, edge7, edge8, edge9, edge10, edge11};
-
-    for(auto&& uEdge : edgeList)
-    {
-      std::sort(uEdge.begin(), uEdge.end());
-      std::pair<T, T> edge = std::make_pair(uEdge[0], uEdge[1]);
-      edgeSet.insert(edge);
-    }
-  }
-
-  typename std::set<std::pair<T, T>>::iterator setIter;
-  edge_List->getDataStore()->reshapeTuples({edgeSet.size()});
-  auto& uEdges = *edge_List;
-  T index = 0;
-
-  for(auto edge : edgeSet)
-  {
-    uEdges[2 * index] = edge.first;
-    uEdges[2 * index + 1] = edge.second;
-    ++index;
-  }
+  auto keys = detail::FindSortedSubElementKeys<T, 2>(*hexList, detail::k_HexEdgeIndices);
+  detail::WriteSubElementKeys<T, 2>(keys, edge_List, false);
 }
 
 /**
- * @brief
+ * @brief Finds the unique triangular faces of a tetrahedral mesh. The faces are written
+ * in ascending order with their vertex indices sorted.
  * @tparam T
  * @param tetList
  * @param faceList
@@ -316,45 +403,13 @@ void FindHexEdges(const DataArray<T>* hexList, DataArray<T>* edge_List)
 template <typename T>
 void FindTetFaces(const DataArray<T>* tetList, DataArray<T>* faceList)
 {
-  auto& tets = *tetList;
-  const usize numElems = tetList->getNumberOfTuples();
-  const usize numVertsPerTet = tetList->getNumberOfComponents();
-
-  std::set<std::tuple<T, T, T>> faceSet;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerTet;
-
-    std::vector<T> tri0 = {tets[offset + 0], tets[offset + 1], tets[offset + 2]};
-    std::vector<T> tri1 = {tets[offset + 1], tets[offset + 2], tets[offset + 3]};
-    std::vector<T> tri2 = {tets[offset + 0], tets[offset + 2], tets[offset + 3]};
-    std::vector<T> tri3 = {tets[offset + 0], tets[offset + 1], tets[offset + 3]};
-    std::list<std::vector<T>> triList = {tri0, tri1, tri2, tri3};
-
-    for(auto&& tri : triList)
-    {
-      std::sort(tri.begin(), tri.end());
-      std::tuple<T, T, T> face = std::make_tuple(tri[0], tri[1], tri[2]);
-      faceSet.insert(face);
-    }
-  }
-
-  faceList->getDataStore()->reshapeTuples({faceSet.size()});
-  auto& uFaces = *faceList;
-  T index = 0;
-
-  for(auto& face : faceSet)
-  {
-    uFaces[3 * index] = std::get<0>(face);
-    uFaces[3 * index + 1] = std::get<1>(face);
-    uFaces[3 * index + 2] = std::get<2>(face);
-    ++index;
-  }
+  auto keys = detail::FindSortedSubElementKeys<T, 3>(*tetList, detail::k_TetFaceIndices);
+  detail::WriteSubElementKeys<T, 3>(keys, faceList, false);
 }
 
 /**
- * @brief
+ * @brief Finds the unique quadrilateral faces of a hexahedral mesh. The faces are written
+ * in ascending order with their vertex indices sorted.
  * @tparam T
  * @param hexList
  * @param faceList
@@ -362,49 +417,12 @@ void FindTetFaces(const DataArray<T>* tetList, DataArray<T>* faceList)
 template <typename T>
 void FindHexFaces(const DataArray<T>* hexList, DataArray<T>* faceList)
 {
-  auto& hexas = *hexList;
-  const usize numElems = hexList->getNumberOfTuples();
-  const usize numVertsPerHex = hexList->getNumberOfComponents();
-
-  std::set<std::tuple<T, T, T, T>> faceSet;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerHex;
-
-    std::vector<T> quad0 = {hexas[offset + 0], hexas[offset + 1], hexas[offset + 5], hexas[offset + 4]};
-    std::vector<T> quad1 = {hexas[offset + 1], hexas[offset + 2], hexas[offset + 6], hexas[offset + 5]};
-    std::vector<T> quad2 = {hexas[offset + 2], hexas[offset + 3], hexas[offset + 7], hexas[offset + 6]};
-    std::vector<T> quad3 = {hexas[offset + 3], hexas[offset + 0], hexas[offset + 4], hexas[offset + 7]};
-    std::vector<T> quad4 = {hexas[offset + 0], hexas[offset + 1], hexas[offset + 2], hexas[offset + 3]};
-    std::vector<T> quad5 = {hexas[offset + 4], hexas[offset + 5], hexas[offset + 6], hexas[offset + 7]};
-
-    std::list<std::vector<T>> quadList = {quad0, quad1, quad2, quad3, quad4, quad5};
-
-    for(auto&& quad : quadList)
-    {
-      std::sort(quad.begin(), quad.end());
-      std::tuple<T, T, T, T> face = std::make_tuple(quad[0], quad[1], quad[2], quad[3]);
-      faceSet.insert(face);
-    }
-  }
-
-  faceList->getDataStore()->reshapeTuples({faceSet.size()});
-  auto& uFaces = *faceList;
-  T index = 0;
-
-  for(auto& face : faceSet)
-  {
-    uFaces[4 * index] = std::get<0>(face);
-    uFaces[4 * index + 1] = std::get<1>(face);
-    uFaces[4 * index + 2] = std::get<2>(face);
-    uFaces[4 * index + 3] = std::get<3>(face);
-    ++index;
-  }
+  auto keys = detail::FindSortedSubElementKeys<T, 4>(*hexList, detail::k_HexFaceIndices);
+  detail::WriteSubElementKeys<T, 4>(keys, faceList, false);
 }
 
 /**
- * @brief
+ * @brief Finds the edges of a tetrahedral mesh that belong to a single tetrahedron.
  * @tparam T
  * @param tetList
  * @param edgeList
@@ -412,60 +430,12 @@ void FindHexFaces(const DataArray<T>* hexList, DataArray<T>* faceList)
 template <typename T>
 void FindUnsharedTetEdges(const DataArray<T>* tetList, DataArray<T>* edgeList)
 {
-  auto& tets = *tetList;
-  const usize numElems = tetList->getNumberOfTuples();
-  const usize numVertsPerTet = tetList->getNumberOfComponents();
-
-  std::map<std::pair<T, T>, T> edgeMap;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerTet;
-
-    std::vector<T> edge0 = {tets[offset + 0], tets[offset + 1]};
-    std::vector<T> edge1 = {tets[offset + 0], tets[offset + 2]};
-    std::vector<T> edge2 = {tets[offset + 1], tets[offset + 2]};
-    std::vector<T> edge3 = {tets[offset + 0], tets[offset + 3]};
-    std::vector<T> edge4 = {tets[offset + 1], tets[offset + 3]};
-    std::vector<T> edge5 = {tets[offset + 2], tets[offset + 3]};
-    std::list<std::vector<T>> edgeVecList = {edge0, edge1, edge2, edge3, edge4, edge5};
-
-    for(auto&& uEdge : edgeVecList)
-    {
-      std::sort(uEdge.begin(), uEdge.end());
-      std::pair<T, T> edge = std::make_pair(uEdge[0], uEdge[1]);
-      edgeMap[edge]++;
-    }
-  }
-
-  typename std::map<std::pair<T, T>, T>::iterator mapIter = edgeMap.begin();
-
-  while(mapIter != edgeMap.end())
-  {
-    if((*mapIter).second > 1)
-    {
-      edgeMap.erase(mapIter++);
-    }
-    else
-    {
-      ++mapIter;
-    }
-  }
-
-  edgeList->getDataStore()->reshapeTuples({edgeMap.size()});
-  auto& bEdges = *edgeList;
-  T index = 0;
-
-  for(auto& pair : edgeMap)
-  {
-    bEdges[2 * index] = pair.first.first;
-    bEdges[2 * index + 1] = pair.first.second;
-    ++index;
-  }
+  auto keys = detail::FindSortedSubElementKeys<T, 2>(*tetList, detail::k_TetEdgeIndices);
+  detail::WriteSubElementKeys<T, 2>(keys, edgeList, true);
 }
 
 /**
- * @brief
+ * @brief Finds the edges of a hexahedral mesh that belong to a single hexahedron.
  * @tparam T
  * @param hexList
  * @param edge_List
@@ -473,70 +443,12 @@ void FindUnsharedTetEdges(const DataArray<T>* tetList, DataArray<T>* edgeList)
 template <typename T>
 void FindUnsharedHexEdges(const DataArray<T>* hexList, DataArray<T>* edge_List)
 {
-  const usize numElems = hexList->getNumberOfTuples();
-  const usize numVertsPerHex = hexList->getNumberOfComponents();
-  auto& hexas = *hexList;
-
-  std::pair<T, T> edge;
-  std::map<std::pair<T, T>, T> edgeMap;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerHex;
-
-    std::vector<T> edge0 = {hexas[offset + 0], hexas[offset + 1]};
-    std::vector<T> edge1 = {hexas[offset + 1], hexas[offset + 2]};
-    std::vector<T> edge2 = {hexas[offset + 2], hexas[offset + 3]};
-    std::vector<T> edge3 = {hexas[offset + 3], hexas[offset + 0]};
-
-    std::vector<T> edge4 = {hexas[offset + 0], hexas[offset + 4]};
-    std::vector<T> edge5 = {hexas[offset + 1], hexas[offset + 5]};
-    std::vector<T> edge6 = {hexas[offset + 2], hexas[offset + 6]};
-    std::vector<T> edge7 = {hexas[offset + 3], hexas[offset + 7]};
-
-    std::vector<T> edge8 = {hexas[offset + 4], hexas[offset + 5]};
-    std::vector<T> edge9 = {hexas[offset + 5], hexas[offset + 6]};
-    std::vector<T> edge10 = {hexas[offset + 6], hexas[offset + 7]};
-    std::vector<T> edge11 = {hexas[offset + 7], hexas[offset + 4]};
-
-    std::list<std::vector<T>> edgeList = {edge0, edge1, edge2, edge3, edge4, edge5, edge6, edge7, edge8, edge9, edge10, edge11};
-
-    for(auto&& uEdge : edgeList)
-    {
-      std::sort(uEdge.begin(), uEdge.end());
-      edge = std::make_pair(uEdge[0], uEdge[1]);
-      edgeMap[edge]++;
-    }
-  }
-
-  typename std::map<std::pair<T, T>, T>::iterator mapIter = edgeMap.begin();
-
-  while(mapIter != edgeMap.end())
-  {
-    if((*mapIter).second > 1)
-    {
-      edgeMap.erase(mapIter++);
-    }
-    else
-    {
-      ++mapIter;
-    }
-  }
-
-  edge_List->getDataStore()->reshapeTuples({edgeMap.size()});
-  auto& bEdges = *edge_List;
-  T index = 0;
-
-  for(auto& pair : edgeMap)
-  {
-    bEdges[2 * index] = pair.first.first;
-    bEdges[2 * index + 1] = pair.first.second;
-    ++index;
-  }
+  auto keys = detail::FindSortedSubElementKeys<T, 2>(*hexList, detail::k_HexEdgeIndices);
+  detail::WriteSubElementKeys<T, 2>(keys, edge_List, true);
 }
 
 /**
- * @brief
+ * @brief Finds the faces of a tetrahedral mesh that belong to a single tetrahedron.
  * @tparam T
  * @param tetList
  * @param faceList
@@ -544,60 +456,12 @@ void FindUnsharedHexEdges(const DataArray<T>* hexList, DataArray<T>* edge_List)
 template <typename T>
 void FindUnsharedTetFaces(const DataArray<T>* tetList, DataArray<T>* faceList)
 {
-  const usize numElems = tetList->getNumberOfTuples();
-  const usize numVertsPerTet = tetList->getNumberOfComponents();
-  auto& tets = *tetList;
-
-  std::tuple<T, T, T> face;
-  std::map<std::tuple<T, T, T>, T> faceMap;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerTet;
-
-    std::vector<T> tri0 = {tets[offset + 0], tets[offset + 1], tets[offset + 2]};
-    std::vector<T> tri1 = {tets[offset + 1], tets[offset + 2], tets[offset + 3]};
-    std::vector<T> tri2 = {tets[offset + 0], tets[offset + 2], tets[offset + 3]};
-    std::vector<T> tri3 = {tets[offset + 0], tets[offset + 1], tets[offset + 3]};
-    std::list<std::vector<T>> triList = {tri0, tri1, tri2, tri3};
-
-    for(auto&& tri : triList)
-    {
-      std::sort(tri.begin(), tri.end());
-      face = std::make_tuple(tri[0], tri[1], tri[2]);
-      faceMap[face]++;
-    }
-  }
-
-  typename std::map<std::tuple<T, T, T>, T>::iterator mapIter = faceMap.begin();
-
-  while(mapIter != faceMap.end())
-  {
-    if((*mapIter).second > 1)
-    {
-      faceMap.erase(mapIter++);
-    }
-    else
-    {
-      ++mapIter;
-    }
-  }
-
-  faceList->getDataStore()->reshapeTuples({faceMap.size()});
-  auto& uFaces = *faceList;
-  T index = 0;
-
-  for(auto& pair : faceMap)
-  {
-    uFaces[3 * index] = std::get<0>(pair.first);
-    uFaces[3 * index + 1] = std::get<1>(pair.first);
-    uFaces[3 * index + 2] = std::get<2>(pair.first);
-    ++index;
-  }
+  auto keys = detail::FindSortedSubElementKeys<T, 3>(*tetList, detail::k_TetFaceIndices);
+  detail::WriteSubElementKeys<T, 3>(keys, faceList, true);
 }
 
 /**
- * @brief
+ * @brief Finds the faces of a hexahedral mesh that belong to a single hexahedron.
  * @tparam T
  * @param hexList
  * @param faceList
@@ -605,64 +469,13 @@ void FindUnsharedTetFaces(const DataArray<T>* tetList, DataArray<T>* faceList)
 template <typename T>
 void FindUnsharedHexFaces(const DataArray<T>* hexList, DataArray<T>* faceList)
 {
-  auto& hexas = *hexList;
-  const usize numElems = hexList->getNumberOfTuples();
-  const usize numVertsPerHex = hexList->getNumberOfComponents();
-
-  std::tuple<T, T, T, T> face;
-  std::map<std::tuple<T, T, T, T>, T> faceMap;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerHex;
-
-    std::vector<T> quad0 = {hexas[offset + 0], hexas[offset + 1], hexas[offset + 5], hexas[offset + 4]};
-    std::vector<T> quad1 = {hexas[offset + 1], hexas[offset + 2], hexas[offset + 6], hexas[offset + 5]};
-    std::vector<T> quad2 = {hexas[offset + 2], hexas[offset + 3], hexas[offset + 7], hexas[offset + 6]};
-    std::vector<T> quad3 = {hexas[offset + 3], hexas[offset + 0], hexas[offset + 4], hexas[offset + 7]};
-    std::vector<T> quad4 = {hexas[offset + 0], hexas[offset + 1], hexas[offset + 2], hexas[offset + 3]};
-    std::vector<T> quad5 = {hexas[offset + 4], hexas[offset + 5], hexas[offset + 6], hexas[offset + 7]};
-
-    std::list<std::vector<T>> quadList = {quad0, quad1, quad2, quad3, quad4, quad5};
-
-    for(auto&& quad : quadList)
-    {
-      std::sort(quad.begin(), quad.end());
-      face = std::make_tuple(quad[0], quad[1], quad[2], quad[3]);
-      faceMap[face]++;
-    }
-  }
-
-  typename std::map<std::tuple<T, T, T, T>, T>::iterator mapIter = faceMap.begin();
-
-  while(mapIter != faceMap.end())
-  {
-    if((*mapIter).second > 1)
-    {
-      faceMap.erase(mapIter++);
-    }
-    else
-    {
-      ++mapIter;
-    }
-  }
-
-  faceList->getDataStore()->reshapeTuples({faceMap.size()});
-  auto& uFaces = *faceList;
-  T index = 0;
-
-  for(auto& pair : faceMap)
-  {
-    uFaces[4 * index] = std::get<0>(pair.first);
-    uFaces[4 * index + 1] = std::get<1>(pair.first);
-    uFaces[4 * index + 2] = std::get<2>(pair.first);
-    uFaces[4 * index + 3] = std::get<3>(pair.first);
-    ++index;
-  }
+  auto keys = detail::FindSortedSubElementKeys<T, 4>(*hexList, detail::k_HexFaceIndices);
+  detail::WriteSubElementKeys<T, 4>(keys, faceList, true);
 }
 
 /**
- * @brief
+ * @brief Finds the unique edges of a triangle or quadrilateral mesh. The edges are
+ * written in ascending order with the smaller vertex index first.
  * @tparam T
  * @param elemList
  * @param edgeList
@@ -670,66 +483,12 @@ void FindUnsharedHexFaces(const DataArray<T>* hexList, DataArray<T>* faceList)
 template <typename T>
 void Find2DElementEdges(const DataArray<T>* elemList, DataArray<T>* edgeList)
 {
-  const usize numElems = elemList->getNumberOfTuples();
-  const usize numVertsPerElem = elemList->getNumberOfComponents();
-  auto& elems = *elemList;
-  T v0 = 0;
-  T v1 = 0;
-
-  std::set<std::pair<T, T>> edgeSet;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerElem;
-
-    for(usize j = 0; j < numVertsPerElem; j++)
-    {
-      if(j == (numVertsPerElem - 1))
-      {
-        if(elems[offset + j] > elems[offset + 0])
-        {
-          v0 = elems[offset + 0];
-          v1 = elems[offset + j];
-        }
-        else
-        {
-          v0 = elems[offset + j];
-          v1 = elems[offset + 0];
-        }
-      }
-      else
-      {
-        if(elems[offset + j] > elems[offset + j + 1])
-        {
-          v0 = elems[offset + j + 1];
-          v1 = elems[offset + j];
-        }
-        else
-        {
-          v0 = elems[offset + j];
-          v1 = elems[offset + j + 1];
-        }
-      }
-      std::pair<T, T> edge = std::make_pair(v0, v1);
-      edgeSet.insert(edge);
-    }
-  }
-
-  typename std::set<std::pair<T, T>>::iterator setIter;
-  edgeList->getDataStore()->reshapeTuples({edgeSet.size()});
-  auto& uEdges = *edgeList;
-  T index = 0;
-
-  for(auto& edge : edgeSet)
-  {
-    uEdges[2 * index] = edge.first;
-    uEdges[2 * index + 1] = edge.second;
-    ++index;
-  }
+  auto keys = detail::FindSortedSubElementKeys<T, 2>(*elemList, detail::PolygonEdgeIndices(elemList->getNumberOfComponents()));
+  detail::WriteSubElementKeys<T, 2>(keys, edgeList, false);
 }
 
 /**
- * @brief
+ * @brief Finds the edges of a triangle or quadrilateral mesh that belong to a single element.
  * @tparam T
  * @param elemList
  * @param edgeList
@@ -737,76 +496,10 @@ void Find2DElementEdges(const DataArray<T>* elemList, DataArray<T>* edgeList)
 template <typename T>
 void Find2DUnsharedEdges(const DataArray<T>* elemList, DataArray<T>* edgeList)
 {
-  auto& elems = *elemList;
-  const usize numElems = elemList->getNumberOfTuples();
-  const usize numVertsPerElem = elemList->getNumberOfComponents();
-  T v0 = 0;
-  T v1 = 0;
-
-  std::map<std::pair<T, T>, T> edgeMap;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerElem;
-
-    for(usize j = 0; j < numVertsPerElem; j++)
-    {
-      if(j == (numVertsPerElem - 1))
-      {
-        if(elems[offset + j] > elems[offset + 0])
-        {
-          v0 = elems[offset + 0];
-          v1 = elems[offset + j];
-        }
-        else
-        {
-          v0 = elems[offset + j];
-          v1 = elems[offset + 0];
-        }
-      }
-      else
-      {
-        if(elems[offset + j] > elems[offset + j + 1])
-        {
-          v0 = elems[offset + j + 1];
-          v1 = elems[offset + j];
-        }
-        else
-        {
-          v0 = elems[offset + j];
-          v1 = elems[offset + j + 1];
-        }
-      }
-      std::pair<T, T> edge = std::make_pair(v0, v1);
-      edgeMap[edge]++;
-    }
-  }
-
-  typename std::map<std::pair<T, T>, T>::iterator mapIter = edgeMap.begin();
-
-  while(mapIter != edgeMap.end())
-  {
-    if((*mapIter).second > 1)
-    {
-      edgeMap.erase(mapIter++);
-    }
-    else
-    {
-      ++mapIter;
-    }
-  }
-
-  edgeList->getDataStore()->reshapeTuples({edgeMap.size()});
-  auto& bEdges = *edgeList;
-  T index = 0;
-
-  for(auto& edge : edgeMap)
-  {
-    bEdges[2 * index] = edge.first.first;
-    bEdges[2 * index + 1] = edge.first.second;
-    ++index;
-  }
+  auto keys = detail::FindSortedSubElementKeys<T, 2>(*elemList, detail::PolygonEdgeIndices(elemList->getNumberOfComponents()));
+  detail::WriteSubElementKeys<T, 2>(keys, edgeList, true);
 }
+
 } // namespace Connectivity
 
 namespace Topology
@@ -0,0 +1,387 @@
+#pragma once
+
+#include "complex/Common/Array.hpp"
+#include "complex/Common/Range.hpp"
+#include "complex/Common/Types.hpp"
+#include "complex/DataStructure/AbstractDataStore.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace complex
+{
+namespace GridLabeling
+{
+namespace detail
+{
+/**
+ * @brief Returns the root of the given point and halves the path on the way.
+ * Roots are always the smallest index in their set.
+ * @tparam IndexType
+ * @param parents
+ * @param index
+ * @return IndexType
+ */
+template <typename IndexType>
+IndexType FindRoot(std::vector<IndexType>& parents, IndexType index)
+{
+  while(parents[index] != index)
+  {
+    parents[index] = parents[parents[index]];
+    index = parents[index];
+  }
+  return index;
+}
+
+/**
+ * @brief Merges the sets containing the two points. The larger root is attached
+ * to the smaller one so that every root is the smallest index of its set.
+ * @tparam IndexType
+ * @param parents
+ * @param first
+ * @param second
+ */
+template <typename IndexType>
+void Union(std::vector<IndexType>& parents, IndexType first, IndexType second)
+{
+  IndexType firstRoot = FindRoot(parents, first);
+  IndexType secondRoot = FindRoot(parents, second);
+  if(firstRoot < secondRoot)
+  {
+    parents[secondRoot] = firstRoot;
+  }
+  else if(secondRoot < firstRoot)
+  {
+    parents[firstRoot] = secondRoot;
+  }
+}
+
+/**
+ * @brief Adds the label counts of one written block of labels to the sizes of its
+ * labeling block. Labels of components whose root lies in an earlier block, as well
+ * as the excluded label 0, are recorded as runs since they mostly come in long rows.
+ * @param labels
+ * @param firstLabel First label handed out to a root of the labeling block
+ * @param ownSizes Sizes of the components rooted in the labeling block
+ * @param carriedRuns Label and count of each run of labels below firstLabel
+ */
+inline void CountLabels(nonstd::span<const int32> labels, usize firstLabel, std::vector<usize>& ownSizes, std::vector<std::pair<usize, usize>>& carriedRuns)
+{
+  for(int32 value : labels)
+  {
+    const auto label = static_cast<usize>(value);
+    if(label >= firstLabel)
+    {
+      ownSizes[label - firstLabel]++;
+    }
+    else if(!carriedRuns.empty() && carriedRuns.back().first == label)
+    {
+      carriedRuns.back().second++;
+    }
+    else
+    {
+      carriedRuns.emplace_back(label, 1);
+    }
+  }
+}
+
+template <typename IndexType, class IncludeFunctor, class ConnectFunctor>
+usize LabelConnectedComponentsImpl(const SizeVec3& dims, AbstractDataStore<int32>& labels, const IncludeFunctor& include, const ConnectFunctor& connect, const std::atomic_bool& shouldCancel,
+                                   bool parallel, std::vector<usize>* componentSizes)
+{
+  constexpr IndexType k_Excluded = std::numeric_limits<IndexType>::max();
+  constexpr usize k_WriteBlockSize = 65536;
+
+  const usize xDim = dims[0];
+  const usize yDim = dims[1];
+  const usize zDim = dims[2];
+  const usize totalPoints = xDim * yDim * zDim;
+  const usize xyDim = xDim * yDim;
+
+  // Blocks are whole planes, or whole rows for a single plane, so that only the
+  // faces between neighboring blocks need to be merged afterwards.
+  const usize layerStride = zDim > 1 ? xyDim : xDim;
+  const usize numLayers = totalPoints / layerStride;
+  const usize numThreads = parallel ? std::max(std::thread::hardware_concurrency(), 1U) : 1;
+  const usize numBlocks = std::min(numLayers, numThreads * 4);
+  const usize layersPerBlock = (numLayers + numBlocks - 1) / numBlocks;
+  std::vector<usize> blockStarts;
+  for(usize layer = 0; layer < numLayers; layer += layersPerBlock)
+  {
+    blockStarts.push_back(layer * layerStride);
+  }
+  blockStarts.push_back(totalPoints);
+  const usize blockCount = blockStarts.size() - 1;
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setParallelizationEnabled(parallel);
+  dataAlg.setRange(0, blockCount);
+
+  // Union every point with its -x, -y and -z neighbors that lie in the same block
+  std::vector<IndexType> parents(totalPoints, k_Excluded);
+  dataAlg.execute([&](const Range& range) {
+    for(usize block = range.min(); block < range.max(); block++)
+    {
+      const usize blockStart = blockStarts[block];
+      for(usize index = blockStart; index < blockStarts[block + 1]; index++)
+      {
+        if(shouldCancel)
+        {
+          return;
+        }
+        if(!include(index))
+        {
+          continue;
+        }
+        parents[index] = static_cast<IndexType>(index);
+
+        const usize col = index % xDim;
+        const usize row = (index / xDim) % yDim;
+        const usize plane = index / xyDim;
+        if(col > 0 && parents[index - 1] != k_Excluded && connect(index, index - 1))
+        {
+          Union<IndexType>(parents, static_cast<IndexType>(index), static_cast<IndexType>(index - 1));
+        }
+        if(row > 0 && index - xDim >= blockStart && parents[index - xDim] != k_Excluded && connect(index, index - xDim))
+        {
+          Union<IndexType>(parents, static_cast<IndexType>(index), static_cast<IndexType>(index - xDim));
+        }
+        if(plane > 0 && index - xyDim >= blockStart && parents[index - xyDim] != k_Excluded && connect(index, index - xyDim))
+        {
+          Union<IndexType>(parents, static_cast<IndexType>(index), static_cast<IndexType>(index - xyDim));
+        }
+      }
+    }
+  });
+  if(shouldCancel)
+  {
+    return 0;
+  }
+
+  // Merge the sets across the faces between neighboring blocks
+  for(usize block = 1; block < blockCount; block++)
+  {
+    const usize blockStart = blockStarts[block];
+    for(usize index = blockStart; index < blockStart + layerStride; index++)
+    {
+      const usize neighbor = index - layerStride;
+      if(parents[index] != k_Excluded && parents[neighbor] != k_Excluded && connect(index, neighbor))
+      {
+        Union<IndexType>(parents, static_cast<IndexType>(index), static_cast<IndexType>(neighbor));
+      }
+    }
+  }
+
+  // Count the roots in each block so that labels can be handed out in the order of
+  // each component's smallest index, exactly as a serial scan would.
+  std::vector<usize> blockLabelOffsets(blockCount + 1, 0);
+  dataAlg.execute([&](const Range& range) {
+    for(usize block = range.min(); block < range.max(); block++)
+    {
+      usize numRoots = 0;
+      for(usize index = blockStarts[block]; index < blockStarts[block + 1]; index++)
+      {
+        numRoots += parents[index] == static_cast<IndexType>(index) ? 1 : 0;
+      }
+      blockLabelOffsets[block + 1] = numRoots;
+    }
+  });
+  for(usize block = 0; block < blockCount; block++)
+  {
+    blockLabelOffsets[block + 1] += blockLabelOffsets[block];
+  }
+
+  // Replace each root with its negated label. Roots only ever point to themselves so
+  // no other block reads them during this pass.
+  dataAlg.execute([&](const Range& range) {
+    for(usize block = range.min(); block < range.max(); block++)
+    {
+      IndexType nextLabel = static_cast<IndexType>(blockLabelOffsets[block] + 1);
+      for(usize index = blockStarts[block]; index < blockStarts[block + 1]; index++)
+      {
+        if(parents[index] == static_cast<IndexType>(index))
+        {
+          parents[index] = -nextLabel;
+          nextLabel++;
+        }
+      }
+    }
+  });
+
+  // Resolve every point to the label of its root and write the labels in blocks
+  std::vector<std::vector<usize>> blockSizes(componentSizes != nullptr ? blockCount : 0);
+  std::vector<std::vector<std::pair<usize, usize>>> blockCarriedRuns(blockSizes.size());
+  dataAlg.execute([&](const Range& range) {
+    std::vector<int32> buffer(k_WriteBlockSize);
+    for(usize block = range.min(); block < range.max(); block++)
+    {
+      if(componentSizes != nullptr)
+      {
+        blockSizes[block].assign(blockLabelOffsets[block + 1] - blockLabelOffsets[block], 0);
+      }
+      for(usize start = blockStarts[block]; start < blockStarts[block + 1]; start += k_WriteBlockSize)
+      {
+        const usize count = std::min(k_WriteBlockSize, blockStarts[block + 1] - start);
+        for(usize i = 0; i < count; i++)
+        {
+          IndexType current = parents[start + i];
+          if(current == k_Excluded)
+          {
+            buffer[i] = 0;
+            continue;
+          }
+          while(current >= 0)
+          {
+            current = parents[current];
+          }
+          buffer[i] = static_cast<int32>(-current);
+        }
+        labels.copyFromBuffer(start, nonstd::span<const int32>(buffer.data(), count));
+        if(componentSizes != nullptr)
+        {
+          CountLabels(nonstd::span<const int32>(buffer.data(), count), blockLabelOffsets[block] + 1, blockSizes[block], blockCarriedRuns[block]);
+        }
+      }
+    }
+  });
+
+  if(componentSizes != nullptr)
+  {
+    componentSizes->assign(blockLabelOffsets.back() + 1, 0);
+    for(usize block = 0; block < blockCount; block++)
+    {
+      std::copy(blockSizes[block].cbegin(), blockSizes[block].cend(), componentSizes->begin() + blockLabelOffsets[block] + 1);
+      for(const auto& [label, count] : blockCarriedRuns[block])
+      {
+        (*componentSizes)[label] += count;
+      }
+    }
+  }
+
+  return blockLabelOffsets.back();
+}
+
+template <class IncludeFunctor, class ConnectFunctor>
+usize LabelConnectedComponents(const SizeVec3& dims, AbstractDataStore<int32>& labels, const IncludeFunctor& include, const ConnectFunctor& connect, const std::atomic_bool& shouldCancel,
+                               bool parallel, std::vector<usize>* componentSizes)
+{
+  const usize totalPoints = dims[0] * dims[1] * dims[2];
+  if(totalPoints == 0)
+  {
+    if(componentSizes != nullptr)
+    {
+      componentSizes->assign(1, 0);
+    }
+    return 0;
+  }
+  if(totalPoints < static_cast<usize>(std::numeric_limits<int32>::max()))
+  {
+    return LabelConnectedComponentsImpl<int32>(dims, labels, include, connect, shouldCancel, parallel, componentSizes);
+  }
+  return LabelConnectedComponentsImpl<int64>(dims, labels, include, connect, shouldCancel, parallel, componentSizes);
+}
+} // namespace detail
+
+/**
+ * @brief Labels the face connected (6-connected) components of a structured grid in parallel.
+ *
+ * The grid is split into blocks of whole planes (or whole rows for a single plane)
+ * that are labeled concurrently with a union-find. The sets are then merged across
+ * the block faces and relabeled. Components are numbered starting at 1 in the order
+ * of their smallest point index, so the result does not depend on the number of
+ * threads and matches a serial flood fill that seeds in index order. Points that
+ * are not included are labeled 0.
+ *
+ * The connect functor must be symmetric and is only called for pairs of included points.
+ * Both functors are called concurrently and must be thread safe.
+ * @tparam IncludeFunctor bool(usize index)
+ * @tparam ConnectFunctor bool(usize index, usize neighbor)
+ * @param dims The X, Y and Z dimensions of the grid
+ * @param labels The store that receives the labels. It must hold at least one value per point.
+ * @param include Returns true if the point takes part in a component
+ * @param connect Returns true if the two neighboring points belong to the same component
+ * @param shouldCancel
+ * @param parallel Set to false to label the grid on the calling thread only
+ * @return usize The number of components that were found
+ */
+template <class IncludeFunctor, class ConnectFunctor>
+usize LabelConnectedComponents(const SizeVec3& dims, AbstractDataStore<int32>& labels, const IncludeFunctor& include, const ConnectFunctor& connect, const std::atomic_bool& shouldCancel,
+                               bool parallel = true)
+{
+  return detail::LabelConnectedComponents(dims, labels, include, connect, shouldCancel, parallel, nullptr);
+}
+
+/**
+ * @brief Labels the face connected components of a structured grid in parallel exactly
+ * like LabelConnectedComponents() and also counts the points of each component while
+ * the labels are written.
+ * @tparam IncludeFunctor bool(usize index)
+ * @tparam ConnectFunctor bool(usize index, usize neighbor)
+ * @param dims The X, Y and Z dimensions of the grid
+ * @param labels The store that receives the labels. It must hold at least one value per point.
+ * @param include Returns true if the point takes part in a component
+ * @param connect Returns true if the two neighboring points belong to the same component
+ * @param shouldCancel
+ * @param parallel Set to false to label the grid on the calling thread only
+ * @return std::vector<usize> The number of points with each label. Entry 0 counts the
+ * points that were not included, so the number of components is one less than the size.
+ */
+template <class IncludeFunctor, class ConnectFunctor>
+std::vector<usize> LabelConnectedComponentsWithSizes(const SizeVec3& dims, AbstractDataStore<int32>& labels, const IncludeFunctor& include, const ConnectFunctor& connect,
+                                                     const std::atomic_bool& shouldCancel, bool parallel = true)
+{
+  std::vector<usize> componentSizes;
+  detail::LabelConnectedComponents(dims, labels, include, connect, shouldCancel, parallel, &componentSizes);
+  return componentSizes;
+}
+
+/**
+ * @brief Finds the components that have at least one point on the outer faces of
+ * the grid.
+ * @param dims The X, Y and Z dimensions of the grid
+ * @param labels Labels written by LabelConnectedComponents()
+ * @param numComponents
+ * @return std::vector<bool> One value per label. Label 0 is never on the boundary.
+ */
+inline std::vector<bool> FindBoundaryComponents(const SizeVec3& dims, const AbstractDataStore<int32>& labels, usize numComponents)
+{
+  std::vector<bool> onBoundary(numComponents + 1, false);
+  const usize xDim = dims[0];
+  const usize yDim = dims[1];
+  const usize zDim = dims[2];
+  const auto markRow = [&](usize start, usize count) {
+    labels.visitConstChunks(start, count, [&onBoundary](usize, nonstd::span<const int32> values) {
+      for(int32 label : values)
+      {
+        onBoundary[label] = true;
+      }
+    });
+  };
+
+  // Whole rows on the outer planes and rows, only the first and last point of the inner rows
+  for(usize z = 0; z < zDim; z++)
+  {
+    for(usize y = 0; y < yDim; y++)
+    {
+      const usize rowStart = (z * yDim + y) * xDim;
+      if(z == 0 || z == zDim - 1 || y == 0 || y == yDim - 1 || xDim <= 2)
+      {
+        markRow(rowStart, xDim);
+        continue;
+      }
+      onBoundary[labels.getValue(rowStart)] = true;
+      onBoundary[labels.getValue(rowStart + xDim - 1)] = true;
+    }
+  }
+  onBoundary[0] = false;
+  return onBoundary;
+}
+} // namespace GridLabeling
+} // namespace complex
@@ -1,8 +1,15 @@
 #pragma once
 
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <nonstd/span.hpp>
+
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
 #include <numeric>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
@@ -197,4 +204,520 @@ std::vector<float> findHistogram(C<T, Ts...>& source, float histmin, float histm
 
   return Histogram;
 }
+// -----------------------------------------------------------------------------
+// Span based statistics for large contiguous arrays. The values are split into
+// chunks that are reduced in parallel. The inner loops keep several independent
+// accumulators so that the compiler can vectorize them.
+// -----------------------------------------------------------------------------
+constexpr size_t k_ReductionLanes = 8;
+constexpr size_t k_MinReductionChunkSize = 65536;
+
+template <typename T>
+using SumType = std::conditional_t<std::is_integral_v<T>, std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>, double>;
+
+/**
+ * @brief Count, min, max, sum and the sum of squared deviations from the mean of a
+ * set of values.
+ */
+template <typename T>
+struct SpanSummary
+{
+  size_t Count = 0;
+  T Min = static_cast<T>(0);
+  T Max = static_cast<T>(0);
+  SumType<T> Sum = 0;
+  double M2 = 0.0;
+};
+
+// -----------------------------------------------------------------------------
+inline size_t reductionChunkSize(size_t count)
+{
+  const size_t numChunks = std::max<size_t>(std::thread::hardware_concurrency(), 1) * 4;
+  return std::max((count + numChunks - 1) / numChunks, k_MinReductionChunkSize);
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+SpanSummary<T> summarizeChunk(const T* values, size_t count)
+{
+  using Lanes = std::array<T, k_ReductionLanes>;
+  // Deviations are taken from the first value so their squares stay small
+  const double shift = static_cast<double>(values[0]);
+  Lanes mins;
+  Lanes maxs;
+  mins.fill(values[0]);
+  maxs.fill(values[0]);
+  std::array<SumType<T>, k_ReductionLanes> sums = {};
+  std::array<double, k_ReductionLanes> deviationSums = {};
+  std::array<double, k_ReductionLanes> squareSums = {};
+
+  size_t i = 0;
+  for(; i + k_ReductionLanes <= count; i += k_ReductionLanes)
+  {
+    for(size_t lane = 0; lane < k_ReductionLanes; lane++)
+    {
+      const T value = values[i + lane];
+      mins[lane] = value < mins[lane] ? value : mins[lane];
+      maxs[lane] = value > maxs[lane] ? value : maxs[lane];
+      sums[lane] += value;
+      const double deviation = static_cast<double>(value) - shift;
+      deviationSums[lane] += deviation;
+      squareSums[lane] += deviation * deviation;
+    }
+  }
+  for(; i < count; i++)
+  {
+    const T value = values[i];
+    mins[0] = value < mins[0] ? value : mins[0];
+    maxs[0] = value > maxs[0] ? value : maxs[0];
+    sums[0] += value;
+    const double deviation = static_cast<double>(value) - shift;
+    deviationSums[0] += deviation;
+    squareSums[0] += deviation * deviation;
+  }
+
+  SpanSummary<T> summary;
+  summary.Count = count;
+  summary.Min = *std::min_element(mins.cbegin(), mins.cend());
+  summary.Max = *std::max_element(maxs.cbegin(), maxs.cend());
+  double deviationSum = 0.0;
+  double squareSum = 0.0;
+  for(size_t lane = 0; lane < k_ReductionLanes; lane++)
+  {
+    summary.Sum += sums[lane];
+    deviationSum += deviationSums[lane];
+    squareSum += squareSums[lane];
+  }
+  summary.M2 = std::max(squareSum - deviationSum * deviationSum / static_cast<double>(count), 0.0);
+  return summary;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+SpanSummary<T> combineSummaries(const SpanSummary<T>& lhs, const SpanSummary<T>& rhs)
+{
+  if(lhs.Count == 0)
+  {
+    return rhs;
+  }
+  if(rhs.Count == 0)
+  {
+    return lhs;
+  }
+  SpanSummary<T> summary;
+  summary.Count = lhs.Count + rhs.Count;
+  summary.Min = std::min(lhs.Min, rhs.Min);
+  summary.Max = std::max(lhs.Max, rhs.Max);
+  summary.Sum = lhs.Sum + rhs.Sum;
+  const double lhsCount = static_cast<double>(lhs.Count);
+  const double rhsCount = static_cast<double>(rhs.Count);
+  const double delta = static_cast<double>(rhs.Sum) / rhsCount - static_cast<double>(lhs.Sum) / lhsCount;
+  summary.M2 = lhs.M2 + rhs.M2 + delta * delta * lhsCount * rhsCount / static_cast<double>(summary.Count);
+  return summary;
+}
+
+/**
+ * @brief Summarizes one chunk of values per index of the range.
+ */
+template <typename T>
+class SummarizeSpanImpl
+{
+public:
+  SummarizeSpanImpl(nonstd::span<const T> values, size_t chunkSize, std::vector<SpanSummary<T>>& summaries)
+  : m_Values(values)
+  , m_ChunkSize(chunkSize)
+  , m_Summaries(summaries)
+  {
+  }
+
+  void operator()(const complex::Range& range) const
+  {
+    for(size_t chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      const size_t start = chunk * m_ChunkSize;
+      m_Summaries[chunk] = summarizeChunk(m_Values.data() + start, std::min(m_ChunkSize, m_Values.size() - start));
+    }
+  }
+
+private:
+  nonstd::span<const T> m_Values;
+  size_t m_ChunkSize;
+  std::vector<SpanSummary<T>>& m_Summaries;
+};
+
+// -----------------------------------------------------------------------------
+template <typename T>
+SpanSummary<T> summarize(nonstd::span<const T> values)
+{
+  if(values.empty())
+  {
+    return {};
+  }
+  const size_t chunkSize = reductionChunkSize(values.size());
+  std::vector<SpanSummary<T>> summaries((values.size() + chunkSize - 1) / chunkSize);
+
+  complex::ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, summaries.size());
+  dataAlg.execute(SummarizeSpanImpl<T>(values, chunkSize, summaries));
+
+  // The chunks are combined in order so the result does not depend on the scheduling
+  SpanSummary<T> summary;
+  for(const auto& chunkSummary : summaries)
+  {
+    summary = combineSummaries(summary, chunkSummary);
+  }
+  return summary;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+float findMean(nonstd::span<const T> values)
+{
+  const SpanSummary<T> summary = summarize(values);
+  if(summary.Count == 0)
+  {
+    return 0.0f;
+  }
+  return static_cast<float>(static_cast<double>(summary.Sum) / static_cast<double>(summary.Count));
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+float findStdDeviation(nonstd::span<const T> values)
+{
+  const SpanSummary<T> summary = summarize(values);
+  if(summary.Count == 0)
+  {
+    return 0.0f;
+  }
+  return static_cast<float>(std::sqrt(summary.M2 / static_cast<double>(summary.Count)));
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+double findSummation(nonstd::span<const T> values)
+{
+  return static_cast<float>(summarize(values).Sum);
+}
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Maps a value to an unsigned integer with the same ordering so values can
+ * be selected digit by digit.
+ */
+template <typename T>
+auto toOrderedKey(T value)
+{
+  if constexpr(std::is_floating_point_v<T>)
+  {
+    using KeyType = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    constexpr KeyType k_SignBit = static_cast<KeyType>(1) << (sizeof(T) * 8 - 1);
+    KeyType bits = 0;
+    std::memcpy(&bits, &value, sizeof(T));
+    return (bits & k_SignBit) != 0 ? static_cast<KeyType>(~bits) : static_cast<KeyType>(bits | k_SignBit);
+  }
+  else
+  {
+    using KeyType = std::make_unsigned_t<T>;
+    auto key = static_cast<KeyType>(value);
+    if constexpr(std::is_signed_v<T>)
+    {
+      key ^= static_cast<KeyType>(1) << (sizeof(T) * 8 - 1);
+    }
+    return key;
+  }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T, typename KeyType>
+T fromOrderedKey(KeyType key)
+{
+  if constexpr(std::is_floating_point_v<T>)
+  {
+    constexpr KeyType k_SignBit = static_cast<KeyType>(1) << (sizeof(T) * 8 - 1);
+    const KeyType bits = (key & k_SignBit) != 0 ? static_cast<KeyType>(key & ~k_SignBit) : static_cast<KeyType>(~key);
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+  }
+  else
+  {
+    if constexpr(std::is_signed_v<T>)
+    {
+      key ^= static_cast<KeyType>(1) << (sizeof(T) * 8 - 1);
+    }
+    return static_cast<T>(key);
+  }
+}
+
+constexpr size_t k_RadixBits = 8;
+constexpr size_t k_RadixBuckets = size_t(1) << k_RadixBits;
+
+/**
+ * @brief Counts the digit at the given shift of every value whose higher digits match
+ * the prefix, one row of counts per chunk.
+ */
+template <typename T, typename KeyType>
+class CountDigitsImpl
+{
+public:
+  CountDigitsImpl(nonstd::span<const T> values, size_t chunkSize, KeyType prefix, KeyType prefixMask, size_t shift, std::vector<std::array<size_t, k_RadixBuckets>>& counts)
+  : m_Values(values)
+  , m_ChunkSize(chunkSize)
+  , m_Prefix(prefix)
+  , m_PrefixMask(prefixMask)
+  , m_Shift(shift)
+  , m_Counts(counts)
+  {
+  }
+
+  void operator()(const complex::Range& range) const
+  {
+    for(size_t chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      auto& counts = m_Counts[chunk];
+      counts.fill(0);
+      const size_t start = chunk * m_ChunkSize;
+      const size_t end = std::min(start + m_ChunkSize, m_Values.size());
+      for(size_t i = start; i < end; i++)
+      {
+        const KeyType key = toOrderedKey(m_Values[i]);
+        if((key & m_PrefixMask) == m_Prefix)
+        {
+          counts[(key >> m_Shift) & (k_RadixBuckets - 1)]++;
+        }
+      }
+    }
+  }
+
+private:
+  nonstd::span<const T> m_Values;
+  size_t m_ChunkSize;
+  KeyType m_Prefix;
+  KeyType m_PrefixMask;
+  size_t m_Shift;
+  std::vector<std::array<size_t, k_RadixBuckets>>& m_Counts;
+};
+
+/**
+ * @brief Finds the largest value whose key is below the bound, one result per chunk.
+ */
+template <typename T, typename KeyType>
+class MaxBelowImpl
+{
+public:
+  MaxBelowImpl(nonstd::span<const T> values, size_t chunkSize, KeyType bound, std::vector<KeyType>& maxKeys)
+  : m_Values(values)
+  , m_ChunkSize(chunkSize)
+  , m_Bound(bound)
+  , m_MaxKeys(maxKeys)
+  {
+  }
+
+  void operator()(const complex::Range& range) const
+  {
+    for(size_t chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      KeyType maxKey = 0;
+      const size_t start = chunk * m_ChunkSize;
+      const size_t end = std::min(start + m_ChunkSize, m_Values.size());
+      for(size_t i = start; i < end; i++)
+      {
+        const KeyType key = toOrderedKey(m_Values[i]);
+        maxKey = key < m_Bound && key > maxKey ? key : maxKey;
+      }
+      m_MaxKeys[chunk] = maxKey;
+    }
+  }
+
+private:
+  nonstd::span<const T> m_Values;
+  size_t m_ChunkSize;
+  KeyType m_Bound;
+  std::vector<KeyType>& m_MaxKeys;
+};
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Finds the value that would be at position n if the values were sorted,
+ * without copying or reordering them. Each digit of the order preserving key is
+ * fixed by one parallel counting pass.
+ * @param values
+ * @param n
+ * @param numLess Set to the number of values that are smaller than the result
+ * @return T
+ */
+template <typename T>
+T selectNth(nonstd::span<const T> values, size_t n, size_t& numLess)
+{
+  using KeyType = decltype(toOrderedKey(T{}));
+  const size_t chunkSize = reductionChunkSize(values.size());
+  const size_t numChunks = (values.size() + chunkSize - 1) / chunkSize;
+  std::vector<std::array<size_t, k_RadixBuckets>> counts(numChunks);
+
+  complex::ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numChunks);
+
+  KeyType prefix = 0;
+  KeyType prefixMask = 0;
+  numLess = 0;
+  for(size_t digit = sizeof(KeyType) * 8 / k_RadixBits; digit > 0; digit--)
+  {
+    const size_t shift = (digit - 1) * k_RadixBits;
+    dataAlg.execute(CountDigitsImpl<T, KeyType>(values, chunkSize, prefix, prefixMask, shift, counts));
+
+    size_t bucket = 0;
+    for(; bucket < k_RadixBuckets; bucket++)
+    {
+      size_t bucketCount = 0;
+      for(const auto& chunkCounts : counts)
+      {
+        bucketCount += chunkCounts[bucket];
+      }
+      if(n < bucketCount)
+      {
+        break;
+      }
+      n -= bucketCount;
+      numLess += bucketCount;
+    }
+    prefix |= static_cast<KeyType>(bucket) << shift;
+    prefixMask |= static_cast<KeyType>(k_RadixBuckets - 1) << shift;
+  }
+  return fromOrderedKey<T>(prefix);
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+float findMedian(nonstd::span<const T> values)
+{
+  if(values.empty())
+  {
+    return 0.0f;
+  }
+  size_t numLess = 0;
+  const size_t highIndex = values.size() / 2;
+  const T high = selectNth(values, highIndex, numLess);
+  if(values.size() % 2 == 1)
+  {
+    return static_cast<float>(high);
+  }
+
+  // The lower middle value equals the upper one unless every value before it is smaller
+  T low = high;
+  if(numLess == highIndex)
+  {
+    using KeyType = decltype(toOrderedKey(T{}));
+    const size_t chunkSize = reductionChunkSize(values.size());
+    std::vector<KeyType> maxKeys((values.size() + chunkSize - 1) / chunkSize, 0);
+    complex::ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, maxKeys.size());
+    dataAlg.execute(MaxBelowImpl<T, KeyType>(values, chunkSize, toOrderedKey(high), maxKeys));
+    low = fromOrderedKey<T>(*std::max_element(maxKeys.cbegin(), maxKeys.cend()));
+  }
+  return (low + high) * 0.5f;
+}
+
+/**
+ * @brief Bins the values of one chunk per index of the range into the chunk's own
+ * row of bins.
+ */
+template <typename T>
+class HistogramImpl
+{
+public:
+  HistogramImpl(nonstd::span<const T> values, size_t chunkSize, float min, float max, float increment, size_t numBins, std::vector<size_t>& bins)
+  : m_Values(values)
+  , m_ChunkSize(chunkSize)
+  , m_Min(min)
+  , m_Max(max)
+  , m_Increment(increment)
+  , m_NumBins(numBins)
+  , m_Bins(bins)
+  {
+  }
+
+  void operator()(const complex::Range& range) const
+  {
+    for(size_t chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      size_t* bins = m_Bins.data() + chunk * m_NumBins;
+      const size_t start = chunk * m_ChunkSize;
+      const size_t end = std::min(start + m_ChunkSize, m_Values.size());
+      for(size_t i = start; i < end; i++)
+      {
+        const float value = static_cast<float>(m_Values[i]);
+        const auto bin = static_cast<size_t>((value - m_Min) / m_Increment);
+        if(bin < m_NumBins)
+        {
+          bins[bin]++;
+        }
+        else if(value == m_Max)
+        {
+          bins[m_NumBins - 1]++;
+        }
+      }
+    }
+  }
+
+private:
+  nonstd::span<const T> m_Values;
+  size_t m_ChunkSize;
+  float m_Min;
+  float m_Max;
+  float m_Increment;
+  size_t m_NumBins;
+  std::vector<size_t>& m_Bins;
+};
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::vector<float> findHistogram(nonstd::span<const T> values, float histmin, float histmax, bool histfullrange, int32_t numBins)
+{
+  if(values.empty())
+  {
+    return std::vector<float>(numBins, 0);
+  }
+
+  float min = histmin;
+  float max = histmax;
+  if(histfullrange)
+  {
+    const SpanSummary<T> summary = summarize(values);
+    min = static_cast<float>(summary.Min);
+    max = static_cast<float>(summary.Max);
+  }
+
+  float increment = (max - min) / (numBins);
+  if(std::abs(increment) < 1E-10)
+  {
+    numBins = 1;
+  }
+
+  std::vector<float> histogram(numBins, 0);
+  if(numBins == 1) // if one bin, just set the first element to total number of points
+  {
+    histogram[0] = static_cast<float>(values.size());
+    return histogram;
+  }
+
+  // Every chunk counts into its own row of bins, which are added up afterwards
+  const size_t chunkSize = reductionChunkSize(values.size());
+  const size_t numChunks = (values.size() + chunkSize - 1) / chunkSize;
+  std::vector<size_t> bins(numChunks * numBins, 0);
+  complex::ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numChunks);
+  dataAlg.execute(HistogramImpl<T>(values, chunkSize, min, max, increment, static_cast<size_t>(numBins), bins));
+
+  for(int32_t bin = 0; bin < numBins; bin++)
+  {
+    size_t count = 0;
+    for(size_t chunk = 0; chunk < numChunks; chunk++)
+    {
+      count += bins[chunk * numBins + bin];
+    }
+    histogram[bin] = static_cast<float>(count);
+  }
+  return histogram;
+}
 } // namespace StaticicsCalculations
@@ -0,0 +1,187 @@
+#include "MemoryMappedFile.hpp"
+
+#include <fmt/core.h>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <utility>
+
+using namespace complex;
+
+namespace
+{
+constexpr int32 k_FileDoesNotExist = -7200;
+constexpr int32 k_FileNotOpened = -7201;
+constexpr int32 k_FileNotMapped = -7202;
+} // namespace
+
+namespace complex
+{
+// -----------------------------------------------------------------------------
+Result<MemoryMappedFile> MemoryMappedFile::Open(const std::filesystem::path& path)
+{
+  std::error_code errorCode;
+  if(!std::filesystem::is_regular_file(path, errorCode))
+  {
+    return MakeErrorResult<MemoryMappedFile>(k_FileDoesNotExist, fmt::format("File does not exist: '{}'", path.string()));
+  }
+
+  MemoryMappedFile file;
+#if defined(_WIN32)
+  HANDLE fileHandle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if(fileHandle == INVALID_HANDLE_VALUE)
+  {
+    return MakeErrorResult<MemoryMappedFile>(k_FileNotOpened, fmt::format("Could not open file for reading: '{}'", path.string()));
+  }
+  file.m_FileHandle = fileHandle;
+
+  LARGE_INTEGER fileSize;
+  if(GetFileSizeEx(fileHandle, &fileSize) == 0)
+  {
+    return MakeErrorResult<MemoryMappedFile>(k_FileNotOpened, fmt::format("Could not read the size of file: '{}'", path.string()));
+  }
+  file.m_Size = static_cast<usize>(fileSize.QuadPart);
+  if(file.m_Size == 0)
+  {
+    return {std::move(file)};
+  }
+
+  HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if(mappingHandle == nullptr)
+  {
+    return MakeErrorResult<MemoryMappedFile>(k_FileNotMapped, fmt::format("Could not map file into memory: '{}'", path.string()));
+  }
+  file.m_MappingHandle = mappingHandle;
+
+  void* data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+  if(data == nullptr)
+  {
+    return MakeErrorResult<MemoryMappedFile>(k_FileNotMapped, fmt::format("Could not map file into memory: '{}'", path.string()));
+  }
+  file.m_Data = static_cast<const uint8*>(data);
+#else
+  int fileDescriptor = open(path.c_str(), O_RDONLY);
+  if(fileDescriptor < 0)
+  {
+    return MakeErrorResult<MemoryMappedFile>(k_FileNotOpened, fmt::format("Could not open file for reading: '{}'", path.string()));
+  }
+
+  struct stat fileStatus = {};
+  if(fstat(fileDescriptor, &fileStatus) != 0)
+  {
+    close(fileDescriptor);
+    return MakeErrorResult<MemoryMappedFile>(k_FileNotOpened, fmt::format("Could not read the size of file: '{}'", path.string()));
+  }
+  file.m_Size = static_cast<usize>(fileStatus.st_size);
+  if(file.m_Size == 0)
+  {
+    close(fileDescriptor);
+    return {std::move(file)};
+  }
+
+  void* data = mmap(nullptr, file.m_Size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+  // The mapping keeps its own reference to the file
+  close(fileDescriptor);
+  if(data == MAP_FAILED)
+  {
+    file.m_Size = 0;
+    return MakeErrorResult<MemoryMappedFile>(k_FileNotMapped, fmt::format("Could not map file into memory: '{}'", path.string()));
+  }
+  file.m_Data = static_cast<const uint8*>(data);
+  // Files are mostly read front to back, so let the kernel read ahead
+  madvise(data, file.m_Size, MADV_SEQUENTIAL);
+#endif
+
+  return {std::move(file)};
+}
+
+// -----------------------------------------------------------------------------
+MemoryMappedFile::~MemoryMappedFile() noexcept
+{
+  unmap();
+}
+
+// -----------------------------------------------------------------------------
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept
+: m_Data(std::exchange(other.m_Data, nullptr))
+, m_Size(std::exchange(other.m_Size, 0))
+#if defined(_WIN32)
+, m_FileHandle(std::exchange(other.m_FileHandle, nullptr))
+, m_MappingHandle(std::exchange(other.m_MappingHandle, nullptr))
+#endif
+{
+}
+
+// -----------------------------------------------------------------------------
+MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other) noexcept
+{
+  if(this != &other)
+  {
+    unmap();
+    m_Data = std::exchange(other.m_Data, nullptr);
+    m_Size = std::exchange(other.m_Size, 0);
+#if defined(_WIN32)
+    m_FileHandle = std::exchange(other.m_FileHandle, nullptr);
+    m_MappingHandle = std::exchange(other.m_MappingHandle, nullptr);
+#endif
+  }
+  return *this;
+}
+
+// -----------------------------------------------------------------------------
+usize MemoryMappedFile::size() const
+{
+  return m_Size;
+}
+
+// -----------------------------------------------------------------------------
+nonstd::span<const uint8> MemoryMappedFile::bytes() const
+{
+  return {m_Data, m_Data == nullptr ? 0 : m_Size};
+}
+
+// -----------------------------------------------------------------------------
+std::string_view MemoryMappedFile::text() const
+{
+  if(m_Data == nullptr)
+  {
+    return {};
+  }
+  return {reinterpret_cast<const char*>(m_Data), m_Size};
+}
+
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::unmap() noexcept
+{
+#if defined(_WIN32)
+  if(m_Data != nullptr)
+  {
+    UnmapViewOfFile(m_Data);
+  }
+  if(m_MappingHandle != nullptr)
+  {
+    CloseHandle(m_MappingHandle);
+  }
+  if(m_FileHandle != nullptr)
+  {
+    CloseHandle(m_FileHandle);
+  }
+  m_FileHandle = nullptr;
+  m_MappingHandle = nullptr;
+#else
+  if(m_Data != nullptr)
+  {
+    munmap(const_cast<uint8*>(m_Data), m_Size);
+  }
+#endif
+  m_Data = nullptr;
+  m_Size = 0;
+}
+} // namespace complex
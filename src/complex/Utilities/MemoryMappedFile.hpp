@@ -0,0 +1,66 @@
+#pragma once
+
+#include "complex/Common/Result.hpp"
+#include "complex/Common/Types.hpp"
+#include "complex/complex_export.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <filesystem>
+#include <string_view>
+
+namespace complex
+{
+/**
+ * @brief Read only view of the whole contents of a file. The file is memory mapped
+ * so that its pages are only read from disk when they are first touched and can be
+ * read from several threads without copying.
+ */
+class COMPLEX_EXPORT MemoryMappedFile
+{
+public:
+  /**
+   * @brief Maps the file into memory. Empty files produce an empty view.
+   * @param path
+   * @return Result<MemoryMappedFile>
+   */
+  static Result<MemoryMappedFile> Open(const std::filesystem::path& path);
+
+  ~MemoryMappedFile() noexcept;
+
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile(MemoryMappedFile&& other) noexcept;
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept;
+
+  /**
+   * @brief Returns the number of bytes in the file.
+   * @return usize
+   */
+  usize size() const;
+
+  /**
+   * @brief Returns the contents of the file as bytes.
+   * @return nonstd::span<const uint8>
+   */
+  nonstd::span<const uint8> bytes() const;
+
+  /**
+   * @brief Returns the contents of the file as text.
+   * @return std::string_view
+   */
+  std::string_view text() const;
+
+private:
+  MemoryMappedFile() = default;
+
+  void unmap() noexcept;
+
+  const uint8* m_Data = nullptr;
+  usize m_Size = 0;
+#if defined(_WIN32)
+  void* m_FileHandle = nullptr;
+  void* m_MappingHandle = nullptr;
+#endif
+};
+} // namespace complex
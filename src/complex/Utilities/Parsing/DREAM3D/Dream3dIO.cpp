@@ -16,6 +16,7 @@
 #include "complex/DataStructure/Geometry/TetrahedralGeom.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/DataStructure/Geometry/VertexGeom.hpp"
+#include "complex/DataStructure/H5ProxyDataStore.hpp"
 #include "complex/DataStructure/NeighborList.hpp"
 #include "complex/DataStructure/StringArray.hpp"
 #include "complex/Pipeline/Pipeline.hpp"
@@ -739,11 +740,16 @@ complex::DREAM3D::PipelineVersionType complex::DREAM3D::GetPipelineVersion(const
   return pipelineVersionAttribute.readAsValue<PipelineVersionType>();
 }
 
-Result<DataStructure> ImportDataStructureV8(const H5::FileReader& fileReader, bool preflight)
+Result<DataStructure> ImportDataStructureV8(const H5::FileReader& fileReader, bool preflight, bool lazy)
 {
   H5::ErrorType errorCode = 0;
   H5::DataStructureReader dataStructureReader;
+  dataStructureReader.setLazyLoading(lazy);
   auto dataStructure = dataStructureReader.readH5Group(fileReader, errorCode, preflight);
+  if(!dataStructureReader.getReadErrors().empty())
+  {
+    return {nonstd::make_unexpected(dataStructureReader.getReadErrors())};
+  }
   if(errorCode < 0)
   {
     return MakeErrorResult<DataStructure>(errorCode, fmt::format("Failed to import DataStructure"));
@@ -765,7 +771,7 @@ Result<DataStructure> ImportDataStructureV8(const H5::FileReader& fileReader, bo
  */
 template <typename T>
 IDataArray* createLegacyDataArray(DataStructure& ds, DataObject::IdType parentId, const H5::DatasetReader& dataArrayReader, const std::vector<usize>& tDims, const std::vector<usize>& cDims,
-                                  bool preflight = false)
+                                  bool preflight = false, bool lazy = false)
 {
   using DataArrayType = DataArray<T>;
   using EmptyDataStoreType = EmptyDataStore<T>;
@@ -777,6 +783,11 @@ IDataArray* createLegacyDataArray(DataStructure& ds, DataObject::IdType parentId
   {
     return DataArrayType::template CreateWithStore<EmptyDataStoreType>(ds, daName, tDims, cDims, parentId);
   }
+  if(lazy)
+  {
+    auto proxyStore = std::make_unique<H5ProxyDataStore<T>>(H5ProxyDataStore<T>::GetFilePath(dataArrayReader), "/" + complex::H5::Support::GetObjectPath(dataArrayReader.getId()), tDims, cDims);
+    return DataArray<T>::Create(ds, daName, std::move(proxyStore), parentId);
+  }
   auto dataStore = std::make_unique<DataStore<T>>(tDims, cDims, static_cast<T>(0));
 
   if(!dataArrayReader.readIntoSpan(dataStore->createSpan()))
@@ -833,7 +844,7 @@ void readLegacyStringArray(DataStructure& ds, const H5::DatasetReader& dataArray
   }
 }
 
-IDataArray* readLegacyDataArray(DataStructure& ds, const H5::DatasetReader& dataArrayReader, DataObject::IdType parentId, bool preflight = false)
+IDataArray* readLegacyDataArray(DataStructure& ds, const H5::DatasetReader& dataArrayReader, DataObject::IdType parentId, bool preflight = false, bool lazy = false)
 {
   auto size = H5Dget_storage_size(dataArrayReader.getId());
   auto typeId = dataArrayReader.getTypeId();
@@ -846,51 +857,51 @@ IDataArray* readLegacyDataArray(DataStructure& ds, const H5::DatasetReader& data
 
   if(H5Tequal(typeId, H5T_NATIVE_FLOAT) > 0)
   {
-    dataArray = createLegacyDataArray<float32>(ds, parentId, dataArrayReader, tDims, cDims, preflight);
+    dataArray = createLegacyDataArray<float32>(ds, parentId, dataArrayReader, tDims, cDims, preflight, lazy);
   }
   else if(H5Tequal(typeId, H5T_NATIVE_DOUBLE) > 0)
   {
-    dataArray = createLegacyDataArray<float64>(ds, parentId, dataArrayReader, tDims, cDims, preflight);
+    dataArray = createLegacyDataArray<float64>(ds, parentId, dataArrayReader, tDims, cDims, preflight, lazy);
   }
   else if(H5Tequal(typeId, H5T_NATIVE_INT8) > 0)
   {
-    dataArray = createLegacyDataArray<int8>(ds, parentId, dataArrayReader, tDims, cDims, preflight);
+    dataArray = createLegacyDataArray<int8>(ds, parentId, dataArrayReader, tDims, cDims, preflight, lazy);
   }
   else if(H5Tequal(typeId, H5T_NATIVE_INT16) > 0)
   {
-    dataArray = createLegacyDataArray<int16>(ds, parentId, dataArrayReader, tDims, cDims, preflight);
+    dataArray = createLegacyDataArray<int16>(ds, parentId, dataArrayReader, tDims, cDims, preflight, lazy);
   }
   else if(H5Tequal(typeId, H5T_NATIVE_INT32) > 0)
   {
-    dataArray = createLegacyDataArray<int32>(ds, parentId, dataArrayReader, tDims, cDims, preflight);
+    dataArray = createLegacyDataArray<int32>(ds, parentId, dataArrayReader, tDims, cDims, preflight, lazy);
   }
   else if(H5Tequal(typeId, H5T_NATIVE_INT64) > 0)
   {
-    dataArray = createLegacyDataArray<int64>(ds, parentId, dataArrayReader, tDims, cDims, preflight);
+    dataArray = createLegacyDataArray<int64>(ds, parentId, dataArrayReader, tDims, cDims, preflight, lazy);
   }
   else if(H5Tequal(typeId, H5T_NATIVE_UINT8) > 0)
   {
     const auto typeAttrib = dataArrayReader.getAttribute(complex::Constants::k_ObjectTypeTag);
     if(typeAttrib.isValid() && typeAttrib.readAsString() == "DataArray<bool>")
     {
-      dataArray = createLegacyDataArray<bool>(ds, parentId, dataArrayReader, tDims, cDims, preflight);
+      dataArray = createLegacyDataArray<bool>(ds, parentId, dataArrayReader, tDims, cDims, preflight, lazy);
     }
     else
     {
-      dataArray = createLegacyDataArray<uint8>(ds, parentId, dataArrayReader, tDims, cDims, preflight);
+      dataArray = createLegacyDataArray<uint8>(ds, parentId, dataArrayReader, tDims, cDims, preflight, lazy);
     }
   }
   else if(H5Tequal(typeId, H5T_NATIVE_UINT16) > 0)
   {
-    dataArray = createLegacyDataArray<uint16>(ds, parentId, dataArrayReader, tDims, cDims, preflight);
+    dataArray = createLegacyDataArray<uint16>(ds, parentId, dataArrayReader, tDims, cDims, preflight, lazy);
   }
   else if(H5Tequal(typeId, H5T_NATIVE_UINT32) > 0)
   {
-    dataArray = createLegacyDataArray<uint32>(ds, parentId, dataArrayReader, tDims, cDims, preflight);
+    dataArray = createLegacyDataArray<uint32>(ds, parentId, dataArrayReader, tDims, cDims, preflight, lazy);
   }
   else if(H5Tequal(typeId, H5T_NATIVE_UINT64) > 0)
   {
-    dataArray = createLegacyDataArray<uint64>(ds, parentId, dataArrayReader, tDims, cDims, preflight);
+    dataArray = createLegacyDataArray<uint64>(ds, parentId, dataArrayReader, tDims, cDims, preflight, lazy);
   }
 
   H5Tclose(typeId);
@@ -902,12 +913,14 @@ template <typename T>
 void createLegacyNeighborList(DataStructure& ds, DataObject ::IdType parentId, const H5::GroupReader& parentReader, const H5::DatasetReader& datasetReader, const std::vector<usize>& tupleDims)
 {
   auto numTuples = std::accumulate(tupleDims.cbegin(), tupleDims.cend(), static_cast<usize>(1), std::multiplies<>());
-  auto data = NeighborList<T>::ReadHdf5Data(parentReader, datasetReader);
+  auto [offsets, values] = NeighborList<T>::ReadHdf5CompactData(parentReader, datasetReader);
   auto* neighborList = NeighborList<T>::Create(ds, datasetReader.getName(), numTuples, parentId);
-  for(usize i = 0; i < data.size(); ++i)
+  // Tuples without a stored list are empty
+  if(offsets.size() < numTuples + 1)
   {
-    neighborList->setList(i, data[i]);
+    offsets.resize(numTuples + 1, offsets.back());
   }
+  neighborList->setLists(std::move(offsets), std::move(values));
 }
 
 void readLegacyNeighborList(DataStructure& ds, const H5::GroupReader& parentReader, const H5::DatasetReader& datasetReader, DataObject::IdType parentId)
@@ -980,7 +993,7 @@ bool isLegacyStringArray(const H5::DatasetReader& arrayReader)
   return objectType == "StringDataArray";
 }
 
-void readLegacyAttributeMatrix(DataStructure& ds, const H5::GroupReader& amGroupReader, DataObject& parent, bool preflight = false)
+void readLegacyAttributeMatrix(DataStructure& ds, const H5::GroupReader& amGroupReader, DataObject& parent, bool preflight = false, bool lazy = false)
 {
   DataObject::IdType parentId = parent.getId();
   const std::string amName = amGroupReader.getName();
@@ -1007,7 +1020,7 @@ void readLegacyAttributeMatrix(DataStructure& ds, const H5::GroupReader& amGroup
     }
     else
     {
-      readLegacyDataArray(ds, dataArraySet, attributeMatrix->getId(), preflight);
+      readLegacyDataArray(ds, dataArraySet, attributeMatrix->getId(), preflight, lazy);
     }
   }
 
@@ -1206,7 +1219,7 @@ DataObject* readLegacyImageGeom(DataStructure& ds, const H5::GroupReader& geomGr
 }
 // End legacy Geometry importing
 
-void readLegacyDataContainer(DataStructure& ds, const H5::GroupReader& dcGroup, bool preflight = false)
+void readLegacyDataContainer(DataStructure& ds, const H5::GroupReader& dcGroup, bool preflight = false, bool lazy = false)
 {
   DataObject* container = nullptr;
   const std::string dcName = dcGroup.getName();
@@ -1266,11 +1279,11 @@ void readLegacyDataContainer(DataStructure& ds, const H5::GroupReader& dcGroup,
     }
 
     auto attributeMatrixGroup = dcGroup.openGroup(amName);
-    readLegacyAttributeMatrix(ds, attributeMatrixGroup, *container, preflight);
+    readLegacyAttributeMatrix(ds, attributeMatrixGroup, *container, preflight, lazy);
   }
 }
 
-Result<DataStructure> ImportLegacyDataStructure(const H5::FileReader& fileReader, bool preflight)
+Result<DataStructure> ImportLegacyDataStructure(const H5::FileReader& fileReader, bool preflight, bool lazy)
 {
   DataStructure ds;
 
@@ -1281,22 +1294,23 @@ Result<DataStructure> ImportLegacyDataStructure(const H5::FileReader& fileReader
   for(const auto& dcName : dcNames)
   {
     auto dcGroup = dcaGroup.openGroup(dcName);
-    readLegacyDataContainer(ds, dcGroup, preflight);
+    readLegacyDataContainer(ds, dcGroup, preflight, lazy);
   }
 
   return {std::move(ds)};
 }
 
-Result<complex::DataStructure> complex::DREAM3D::ImportDataStructureFromFile(const H5::FileReader& fileReader, bool preflight)
+Result<complex::DataStructure> complex::DREAM3D::ImportDataStructureFromFile(const H5::FileReader& fileReader, bool preflight, bool lazy)
 {
+  std::lock_guard<std::recursive_mutex> libraryLock(H5::GetLibraryMutex());
   const auto fileVersion = GetFileVersion(fileReader);
   if(fileVersion == k_CurrentFileVersion)
   {
-    return ImportDataStructureV8(fileReader, preflight);
+    return ImportDataStructureV8(fileReader, preflight, lazy);
   }
   else if(fileVersion == Legacy::FileVersion)
   {
-    return ImportLegacyDataStructure(fileReader, preflight);
+    return ImportLegacyDataStructure(fileReader, preflight, lazy);
   }
   // Unsupported file version
   return MakeErrorResult<DataStructure>(k_InvalidDataStructureVersion,
@@ -1305,6 +1319,8 @@ Result<complex::DataStructure> complex::DREAM3D::ImportDataStructureFromFile(con
 
 Result<complex::DataStructure> complex::DREAM3D::ImportDataStructureFromFile(const std::filesystem::path& filePath)
 {
+  // The file is opened and closed under the same lock as the import
+  std::lock_guard<std::recursive_mutex> libraryLock(H5::GetLibraryMutex());
   H5::FileReader fileReader(filePath);
   if(!fileReader.isValid())
   {
@@ -1369,6 +1385,7 @@ Result<complex::DREAM3D::FileData> complex::DREAM3D::ReadFile(const H5::FileRead
 
 Result<complex::DREAM3D::FileData> complex::DREAM3D::ReadFile(const std::filesystem::path& path)
 {
+  std::lock_guard<std::recursive_mutex> libraryLock(H5::GetLibraryMutex());
   H5::FileReader reader(path);
   H5::ErrorType error = 0;
 
@@ -1440,7 +1457,8 @@ H5::ErrorType complex::DREAM3D::WriteFile(H5::FileWriter& fileWriter, const Pipe
   return errorCode;
 }
 
-Result<> complex::DREAM3D::WriteFile(const std::filesystem::path& path, const DataStructure& dataStructure, const Pipeline& pipeline, bool writeXdmf)
+Result<> complex::DREAM3D::WriteFile(const std::filesystem::path& path, const DataStructure& dataStructure, const Pipeline& pipeline, bool writeXdmf,
+                                     const H5::DatasetCreationOptions& datasetOptions)
 {
   Result<H5::FileWriter> fileWriterResult = H5::FileWriter::CreateFile(path);
   if(fileWriterResult.invalid())
@@ -1449,6 +1467,7 @@ Result<> complex::DREAM3D::WriteFile(const std::filesystem::path& path, const Da
   }
 
   H5::FileWriter fileWriter = std::move(fileWriterResult.value());
+  fileWriter.setDatasetCreationOptions(datasetOptions);
 
   H5::ErrorType error = WriteFile(fileWriter, Pipeline(), dataStructure);
   if(error < 0)
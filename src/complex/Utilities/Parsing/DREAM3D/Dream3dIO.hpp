@@ -83,23 +83,29 @@ COMPLEX_EXPORT H5::ErrorType WriteFile(H5::FileWriter& fileWriter, const FileDat
 COMPLEX_EXPORT H5::ErrorType WriteFile(H5::FileWriter& fileWriter, const Pipeline& pipeline, const DataStructure& dataStructure);
 
 /**
- * @brief Writes a .dream3d file with the specified data.
+ * @brief Writes a .dream3d file with the specified data. The dataset options
+ * select the chunk layout and compression filters of the written arrays.
  * @param path
  * @param dataStructure
  * @param writeXdmf
+ * @param datasetOptions = {}
  * @return bool
  */
-COMPLEX_EXPORT Result<> WriteFile(const std::filesystem::path& path, const DataStructure& dataStructure, const Pipeline& pipeline = {}, bool writeXdmf = false);
+COMPLEX_EXPORT Result<> WriteFile(const std::filesystem::path& path, const DataStructure& dataStructure, const Pipeline& pipeline = {}, bool writeXdmf = false,
+                                  const H5::DatasetCreationOptions& datasetOptions = {});
 
 /**
  * @brief Imports and returns the DataStructure from the target .dream3d file.
  *
- * This method imports both current and legacy DataStructures.
+ * This method imports both current and legacy DataStructures. When lazy is
+ * true, DataArrays are imported as proxies that read their values from the
+ * file the first time they are accessed.
  * @param fileReader
  * @param preflight = false
+ * @param lazy = false
  * @return complex::DataStructure
  */
-COMPLEX_EXPORT Result<complex::DataStructure> ImportDataStructureFromFile(const H5::FileReader& fileReader, bool preflight = false);
+COMPLEX_EXPORT Result<complex::DataStructure> ImportDataStructureFromFile(const H5::FileReader& fileReader, bool preflight = false, bool lazy = false);
 
 /**
  * @brief Imports and returns the DataStructure from the target .dream3d file.
@@ -4,8 +4,10 @@
 #include "complex/Common/Types.hpp"
 
 #include <cstdint>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "complex/complex_export.hpp"
 
@@ -80,6 +82,40 @@ std::string COMPLEX_EXPORT GetNameFromId(IdType id);
  */
 std::string COMPLEX_EXPORT GetParentPath(const std::string& objectPath);
 
+/**
+ * @brief Returns the process-wide mutex that serializes HDF5 reads. The HDF5
+ * library is not built thread-safe, so reads that may run while another thread
+ * uses HDF5, such as lazily loaded arrays and DataStructure imports, must hold
+ * this mutex.
+ * @return std::recursive_mutex&
+ */
+std::recursive_mutex& COMPLEX_EXPORT GetLibraryMutex();
+
+/**
+ * @brief DatasetCreationOptions describes how new numeric datasets are laid
+ * out and filtered in the HDF5 file. Any of the filters requires a chunked
+ * layout, so enabling one without an explicit chunk shape chunks the dataset
+ * automatically along its slowest dimensions. The default options write
+ * contiguous, uncompressed datasets.
+ */
+struct COMPLEX_EXPORT DatasetCreationOptions
+{
+  std::vector<SizeType> chunkDims;      // Explicit chunk shape. Must match the dataset rank to be used.
+  usize targetChunkBytes = 1024 * 1024; // Chunk size used when the chunk shape is chosen automatically
+  int32 deflateLevel = 0;               // 0 disables deflate, 1-9 selects the gzip level
+  bool shuffle = false;                 // Byte shuffle before deflate
+  bool scaleOffset = false;             // Lossless scale-offset filter. Only applied to integer datasets.
+
+  /**
+   * @brief Returns true if the options require a chunked dataset layout.
+   * @return bool
+   */
+  bool isChunked() const
+  {
+    return !chunkDims.empty() || deflateLevel > 0 || shuffle || scaleOffset;
+  }
+};
+
 inline constexpr StringLiteral k_DataTypeTag = "DataType";
 
 inline constexpr StringLiteral k_DataStoreTag = "DataStore";
@@ -16,6 +16,8 @@ H5::DataStructureReader::~DataStructureReader() = default;
 
 complex::DataStructure H5::DataStructureReader::readH5Group(const H5::GroupReader& groupReader, H5::ErrorType& errorCode, bool preflight)
 {
+  // Lazily imported arrays may be loaded by other threads while this reads
+  std::lock_guard<std::recursive_mutex> libraryLock(H5::GetLibraryMutex());
   clearDataStructure();
 
   auto rootGroupReader = groupReader.openGroup(Constants::k_DataStructureTag);
@@ -35,6 +37,17 @@ complex::DataStructure H5::DataStructureReader::readH5Group(const H5::GroupReade
   m_CurrentStructure = DataStructure();
   m_CurrentStructure.setNextId(idAttribute.readAsValue<DataObject::IdType>());
   errorCode = m_CurrentStructure.getRootGroup().readH5Group(*this, rootGroupReader, {}, preflight);
+
+  // Read the values of every imported DataArray
+  Result<> readResult = m_ReadScheduler.run();
+  if(readResult.invalid())
+  {
+    m_ReadErrors = std::move(readResult.errors());
+    if(errorCode >= 0)
+    {
+      errorCode = m_ReadErrors.front().code;
+    }
+  }
   return std::move(m_CurrentStructure);
 }
 
@@ -117,6 +130,27 @@ DataStructure& H5::DataStructureReader::getDataStructure()
 void H5::DataStructureReader::clearDataStructure()
 {
   m_CurrentStructure = DataStructure();
+  m_ReadErrors.clear();
+}
+
+bool H5::DataStructureReader::isLazyLoading() const
+{
+  return m_LazyLoading;
+}
+
+void H5::DataStructureReader::setLazyLoading(bool lazyLoading)
+{
+  m_LazyLoading = lazyLoading;
+}
+
+H5::DatasetReadScheduler& H5::DataStructureReader::getReadScheduler()
+{
+  return m_ReadScheduler;
+}
+
+const ErrorCollection& H5::DataStructureReader::getReadErrors() const
+{
+  return m_ReadErrors;
 }
 
 H5::DataFactoryManager* H5::DataStructureReader::getDataReader() const
@@ -5,6 +5,7 @@
 #include "complex/DataStructure/DataObject.hpp"
 #include "complex/DataStructure/DataStructure.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5DataFactoryManager.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DatasetReadScheduler.hpp"
 
 namespace complex
 {
@@ -71,6 +72,35 @@ public:
    */
   void clearDataStructure();
 
+  /**
+   * @brief Returns true if DataArrays are imported as proxies that read their
+   * values from file on first access instead of during import.
+   * @return bool
+   */
+  bool isLazyLoading() const;
+
+  /**
+   * @brief Sets whether DataArrays are imported as proxies that read their
+   * values from file on first access. The HDF5 file must remain unchanged
+   * until the values are read. Ignored when preflighting.
+   * @param lazyLoading
+   */
+  void setLazyLoading(bool lazyLoading);
+
+  /**
+   * @brief Returns the scheduler that DataArray values are read through. Reads
+   * scheduled while walking the file are performed before readH5Group returns.
+   * @return H5::DatasetReadScheduler&
+   */
+  H5::DatasetReadScheduler& getReadScheduler();
+
+  /**
+   * @brief Returns the errors of the dataset reads performed by the last call
+   * to readH5Group. Each error names the dataset that could not be read.
+   * @return const ErrorCollection&
+   */
+  const ErrorCollection& getReadErrors() const;
+
 protected:
   /**
    * @brief Returns a pointer to the H5::DataFactoryManager used for finding the
@@ -90,6 +120,9 @@ protected:
 private:
   H5::DataFactoryManager* m_FactoryManager = nullptr;
   DataStructure m_CurrentStructure;
+  bool m_LazyLoading = false;
+  H5::DatasetReadScheduler m_ReadScheduler;
+  ErrorCollection m_ReadErrors;
 };
 } // namespace H5
 } // namespace complex
@@ -0,0 +1,565 @@
+#include "H5DatasetReadScheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <thread>
+
+#ifdef COMPLEX_ENABLE_MULTICORE
+#include <tbb/concurrent_queue.h>
+#include <tbb/task_group.h>
+#endif
+
+#include <zlib.h>
+
+#include "complex/Utilities/Parsing/HDF5/H5DatasetReader.hpp"
+
+#include <fmt/core.h>
+
+using namespace complex;
+
+namespace
+{
+constexpr H5::ErrorType k_OpenDatasetError = -1;
+constexpr H5::ErrorType k_ReadDatasetError = -2;
+constexpr H5::ErrorType k_ReadChunkError = -3;
+constexpr H5::ErrorType k_DecodeChunkError = -4;
+
+constexpr uint64 k_UnknownOffset = std::numeric_limits<uint64>::max();
+
+/**
+ * @brief Describes how the raw chunks of a dataset are decoded and where
+ * their values are copied to.
+ */
+struct ChunkLayout
+{
+  std::vector<hsize_t> datasetDims;
+  std::vector<hsize_t> chunkDims;
+  std::vector<H5Z_filter_t> filters;
+  usize typeSize = 0;
+  usize chunkBytes = 0;
+  bool swapBytes = false;
+  uint8* target = nullptr;
+};
+
+/**
+ * @brief Limits the bytes of undecoded chunks in memory and runs the decode
+ * tasks on the thread pool.
+ */
+class DecodeQueue
+{
+public:
+  static inline constexpr usize k_NoFailure = std::numeric_limits<usize>::max();
+
+  DecodeQueue(usize maxBufferedBytes, bool doParallel)
+  : m_MaxBufferedBytes(maxBufferedBytes)
+  , m_Parallelization(doParallel)
+  {
+  }
+
+  ~DecodeQueue()
+  {
+    wait();
+  }
+
+  /**
+   * @brief Decodes a chunk of the given request. Returns as soon as the undecoded
+   * bytes fit into the budget, so that the next chunk can be read while the
+   * queued chunks are being decoded.
+   * @param requestIndex
+   * @param numBytes
+   * @param body
+   */
+  template <typename Body>
+  void execute(usize requestIndex, usize numBytes, Body&& body)
+  {
+#ifdef COMPLEX_ENABLE_MULTICORE
+    if(m_Parallelization)
+    {
+      // While the budget is used up the reading thread decodes queued chunks itself.
+      // Blocking instead would deadlock when no worker is free.
+      while(m_BufferedBytes > 0 && m_BufferedBytes + numBytes > m_MaxBufferedBytes)
+      {
+        if(!runPendingTask())
+        {
+          std::this_thread::yield();
+        }
+      }
+      m_BufferedBytes += numBytes;
+      m_PendingTasks.push([this, requestIndex, numBytes, body = std::forward<Body>(body)]() {
+        if(!body())
+        {
+          setFailed(requestIndex);
+        }
+        m_BufferedBytes -= numBytes;
+      });
+      m_TaskGroup.run([this]() { runPendingTask(); });
+      return;
+    }
+#endif
+    if(!body())
+    {
+      setFailed(requestIndex);
+    }
+  }
+
+  void wait()
+  {
+#ifdef COMPLEX_ENABLE_MULTICORE
+    m_TaskGroup.wait();
+#endif
+  }
+
+  /**
+   * @brief Returns the index of the first request that failed to decode, or
+   * k_NoFailure.
+   * @return usize
+   */
+  usize failedRequest() const
+  {
+    return m_FailedRequest;
+  }
+
+private:
+  void setFailed(usize requestIndex)
+  {
+    usize failedRequest = m_FailedRequest;
+    while(requestIndex < failedRequest && !m_FailedRequest.compare_exchange_weak(failedRequest, requestIndex))
+    {
+    }
+  }
+
+#ifdef COMPLEX_ENABLE_MULTICORE
+  /**
+   * @brief Runs one queued decode task on the calling thread. Every queued task
+   * is run once, either here or by the pool task scheduled with it.
+   * @return bool False if no task was waiting
+   */
+  bool runPendingTask()
+  {
+    std::function<void()> task;
+    if(!m_PendingTasks.try_pop(task))
+    {
+      return false;
+    }
+    task();
+    return true;
+  }
+#endif
+
+  usize m_MaxBufferedBytes = 0;
+  bool m_Parallelization = false;
+  std::atomic<usize> m_FailedRequest{k_NoFailure};
+#ifdef COMPLEX_ENABLE_MULTICORE
+  std::atomic<usize> m_BufferedBytes{0};
+  tbb::concurrent_queue<std::function<void()>> m_PendingTasks;
+  tbb::task_group m_TaskGroup;
+#endif
+};
+
+bool Inflate(const std::vector<uint8>& input, std::vector<uint8>& output, usize expectedBytes)
+{
+  output.resize(expectedBytes);
+  uLongf outputSize = static_cast<uLongf>(expectedBytes);
+  const int status = uncompress(output.data(), &outputSize, input.data(), static_cast<uLong>(input.size()));
+  if(status != Z_OK)
+  {
+    return false;
+  }
+  output.resize(outputSize);
+  return true;
+}
+
+/**
+ * @brief Reverses the HDF5 shuffle filter, which stores the first byte of
+ * every value, then the second byte of every value, and so on. Trailing bytes
+ * that do not form a whole value are stored unshuffled.
+ */
+void Unshuffle(const std::vector<uint8>& input, std::vector<uint8>& output, usize typeSize)
+{
+  output.resize(input.size());
+  const usize numValues = input.size() / typeSize;
+  for(usize byte = 0; byte < typeSize; byte++)
+  {
+    const uint8* src = input.data() + byte * numValues;
+    for(usize i = 0; i < numValues; i++)
+    {
+      output[i * typeSize + byte] = src[i];
+    }
+  }
+  const usize shuffledBytes = numValues * typeSize;
+  std::copy(input.begin() + shuffledBytes, input.end(), output.begin() + shuffledBytes);
+}
+
+void SwapBytes(std::vector<uint8>& data, usize typeSize)
+{
+  for(usize offset = 0; offset + typeSize <= data.size(); offset += typeSize)
+  {
+    std::reverse(data.begin() + offset, data.begin() + offset + typeSize);
+  }
+}
+
+/**
+ * @brief Copies the values of a decoded chunk into the target buffer. Chunks
+ * on the upper edges of the dataset are clipped to the dataset's dimensions.
+ */
+void ScatterChunk(const ChunkLayout& layout, const std::vector<hsize_t>& chunkOffset, const uint8* chunk)
+{
+  const usize rank = layout.datasetDims.size();
+  const usize lastDim = rank - 1;
+  const usize rowValues = static_cast<usize>(std::min(layout.chunkDims[lastDim], layout.datasetDims[lastDim] - chunkOffset[lastDim]));
+  const usize rowBytes = rowValues * layout.typeSize;
+
+  // Iterate over every row of the chunk along the fastest dimension
+  std::vector<hsize_t> position(rank, 0);
+  while(true)
+  {
+    bool inside = true;
+    usize chunkIndex = 0;
+    usize targetIndex = 0;
+    for(usize dim = 0; dim < rank; dim++)
+    {
+      if(chunkOffset[dim] + position[dim] >= layout.datasetDims[dim])
+      {
+        inside = false;
+        break;
+      }
+      chunkIndex = chunkIndex * layout.chunkDims[dim] + position[dim];
+      targetIndex = targetIndex * layout.datasetDims[dim] + chunkOffset[dim] + position[dim];
+    }
+    if(inside)
+    {
+      std::memcpy(layout.target + targetIndex * layout.typeSize, chunk + chunkIndex * layout.typeSize, rowBytes);
+    }
+
+    // Advance to the next row
+    if(rank == 1)
+    {
+      return;
+    }
+    usize dim = rank - 2;
+    while(true)
+    {
+      position[dim]++;
+      if(position[dim] < layout.chunkDims[dim])
+      {
+        break;
+      }
+      position[dim] = 0;
+      if(dim == 0)
+      {
+        return;
+      }
+      dim--;
+    }
+  }
+}
+
+/**
+ * @brief Decodes a raw chunk by undoing its filters in reverse pipeline order
+ * and copies its values into the target buffer.
+ */
+bool DecodeChunk(const ChunkLayout& layout, const std::vector<hsize_t>& chunkOffset, uint32 filterMask, std::vector<uint8>& rawChunk)
+{
+  std::vector<uint8> decoded;
+  for(usize i = layout.filters.size(); i-- > 0;)
+  {
+    // A set bit means the filter was skipped for this chunk
+    if((filterMask & (1u << i)) != 0)
+    {
+      continue;
+    }
+    if(layout.filters[i] == H5Z_FILTER_DEFLATE)
+    {
+      if(!Inflate(rawChunk, decoded, layout.chunkBytes))
+      {
+        return false;
+      }
+    }
+    else
+    {
+      Unshuffle(rawChunk, decoded, layout.typeSize);
+    }
+    rawChunk.swap(decoded);
+  }
+  if(rawChunk.size() != layout.chunkBytes)
+  {
+    return false;
+  }
+  if(layout.swapBytes)
+  {
+    SwapBytes(rawChunk, layout.typeSize);
+  }
+  ScatterChunk(layout, chunkOffset, rawChunk.data());
+  return true;
+}
+
+/**
+ * @brief Returns the file address of the dataset's data or k_UnknownOffset if
+ * it cannot be determined.
+ */
+uint64 GetFileOffset(hid_t datasetId)
+{
+  const haddr_t offset = H5Dget_offset(datasetId);
+  if(offset != HADDR_UNDEF)
+  {
+    return static_cast<uint64>(offset);
+  }
+#if H5_VERSION_GE(1, 10, 5)
+  uint64 fileOffset = k_UnknownOffset;
+  hid_t dataspaceId = H5Dget_space(datasetId);
+  hsize_t numChunks = 0;
+  if(H5Dget_num_chunks(datasetId, dataspaceId, &numChunks) >= 0 && numChunks > 0)
+  {
+    haddr_t address = HADDR_UNDEF;
+    hsize_t size = 0;
+    uint32 filterMask = 0;
+    if(H5Dget_chunk_info(datasetId, dataspaceId, 0, nullptr, &filterMask, &address, &size) >= 0 && address != HADDR_UNDEF)
+    {
+      fileOffset = static_cast<uint64>(address);
+    }
+  }
+  H5Sclose(dataspaceId);
+  return fileOffset;
+#else
+  return k_UnknownOffset;
+#endif
+}
+
+/**
+ * @brief Fills in the chunk layout and returns true if the raw chunks of the
+ * dataset can be decoded by DecodeChunk.
+ */
+bool GetChunkLayout(hid_t datasetId, hid_t memTypeId, usize numBytes, ChunkLayout& layout)
+{
+#if H5_VERSION_GE(1, 10, 5)
+  hid_t propertyListId = H5Dget_create_plist(datasetId);
+  if(propertyListId < 0)
+  {
+    return false;
+  }
+  bool supported = (H5Pget_layout(propertyListId) == H5D_CHUNKED);
+
+  hid_t dataspaceId = H5Dget_space(datasetId);
+  const int rank = H5Sget_simple_extent_ndims(dataspaceId);
+  supported = supported && rank > 0;
+  if(supported)
+  {
+    layout.datasetDims.resize(rank);
+    layout.chunkDims.resize(rank);
+    H5Sget_simple_extent_dims(dataspaceId, layout.datasetDims.data(), nullptr);
+    supported = H5Pget_chunk(propertyListId, rank, layout.chunkDims.data()) == rank;
+  }
+  H5Sclose(dataspaceId);
+
+  const int numFilters = supported ? H5Pget_nfilters(propertyListId) : 0;
+  for(int i = 0; i < numFilters && supported; i++)
+  {
+    uint32 flags = 0;
+    usize numValues = 0;
+    const H5Z_filter_t filter = H5Pget_filter2(propertyListId, i, &flags, &numValues, nullptr, 0, nullptr, nullptr);
+    supported = (filter == H5Z_FILTER_DEFLATE || filter == H5Z_FILTER_SHUFFLE);
+    layout.filters.push_back(filter);
+  }
+  H5Pclose(propertyListId);
+  if(!supported)
+  {
+    return false;
+  }
+
+  // The file type must match the memory type except for its byte order
+  hid_t fileTypeId = H5Dget_type(datasetId);
+  hid_t nativeTypeId = H5Tget_native_type(fileTypeId, H5T_DIR_ASCEND);
+  supported = nativeTypeId >= 0 && H5Tequal(nativeTypeId, memTypeId) > 0;
+  if(supported)
+  {
+    layout.typeSize = H5Tget_size(memTypeId);
+    layout.swapBytes = H5Tget_order(fileTypeId) != H5Tget_order(memTypeId);
+  }
+  if(nativeTypeId >= 0)
+  {
+    H5Tclose(nativeTypeId);
+  }
+  H5Tclose(fileTypeId);
+  if(!supported)
+  {
+    return false;
+  }
+
+  const hsize_t numValues = std::accumulate(layout.datasetDims.cbegin(), layout.datasetDims.cend(), static_cast<hsize_t>(1), std::multiplies<>());
+  const hsize_t chunkValues = std::accumulate(layout.chunkDims.cbegin(), layout.chunkDims.cend(), static_cast<hsize_t>(1), std::multiplies<>());
+  layout.chunkBytes = static_cast<usize>(chunkValues) * layout.typeSize;
+  return numValues * layout.typeSize == numBytes;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Reads the raw chunks of the dataset and queues them for decoding.
+ * handled is set to false if the chunks cannot be read this way, which leaves
+ * the target untouched.
+ */
+H5::ErrorType ReadChunks(hid_t datasetId, usize requestIndex, const std::shared_ptr<ChunkLayout>& layout, DecodeQueue& decodeQueue, bool& handled)
+{
+  handled = false;
+#if H5_VERSION_GE(1, 10, 5)
+  hid_t dataspaceId = H5Dget_space(datasetId);
+  hsize_t numChunks = 0;
+  if(H5Dget_num_chunks(datasetId, dataspaceId, &numChunks) < 0)
+  {
+    H5Sclose(dataspaceId);
+    return 0;
+  }
+  // Unwritten chunks hold the fill value and are left to H5Dread
+  hsize_t expectedChunks = 1;
+  for(usize dim = 0; dim < layout->datasetDims.size(); dim++)
+  {
+    expectedChunks *= (layout->datasetDims[dim] + layout->chunkDims[dim] - 1) / layout->chunkDims[dim];
+  }
+  if(numChunks != expectedChunks)
+  {
+    H5Sclose(dataspaceId);
+    return 0;
+  }
+
+  handled = true;
+  const usize rank = layout->datasetDims.size();
+  for(hsize_t chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+  {
+    std::vector<hsize_t> chunkOffset(rank, 0);
+    uint32 filterMask = 0;
+    haddr_t address = HADDR_UNDEF;
+    hsize_t chunkSize = 0;
+    if(H5Dget_chunk_info(datasetId, dataspaceId, chunkIndex, chunkOffset.data(), &filterMask, &address, &chunkSize) < 0)
+    {
+      H5Sclose(dataspaceId);
+      return k_ReadChunkError;
+    }
+    auto rawChunk = std::make_shared<std::vector<uint8>>(static_cast<usize>(chunkSize));
+    if(H5Dread_chunk(datasetId, H5P_DEFAULT, chunkOffset.data(), &filterMask, rawChunk->data()) < 0)
+    {
+      H5Sclose(dataspaceId);
+      return k_ReadChunkError;
+    }
+    decodeQueue.execute(requestIndex, rawChunk->size(), [layout, chunkOffset = std::move(chunkOffset), filterMask, rawChunk]() {
+      return DecodeChunk(*layout, chunkOffset, filterMask, *rawChunk);
+    });
+  }
+  H5Sclose(dataspaceId);
+#endif
+  return 0;
+}
+} // namespace
+
+H5::DatasetReadScheduler::DatasetReadScheduler(usize maxBufferedBytes)
+: m_MaxBufferedBytes(maxBufferedBytes)
+{
+}
+
+H5::DatasetReadScheduler::~DatasetReadScheduler()
+{
+  clear();
+}
+
+void H5::DatasetReadScheduler::enqueueRead(const DatasetReader& datasetReader, IdType memTypeId, void* buffer, usize numBytes)
+{
+  ReadRequest request;
+  request.fileId = H5Iget_file_id(datasetReader.getId());
+  request.datasetPath = "/" + Support::GetObjectPath(datasetReader.getId());
+  request.memTypeId = memTypeId;
+  request.buffer = buffer;
+  request.numBytes = numBytes;
+  request.fileOffset = GetFileOffset(datasetReader.getId());
+  m_Requests.push_back(std::move(request));
+}
+
+usize H5::DatasetReadScheduler::getNumberOfReads() const
+{
+  return m_Requests.size();
+}
+
+usize H5::DatasetReadScheduler::getMaxBufferedBytes() const
+{
+  return m_MaxBufferedBytes;
+}
+
+void H5::DatasetReadScheduler::setMaxBufferedBytes(usize maxBufferedBytes)
+{
+  m_MaxBufferedBytes = maxBufferedBytes;
+}
+
+bool H5::DatasetReadScheduler::getParallelizationEnabled() const
+{
+  return m_Parallelization;
+}
+
+void H5::DatasetReadScheduler::setParallelizationEnabled(bool doParallel)
+{
+  m_Parallelization = doParallel;
+}
+
+Result<> H5::DatasetReadScheduler::run()
+{
+  std::stable_sort(m_Requests.begin(), m_Requests.end(), [](const ReadRequest& lhs, const ReadRequest& rhs) { return lhs.fileOffset < rhs.fileOffset; });
+
+  Result<> result;
+  {
+    DecodeQueue decodeQueue(m_MaxBufferedBytes, m_Parallelization);
+    for(usize requestIndex = 0; requestIndex < m_Requests.size(); requestIndex++)
+    {
+      const ReadRequest& request = m_Requests[requestIndex];
+      std::lock_guard<std::recursive_mutex> libraryLock(GetLibraryMutex());
+      hid_t datasetId = H5Dopen(request.fileId, request.datasetPath.c_str(), H5P_DEFAULT);
+      if(datasetId < 0)
+      {
+        result = MakeErrorResult(k_OpenDatasetError, fmt::format("Error opening dataset '{}'", request.datasetPath));
+        break;
+      }
+
+      ErrorType errorCode = 0;
+      bool handled = false;
+      auto layout = std::make_shared<ChunkLayout>();
+      layout->target = static_cast<uint8*>(request.buffer);
+      if(GetChunkLayout(datasetId, request.memTypeId, request.numBytes, *layout))
+      {
+        errorCode = ReadChunks(datasetId, requestIndex, layout, decodeQueue, handled);
+      }
+      if(errorCode >= 0 && !handled && H5Dread(datasetId, request.memTypeId, H5S_ALL, H5S_ALL, H5P_DEFAULT, request.buffer) < 0)
+      {
+        errorCode = k_ReadDatasetError;
+      }
+      H5Dclose(datasetId);
+      if(errorCode < 0)
+      {
+        result = MakeErrorResult(errorCode, fmt::format("Error reading dataset '{}'", request.datasetPath));
+        break;
+      }
+    }
+    decodeQueue.wait();
+    const usize failedRequest = decodeQueue.failedRequest();
+    if(result.valid() && failedRequest != DecodeQueue::k_NoFailure)
+    {
+      result = MakeErrorResult(k_DecodeChunkError, fmt::format("Error decoding the chunks of dataset '{}'", m_Requests[failedRequest].datasetPath));
+    }
+  }
+
+  clear();
+  return result;
+}
+
+void H5::DatasetReadScheduler::clear()
+{
+  for(const auto& request : m_Requests)
+  {
+    if(request.fileId > 0)
+    {
+      H5Fclose(request.fileId);
+    }
+  }
+  m_Requests.clear();
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <nonstd/span.hpp>
+
+#include "complex/Common/Result.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5Support.hpp"
+
+namespace complex
+{
+namespace H5
+{
+class DatasetReader;
+
+/**
+ * @class DatasetReadScheduler
+ * @brief The DatasetReadScheduler class collects dataset reads while a file is
+ * being imported and performs them together once the import has finished
+ * walking the file.
+ *
+ * Reads are performed in file offset order to keep disk access sequential.
+ * Chunked datasets that only use the deflate and shuffle filters are read as
+ * raw chunks by the calling thread while the chunks are decompressed, byte
+ * swapped and copied into their targets on the TBB thread pool, so reading
+ * and decoding overlap. All other datasets are read through H5Dread.
+ *
+ * HDF5 is only ever called from the thread that calls run().
+ */
+class COMPLEX_EXPORT DatasetReadScheduler
+{
+public:
+  static inline constexpr usize k_DefaultMaxBufferedBytes = 256 * 1024 * 1024;
+
+  /**
+   * @brief Constructs a DatasetReadScheduler that keeps at most maxBufferedBytes
+   * of undecoded chunks in memory.
+   * @param maxBufferedBytes
+   */
+  DatasetReadScheduler(usize maxBufferedBytes = k_DefaultMaxBufferedBytes);
+
+  /**
+   * @brief Releases any reads that were not run.
+   */
+  ~DatasetReadScheduler();
+
+  DatasetReadScheduler(const DatasetReadScheduler&) = delete;
+  DatasetReadScheduler(DatasetReadScheduler&&) noexcept = delete;
+  DatasetReadScheduler& operator=(const DatasetReadScheduler&) = delete;
+  DatasetReadScheduler& operator=(DatasetReadScheduler&&) noexcept = delete;
+
+  /**
+   * @brief Schedules reading the entire dataset into the given span. The span
+   * must stay valid until run() or clear() is called.
+   * @tparam T
+   * @param datasetReader
+   * @param data
+   */
+  template <class T>
+  void enqueue(const DatasetReader& datasetReader, nonstd::span<T> data)
+  {
+    enqueueRead(datasetReader, Support::HdfTypeForPrimitive<T>(), data.data(), data.size() * sizeof(T));
+  }
+
+  /**
+   * @brief Schedules reading the entire dataset into the given buffer as the
+   * given memory type. The buffer must stay valid until run() or clear() is
+   * called.
+   * @param datasetReader
+   * @param memTypeId
+   * @param buffer
+   * @param numBytes
+   */
+  void enqueueRead(const DatasetReader& datasetReader, IdType memTypeId, void* buffer, usize numBytes);
+
+  /**
+   * @brief Returns the number of scheduled reads.
+   * @return usize
+   */
+  usize getNumberOfReads() const;
+
+  /**
+   * @brief Returns the maximum number of bytes of undecoded chunks kept in memory.
+   * @return usize
+   */
+  usize getMaxBufferedBytes() const;
+
+  /**
+   * @brief Sets the maximum number of bytes of undecoded chunks kept in memory.
+   * @param maxBufferedBytes
+   */
+  void setMaxBufferedBytes(usize maxBufferedBytes);
+
+  /**
+   * @brief Returns true if chunks are decoded on the thread pool.
+   * @return bool
+   */
+  bool getParallelizationEnabled() const;
+
+  /**
+   * @brief Sets whether chunks are decoded on the thread pool.
+   * @param doParallel
+   */
+  void setParallelizationEnabled(bool doParallel);
+
+  /**
+   * @brief Performs all scheduled reads and blocks until every target has
+   * been filled. Returns the first error encountered along with the path of
+   * the dataset it occurred in. The scheduled reads are cleared either way.
+   * @return Result<>
+   */
+  Result<> run();
+
+  /**
+   * @brief Removes all scheduled reads without performing them.
+   */
+  void clear();
+
+private:
+  struct ReadRequest
+  {
+    IdType fileId = 0;
+    std::string datasetPath;
+    IdType memTypeId = 0;
+    void* buffer = nullptr;
+    usize numBytes = 0;
+    uint64 fileOffset = 0;
+  };
+
+  std::vector<ReadRequest> m_Requests;
+  usize m_MaxBufferedBytes = k_DefaultMaxBufferedBytes;
+  bool m_Parallelization = true;
+};
+} // namespace H5
+} // namespace complex
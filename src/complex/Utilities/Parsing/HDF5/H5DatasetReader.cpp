@@ -1,5 +1,6 @@
 #include "H5DatasetReader.hpp"
 
+#include <functional>
 #include <iostream>
 #include <numeric>
 
@@ -281,6 +282,52 @@ bool H5::DatasetReader::readIntoSpan(nonstd::span<T> data) const
   return true;
 }
 
+template <class T>
+bool H5::DatasetReader::readHyperslabIntoSpan(const std::vector<hsize_t>& start, const std::vector<hsize_t>& count, nonstd::span<T> data) const
+{
+  if(!isValid())
+  {
+    return false;
+  }
+
+  hid_t dataType = H5::Support::HdfTypeForPrimitive<T>();
+  if(dataType == -1)
+  {
+    return false;
+  }
+
+  const hsize_t numElements = std::accumulate(count.cbegin(), count.cend(), static_cast<hsize_t>(1), std::multiplies<>());
+  if(numElements != data.size())
+  {
+    return false;
+  }
+
+  hid_t fileSpaceId = H5Dget_space(getId());
+  if(fileSpaceId < 0)
+  {
+    std::cout << "Error Opening SpaceID" << std::endl;
+    return false;
+  }
+  bool success = false;
+  if(H5Sget_simple_extent_ndims(fileSpaceId) == static_cast<int32>(start.size()) && start.size() == count.size() &&
+     H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, start.data(), nullptr, count.data(), nullptr) >= 0)
+  {
+    hsize_t memDims = numElements;
+    hid_t memSpaceId = H5Screate_simple(1, &memDims, nullptr);
+    if(memSpaceId >= 0)
+    {
+      success = H5Dread(getId(), dataType, memSpaceId, fileSpaceId, H5P_DEFAULT, data.data()) >= 0;
+      if(!success)
+      {
+        std::cout << "Error Reading Hyperslab.'" << getName() << "'" << std::endl;
+      }
+      H5Sclose(memSpaceId);
+    }
+  }
+  H5Sclose(fileSpaceId);
+  return success;
+}
+
 std::vector<hsize_t> H5::DatasetReader::getDimensions() const
 {
   std::vector<hsize_t> dims;
@@ -342,3 +389,18 @@ template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<usize>(nonstd::span
 #endif
 template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<float32>(nonstd::span<float32>) const;
 template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<float64>(nonstd::span<float64>) const;
+
+template COMPLEX_EXPORT bool H5::DatasetReader::readHyperslabIntoSpan<int8>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<int8>) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readHyperslabIntoSpan<int16>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<int16>) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readHyperslabIntoSpan<int32>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<int32>) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readHyperslabIntoSpan<int64>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<int64>) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readHyperslabIntoSpan<uint8>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<uint8>) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readHyperslabIntoSpan<uint16>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<uint16>) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readHyperslabIntoSpan<uint32>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<uint32>) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readHyperslabIntoSpan<uint64>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<uint64>) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readHyperslabIntoSpan<bool>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<bool>) const;
+#ifdef __APPLE__
+template COMPLEX_EXPORT bool H5::DatasetReader::readHyperslabIntoSpan<usize>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<usize>) const;
+#endif
+template COMPLEX_EXPORT bool H5::DatasetReader::readHyperslabIntoSpan<float32>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<float32>) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readHyperslabIntoSpan<float64>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<float64>) const;
@@ -112,6 +112,18 @@ public:
   template <class T>
   bool readIntoSpan(nonstd::span<T> data) const;
 
+  /**
+   * @brief Reads the hyperslab of the dataset described by start and count
+   * into the given span. The span must contain exactly the product of count
+   * values. Returns false if unable to read.
+   * @tparam T
+   * @param start
+   * @param count
+   * @param data
+   */
+  template <class T>
+  bool readHyperslabIntoSpan(const std::vector<hsize_t>& start, const std::vector<hsize_t>& count, nonstd::span<T> data) const;
+
   /**
    * @brief Returns a vector of the sizes of the dimensions for the dataset
    * Returns empty vector if unable to read.
@@ -135,5 +147,16 @@ extern template bool DatasetReader::readIntoSpan<uint32>(nonstd::span<uint32>) c
 extern template bool DatasetReader::readIntoSpan<uint64>(nonstd::span<uint64>) const;
 extern template bool DatasetReader::readIntoSpan<float32>(nonstd::span<float32>) const;
 extern template bool DatasetReader::readIntoSpan<float64>(nonstd::span<float64>) const;
+extern template bool DatasetReader::readHyperslabIntoSpan<bool>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<bool>) const;
+extern template bool DatasetReader::readHyperslabIntoSpan<int8>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<int8>) const;
+extern template bool DatasetReader::readHyperslabIntoSpan<int16>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<int16>) const;
+extern template bool DatasetReader::readHyperslabIntoSpan<int32>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<int32>) const;
+extern template bool DatasetReader::readHyperslabIntoSpan<int64>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<int64>) const;
+extern template bool DatasetReader::readHyperslabIntoSpan<uint8>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<uint8>) const;
+extern template bool DatasetReader::readHyperslabIntoSpan<uint16>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<uint16>) const;
+extern template bool DatasetReader::readHyperslabIntoSpan<uint32>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<uint32>) const;
+extern template bool DatasetReader::readHyperslabIntoSpan<uint64>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<uint64>) const;
+extern template bool DatasetReader::readHyperslabIntoSpan<float32>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<float32>) const;
+extern template bool DatasetReader::readHyperslabIntoSpan<float64>(const std::vector<hsize_t>&, const std::vector<hsize_t>&, nonstd::span<float64>) const;
 } // namespace H5
 } // namespace complex
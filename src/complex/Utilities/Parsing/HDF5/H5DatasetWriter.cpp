@@ -1,5 +1,6 @@
 #include "H5DatasetWriter.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #include <H5Apublic.h>
@@ -13,9 +14,10 @@ H5::DatasetWriter::DatasetWriter()
 {
 }
 
-H5::DatasetWriter::DatasetWriter(H5::IdType parentId, const std::string& datasetName)
+H5::DatasetWriter::DatasetWriter(H5::IdType parentId, const std::string& datasetName, const DatasetCreationOptions& options)
 : ObjectWriter(parentId)
 , m_DatasetName(datasetName)
+, m_CreationOptions(options)
 {
 #if 0
   if(!tryOpeningDataset(datasetName, dataType))
@@ -114,17 +116,101 @@ H5::ErrorType H5::DatasetWriter::findAndDeleteAttribute()
   return 0;
 }
 
-void H5::DatasetWriter::createOrOpenDataset(H5::IdType typeId, H5::IdType dataspaceId)
+void H5::DatasetWriter::createOrOpenDataset(H5::IdType typeId, H5::IdType dataspaceId, H5::IdType propertyListId)
 {
   HDF_ERROR_HANDLER_OFF
   setId(H5Dopen(getParentId(), getName().c_str(), H5P_DEFAULT));
   HDF_ERROR_HANDLER_ON
   if(getId() < 0) // dataset does not exist so create it
   {
-    setId(H5Dcreate(getParentId(), getName().c_str(), typeId, dataspaceId, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+    setId(H5Dcreate(getParentId(), getName().c_str(), typeId, dataspaceId, H5P_DEFAULT, propertyListId, H5P_DEFAULT));
   }
 }
 
+H5::IdType H5::DatasetWriter::createDatasetCreationPropertyList(H5::IdType typeId, const DimsType& dims) const
+{
+  if(!m_CreationOptions.isChunked() || dims.empty())
+  {
+    return H5P_DEFAULT;
+  }
+  // HDF5 cannot chunk an empty dataset
+  if(std::find(dims.cbegin(), dims.cend(), 0) != dims.cend())
+  {
+    return H5P_DEFAULT;
+  }
+
+  DimsType chunkDims = m_CreationOptions.chunkDims;
+  if(chunkDims.size() != dims.size())
+  {
+    // Keep the fastest dimensions whole and split the slowest one that no
+    // longer fits into the target chunk size
+    const usize typeSize = H5Tget_size(typeId);
+    const usize targetValues = std::max(m_CreationOptions.targetChunkBytes / std::max(typeSize, static_cast<usize>(1)), static_cast<usize>(1));
+    chunkDims.assign(dims.size(), 1);
+    usize numValues = 1;
+    for(usize i = dims.size(); i > 0; i--)
+    {
+      const usize extent = dims[i - 1];
+      if(numValues * extent <= targetValues)
+      {
+        chunkDims[i - 1] = extent;
+        numValues *= extent;
+        continue;
+      }
+      chunkDims[i - 1] = std::max(targetValues / numValues, static_cast<usize>(1));
+      break;
+    }
+  }
+  for(usize i = 0; i < dims.size(); i++)
+  {
+    chunkDims[i] = std::clamp(chunkDims[i], static_cast<H5::SizeType>(1), dims[i]);
+  }
+
+  hid_t propertyListId = H5Pcreate(H5P_DATASET_CREATE);
+  if(propertyListId < 0)
+  {
+    return H5P_DEFAULT;
+  }
+  herr_t error = H5Pset_chunk(propertyListId, static_cast<int32>(chunkDims.size()), chunkDims.data());
+  if(error >= 0 && m_CreationOptions.scaleOffset && H5Tget_class(typeId) == H5T_INTEGER && H5Zfilter_avail(H5Z_FILTER_SCALEOFFSET) > 0)
+  {
+    error = H5Pset_scaleoffset(propertyListId, H5Z_SO_INT, H5Z_SO_INT_MINBITS_DEFAULT);
+  }
+  if(error >= 0 && m_CreationOptions.shuffle && H5Zfilter_avail(H5Z_FILTER_SHUFFLE) > 0)
+  {
+    error = H5Pset_shuffle(propertyListId);
+  }
+  if(error >= 0 && m_CreationOptions.deflateLevel > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)
+  {
+    error = H5Pset_deflate(propertyListId, static_cast<uint32>(std::min(m_CreationOptions.deflateLevel, 9)));
+  }
+  if(error < 0)
+  {
+    std::cout << "Error Setting Dataset Creation Properties for '" << getName() << "'" << std::endl;
+    H5Pclose(propertyListId);
+    return H5P_DEFAULT;
+  }
+  return propertyListId;
+}
+
+void H5::DatasetWriter::closeDatasetCreationPropertyList(H5::IdType propertyListId)
+{
+  if(propertyListId != H5P_DEFAULT)
+  {
+    H5Pclose(propertyListId);
+  }
+}
+
+const H5::DatasetCreationOptions& H5::DatasetWriter::getCreationOptions() const
+{
+  return m_CreationOptions;
+}
+
+void H5::DatasetWriter::setCreationOptions(const DatasetCreationOptions& options)
+{
+  m_CreationOptions = options;
+}
+
 bool H5::DatasetWriter::isValid() const
 {
   return (getParentId() > 0) && (m_DatasetName.empty() == false);
@@ -27,8 +27,9 @@ public:
    * or the datasetName is empty.
    * @param parentId
    * @param datasetName
+   * @param options = {}
    */
-  DatasetWriter(H5::IdType parentId, const std::string& datasetName);
+  DatasetWriter(H5::IdType parentId, const std::string& datasetName, const DatasetCreationOptions& options = {});
 
   /**
    * @brief Default destructor
@@ -49,6 +50,20 @@ public:
    */
   std::string getName() const override;
 
+  /**
+   * @brief Returns the options used when the dataset is created by one of the
+   * numeric write methods.
+   * @return const DatasetCreationOptions&
+   */
+  const DatasetCreationOptions& getCreationOptions() const;
+
+  /**
+   * @brief Sets the options used when the dataset is created by one of the
+   * numeric write methods. Existing datasets keep their layout.
+   * @param options
+   */
+  void setCreationOptions(const DatasetCreationOptions& options);
+
   /**
    * @brief Writes a given string to the dataset. Returns the HDF5 error,
    * should one occur.
@@ -122,7 +137,9 @@ public:
       {
         /* Create the attribute. */
         // hid_t attributeId = H5Acreate(getId(), getName().c_str(), dataType, dataspaceId, H5P_DEFAULT, H5P_DEFAULT);
-        createOrOpenDataset(dataType, dataspaceId);
+        hid_t propertyListId = createDatasetCreationPropertyList(dataType, dims);
+        createOrOpenDataset(dataType, dataspaceId, propertyListId);
+        closeDatasetCreationPropertyList(propertyListId);
         if(getId() >= 0)
         {
           /* Write the attribute data. */
@@ -162,6 +179,87 @@ public:
     return returnError;
   }
 
+  /**
+   * @brief Creates (or opens) the dataset with the given dimensions without
+   * writing any values. The values can then be written in pieces using
+   * writeHyperslab(). Returns the HDF5 error, should one occur.
+   * @tparam T
+   * @param dims
+   * @return H5::ErrorType
+   */
+  template <typename T>
+  H5::ErrorType createEmptyDataset(const DimsType& dims)
+  {
+    hid_t dataType = H5::Support::HdfTypeForPrimitive<T>();
+    if(dataType == -1)
+    {
+      std::cout << "dataType was unknown" << std::endl;
+      return -1;
+    }
+    int32_t rank = static_cast<int32_t>(dims.size());
+    hid_t dataspaceId = H5Screate_simple(rank, dims.data(), nullptr);
+    if(dataspaceId < 0)
+    {
+      return static_cast<herr_t>(dataspaceId);
+    }
+    hid_t propertyListId = createDatasetCreationPropertyList(dataType, dims);
+    createOrOpenDataset(dataType, dataspaceId, propertyListId);
+    closeDatasetCreationPropertyList(propertyListId);
+    herr_t error = H5Sclose(dataspaceId);
+    if(getId() < 0)
+    {
+      std::cout << "Error Creating Dataset" << std::endl;
+      return static_cast<herr_t>(getId());
+    }
+    return error;
+  }
+
+  /**
+   * @brief Writes a span of values into the hyperslab of an existing dataset
+   * described by start and count. The span must contain exactly the product
+   * of count values. Returns the HDF5 error, should one occur.
+   * @tparam T
+   * @param start
+   * @param count
+   * @param values
+   * @return H5::ErrorType
+   */
+  template <typename T>
+  H5::ErrorType writeHyperslab(const DimsType& start, const DimsType& count, nonstd::span<const T> values)
+  {
+    if(getId() <= 0)
+    {
+      return -1;
+    }
+    hid_t dataType = H5::Support::HdfTypeForPrimitive<T>();
+    hid_t fileSpaceId = H5Dget_space(getId());
+    if(fileSpaceId < 0)
+    {
+      return static_cast<herr_t>(fileSpaceId);
+    }
+    herr_t returnError = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, start.data(), nullptr, count.data(), nullptr);
+    if(returnError >= 0)
+    {
+      hsize_t memDims = values.size();
+      hid_t memSpaceId = H5Screate_simple(1, &memDims, nullptr);
+      if(memSpaceId >= 0)
+      {
+        returnError = H5Dwrite(getId(), dataType, memSpaceId, fileSpaceId, H5P_DEFAULT, static_cast<const void*>(values.data()));
+        if(returnError < 0)
+        {
+          std::cout << "Error Writing Hyperslab" << std::endl;
+        }
+        H5Sclose(memSpaceId);
+      }
+      else
+      {
+        returnError = static_cast<herr_t>(memSpaceId);
+      }
+    }
+    H5Sclose(fileSpaceId);
+    return returnError;
+  }
+
 protected:
   /**
    * @brief Finds and deletes any existing attribute with the current name.
@@ -172,11 +270,28 @@ protected:
 
   /**
    * @brief Opens the target HDF5 dataset or creates a new one using the given
-   * datatype and dataspace IDs.
+   * datatype, dataspace and dataset creation property list IDs.
    * @param typeId
    * @param dataspaceId
+   * @param propertyListId = H5P_DEFAULT
+   */
+  void createOrOpenDataset(H5::IdType typeId, H5::IdType dataspaceId, H5::IdType propertyListId = H5P_DEFAULT);
+
+  /**
+   * @brief Creates the dataset creation property list that applies the
+   * creation options to a dataset of the given type and dimensions. Returns
+   * H5P_DEFAULT if the dataset should use the default contiguous layout.
+   * @param typeId
+   * @param dims
+   * @return H5::IdType
+   */
+  H5::IdType createDatasetCreationPropertyList(H5::IdType typeId, const DimsType& dims) const;
+
+  /**
+   * @brief Closes a property list returned by createDatasetCreationPropertyList().
+   * @param propertyListId
    */
-  void createOrOpenDataset(H5::IdType typeId, H5::IdType dataspaceId);
+  static void closeDatasetCreationPropertyList(H5::IdType propertyListId);
 
   /**
    * @brief Closes the HDF5 dataset and resets the ID to 0.
@@ -190,6 +305,7 @@ private:
 #endif
 
   const std::string m_DatasetName;
+  DatasetCreationOptions m_CreationOptions;
 };
 } // namespace H5
 } // namespace complex
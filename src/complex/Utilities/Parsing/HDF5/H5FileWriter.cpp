@@ -45,6 +45,7 @@ H5::FileWriter::FileWriter(FileWriter&& rhs) noexcept
 {
   auto rhsId = rhs.getId();
   setId(rhsId);
+  setDatasetCreationOptions(rhs.getDatasetCreationOptions());
   rhs.setId(-1);
 }
 
@@ -16,8 +16,9 @@ H5::GroupWriter::GroupWriter(H5::IdType parentId, H5::IdType objectId)
 {
 }
 
-H5::GroupWriter::GroupWriter(H5::IdType parentId, const std::string& groupName)
+H5::GroupWriter::GroupWriter(H5::IdType parentId, const std::string& groupName, const DatasetCreationOptions& options)
 : ObjectWriter(parentId)
+, m_DatasetCreationOptions(options)
 {
   // Check if group exists
   HDF_ERROR_HANDLER_OFF
@@ -60,7 +61,7 @@ H5::GroupWriter H5::GroupWriter::createGroupWriter(const std::string& childName)
     return GroupWriter();
   }
 
-  return GroupWriter(getId(), childName);
+  return GroupWriter(getId(), childName, m_DatasetCreationOptions);
 }
 
 H5::DatasetWriter H5::GroupWriter::createDatasetWriter(const std::string& childName)
@@ -70,7 +71,7 @@ H5::DatasetWriter H5::GroupWriter::createDatasetWriter(const std::string& childN
     return DatasetWriter();
   }
 
-  return DatasetWriter(getId(), childName);
+  return DatasetWriter(getId(), childName, m_DatasetCreationOptions);
 }
 
 H5::ErrorType H5::GroupWriter::createLink(const std::string& objectPath)
@@ -89,3 +90,13 @@ H5::ErrorType H5::GroupWriter::createLink(const std::string& objectPath)
   herr_t errorCode = H5Lcreate_hard(getFileId(), objectPath.c_str(), getId(), objectName.c_str(), H5P_DEFAULT, H5P_DEFAULT);
   return errorCode;
 }
+
+const H5::DatasetCreationOptions& H5::GroupWriter::getDatasetCreationOptions() const
+{
+  return m_DatasetCreationOptions;
+}
+
+void H5::GroupWriter::setDatasetCreationOptions(const DatasetCreationOptions& options)
+{
+  m_DatasetCreationOptions = options;
+}
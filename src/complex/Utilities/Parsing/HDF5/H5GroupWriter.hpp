@@ -23,8 +23,9 @@ public:
    * HDF5 group fails, this writer is invalid.
    * @param parentId
    * @param objectName
+   * @param options = {}
    */
-  GroupWriter(H5::IdType parentId, const std::string& objectName);
+  GroupWriter(H5::IdType parentId, const std::string& objectName, const DatasetCreationOptions& options = {});
 
   /**
    * @brief Closes the HDF5 group.
@@ -64,6 +65,21 @@ public:
    */
   H5::ErrorType createLink(const std::string& objectPath);
 
+  /**
+   * @brief Returns the creation options passed to the DatasetWriters and
+   * child GroupWriters created by this group.
+   * @return const DatasetCreationOptions&
+   */
+  const DatasetCreationOptions& getDatasetCreationOptions() const;
+
+  /**
+   * @brief Sets the creation options passed to the DatasetWriters and child
+   * GroupWriters created by this group. This allows the layout and filters of
+   * every dataset in a file to be selected once on the FileWriter.
+   * @param options
+   */
+  void setDatasetCreationOptions(const DatasetCreationOptions& options);
+
 protected:
   /**
    * @brief Closes the HDF5 ID and resets it to 0.
@@ -78,6 +94,9 @@ protected:
    * @param objectId
    */
   GroupWriter(H5::IdType parentId, H5::IdType objectId);
+
+private:
+  DatasetCreationOptions m_DatasetCreationOptions;
 };
 } // namespace H5
 } // namespace complex
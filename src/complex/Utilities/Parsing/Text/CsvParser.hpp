@@ -2,7 +2,11 @@
 
 #include "complex/Common/Result.hpp"
 #include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/DataStructure.hpp"
+#include "complex/Utilities/MemoryMappedFile.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+#include "complex/Utilities/Parsing/Text/TextIngestion.hpp"
 #include "complex/Utilities/StringUtilities.hpp"
 #include "complex/complex_export.hpp"
 
@@ -12,6 +16,7 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -33,6 +38,7 @@ constexpr int32_t k_RBR_READ_BAD = 1045;
 constexpr int32_t k_RBR_FILE_NOT_EXIST = 1050;
 
 constexpr size_t k_BufferSize = 1024;
+constexpr size_t k_ChunkSize = 1024 * 1024;
 
 class DelimiterType : public std::ctype<char>
 {
@@ -91,82 +97,102 @@ COMPLEX_EXPORT int32_t ReadLine(std::istream& in, char* buffer, size_t length);
 template <typename T, typename K>
 Result<> ReadFile(const fs::path& filename, DataArray<T>& data, uint64_t skipHeaderLines, char delimiter, bool inputIsBool = false)
 {
-  int32_t err = k_RBR_NO_ERROR;
   if(!fs::exists(filename))
   {
     return MakeErrorResult(k_RBR_FILE_NOT_EXIST, fmt::format("Input file does not exist: {}", filename.string()));
   }
 
-  std::ifstream in(filename.c_str(), std::ios_base::in | std::ios_base::binary);
-  if(!in.is_open())
+  Result<MemoryMappedFile> fileResult = MemoryMappedFile::Open(filename);
+  if(fileResult.invalid())
   {
     return MakeErrorResult(k_RBR_FILE_NOT_OPEN, fmt::format("Could not open file for reading: {}", filename.string()));
   }
+  std::string_view text = fileResult.value().text();
 
-  in.imbue(std::locale(std::locale(), new complex::CsvParser::DelimiterType(delimiter)));
+  for(uint64_t i = 0; i < skipHeaderLines && !text.empty(); i++)
+  {
+    const size_t lineEnd = text.find('\n');
+    text.remove_prefix(lineEnd == std::string_view::npos ? text.size() : lineEnd + 1);
+  }
 
-  std::array<char, k_BufferSize> buf = {};
-  char* buffer = buf.data();
+  const size_t totalSize = data.getSize();
+  // The values may all be on one line, so chunks are split between any two values
+  const std::vector<TextIngestion::LineChunk> chunks = TextIngestion::SplitIntoValueChunks(text, k_ChunkSize, delimiter);
 
-  // Skip some header bytes by just reading those bytes into the pointer knowing that the next
-  // thing we are going to do it over write those bytes with the real data that we are after.
-  for(int i = 0; i < skipHeaderLines; i++)
-  {
-    buf.fill(0x00);                                               // Splat Null Chars across the line
-    err = complex::CsvParser::ReadLine(in, buffer, k_BufferSize); // Read Line 1 - VTK Version Info
-    if(err < 0)
+  // Count the values of every chunk so that each chunk knows where its first value goes
+  std::vector<size_t> chunkOffsets(chunks.size() + 1, 0);
+  ParallelDataAlgorithm countAlg;
+  countAlg.setRange(0, chunks.size());
+  countAlg.execute([&](const Range& range) {
+    for(size_t chunk = range.min(); chunk < range.max(); chunk++)
     {
-      return MakeErrorResult(k_RBR_READ_ERROR, fmt::format("Could not read data from file while skipping header lines: {}", filename.string()));
+      size_t count = 0;
+      TextIngestion::ForEachValueToken(text.substr(chunks[chunk].Begin, chunks[chunk].End - chunks[chunk].Begin), delimiter, [&count](std::string_view) {
+        count++;
+        return true;
+      });
+      chunkOffsets[chunk + 1] = count;
     }
+  });
+  std::partial_sum(chunkOffsets.begin(), chunkOffsets.end(), chunkOffsets.begin());
+  if(chunkOffsets.back() < totalSize)
+  {
+    return MakeErrorResult(k_RBR_READ_EOF, fmt::format("Read past End Of File (EOF) while parsing file: {}", filename.string()));
   }
 
-  size_t numTuples = data.getNumberOfTuples();
-  int scalarNumComp = data.getNumberOfComponents();
-
-  size_t totalSize = numTuples * static_cast<size_t>(scalarNumComp);
-
-  if(inputIsBool)
-  {
-    double value = 0.0;
-    int64_t* si64Ptr = reinterpret_cast<int64_t*>(&value);
-    for(size_t i = 0; i < totalSize; ++i)
+  AbstractDataStore<T>& dataStore = data.getDataStoreRef();
+  auto* inMemoryStore = dynamic_cast<DataStore<T>*>(&dataStore);
+  T* values = inMemoryStore != nullptr ? inMemoryStore->data() : nullptr;
+
+  // The first token of each chunk that could not be converted
+  std::vector<std::string_view> failedTokens(chunks.size());
+  ParallelDataAlgorithm parseAlg;
+  parseAlg.setRange(0, chunks.size());
+  parseAlg.setParallelizationEnabled(values != nullptr);
+  parseAlg.execute([&](const Range& range) {
+    for(size_t chunk = range.min(); chunk < range.max() && chunkOffsets[chunk] < totalSize; chunk++)
     {
-      in >> value;
-      if(*si64Ptr == 0)
-      {
-        data[i] = false;
-      }
-      else
-      {
-        data[i] = true;
-      }
-      err = CheckErrorBits(&in);
-      if(err == k_RBR_READ_EOF && i < totalSize - 1)
-      {
-        return MakeErrorResult(k_RBR_READ_EOF, fmt::format("Read past End Of File (EOF) while parsing file: {}", filename.string()));
-      }
-      if(err == k_RBR_READ_ERROR)
-      {
-        return MakeErrorResult(k_RBR_READ_ERROR, fmt::format("Read error while parsing file: {}", filename.string()));
-      }
+      size_t index = chunkOffsets[chunk];
+      TextIngestion::ForEachValueToken(text.substr(chunks[chunk].Begin, chunks[chunk].End - chunks[chunk].Begin), delimiter, [&](std::string_view token) {
+        T value = {};
+        std::errc errorCode = {};
+        if(inputIsBool)
+        {
+          double parsedValue = 0.0;
+          errorCode = TextIngestion::ParseNumber(token, parsedValue);
+          value = static_cast<T>(parsedValue != 0.0);
+        }
+        else
+        {
+          K parsedValue = {};
+          errorCode = TextIngestion::ParseNumber(token, parsedValue);
+          value = static_cast<T>(parsedValue);
+        }
+        if(errorCode != std::errc{})
+        {
+          failedTokens[chunk] = token;
+          return false;
+        }
+
+        if(values != nullptr)
+        {
+          values[index] = value;
+        }
+        else
+        {
+          dataStore.setValue(index, value);
+        }
+        index++;
+        return index < totalSize;
+      });
     }
-  }
-  else
+  });
+
+  for(size_t chunk = 0; chunk < chunks.size(); chunk++)
   {
-    K value = static_cast<T>(0.0);
-    for(size_t i = 0; i < totalSize; ++i)
+    if(failedTokens[chunk].data() != nullptr)
     {
-      in >> value;
-      data[i] = static_cast<T>(value);
-      err = CheckErrorBits(&in);
-      if(err == k_RBR_READ_EOF && i < totalSize - 1)
-      {
-        return MakeErrorResult(k_RBR_READ_EOF, fmt::format("Read past End Of File (EOF) while parsing file: {}", filename.string()));
-      }
-      if(err == k_RBR_READ_ERROR)
-      {
-        return MakeErrorResult(k_RBR_READ_ERROR, fmt::format("Read error while parsing file: {}", filename.string()));
-      }
+      return MakeErrorResult(k_RBR_READ_FAIL, fmt::format("Could not convert '{}' while parsing file: {}", failedTokens[chunk], filename.string()));
     }
   }
 
@@ -0,0 +1,156 @@
+#include "TextIngestion.hpp"
+
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <limits>
+#include <numeric>
+
+using namespace complex;
+
+namespace
+{
+constexpr std::string_view k_TrimmedCharacters = " \t\f\v\n\r";
+
+std::string_view Trim(std::string_view token)
+{
+  const usize front = token.find_first_not_of(k_TrimmedCharacters);
+  if(front == std::string_view::npos)
+  {
+    return {};
+  }
+  const usize back = token.find_last_not_of(k_TrimmedCharacters);
+  return token.substr(front, back - front + 1);
+}
+
+/**
+ * @brief Splits the text into chunks of about chunkSize bytes. Every chunk after the
+ * first starts right after the first boundary character that findBoundary(first, length)
+ * finds in its own nominal range, so each byte is searched once. A chunk without a
+ * boundary in its range is merged into the chunk before it.
+ * @param text
+ * @param chunkSize
+ * @param findBoundary
+ * @return std::vector<TextIngestion::LineChunk> The non empty chunks in order
+ */
+template <class FindBoundary>
+std::vector<TextIngestion::LineChunk> SplitAtBoundaries(std::string_view text, usize chunkSize, FindBoundary&& findBoundary)
+{
+  if(text.empty())
+  {
+    return {};
+  }
+  chunkSize = std::max<usize>(chunkSize, 1);
+  const usize numChunks = (text.size() + chunkSize - 1) / chunkSize;
+
+  // A boundary at the last byte of the previous chunk still starts this chunk at its nominal start
+  constexpr usize k_NoBoundary = std::numeric_limits<usize>::max();
+  std::vector<usize> begins(numChunks, 0);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numChunks);
+  dataAlg.execute([&](const Range& range) {
+    for(usize chunk = std::max<usize>(range.min(), 1); chunk < range.max(); chunk++)
+    {
+      const usize searchBegin = chunk * chunkSize - 1;
+      const char* boundary = findBoundary(text.data() + searchBegin, std::min(chunkSize, text.size() - searchBegin));
+      begins[chunk] = boundary == nullptr ? k_NoBoundary : static_cast<usize>(boundary - text.data()) + 1;
+    }
+  });
+
+  std::vector<TextIngestion::LineChunk> chunks;
+  chunks.reserve(numChunks);
+  for(usize chunk = 0; chunk < numChunks; chunk++)
+  {
+    if(begins[chunk] == k_NoBoundary)
+    {
+      continue;
+    }
+    if(!chunks.empty())
+    {
+      chunks.back().End = begins[chunk];
+    }
+    chunks.push_back({begins[chunk], text.size(), 0});
+  }
+  if(chunks.back().Begin == text.size())
+  {
+    chunks.pop_back();
+  }
+  return chunks;
+}
+} // namespace
+
+namespace complex
+{
+namespace TextIngestion
+{
+// -----------------------------------------------------------------------------
+std::vector<LineChunk> SplitIntoLineChunks(std::string_view text, usize chunkSize)
+{
+  std::vector<LineChunk> chunks = SplitAtBoundaries(text, chunkSize, [](const char* first, usize length) { return static_cast<const char*>(std::memchr(first, '\n', length)); });
+
+  std::vector<usize> lineCounts(chunks.size() + 1, 0);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, chunks.size());
+  dataAlg.execute([&](const Range& range) {
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      lineCounts[chunk + 1] = std::count(text.data() + chunks[chunk].Begin, text.data() + chunks[chunk].End, '\n');
+    }
+  });
+  std::partial_sum(lineCounts.begin(), lineCounts.end(), lineCounts.begin());
+  for(usize chunk = 0; chunk < chunks.size(); chunk++)
+  {
+    chunks[chunk].FirstLine = lineCounts[chunk];
+  }
+  return chunks;
+}
+
+// -----------------------------------------------------------------------------
+std::vector<LineChunk> SplitIntoValueChunks(std::string_view text, usize chunkSize, char separator)
+{
+  return SplitAtBoundaries(text, chunkSize, [separator](const char* first, usize length) {
+    const char* last = first + length;
+    const char* boundary = std::find_if(first, last, [separator](char character) { return IsValueSeparator(character, separator); });
+    return boundary == last ? nullptr : boundary;
+  });
+}
+
+// -----------------------------------------------------------------------------
+usize CountLines(std::string_view text, const std::vector<LineChunk>& chunks)
+{
+  if(chunks.empty())
+  {
+    return 0;
+  }
+  const LineChunk& lastChunk = chunks.back();
+  const usize lastChunkLines = std::count(text.data() + lastChunk.Begin, text.data() + lastChunk.End, '\n');
+  const bool unterminatedLine = text.back() != '\n';
+  return lastChunk.FirstLine + lastChunkLines + (unterminatedLine ? 1 : 0);
+}
+
+// -----------------------------------------------------------------------------
+void SplitLine(std::string_view line, nonstd::span<const char> delimiters, bool consecutiveDelimiters, std::vector<std::string_view>& tokens)
+{
+  tokens.clear();
+  const std::string_view delimiterView(delimiters.data(), delimiters.size());
+  usize tokenBegin = 0;
+  while(true)
+  {
+    const usize tokenEnd = std::min(line.find_first_of(delimiterView, tokenBegin), line.size());
+    // Empty ranges between two delimiters are never tokens, as in StringUtilities::split
+    if(tokenEnd > tokenBegin)
+    {
+      std::string_view token = Trim(line.substr(tokenBegin, tokenEnd - tokenBegin));
+      if(!token.empty() || !consecutiveDelimiters)
+      {
+        tokens.push_back(token);
+      }
+    }
+    if(tokenEnd == line.size())
+    {
+      break;
+    }
+    tokenBegin = tokenEnd + 1;
+  }
+}
+} // namespace TextIngestion
+} // namespace complex
@@ -0,0 +1,249 @@
+#pragma once
+
+#include "complex/Common/Types.hpp"
+#include "complex/complex_export.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace complex
+{
+/**
+ * @brief Building blocks for reading large delimited text files in parallel. The file
+ * is split into chunks of whole lines that can be tokenized and parsed independently,
+ * and tokens are views into the file that are converted with std::from_chars.
+ */
+namespace TextIngestion
+{
+/**
+ * @brief A byte range of the text that starts at the beginning of a line and ends
+ * after the end of a line. FirstLine is the zero based number of its first line.
+ * Chunks from SplitIntoValueChunks start and end at value boundaries instead.
+ */
+struct COMPLEX_EXPORT LineChunk
+{
+  usize Begin = 0;
+  usize End = 0;
+  usize FirstLine = 0;
+};
+
+/**
+ * @brief Splits the text into chunks of about chunkSize bytes that only hold whole
+ * lines. The chunk boundaries and line numbers are found in parallel. A line longer
+ * than chunkSize is kept whole in one chunk.
+ * @param text
+ * @param chunkSize
+ * @return std::vector<LineChunk> The non empty chunks in order
+ */
+COMPLEX_EXPORT std::vector<LineChunk> SplitIntoLineChunks(std::string_view text, usize chunkSize);
+
+/**
+ * @brief Returns true if the character separates values, which is the separator or any
+ * white space.
+ * @param character
+ * @param separator
+ * @return bool
+ */
+inline bool IsValueSeparator(char character, char separator)
+{
+  return character == separator || character == ' ' || character == '\t' || character == '\n' || character == '\r' || character == '\f' || character == '\v';
+}
+
+/**
+ * @brief Splits the text into chunks of about chunkSize bytes that only hold whole values
+ * for ForEachValueToken. Chunks start after any separator or white space, so text with
+ * few or no line endings is still split. FirstLine is not set.
+ * @param text
+ * @param chunkSize
+ * @param separator
+ * @return std::vector<LineChunk> The non empty chunks in order
+ */
+COMPLEX_EXPORT std::vector<LineChunk> SplitIntoValueChunks(std::string_view text, usize chunkSize, char separator);
+
+/**
+ * @brief Returns the number of lines in the text. A final line without a line ending is counted.
+ * @param text
+ * @param chunks The chunks of the text
+ * @return usize
+ */
+COMPLEX_EXPORT usize CountLines(std::string_view text, const std::vector<LineChunk>& chunks);
+
+/**
+ * @brief Calls lineFunction(lineNumber, line) for each line of the chunk until it returns
+ * false. The line ending, including a carriage return, is not part of the line.
+ * @param text
+ * @param chunk
+ * @param lineFunction
+ */
+template <class LineFunction>
+void ForEachLine(std::string_view text, const LineChunk& chunk, LineFunction&& lineFunction)
+{
+  usize lineNumber = chunk.FirstLine;
+  usize position = chunk.Begin;
+  while(position < chunk.End)
+  {
+    const char* lineBegin = text.data() + position;
+    const auto* lineEnd = static_cast<const char*>(std::memchr(lineBegin, '\n', chunk.End - position));
+    const usize lineLength = lineEnd == nullptr ? chunk.End - position : static_cast<usize>(lineEnd - lineBegin);
+    std::string_view line(lineBegin, lineLength);
+    if(!line.empty() && line.back() == '\r')
+    {
+      line.remove_suffix(1);
+    }
+    if(!lineFunction(lineNumber, line))
+    {
+      return;
+    }
+    position += lineLength + 1;
+    lineNumber++;
+  }
+}
+
+/**
+ * @brief Splits the line at each of the delimiters the same way as StringUtilities::split,
+ * but the tokens are trimmed views into the line. The tokens are cleared first so that
+ * the vector can be reused for every line without allocating.
+ * @param line
+ * @param delimiters
+ * @param consecutiveDelimiters Drops tokens that are empty after trimming
+ * @param tokens
+ */
+COMPLEX_EXPORT void SplitLine(std::string_view line, nonstd::span<const char> delimiters, bool consecutiveDelimiters, std::vector<std::string_view>& tokens);
+
+/**
+ * @brief Calls tokenFunction(token) for each run of characters that are neither
+ * separators nor white space until it returns false.
+ * @param text
+ * @param separator
+ * @param tokenFunction
+ */
+template <class TokenFunction>
+void ForEachValueToken(std::string_view text, char separator, TokenFunction&& tokenFunction)
+{
+  const auto isSeparator = [separator](char character) { return IsValueSeparator(character, separator); };
+  usize position = 0;
+  while(position < text.size())
+  {
+    while(position < text.size() && isSeparator(text[position]))
+    {
+      position++;
+    }
+    const usize tokenBegin = position;
+    while(position < text.size() && !isSeparator(text[position]))
+    {
+      position++;
+    }
+    if(position > tokenBegin && !tokenFunction(text.substr(tokenBegin, position - tokenBegin)))
+    {
+      return;
+    }
+  }
+}
+
+namespace detail
+{
+template <class T>
+std::errc ParseFloatingPoint(std::string_view token, T& value)
+{
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  const std::from_chars_result result = std::from_chars(token.data(), token.data() + token.size(), value);
+  return result.ec;
+#else
+  // Standard libraries without floating point from_chars parse a terminated copy of the token
+  std::array<char, 128> buffer = {};
+  if(token.size() >= buffer.size())
+  {
+    return std::errc::invalid_argument;
+  }
+  std::copy(token.cbegin(), token.cend(), buffer.begin());
+  char* end = nullptr;
+  errno = 0;
+  if constexpr(std::is_same_v<T, float32>)
+  {
+    value = std::strtof(buffer.data(), &end);
+  }
+  else
+  {
+    value = std::strtod(buffer.data(), &end);
+  }
+  if(end == buffer.data())
+  {
+    return std::errc::invalid_argument;
+  }
+  return errno == ERANGE ? std::errc::result_out_of_range : std::errc{};
+#endif
+}
+} // namespace detail
+
+/**
+ * @brief Converts the leading number of the token. A leading '+' is accepted, unsigned
+ * types reject negative numbers and values outside of the range of T are reported as
+ * std::errc::result_out_of_range.
+ *
+ * This differs from ConvertTo<T> for floating point types: std::from_chars does not
+ * accept hexadecimal floats ("0x1p3") that std::stof/std::stod accept, and it ignores
+ * the locale. Where floating point from_chars is unavailable the strtof/strtod fallback
+ * follows the current C locale, as std::stof/std::stod do.
+ * @tparam T Integer or floating point type
+ * @param token
+ * @param value
+ * @return std::errc std::errc{} on success
+ */
+template <class T>
+std::errc ParseNumber(std::string_view token, T& value)
+{
+  if(!token.empty() && token.front() == '+')
+  {
+    token.remove_prefix(1);
+    if(!token.empty() && token.front() == '-')
+    {
+      return std::errc::invalid_argument;
+    }
+  }
+  if(token.empty())
+  {
+    return std::errc::invalid_argument;
+  }
+
+  if constexpr(std::is_floating_point_v<T>)
+  {
+    return detail::ParseFloatingPoint(token, value);
+  }
+  else
+  {
+    if constexpr(std::is_unsigned_v<T>)
+    {
+      if(token.front() == '-')
+      {
+        return std::errc::result_out_of_range;
+      }
+    }
+    using ParseType = std::conditional_t<std::is_signed_v<T>, int64, uint64>;
+    ParseType parsedValue = 0;
+    const std::from_chars_result result = std::from_chars(token.data(), token.data() + token.size(), parsedValue);
+    if(result.ec != std::errc{})
+    {
+      return result.ec;
+    }
+    if(parsedValue < static_cast<ParseType>(std::numeric_limits<T>::min()) || parsedValue > static_cast<ParseType>(std::numeric_limits<T>::max()))
+    {
+      return std::errc::result_out_of_range;
+    }
+    value = static_cast<T>(parsedValue);
+    return std::errc{};
+  }
+}
+} // namespace TextIngestion
+} // namespace complex
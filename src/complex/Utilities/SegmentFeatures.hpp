@@ -4,9 +4,11 @@
 
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStructure.hpp"
+#include "complex/DataStructure/Geometry/IGridGeometry.hpp"
 #include "complex/DataStructure/IDataArray.hpp"
 #include "complex/Filter/Arguments.hpp"
 #include "complex/Filter/IFilter.hpp"
+#include "complex/Utilities/GridLabeling.hpp"
 
 #include <random>
 #include <vector>
@@ -14,8 +16,6 @@
 namespace complex
 {
 
-class IGridGeometry;
-
 class COMPLEX_EXPORT SegmentFeatures
 {
 
@@ -39,6 +39,30 @@ public:
    */
   Result<> execute(IGridGeometry* gridGeom);
 
+  /**
+   * @brief Segments the grid in parallel with a block decomposed union-find instead
+   * of the seed based flood fill used by execute(). Features are numbered from 1 in
+   * the order of their first point, which gives the same feature ids as execute().
+   * Points that are not included are set to 0.
+   *
+   * The comparator must be symmetric. Both functors are called concurrently and
+   * are passed by template so that they can be inlined.
+   * @tparam IncludeFunctor bool(usize index)
+   * @tparam CompareFunctorType bool(usize referencePoint, usize neighborPoint)
+   * @param gridGeom
+   * @param featureIds
+   * @param include Returns true if the point can be part of a feature
+   * @param compare Returns true if the two neighboring points belong to the same feature
+   * @return usize The number of features found
+   */
+  template <class IncludeFunctor, class CompareFunctorType>
+  usize executeParallel(const IGridGeometry& gridGeom, AbstractDataStore<int32>& featureIds, const IncludeFunctor& include, const CompareFunctorType& compare)
+  {
+    usize numFeatures = GridLabeling::LabelConnectedComponents(gridGeom.getDimensions(), featureIds, include, compare, m_ShouldCancel);
+    m_MessageHandler({IFilter::Message::Type::Info, fmt::format("Total Features Found: {}", numFeatures)});
+    return numFeatures;
+  }
+
   /**
    * @brief Returns the seed for the specified values.
    * @param data
@@ -62,4 +62,18 @@ TEST_CASE("BitTest")
     constexpr uint64 swapped = byteswap(original);
     REQUIRE(swapped == expected);
   }
+  SECTION("popcount64")
+  {
+    REQUIRE(popcount64(0) == 0);
+    REQUIRE(popcount64(0x8000000000000001ull) == 2);
+    REQUIRE(popcount64(0xFFFFFFFFFFFFFFFFull) == 64);
+    REQUIRE(popcount64(0x0F0F0F0F0F0F0F0Full) == 32);
+  }
+  SECTION("countr_zero64")
+  {
+    REQUIRE(countr_zero64(0) == 64);
+    REQUIRE(countr_zero64(1) == 0);
+    REQUIRE(countr_zero64(0x8000000000000000ull) == 63);
+    REQUIRE(countr_zero64(0x0000000000F00000ull) == 20);
+  }
 }
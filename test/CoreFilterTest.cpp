@@ -127,6 +127,54 @@ TEST_CASE("RunCoreFilter")
   }
 }
 
+TEST_CASE("RunCoreFilter Single Line")
+{
+  static const fs::path k_FileName = fmt::format("{}/test/data/ascii_single_line.txt", complex::unit_test::k_BuildDir);
+  // Large enough for several parse chunks on a line without a line ending
+  static constexpr int32 k_NValues = 400000;
+
+  SECTION("Create ASCII File")
+  {
+    std::ofstream file(k_FileName.c_str());
+    for(int32 i = 0; i < k_NValues; i++)
+    {
+      file << i << (i + 1 < k_NValues ? "," : "");
+    }
+  }
+  SECTION("Run ImportTextFilter")
+  {
+    ImportTextFilter filter;
+    DataStructure ds;
+    Arguments args;
+    DataPath dataPath({"foo"});
+
+    args.insert("input_file", std::make_any<fs::path>(k_FileName));
+    args.insert("scalar_type", std::make_any<NumericType>(NumericType::int32));
+    args.insert("n_tuples", std::make_any<uint64>(k_NValues));
+    args.insert("n_comp", std::make_any<uint64>(1));
+    args.insert("n_skip_lines", std::make_any<uint64>(0));
+    args.insert("delimiter_choice", std::make_any<uint64>(0));
+    args.insert("output_data_array", std::make_any<DataPath>(dataPath));
+
+    IFilter::ExecuteResult result = filter.execute(ds, args);
+    if(result.result.invalid())
+    {
+      for(const auto& error : result.result.errors())
+      {
+        UNSCOPED_INFO(fmt::format("Error {}: {}", error.code, error.message));
+      }
+    }
+    REQUIRE(result.result.valid());
+    const auto* dataArrayPtr = dynamic_cast<DataArray<int32>*>(ds.getData(dataPath));
+    REQUIRE(dataArrayPtr != nullptr);
+    const auto& dataArray = *dataArrayPtr;
+    for(int32 i = 0; i < k_NValues; i++)
+    {
+      REQUIRE(dataArray[i] == i);
+    }
+  }
+}
+
 TEST_CASE("CreateDataGroup")
 {
   DataStructure data;
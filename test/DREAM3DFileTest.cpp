@@ -356,3 +356,36 @@ TEST_CASE("Import/Export Multi-DREAM3D Filter Test")
   REQUIRE(importDataStructure.getData(DataPath({DataNames::k_Group1Name})) != nullptr);
   REQUIRE(importDataStructure.getData(DataPath({DataNames::k_Group2Name})) != nullptr);
 }
+
+TEST_CASE("Import DREAM3D Filter Sub-Volume Test")
+{
+  Application app;
+  fs::path pluginPath = complex::unit_test::k_BuildDir.str();
+  app.loadPlugins(pluginPath, false);
+
+  std::lock_guard<std::mutex> lock(m_DataMutex);
+
+  auto exportPipeline = CreateExportPipeline();
+  REQUIRE(exportPipeline.execute());
+
+  auto filter = app.getFilterList()->createFilter(k_ImportD3DHandle);
+  REQUIRE(filter != nullptr);
+  const Parameters parameters = filter->parameters();
+  REQUIRE(parameters.contains("Import_Sub_Volume"));
+  REQUIRE(parameters.contains("Min_Voxel"));
+  REQUIRE(parameters.contains("Max_Voxel"));
+
+  Arguments args;
+  Dream3dImportParameter::ImportData importData;
+  importData.FilePath = GetExportDataPath();
+  importData.DataPaths = std::vector<DataPath>{DataPath({DataNames::k_Group1Name})};
+  args.insert("Import_File_Data", importData);
+  args.insert("Import_Sub_Volume", std::make_any<bool>(true));
+  args.insert("Min_Voxel", std::make_any<std::vector<uint64>>(std::vector<uint64>{2, 0, 0}));
+  args.insert("Max_Voxel", std::make_any<std::vector<uint64>>(std::vector<uint64>{1, 0, 0}));
+
+  // The Min Voxel is past the Max Voxel in X
+  DataStructure dataStructure;
+  auto preflightResult = filter->preflight(dataStructure, args);
+  REQUIRE(preflightResult.outputActions.invalid());
+}
@@ -1,15 +1,25 @@
+#include <filesystem>
 #include <memory>
+#include <numeric>
+#include <thread>
 #include <vector>
 
 #include <catch2/catch.hpp>
 
 #include "complex/Common/Types.hpp"
+#include "complex/DataStructure/BitDataStore.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/DataStructure.hpp"
+#include "complex/DataStructure/NeighborList.hpp"
+#include "complex/DataStructure/OutOfCoreDataStore.hpp"
+#include "complex/DataStructure/StringArray.hpp"
+#include "complex/Filter/Actions/CreateArrayAction.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5FileReader.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5FileWriter.hpp"
 
 using namespace complex;
 
@@ -97,3 +107,426 @@ TEST_CASE("DataStore Test")
   REQUIRE(dataStore[8] == 99);
   REQUIRE(dataStore.getComponentValue(2, 2) == 99);
 }
+
+TEST_CASE("OutOfCoreDataStore Test", "[complex][DataArray]")
+{
+  const IDataStore::ShapeType tupleShape{7, 5};
+  const IDataStore::ShapeType componentShape{3};
+  const usize k_ChunkSize = 8;
+  const usize k_MaxCachedChunks = 2;
+
+  fs::path backingFilePath;
+  {
+    OutOfCoreDataStore<int32> dataStore(tupleShape, componentShape, 5, fs::temp_directory_path(), k_ChunkSize, k_MaxCachedChunks);
+    backingFilePath = dataStore.getFilePath();
+    REQUIRE(dataStore.getStoreType() == IDataStore::StoreType::OutOfCore);
+    REQUIRE(dataStore.getSize() == 105);
+    REQUIRE(fs::exists(backingFilePath));
+
+    // Values that were never written read back as the initial value
+    REQUIRE(dataStore[104] == 5);
+
+    // Touch every chunk several times so that chunks are evicted and read back from disk
+    for(usize i = 0; i < dataStore.getSize(); i++)
+    {
+      dataStore[i] = static_cast<int32>(i);
+    }
+    for(usize i = 0; i < dataStore.getSize(); i++)
+    {
+      REQUIRE(dataStore.getValue(i) == static_cast<int32>(i));
+    }
+
+    std::vector<int32> buffer(20);
+    dataStore.copyIntoBuffer(30, nonstd::span<int32>(buffer.data(), buffer.size()));
+    for(usize i = 0; i < buffer.size(); i++)
+    {
+      REQUIRE(buffer[i] == static_cast<int32>(30 + i));
+    }
+
+    auto copy = dataStore.deepCopy();
+    auto& copiedStore = dynamic_cast<OutOfCoreDataStore<int32>&>(*copy);
+    REQUIRE(copiedStore.getFilePath() != backingFilePath);
+    copiedStore.setValue(0, -1);
+    REQUIRE(dataStore[0] == 0);
+    for(usize i = 1; i < copiedStore.getSize(); i++)
+    {
+      REQUIRE(copiedStore[i] == static_cast<int32>(i));
+    }
+
+    dataStore.reshapeTuples({10, 5});
+    REQUIRE(dataStore.getSize() == 150);
+    REQUIRE(dataStore[104] == 104);
+
+    // A reference stays valid while other threads page every chunk in and out
+    int32& pinnedValue = dataStore[0];
+    std::thread otherThread([&dataStore]() {
+      for(usize i = 1; i < dataStore.getSize(); i++)
+      {
+        dataStore[i] += 1;
+      }
+    });
+    otherThread.join();
+    pinnedValue = -7;
+    for(usize i = 0; i < dataStore.getSize(); i++)
+    {
+      REQUIRE(dataStore.getValue(i) == (i == 0 ? -7 : static_cast<int32>(i < 105 ? i + 1 : 6)));
+    }
+
+    // Chunks are visited in place and may be written to
+    dataStore.visitChunks(10, 100, [](usize index, nonstd::span<int32> values) {
+      for(usize i = 0; i < values.size(); i++)
+      {
+        values[i] = static_cast<int32>(2 * (index + i));
+      }
+    });
+    int64 sum = 0;
+    dataStore.visitConstChunks(10, 100, [&sum](usize, nonstd::span<const int32> values) { sum = std::accumulate(values.begin(), values.end(), sum); });
+    REQUIRE(sum == 2 * ((109 * 110) / 2 - (9 * 10) / 2));
+
+    // Copying within the same store to a later, overlapping position keeps every value
+    for(usize i = 0; i < dataStore.getSize(); i++)
+    {
+      dataStore[i] = static_cast<int32>(i);
+    }
+    REQUIRE(dataStore.copyFrom(5, dataStore, 0, 25));
+    for(usize i = 0; i < dataStore.getSize(); i++)
+    {
+      const usize expected = (i >= 15 && i < 90) ? i - 15 : i;
+      REQUIRE(dataStore.getValue(i) == static_cast<int32>(expected));
+    }
+
+    dataStore.fill(3);
+    for(usize i = 0; i < dataStore.getSize(); i++)
+    {
+      REQUIRE(dataStore[i] == 3);
+    }
+
+    // Values removed by shrinking, including those in the chunk the new end cuts through, come back as the fill value when growing
+    for(usize i = 0; i < dataStore.getSize(); i++)
+    {
+      dataStore[i] = static_cast<int32>(i);
+    }
+    dataStore.reshapeTuples({4, 5});
+    REQUIRE(dataStore.getSize() == 60);
+    dataStore.reshapeTuples({10, 5});
+    for(usize i = 0; i < dataStore.getSize(); i++)
+    {
+      REQUIRE(dataStore[i] == (i < 60 ? static_cast<int32>(i) : 3));
+    }
+  }
+  REQUIRE_FALSE(fs::exists(backingFilePath));
+}
+
+TEST_CASE("OutOfCoreDataStore HDF5 Test", "[complex][DataArray]")
+{
+  const IDataStore::ShapeType tupleShape{4, 6, 5};
+  const IDataStore::ShapeType componentShape{3};
+  OutOfCoreDataStore<float32> dataStore(tupleShape, componentShape, 0.0f, fs::temp_directory_path(), 10, 3);
+  for(usize i = 0; i < dataStore.getSize(); i++)
+  {
+    dataStore[i] = static_cast<float32>(i) * 0.5f;
+  }
+
+  const fs::path filePath = fs::temp_directory_path() / "OutOfCoreDataStoreTest.h5";
+  {
+    Result<H5::FileWriter> result = H5::FileWriter::CreateFile(filePath);
+    REQUIRE(result.valid());
+    H5::FileWriter fileWriter = std::move(result.value());
+    auto datasetWriter = fileWriter.createDatasetWriter("Data");
+    REQUIRE(dataStore.writeHdf5(datasetWriter) >= 0);
+  }
+  {
+    H5::FileReader fileReader(filePath);
+    REQUIRE(fileReader.isValid());
+    auto datasetReader = fileReader.openDataset("Data");
+    auto readStore = DataStore<float32>::ReadHdf5(datasetReader);
+    REQUIRE(readStore->getTupleShape() == tupleShape);
+    REQUIRE(readStore->getComponentShape() == componentShape);
+    for(usize i = 0; i < dataStore.getSize(); i++)
+    {
+      REQUIRE(readStore->getValue(i) == dataStore.getValue(i));
+    }
+  }
+  fs::remove(filePath);
+}
+
+TEST_CASE("CreateDataStore OutOfCore Threshold", "[complex][DataArray]")
+{
+  const OutOfCoreOptions originalOptions = GetOutOfCoreOptions();
+  REQUIRE(CreateDataStore<int32>({10}, {1}, IDataAction::Mode::Execute)->getStoreType() == IDataStore::StoreType::InMemory);
+
+  OutOfCoreOptions options = originalOptions;
+  options.thresholdBytes = 40;
+  options.chunkSize = 4;
+  SetOutOfCoreOptions(options);
+  REQUIRE(CreateDataStore<int32>({9}, {1}, IDataAction::Mode::Execute)->getStoreType() == IDataStore::StoreType::InMemory);
+  auto dataStore = CreateDataStore<int32>({10}, {1}, IDataAction::Mode::Execute);
+  REQUIRE(dataStore->getStoreType() == IDataStore::StoreType::OutOfCore);
+  REQUIRE(dynamic_cast<OutOfCoreDataStore<int32>&>(*dataStore).getChunkSize() == 4);
+  REQUIRE(CreateDataStore<int32>({10}, {1}, IDataAction::Mode::Preflight)->getStoreType() == IDataStore::StoreType::Empty);
+
+  SetOutOfCoreOptions(originalOptions);
+}
+
+TEST_CASE("CreateDataStore Allocation Policy", "[complex][DataArray]")
+{
+  const AllocationOptions originalOptions = GetAllocationOptions();
+
+  // Force the parallel fill and huge page advice paths on a buffer spanning several huge pages
+  AllocationOptions options = originalOptions;
+  options.parallelFillBytes = 0;
+  options.hugePages = true;
+  SetAllocationOptions(options);
+
+  const usize numValues = 3 * 1024 * 1024 + 7;
+  auto zeroedStore = CreateDataStore<float32>({numValues}, {1}, IDataAction::Mode::Execute);
+  REQUIRE(zeroedStore->getStoreType() == IDataStore::StoreType::InMemory);
+  const auto& zeroedData = dynamic_cast<const DataStore<float32>&>(*zeroedStore);
+  REQUIRE(std::all_of(zeroedData.data(), zeroedData.data() + numValues, [](float32 value) { return value == 0.0f; }));
+
+  auto uninitializedStore = CreateDataStore<int32>({10}, {3}, IDataAction::Mode::Execute, false, AllocationPolicy::Uninitialized);
+  REQUIRE(uninitializedStore->getStoreType() == IDataStore::StoreType::InMemory);
+  REQUIRE(uninitializedStore->getSize() == 30);
+
+  std::vector<uint8> buffer(1000, 1);
+  ParallelZeroFill(buffer.data(), buffer.size(), 0);
+  REQUIRE(std::all_of(buffer.cbegin(), buffer.cend(), [](uint8 value) { return value == 0; }));
+
+  // Blocks follow the huge page boundaries of the buffer, not its start, and stay inside it
+  std::vector<uint8> largeBuffer(5 * 1024 * 1024 + 10, 1);
+  ParallelZeroFill(largeBuffer.data() + 3, largeBuffer.size() - 6, 0);
+  REQUIRE(std::all_of(largeBuffer.cbegin(), largeBuffer.cbegin() + 3, [](uint8 value) { return value == 1; }));
+  REQUIRE(std::all_of(largeBuffer.cbegin() + 3, largeBuffer.cend() - 3, [](uint8 value) { return value == 0; }));
+  REQUIRE(std::all_of(largeBuffer.cend() - 3, largeBuffer.cend(), [](uint8 value) { return value == 1; }));
+
+  SetAllocationOptions(originalOptions);
+}
+
+TEST_CASE("DataStore Memory Usage", "[complex][DataArray]")
+{
+  REQUIRE(CreateDataStore<int32>({10}, {3}, IDataAction::Mode::Execute)->getMemoryUsage() == 120);
+  REQUIRE(CreateDataStore<int32>({10}, {3}, IDataAction::Mode::Preflight)->getMemoryUsage() == 120);
+  REQUIRE(CreateDataStore<bool>({100}, {1}, IDataAction::Mode::Execute, true)->getMemoryUsage() == 16);
+  REQUIRE(CreateDataStore<bool>({100}, {1}, IDataAction::Mode::Preflight, true)->getMemoryUsage() == 16);
+  REQUIRE(CreateArrayAction(DataType::boolean, {100}, {1}, DataPath({"Mask"}), true).projectedMemoryUsage() == 16);
+  REQUIRE(CreateArrayAction(DataType::float64, {10}, {2}, DataPath({"Array"})).projectedMemoryUsage() == 160);
+
+  // Out of core stores only hold their chunk cache in memory
+  const OutOfCoreOptions originalOptions = GetOutOfCoreOptions();
+  OutOfCoreOptions options = originalOptions;
+  options.thresholdBytes = 40;
+  options.chunkSize = 4;
+  options.maxCachedChunks = 2;
+  SetOutOfCoreOptions(options);
+  REQUIRE(CreateDataStore<int32>({10}, {1}, IDataAction::Mode::Preflight)->getMemoryUsage() == 32);
+  auto outOfCoreStore = CreateDataStore<int32>({10}, {1}, IDataAction::Mode::Execute);
+  REQUIRE(outOfCoreStore->getStoreType() == IDataStore::StoreType::OutOfCore);
+  for(usize i = 0; i < 10; i++)
+  {
+    outOfCoreStore->setValue(i, static_cast<int32>(i));
+  }
+  REQUIRE(outOfCoreStore->getMemoryUsage() == 32);
+  SetOutOfCoreOptions(originalOptions);
+
+  // Arrays sharing a DataStore are only counted once
+  DataStructure dataStructure;
+  auto* dataArray = UnitTest::CreateTestDataArray<float32>(dataStructure, "Array", {25}, {1});
+  UnitTest::CreateTestDataArray<uint8>(dataStructure, "Bytes", {10}, {1});
+  REQUIRE(dataStructure.getMemoryUsage() == 110);
+  auto* group = DataGroup::Create(dataStructure, "Group");
+  REQUIRE(dataStructure.setAdditionalParent(dataArray->getId(), group->getId()));
+  REQUIRE(dataStructure.getMemoryUsage() == 110);
+
+  // NeighborLists and StringArrays count the values they hold
+  auto* neighborList = NeighborList<int32>::Create(dataStructure, "Neighbors", 2);
+  neighborList->setList(0, std::make_shared<std::vector<int32>>(std::vector<int32>{1, 2}));
+  neighborList->setList(1, std::make_shared<std::vector<int32>>(std::vector<int32>{3, 4, 5}));
+  REQUIRE(neighborList->getMemoryUsage() == 20);
+  StringArray::CreateWithValues(dataStructure, "Strings", {"ab", "cde"});
+  REQUIRE(dataStructure.getMemoryUsage() == 110 + 20 + 2 * sizeof(std::string) + 5);
+}
+
+TEST_CASE("BitDataStore Test", "[complex][DataArray]")
+{
+  const IDataStore::ShapeType tupleShape{10000};
+  const IDataStore::ShapeType componentShape{1};
+  BitDataStore dataStore(tupleShape, componentShape, false);
+  REQUIRE(dataStore.getSize() == 10000);
+  REQUIRE(dataStore.getNumberOfWords() == 157);
+  REQUIRE(dataStore.countTrue() == 0);
+  REQUIRE(dataStore.findNextTrue(0) == BitDataStore::k_NotFound);
+
+  for(usize i = 0; i < dataStore.getSize(); i += 3)
+  {
+    dataStore.setValue(i, true);
+  }
+  REQUIRE(dataStore.countTrue() == 3334);
+  REQUIRE(dataStore.findNextTrue(1) == 3);
+  REQUIRE(dataStore.findNextTrue(9999) == 9999);
+
+  // Writes through references land in windows and are visible to every accessor
+  for(usize i = 0; i < dataStore.getSize(); i += 5)
+  {
+    dataStore[i] = !dataStore[i];
+  }
+  for(usize i = 0; i < dataStore.getSize(); i++)
+  {
+    const bool expected = (i % 3 == 0) != (i % 5 == 0);
+    REQUIRE(dataStore.getValue(i) == expected);
+  }
+  const auto& constStore = dataStore;
+  REQUIRE_FALSE(constStore[15]);
+  REQUIRE(constStore.at(9) == true);
+  REQUIRE_THROWS(constStore.at(10000));
+
+  // Const readers see the values held in windows without closing them, so several
+  // threads can read the store at once
+  const usize expectedTrue = 3334 + 2000 - 2 * 667;
+  const usize memoryUsage = constStore.getMemoryUsage();
+  REQUIRE(memoryUsage > constStore.getNumberOfWords() * sizeof(BitDataStore::WordType));
+  std::vector<usize> counts(4, 0);
+  std::vector<std::thread> readers;
+  for(usize thread = 0; thread < counts.size(); thread++)
+  {
+    readers.emplace_back([&constStore, &counts, thread]() {
+      auto buffer = std::make_unique<bool[]>(constStore.getSize());
+      constStore.copyIntoBuffer(0, nonstd::span<bool>(buffer.get(), constStore.getSize()));
+      counts[thread] = static_cast<usize>(std::count(buffer.get(), buffer.get() + constStore.getSize(), true));
+      if(constStore.countTrue() != counts[thread] || constStore.findNextTrue(4) != 5)
+      {
+        counts[thread] = 0;
+      }
+    });
+  }
+  for(auto& reader : readers)
+  {
+    reader.join();
+  }
+  REQUIRE(counts == std::vector<usize>(counts.size(), expectedTrue));
+  REQUIRE(constStore.getMemoryUsage() == memoryUsage);
+
+  auto copy = dataStore.deepCopy();
+  auto& copiedStore = dynamic_cast<BitDataStore&>(*copy);
+  copiedStore.flip();
+  REQUIRE(copiedStore.countTrue() == dataStore.getSize() - dataStore.countTrue());
+  copiedStore.andWith(dataStore);
+  REQUIRE(copiedStore.countTrue() == 0);
+  copiedStore.orWith(dataStore);
+  REQUIRE(copiedStore.countTrue() == dataStore.countTrue());
+  copiedStore.xorWith(dataStore);
+  REQUIRE(copiedStore.findNextTrue(0) == BitDataStore::k_NotFound);
+
+  std::vector<bool> values(130, true);
+  values[65] = false;
+  std::unique_ptr<bool[]> valueBuffer = std::make_unique<bool[]>(values.size());
+  std::copy(values.begin(), values.end(), valueBuffer.get());
+  copiedStore.copyFromBuffer(37, nonstd::span<const bool>(valueBuffer.get(), values.size()));
+  REQUIRE(copiedStore.countTrue() == 129);
+  REQUIRE(copiedStore.findNextTrue(0) == 37);
+  REQUIRE(copiedStore.getValue(37 + 65) == false);
+
+  BitDataStore otherSize({10}, {1}, false);
+  REQUIRE_THROWS(copiedStore.andWith(otherSize));
+
+  dataStore.reshapeTuples({70});
+  REQUIRE(dataStore.getNumberOfWords() == 2);
+  dataStore.fill(true);
+  REQUIRE(dataStore.countTrue() == 70);
+  dataStore.reshapeTuples({100});
+  REQUIRE(dataStore.countTrue() == 70);
+  REQUIRE(dataStore.findNextTrue(70) == BitDataStore::k_NotFound);
+}
+
+TEST_CASE("BitDataStore HDF5 Test", "[complex][DataArray]")
+{
+  const IDataStore::ShapeType tupleShape{3, 50};
+  const IDataStore::ShapeType componentShape{2};
+  BitDataStore dataStore(tupleShape, componentShape, false);
+  for(usize i = 0; i < dataStore.getSize(); i++)
+  {
+    dataStore.setValue(i, (i % 7) < 3);
+  }
+
+  const fs::path filePath = fs::temp_directory_path() / "BitDataStoreTest.h5";
+  {
+    Result<H5::FileWriter> result = H5::FileWriter::CreateFile(filePath);
+    REQUIRE(result.valid());
+    H5::FileWriter fileWriter = std::move(result.value());
+    auto datasetWriter = fileWriter.createDatasetWriter("Data");
+    REQUIRE(dataStore.writeHdf5(datasetWriter) >= 0);
+  }
+  {
+    H5::FileReader fileReader(filePath);
+    REQUIRE(fileReader.isValid());
+    auto datasetReader = fileReader.openDataset("Data");
+    auto readStore = DataStore<bool>::ReadHdf5(datasetReader);
+    REQUIRE(readStore->getTupleShape() == tupleShape);
+    REQUIRE(readStore->getComponentShape() == componentShape);
+    for(usize i = 0; i < dataStore.getSize(); i++)
+    {
+      REQUIRE(readStore->getValue(i) == dataStore.getValue(i));
+    }
+  }
+  fs::remove(filePath);
+
+  auto createdStore = CreateDataStore<bool>(tupleShape, componentShape, IDataAction::Mode::Execute, true);
+  REQUIRE(dynamic_cast<BitDataStore*>(createdStore.get()) != nullptr);
+  REQUIRE(dynamic_cast<BitDataStore*>(CreateDataStore<bool>(tupleShape, componentShape, IDataAction::Mode::Execute).get()) == nullptr);
+}
+
+TEST_CASE("DataStore Bulk Access Test", "[complex][DataArray]")
+{
+  const IDataStore::ShapeType tupleShape{10};
+  const IDataStore::ShapeType componentShape{2};
+  DataStore<int32> dataStore(tupleShape, componentShape, 0);
+  OutOfCoreDataStore<int32> outOfCoreStore(tupleShape, componentShape, 0, fs::temp_directory_path(), 3, 2);
+
+  for(AbstractDataStore<int32>* store : std::vector<AbstractDataStore<int32>*>{&dataStore, &outOfCoreStore})
+  {
+    std::vector<int32> values(store->getSize());
+    std::iota(values.begin(), values.end(), 0);
+    store->copyFromBuffer(0, nonstd::span<const int32>(values.data(), values.size()));
+
+    std::vector<int32> buffer(5);
+    store->copyIntoBuffer(7, nonstd::span<int32>(buffer.data(), buffer.size()));
+    for(usize i = 0; i < buffer.size(); i++)
+    {
+      REQUIRE(buffer[i] == static_cast<int32>(7 + i));
+    }
+    REQUIRE_THROWS(store->copyIntoBuffer(18, nonstd::span<int32>(buffer.data(), buffer.size())));
+
+    usize visitedCount = 0;
+    store->visitConstChunks(4, 12, [&visitedCount](usize index, nonstd::span<const int32> chunk) {
+      for(usize i = 0; i < chunk.size(); i++)
+      {
+        REQUIRE(chunk[i] == static_cast<int32>(index + i));
+      }
+      visitedCount += chunk.size();
+    });
+    REQUIRE(visitedCount == 12);
+
+    store->visitChunks(0, store->getSize(), [](usize index, nonstd::span<int32> chunk) {
+      for(usize i = 0; i < chunk.size(); i++)
+      {
+        chunk[i] = static_cast<int32>(index + i) * 2;
+      }
+    });
+    REQUIRE(store->getValue(19) == 38);
+
+    store->fillTuple(3, -1);
+    REQUIRE(store->getComponentValue(3, 0) == -1);
+    REQUIRE(store->getComponentValue(3, 1) == -1);
+    REQUIRE(store->getComponentValue(4, 0) == 16);
+  }
+
+  REQUIRE(dataStore.copyFrom(5, outOfCoreStore, 0, 5));
+  REQUIRE(dataStore.getComponentValue(8, 0) == -1);
+  REQUIRE(dataStore.getComponentValue(9, 1) == 18);
+  REQUIRE_FALSE(dataStore.copyFrom(0, outOfCoreStore, 8, 5));
+
+  // Overlapping copy within the same store
+  REQUIRE(dataStore.copyFrom(1, dataStore, 0, 4));
+  REQUIRE(dataStore.getComponentValue(1, 0) == 0);
+  REQUIRE(dataStore.getComponentValue(2, 1) == 6);
+  REQUIRE(dataStore.getComponentValue(4, 0) == -1);
+}
@@ -1,4 +1,7 @@
+#include <atomic>
 #include <memory>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <catch2/catch.hpp>
@@ -10,6 +13,7 @@
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/DataStructure.hpp"
+#include "complex/DataStructure/NeighborList.hpp"
 #include "complex/DataStructure/ScalarData.hpp"
 
 /**
@@ -340,6 +344,56 @@ TEST_CASE("DataArrayTest")
   }
 }
 
+TEST_CASE("DataArrayCopyOnWriteTest")
+{
+  DataStructure dataStr;
+  auto dataArr = Int32Array::CreateWithStore<Int32DataStore>(dataStr, "array", {10}, {1});
+  REQUIRE(dataArr != nullptr);
+  dataArr->fill(5);
+  const auto arrayId = dataArr->getId();
+
+  DataStructure dataStrCopy(dataStr);
+  auto& originalArray = dataStr.getDataRefAs<Int32Array>(arrayId);
+  auto& copiedArray = dataStrCopy.getDataRefAs<Int32Array>(arrayId);
+
+  // Copies share the same store until one of them is written to
+  const auto& constCopy = copiedArray;
+  REQUIRE(constCopy.getDataStore() == std::as_const(originalArray).getDataStore());
+  REQUIRE(copiedArray.isDataStoreShared());
+  REQUIRE(originalArray.isDataStoreShared());
+
+  // Const access does not copy the store
+  REQUIRE(constCopy[3] == 5);
+  REQUIRE(constCopy.isDataStoreShared());
+
+  copiedArray[3] = 42;
+  REQUIRE_FALSE(copiedArray.isDataStoreShared());
+  REQUIRE(constCopy.getDataStore() != std::as_const(originalArray).getDataStore());
+  REQUIRE(copiedArray[3] == 42);
+  REQUIRE(std::as_const(originalArray)[3] == 5);
+
+  // The original is the sole owner now so writing to it does not copy again
+  const auto* originalStore = std::as_const(originalArray).getDataStore();
+  originalArray.fill(7);
+  REQUIRE(std::as_const(originalArray).getDataStore() == originalStore);
+  REQUIRE(std::as_const(originalArray)[0] == 7);
+  REQUIRE(copiedArray[0] == 5);
+
+  // Writes through iterators and the DataStore reference detach as well
+  DataStructure iteratorCopy(dataStr);
+  auto& iteratorArray = iteratorCopy.getDataRefAs<Int32Array>(arrayId);
+  REQUIRE(iteratorArray.isDataStoreShared());
+  std::fill(iteratorArray.begin(), iteratorArray.end(), 9);
+  REQUIRE_FALSE(iteratorArray.isDataStoreShared());
+  REQUIRE(std::as_const(originalArray)[0] == 7);
+
+  DataStructure storeCopy(dataStr);
+  auto& storeArray = storeCopy.getDataRefAs<Int32Array>(arrayId);
+  storeArray.getDataStoreRef()[0] = 11;
+  REQUIRE(std::as_const(storeArray)[0] == 11);
+  REQUIRE(std::as_const(originalArray)[0] == 7);
+}
+
 TEST_CASE("ScalarDataTest")
 {
   DataStructure dataStr;
@@ -361,6 +415,125 @@ TEST_CASE("ScalarDataTest")
   REQUIRE(scalar->getValue() == newValue2);
 }
 
+TEST_CASE("NeighborListCompactStorageTest")
+{
+  DataStructure dataStr;
+  auto* neighborList = Int32NeighborList::Create(dataStr, "neighbors", 0);
+  REQUIRE(neighborList != nullptr);
+
+  // Lists {}, {1, 2}, {3}, {4, 5, 6}
+  neighborList->setLists({0, 0, 2, 3, 6}, {1, 2, 3, 4, 5, 6});
+  REQUIRE(neighborList->isCompact());
+  REQUIRE(neighborList->getNumberOfTuples() == 4);
+  REQUIRE(neighborList->getNumberOfLists() == 4);
+  REQUIRE(neighborList->getSize() == 6);
+  REQUIRE(neighborList->getListSize(0) == 0);
+  REQUIRE(neighborList->getListSize(3) == 3);
+  REQUIRE(neighborList->copyOfList(1) == std::vector<int32>{1, 2});
+  bool ok = true;
+  REQUIRE(neighborList->getValue(3, 1, ok) == 5);
+  REQUIRE(ok);
+
+  // Erasing and resizing keep the compact form
+  REQUIRE(neighborList->eraseTuples({1}) == 0);
+  REQUIRE(neighborList->isCompact());
+  REQUIRE(neighborList->getOffsets() == std::vector<usize>{0, 0, 1, 4});
+  REQUIRE(neighborList->getValues() == std::vector<int32>{3, 4, 5, 6});
+  neighborList->resizeTuples(4);
+  REQUIRE(neighborList->isCompact());
+  REQUIRE(neighborList->getListSize(3) == 0);
+
+  // A copy keeps its own lists when the original is unpacked
+  DataStructure dataStrCopy(dataStr);
+  auto* copy = dataStrCopy.getDataAs<Int32NeighborList>(neighborList->getId());
+  REQUIRE(copy != nullptr);
+
+  // Accessors handing out vectors unpack the lists
+  (*neighborList)[1].push_back(7);
+  REQUIRE_FALSE(neighborList->isCompact());
+  // Unpacking frees the compact buffers, so the lists are only held once
+  REQUIRE(neighborList->getMemoryUsage() == 5 * sizeof(int32));
+  REQUIRE(neighborList->copyOfList(1) == std::vector<int32>{3, 7});
+  neighborList->addEntry(3, 8);
+  REQUIRE(neighborList->getListSpan(3).size() == 1);
+
+  REQUIRE(copy->isCompact());
+  REQUIRE(copy->copyOfList(1) == std::vector<int32>{3});
+
+  // Compacting again keeps every list
+  neighborList->compact();
+  REQUIRE(neighborList->isCompact());
+  REQUIRE(neighborList->getOffsets() == std::vector<usize>{0, 0, 2, 5, 6});
+  REQUIRE(neighborList->getValues() == std::vector<int32>{3, 7, 4, 5, 6, 8});
+}
+
+TEST_CASE("NeighborListConcurrentUnpackTest")
+{
+  constexpr usize k_NumLists = 20000;
+  constexpr usize k_NumThreads = 4;
+
+  std::vector<usize> offsets(k_NumLists + 1, 0);
+  std::vector<int32> values;
+  for(usize i = 0; i < k_NumLists; i++)
+  {
+    for(usize j = 0; j < i % 5; j++)
+    {
+      values.push_back(static_cast<int32>(i + j));
+    }
+    offsets[i + 1] = values.size();
+  }
+
+  for(usize iteration = 0; iteration < 10; iteration++)
+  {
+    DataStructure dataStr;
+    auto* neighborList = Int32NeighborList::Create(dataStr, "neighbors", 0);
+    REQUIRE(neighborList != nullptr);
+    neighborList->setLists(offsets, values);
+
+    // Half of the threads read the sizes while the others unpack the lists through getList().
+    // The unpacking starts once the readers are part way through the lists.
+    std::vector<usize> mismatches(k_NumThreads, 0);
+    std::atomic<usize> readProgress = 0;
+    std::vector<std::thread> threads;
+    for(usize thread = 0; thread < k_NumThreads; thread++)
+    {
+      threads.emplace_back([&, thread]() {
+        if(thread % 2 == 1)
+        {
+          while(readProgress.load(std::memory_order_relaxed) < k_NumLists / 4)
+          {
+            std::this_thread::yield();
+          }
+        }
+        for(usize i = 0; i < k_NumLists; i++)
+        {
+          const usize expectedSize = i % 5;
+          if(thread % 2 == 0)
+          {
+            mismatches[thread] += static_cast<usize>(neighborList->getListSize(static_cast<int32>(i))) == expectedSize ? 0 : 1;
+            readProgress.store(i, std::memory_order_relaxed);
+          }
+          else
+          {
+            auto list = neighborList->getList(static_cast<int32>(i));
+            mismatches[thread] += list->size() == expectedSize && (expectedSize == 0 || list->front() == static_cast<int32>(i)) ? 0 : 1;
+          }
+        }
+      });
+    }
+    for(auto& thread : threads)
+    {
+      thread.join();
+    }
+    for(usize count : mismatches)
+    {
+      REQUIRE(count == 0);
+    }
+    REQUIRE_FALSE(neighborList->isCompact());
+    REQUIRE(neighborList->getSize() == values.size());
+  }
+}
+
 TEST_CASE("DataStructureDuplicateNames")
 {
   static constexpr StringLiteral name = "foo";
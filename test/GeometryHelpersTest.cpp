@@ -0,0 +1,368 @@
+#include <catch2/catch.hpp>
+
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/DataStructure.hpp"
+#include "complex/DataStructure/DynamicListArray.hpp"
+#include "complex/Utilities/GeometryHelpers.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <vector>
+
+using namespace complex;
+
+namespace
+{
+using IndexArray = DataArray<uint64>;
+
+// Local corner offsets (x, y, z) of a hexahedron in the vertex order used by HexahedralGeom
+constexpr std::array<std::array<usize, 3>, 8> k_HexCorners = {{{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}}};
+
+IndexArray* CreateIndexArray(DataStructure& dataStructure, const std::string& name, usize numTuples, usize numComps)
+{
+  auto dataStore = std::make_unique<DataStore<uint64>>(std::vector<usize>{numTuples}, std::vector<usize>{numComps}, 0);
+  return IndexArray::Create(dataStructure, name, std::move(dataStore));
+}
+
+usize GridVertex(usize cells, usize x, usize y, usize z)
+{
+  return (z * (cells + 1) + y) * (cells + 1) + x;
+}
+
+IndexArray* CreateHexGrid(DataStructure& dataStructure, usize cells)
+{
+  auto* hexList = CreateIndexArray(dataStructure, "Hexes", cells * cells * cells, 8);
+  usize hex = 0;
+  for(usize z = 0; z < cells; z++)
+  {
+    for(usize y = 0; y < cells; y++)
+    {
+      for(usize x = 0; x < cells; x++)
+      {
+        for(usize v = 0; v < 8; v++)
+        {
+          (*hexList)[hex * 8 + v] = GridVertex(cells, x + k_HexCorners[v][0], y + k_HexCorners[v][1], z + k_HexCorners[v][2]);
+        }
+        hex++;
+      }
+    }
+  }
+  return hexList;
+}
+
+// Splits every cube of the grid into six tetrahedra around its main diagonal
+IndexArray* CreateTetGrid(DataStructure& dataStructure, usize cells)
+{
+  constexpr std::array<std::array<usize, 3>, 6> k_AxisOrders = {{{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}}};
+  auto* tetList = CreateIndexArray(dataStructure, "Tets", cells * cells * cells * 6, 4);
+  usize tet = 0;
+  for(usize z = 0; z < cells; z++)
+  {
+    for(usize y = 0; y < cells; y++)
+    {
+      for(usize x = 0; x < cells; x++)
+      {
+        for(const auto& axisOrder : k_AxisOrders)
+        {
+          std::array<usize, 3> corner = {x, y, z};
+          (*tetList)[tet * 4] = GridVertex(cells, corner[0], corner[1], corner[2]);
+          for(usize v = 0; v < 3; v++)
+          {
+            corner[axisOrder[v]]++;
+            (*tetList)[tet * 4 + v + 1] = GridVertex(cells, corner[0], corner[1], corner[2]);
+          }
+          tet++;
+        }
+      }
+    }
+  }
+  return tetList;
+}
+
+IndexArray* CreateTriangleGrid(DataStructure& dataStructure, usize cells)
+{
+  auto* triList = CreateIndexArray(dataStructure, "Triangles", cells * cells * 2, 3);
+  usize tri = 0;
+  for(usize y = 0; y < cells; y++)
+  {
+    for(usize x = 0; x < cells; x++)
+    {
+      const std::array<usize, 4> quad = {GridVertex(cells, x, y, 0), GridVertex(cells, x + 1, y, 0), GridVertex(cells, x + 1, y + 1, 0), GridVertex(cells, x, y + 1, 0)};
+      const std::array<usize, 6> vertices = {quad[0], quad[1], quad[2], quad[0], quad[2], quad[3]};
+      for(usize v = 0; v < 6; v++)
+      {
+        (*triList)[tri * 3 + v] = vertices[v];
+      }
+      tri += 2;
+    }
+  }
+  return triList;
+}
+
+// Ordered map based extraction equivalent to the original GeometryHelpers implementation
+template <usize N>
+std::vector<uint64> ReferenceSubElements(const IndexArray& elemList, const std::vector<std::array<usize, N>>& localIndices, bool unsharedOnly)
+{
+  const usize numVertsPerElem = elemList.getNumberOfComponents();
+  std::map<std::array<uint64, N>, usize> keyCounts;
+  for(usize i = 0; i < elemList.getNumberOfTuples(); i++)
+  {
+    for(const auto& local : localIndices)
+    {
+      std::array<uint64, N> key;
+      for(usize k = 0; k < N; k++)
+      {
+        key[k] = elemList[i * numVertsPerElem + local[k]];
+      }
+      std::sort(key.begin(), key.end());
+      keyCounts[key]++;
+    }
+  }
+
+  std::vector<uint64> values;
+  for(const auto& [key, count] : keyCounts)
+  {
+    if(!unsharedOnly || count == 1)
+    {
+      values.insert(values.end(), key.begin(), key.end());
+    }
+  }
+  return values;
+}
+
+void RequireEqual(const IndexArray& output, usize numComps, const std::vector<uint64>& expected)
+{
+  REQUIRE(output.getNumberOfComponents() == numComps);
+  REQUIRE(output.getSize() == expected.size());
+  for(usize i = 0; i < expected.size(); i++)
+  {
+    REQUIRE(output[i] == expected[i]);
+  }
+}
+} // namespace
+
+TEST_CASE("GeometryHelpers Edge and Face Extraction Test")
+{
+  DataStructure dataStructure;
+  const usize cells = 4;
+
+  SECTION("Tetrahedra")
+  {
+    const auto* tetList = CreateTetGrid(dataStructure, cells);
+
+    auto* edges = CreateIndexArray(dataStructure, "Edges", 0, 2);
+    GeometryHelpers::Connectivity::FindTetEdges(tetList, edges);
+    RequireEqual(*edges, 2, ReferenceSubElements<2>(*tetList, GeometryHelpers::Connectivity::detail::k_TetEdgeIndices, false));
+
+    auto* faces = CreateIndexArray(dataStructure, "Faces", 0, 3);
+    GeometryHelpers::Connectivity::FindTetFaces(tetList, faces);
+    RequireEqual(*faces, 3, ReferenceSubElements<3>(*tetList, GeometryHelpers::Connectivity::detail::k_TetFaceIndices, false));
+
+    auto* unsharedEdges = CreateIndexArray(dataStructure, "Unshared Edges", 0, 2);
+    GeometryHelpers::Connectivity::FindUnsharedTetEdges(tetList, unsharedEdges);
+    RequireEqual(*unsharedEdges, 2, ReferenceSubElements<2>(*tetList, GeometryHelpers::Connectivity::detail::k_TetEdgeIndices, true));
+
+    auto* unsharedFaces = CreateIndexArray(dataStructure, "Unshared Faces", 0, 3);
+    GeometryHelpers::Connectivity::FindUnsharedTetFaces(tetList, unsharedFaces);
+    // Every boundary square of the grid is split into two triangles
+    REQUIRE(unsharedFaces->getNumberOfTuples() == 6 * cells * cells * 2);
+    RequireEqual(*unsharedFaces, 3, ReferenceSubElements<3>(*tetList, GeometryHelpers::Connectivity::detail::k_TetFaceIndices, true));
+  }
+  SECTION("Hexahedra")
+  {
+    const auto* hexList = CreateHexGrid(dataStructure, cells);
+
+    auto* edges = CreateIndexArray(dataStructure, "Edges", 0, 2);
+    GeometryHelpers::Connectivity::FindHexEdges(hexList, edges);
+    REQUIRE(edges->getNumberOfTuples() == 3 * cells * (cells + 1) * (cells + 1));
+    RequireEqual(*edges, 2, ReferenceSubElements<2>(*hexList, GeometryHelpers::Connectivity::detail::k_HexEdgeIndices, false));
+
+    auto* faces = CreateIndexArray(dataStructure, "Faces", 0, 4);
+    GeometryHelpers::Connectivity::FindHexFaces(hexList, faces);
+    REQUIRE(faces->getNumberOfTuples() == 3 * cells * cells * (cells + 1));
+    RequireEqual(*faces, 4, ReferenceSubElements<4>(*hexList, GeometryHelpers::Connectivity::detail::k_HexFaceIndices, false));
+
+    auto* unsharedEdges = CreateIndexArray(dataStructure, "Unshared Edges", 0, 2);
+    GeometryHelpers::Connectivity::FindUnsharedHexEdges(hexList, unsharedEdges);
+    RequireEqual(*unsharedEdges, 2, ReferenceSubElements<2>(*hexList, GeometryHelpers::Connectivity::detail::k_HexEdgeIndices, true));
+
+    auto* unsharedFaces = CreateIndexArray(dataStructure, "Unshared Faces", 0, 4);
+    GeometryHelpers::Connectivity::FindUnsharedHexFaces(hexList, unsharedFaces);
+    REQUIRE(unsharedFaces->getNumberOfTuples() == 6 * cells * cells);
+    RequireEqual(*unsharedFaces, 4, ReferenceSubElements<4>(*hexList, GeometryHelpers::Connectivity::detail::k_HexFaceIndices, true));
+  }
+  SECTION("Triangles")
+  {
+    const auto* triList = CreateTriangleGrid(dataStructure, cells);
+
+    auto* edges = CreateIndexArray(dataStructure, "Edges", 0, 2);
+    GeometryHelpers::Connectivity::Find2DElementEdges(triList, edges);
+    RequireEqual(*edges, 2, ReferenceSubElements<2>(*triList, GeometryHelpers::Connectivity::detail::PolygonEdgeIndices(3), false));
+
+    auto* unsharedEdges = CreateIndexArray(dataStructure, "Unshared Edges", 0, 2);
+    GeometryHelpers::Connectivity::Find2DUnsharedEdges(triList, unsharedEdges);
+    REQUIRE(unsharedEdges->getNumberOfTuples() == 4 * cells);
+    RequireEqual(*unsharedEdges, 2, ReferenceSubElements<2>(*triList, GeometryHelpers::Connectivity::detail::PolygonEdgeIndices(3), true));
+  }
+  SECTION("Empty")
+  {
+    const auto* tetList = CreateIndexArray(dataStructure, "Empty Tets", 0, 4);
+    auto* edges = CreateIndexArray(dataStructure, "Edges", 0, 2);
+    GeometryHelpers::Connectivity::FindTetEdges(tetList, edges);
+    REQUIRE(edges->getNumberOfTuples() == 0);
+  }
+}
+
+TEST_CASE("GeometryHelpers Element Connectivity Test")
+{
+  using ElementList = DynamicListArray<uint16, uint64>;
+
+  DataStructure dataStructure;
+  const usize cells = 3;
+  const usize numVerts = (cells + 1) * (cells + 1) * (cells + 1);
+  const auto* tetList = CreateTetGrid(dataStructure, cells);
+  const usize numTets = tetList->getNumberOfTuples();
+
+  auto* containsVert = ElementList::Create(dataStructure, "Tets Containing Vert", {});
+  GeometryHelpers::Connectivity::FindElementsContainingVert<uint16, uint64>(tetList, containsVert, numVerts);
+  REQUIRE(containsVert->size() == numVerts);
+  REQUIRE(containsVert->getTotalNumberOfElements() == numTets * 4);
+  for(usize vert = 0; vert < numVerts; vert++)
+  {
+    std::vector<uint64> expected;
+    for(usize tet = 0; tet < numTets; tet++)
+    {
+      for(usize v = 0; v < 4; v++)
+      {
+        if((*tetList)[tet * 4 + v] == vert)
+        {
+          expected.push_back(tet);
+        }
+      }
+    }
+    REQUIRE(containsVert->getNumberOfElements(vert) == expected.size());
+    REQUIRE(std::equal(expected.begin(), expected.end(), containsVert->getElementListPointer(vert)));
+  }
+
+  auto* neighbors = ElementList::Create(dataStructure, "Tet Neighbors", {});
+  REQUIRE(GeometryHelpers::Connectivity::FindElementNeighbors<uint16, uint64>(tetList, containsVert, neighbors, IGeometry::Type::Tetrahedral) == 0);
+  REQUIRE(neighbors->size() == numTets);
+  usize numNeighborPairs = 0;
+  for(usize tet = 0; tet < numTets; tet++)
+  {
+    std::vector<uint64> expected;
+    for(usize other = 0; other < numTets; other++)
+    {
+      usize numShared = 0;
+      for(usize i = 0; i < 4; i++)
+      {
+        for(usize j = 0; j < 4; j++)
+        {
+          numShared += (*tetList)[tet * 4 + i] == (*tetList)[other * 4 + j] ? 1 : 0;
+        }
+      }
+      if(other != tet && numShared == 3)
+      {
+        expected.push_back(other);
+      }
+    }
+    REQUIRE(neighbors->getNumberOfElements(tet) == expected.size());
+    REQUIRE(std::equal(expected.begin(), expected.end(), neighbors->getElementListPointer(tet)));
+    numNeighborPairs += expected.size();
+  }
+  // Every interior face is shared by exactly two tetrahedra
+  auto* faces = CreateIndexArray(dataStructure, "Faces", 0, 3);
+  auto* unsharedFaces = CreateIndexArray(dataStructure, "Unshared Faces", 0, 3);
+  GeometryHelpers::Connectivity::FindTetFaces(tetList, faces);
+  GeometryHelpers::Connectivity::FindUnsharedTetFaces(tetList, unsharedFaces);
+  REQUIRE(numNeighborPairs == 2 * (faces->getNumberOfTuples() - unsharedFaces->getNumberOfTuples()));
+
+  REQUIRE(GeometryHelpers::Connectivity::FindElementNeighbors<uint16, uint64>(tetList, containsVert, neighbors, IGeometry::Type::Image) == -1);
+}
+
+TEST_CASE("GeometryHelpers Triangle Neighbors Test")
+{
+  using ElementList = DynamicListArray<uint16, uint64>;
+
+  // A 3 x 3 vertex grid where each of the four squares is split into two triangles along its diagonal
+  const std::vector<uint64> triangles = {0, 1, 4, 0, 4, 3, 1, 2, 5, 1, 5, 4, 3, 4, 7, 3, 7, 6, 4, 5, 8, 4, 8, 7};
+  const std::vector<std::vector<uint64>> expectedNeighbors = {{1, 3}, {0, 4}, {3}, {0, 2, 6}, {1, 5, 7}, {4}, {3, 7}, {4, 6}};
+
+  DataStructure dataStructure;
+  auto* triList = CreateIndexArray(dataStructure, "Triangles", triangles.size() / 3, 3);
+  for(usize i = 0; i < triangles.size(); i++)
+  {
+    (*triList)[i] = triangles[i];
+  }
+
+  auto* containsVert = ElementList::Create(dataStructure, "Triangles Containing Vert", {});
+  GeometryHelpers::Connectivity::FindElementsContainingVert<uint16, uint64>(triList, containsVert, 9);
+  auto* neighbors = ElementList::Create(dataStructure, "Triangle Neighbors", {});
+  REQUIRE(GeometryHelpers::Connectivity::FindElementNeighbors<uint16, uint64>(triList, containsVert, neighbors, IGeometry::Type::Triangle) == 0);
+
+  // Only triangles that share an edge are neighbors, not the ones that only share a vertex
+  const ElementList& constNeighbors = *neighbors;
+  REQUIRE(constNeighbors.size() == expectedNeighbors.size());
+  for(usize tri = 0; tri < expectedNeighbors.size(); tri++)
+  {
+    const auto list = constNeighbors.getElementList(tri);
+    REQUIRE(std::vector<uint64>(list.cells, list.cells + list.numCells) == expectedNeighbors[tri]);
+  }
+}
+
+TEST_CASE("DynamicListArray Test")
+{
+  using ElementList = DynamicListArray<uint16, uint64>;
+
+  DataStructure dataStructure;
+  auto* lists = ElementList::Create(dataStructure, "Lists", {});
+  REQUIRE(lists->size() == 0);
+
+  lists->allocateLists(std::vector<uint16>{2, 0, 3});
+  REQUIRE(lists->size() == 3);
+  REQUIRE(lists->getOffsets() == std::vector<usize>{0, 2, 2, 5});
+  for(usize i = 0; i < 3; i++)
+  {
+    lists->insertCellReference(2, i, 10 + i);
+  }
+  lists->insertCellReference(0, 0, 1);
+  lists->insertCellReference(0, 1, 2);
+
+  // Growing and shrinking a list in the middle shifts the lists that follow it
+  const std::vector<uint64> middle = {7, 8, 9, 6};
+  REQUIRE(lists->setElementList(1, 4, middle.data()));
+  REQUIRE(lists->getOffsets() == std::vector<usize>{0, 2, 6, 9});
+  REQUIRE(lists->getElementListPointer(2)[0] == 10);
+  REQUIRE(lists->getElementListPointer(1)[3] == 6);
+  REQUIRE(lists->setElementList(0, 1, middle.data()));
+  REQUIRE(lists->getOffsets() == std::vector<usize>{0, 1, 5, 8});
+  REQUIRE(lists->getElementList(2).numCells == 3);
+  REQUIRE(lists->getElementList(2).cells[2] == 12);
+  REQUIRE_FALSE(lists->setElementList(3, 1, middle.data()));
+}
+
+// Run explicitly with: complex_test "[benchmark]"
+TEST_CASE("GeometryHelpers Edge Extraction Benchmark", "[.][benchmark]")
+{
+  using Clock = std::chrono::steady_clock;
+
+  DataStructure dataStructure;
+  const usize cells = 64;
+  const auto* tetList = CreateTetGrid(dataStructure, cells);
+  auto* edges = CreateIndexArray(dataStructure, "Edges", 0, 2);
+
+  auto start = Clock::now();
+  std::vector<uint64> expected = ReferenceSubElements<2>(*tetList, GeometryHelpers::Connectivity::detail::k_TetEdgeIndices, false);
+  const auto referenceTime = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+
+  start = Clock::now();
+  GeometryHelpers::Connectivity::FindTetEdges(tetList, edges);
+  const auto sortedTime = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+
+  std::cout << "FindTetEdges on " << tetList->getNumberOfTuples() << " tetrahedra: ordered map " << referenceTime << " ms, bucket sort " << sortedTime << " ms" << std::endl;
+  RequireEqual(*edges, 2, expected);
+}
@@ -12,12 +12,16 @@
 #include "complex/DataStructure/Geometry/QuadGeom.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/DataStructure/Geometry/VertexGeom.hpp"
+#include "complex/DataStructure/H5ProxyDataStore.hpp"
 #include "complex/DataStructure/Montage/GridMontage.hpp"
 #include "complex/DataStructure/ScalarData.hpp"
 #include "complex/DataStructure/StringArray.hpp"
+#include "complex/Filter/Actions/ImportH5ObjectPathsAction.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
 #include "complex/Utilities/Parsing/DREAM3D/Dream3dIO.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DatasetReadScheduler.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DatasetReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5FileReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5FileWriter.hpp"
 #include "complex/Utilities/Parsing/Text/CsvParser.hpp"
@@ -29,8 +33,12 @@
 
 #include <catch2/catch.hpp>
 
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <numeric>
 #include <string>
+#include <thread>
 #include <type_traits>
 
 #include <random>
@@ -667,6 +675,17 @@ TEST_CASE("NeighborList IO")
     // auto neighborList = ds.getDataAs<NeighborList<int64>>(DataPath({k_NeighborGroupName, "NeighborList"}));
     auto neighborList = ds.getData(DataPath({k_NeighborGroupName, "NeighborList"}));
     REQUIRE(neighborList != nullptr);
+
+    // Lists are read straight into the compact form
+    const auto& int64NeighborList = dynamic_cast<const NeighborList<int64>&>(*neighborList);
+    REQUIRE(int64NeighborList.isCompact());
+    REQUIRE(int64NeighborList.getNumberOfLists() == 50);
+    for(int32 i = 0; i < 50; i++)
+    {
+      nonstd::span<const int64> list = int64NeighborList.getListSpan(i);
+      REQUIRE(list.size() == 50 - i);
+      REQUIRE(std::all_of(list.begin(), list.end(), [i](int64 value) { return value == i; }));
+    }
   } catch(const std::exception& e)
   {
     FAIL(e.what());
@@ -744,6 +763,284 @@ TEST_CASE("DataArray<bool> IO")
   }
 }
 
+TEST_CASE("Compressed DataArray IO")
+{
+  Application app;
+
+  fs::path dataDir = GetDataDir();
+
+  if(!fs::exists(dataDir))
+  {
+    REQUIRE(fs::create_directories(dataDir));
+  }
+
+  fs::path filePath = GetDataDir() / "CompressedArrayTest.dream3d";
+
+  const std::vector<usize> tupleShape = {40, 30, 20};
+  const usize numTuples = 40 * 30 * 20;
+
+  DataStructure ds;
+  auto* featureIds = Int32Array::CreateWithStore<DataStore<int32>>(ds, "FeatureIds", tupleShape, {1});
+  auto* eulers = Float32Array::CreateWithStore<DataStore<float32>>(ds, "Eulers", tupleShape, {3});
+  REQUIRE(featureIds != nullptr);
+  REQUIRE(eulers != nullptr);
+  for(usize i = 0; i < numTuples; i++)
+  {
+    (*featureIds)[i] = static_cast<int32>(i / 500);
+    (*eulers)[i * 3] = static_cast<float32>(i) * 0.5f;
+    (*eulers)[i * 3 + 1] = 1.0f;
+    (*eulers)[i * 3 + 2] = -static_cast<float32>(i);
+  }
+
+  H5::DatasetCreationOptions options;
+  options.deflateLevel = 5;
+  options.shuffle = true;
+  options.scaleOffset = true;
+  options.targetChunkBytes = 16 * 1024;
+  auto writeResult = DREAM3D::WriteFile(filePath, ds, {}, false, options);
+  COMPLEX_RESULT_REQUIRE_VALID(writeResult);
+
+  // The arrays are chunked and filtered. Deflate depends on how HDF5 was built.
+  {
+    const int32 numDeflateFilters = H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0 ? 1 : 0;
+    hid_t fileId = H5Fopen(filePath.string().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    REQUIRE(fileId > 0);
+    hid_t datasetId = H5Dopen(fileId, "/DataStructure/FeatureIds", H5P_DEFAULT);
+    REQUIRE(datasetId > 0);
+    hid_t propertyListId = H5Dget_create_plist(datasetId);
+    REQUIRE(H5Pget_layout(propertyListId) == H5D_CHUNKED);
+    std::array<hsize_t, 4> chunkDims = {0, 0, 0, 0};
+    REQUIRE(H5Pget_chunk(propertyListId, 4, chunkDims.data()) == 4);
+    REQUIRE(chunkDims == std::array<hsize_t, 4>{6, 30, 20, 1});
+    REQUIRE(H5Pget_nfilters(propertyListId) == 2 + numDeflateFilters);
+    H5Pclose(propertyListId);
+    H5Dclose(datasetId);
+
+    datasetId = H5Dopen(fileId, "/DataStructure/Eulers", H5P_DEFAULT);
+    REQUIRE(datasetId > 0);
+    propertyListId = H5Dget_create_plist(datasetId);
+    REQUIRE(H5Pget_layout(propertyListId) == H5D_CHUNKED);
+    // Scale-offset is only lossless for integers and is skipped for floats
+    REQUIRE(H5Pget_nfilters(propertyListId) == 1 + numDeflateFilters);
+    H5Pclose(propertyListId);
+    H5Dclose(datasetId);
+    H5Fclose(fileId);
+  }
+
+  auto readResult = DREAM3D::ImportDataStructureFromFile(filePath);
+  COMPLEX_RESULT_REQUIRE_VALID(readResult);
+  const DataStructure& importedDs = readResult.value();
+  const auto* importedFeatureIds = importedDs.getDataAs<Int32Array>(DataPath({"FeatureIds"}));
+  const auto* importedEulers = importedDs.getDataAs<Float32Array>(DataPath({"Eulers"}));
+  REQUIRE(importedFeatureIds != nullptr);
+  REQUIRE(importedEulers != nullptr);
+  REQUIRE(importedFeatureIds->getSize() == featureIds->getSize());
+  REQUIRE(importedEulers->getSize() == eulers->getSize());
+  REQUIRE(std::equal(featureIds->begin(), featureIds->end(), importedFeatureIds->begin()));
+  REQUIRE(std::equal(eulers->begin(), eulers->end(), importedEulers->begin()));
+}
+
+TEST_CASE("Scheduled DataArray Reads")
+{
+  Application app;
+
+  fs::path dataDir = GetDataDir();
+
+  if(!fs::exists(dataDir))
+  {
+    REQUIRE(fs::create_directories(dataDir));
+  }
+
+  fs::path filePath = GetDataDir() / "ScheduledReadTest.dream3d";
+
+  // The tuple shape is not a multiple of the chunk shape so edge chunks are clipped
+  const std::vector<usize> tupleShape = {17, 13, 11};
+  const usize numTuples = 17 * 13 * 11;
+
+  DataStructure ds;
+  auto* featureIds = Int32Array::CreateWithStore<DataStore<int32>>(ds, "FeatureIds", tupleShape, {1});
+  auto* eulers = Float32Array::CreateWithStore<DataStore<float32>>(ds, "Eulers", tupleShape, {3});
+  auto* phases = UInt8Array::CreateWithStore<DataStore<uint8>>(ds, "Phases", tupleShape, {1});
+  REQUIRE(featureIds != nullptr);
+  REQUIRE(eulers != nullptr);
+  REQUIRE(phases != nullptr);
+  for(usize i = 0; i < numTuples; i++)
+  {
+    (*featureIds)[i] = static_cast<int32>(i / 7) - 100;
+    (*eulers)[i * 3] = static_cast<float32>(i) * 0.25f;
+    (*eulers)[i * 3 + 1] = -1.0f;
+    (*eulers)[i * 3 + 2] = static_cast<float32>(i % 13);
+    (*phases)[i] = static_cast<uint8>(i % 5);
+  }
+
+  H5::DatasetCreationOptions options;
+  options.deflateLevel = 3;
+  options.shuffle = true;
+  options.targetChunkBytes = 1024;
+  auto writeResult = DREAM3D::WriteFile(filePath, ds, {}, false, options);
+  COMPLEX_RESULT_REQUIRE_VALID(writeResult);
+
+  for(bool doParallel : {false, true})
+  {
+    std::vector<int32> importedFeatureIds(numTuples);
+    std::vector<float32> importedEulers(numTuples * 3);
+    std::vector<uint8> importedPhases(numTuples);
+
+    H5::FileReader fileReader(filePath);
+    REQUIRE(fileReader.isValid());
+    auto dataStructureGroup = fileReader.openGroup(complex::Constants::k_DataStructureTag);
+    REQUIRE(dataStructureGroup.isValid());
+
+    // A small buffer forces the reading thread to wait for decoded chunks
+    H5::DatasetReadScheduler readScheduler(4 * 1024);
+    readScheduler.setParallelizationEnabled(doParallel);
+    readScheduler.enqueue(dataStructureGroup.openDataset("Phases"), nonstd::span<uint8>(importedPhases.data(), importedPhases.size()));
+    readScheduler.enqueue(dataStructureGroup.openDataset("FeatureIds"), nonstd::span<int32>(importedFeatureIds.data(), importedFeatureIds.size()));
+    readScheduler.enqueue(dataStructureGroup.openDataset("Eulers"), nonstd::span<float32>(importedEulers.data(), importedEulers.size()));
+    REQUIRE(readScheduler.getNumberOfReads() == 3);
+    REQUIRE(readScheduler.run().valid());
+    REQUIRE(readScheduler.getNumberOfReads() == 0);
+
+    REQUIRE(std::equal(featureIds->begin(), featureIds->end(), importedFeatureIds.begin()));
+    REQUIRE(std::equal(eulers->begin(), eulers->end(), importedEulers.begin()));
+    REQUIRE(std::equal(phases->begin(), phases->end(), importedPhases.begin()));
+  }
+}
+
+TEST_CASE("Lazy and Sub-Volume DataArray IO")
+{
+  Application app;
+
+  fs::path dataDir = GetDataDir();
+
+  if(!fs::exists(dataDir))
+  {
+    REQUIRE(fs::create_directories(dataDir));
+  }
+
+  fs::path filePath = GetDataDir() / "LazyArrayTest.dream3d";
+
+  // X = 6, Y = 5, Z = 4
+  const std::vector<usize> tupleShape = {4, 5, 6};
+  const usize numTuples = 4 * 5 * 6;
+
+  DataStructure ds;
+  auto* imageGeom = ImageGeom::Create(ds, "ImageGeom");
+  imageGeom->setDimensions({6, 5, 4});
+  imageGeom->setSpacing({0.5f, 1.0f, 2.0f});
+  imageGeom->setOrigin({10.0f, 20.0f, 30.0f});
+  auto* cellData = AttributeMatrix::Create(ds, "CellData", imageGeom->getId());
+  cellData->setShape(tupleShape);
+  imageGeom->setCellData(*cellData);
+  auto* featureIds = Int32Array::CreateWithStore<DataStore<int32>>(ds, "FeatureIds", tupleShape, {1}, cellData->getId());
+  auto* eulers = Float32Array::CreateWithStore<DataStore<float32>>(ds, "Eulers", tupleShape, {3}, cellData->getId());
+  for(usize i = 0; i < numTuples; i++)
+  {
+    (*featureIds)[i] = static_cast<int32>(i);
+    (*eulers)[i * 3] = static_cast<float32>(i);
+    (*eulers)[i * 3 + 1] = 0.0f;
+    (*eulers)[i * 3 + 2] = -static_cast<float32>(i);
+  }
+  auto writeResult = DREAM3D::WriteFile(filePath, ds);
+  COMPLEX_RESULT_REQUIRE_VALID(writeResult);
+
+  const DataPath geomPath({"ImageGeom"});
+  const DataPath cellDataPath = geomPath.createChildPath("CellData");
+  const DataPath featureIdsPath = cellDataPath.createChildPath("FeatureIds");
+  const DataPath eulersPath = cellDataPath.createChildPath("Eulers");
+
+  // Arrays are not read until their values are accessed
+  {
+    H5::FileReader fileReader(filePath);
+    REQUIRE(fileReader.isValid());
+    auto readResult = DREAM3D::ImportDataStructureFromFile(fileReader, false, true);
+    COMPLEX_RESULT_REQUIRE_VALID(readResult);
+    DataStructure& importedDs = readResult.value();
+    auto* importedFeatureIds = importedDs.getDataAs<Int32Array>(featureIdsPath);
+    REQUIRE(importedFeatureIds != nullptr);
+    const auto* proxyStore = dynamic_cast<const H5ProxyDataStore<int32>*>(importedFeatureIds->getDataStore());
+    REQUIRE(proxyStore != nullptr);
+    REQUIRE(proxyStore->getStoreType() == IDataStore::StoreType::Proxy);
+    REQUIRE(!proxyStore->isLoaded());
+    REQUIRE(importedFeatureIds->getTupleShape() == tupleShape);
+    REQUIRE(proxyStore->getValue(17) == 17);
+    REQUIRE(proxyStore->isLoaded());
+    REQUIRE(std::equal(featureIds->begin(), featureIds->end(), importedFeatureIds->begin()));
+  }
+
+  // Proxies can be loaded from several threads while the file is imported again
+  {
+    H5::FileReader fileReader(filePath);
+    REQUIRE(fileReader.isValid());
+    auto readResult = DREAM3D::ImportDataStructureFromFile(fileReader, false, true);
+    COMPLEX_RESULT_REQUIRE_VALID(readResult);
+    const DataStructure& importedDs = readResult.value();
+    const auto* importedFeatureIds = importedDs.getDataAs<Int32Array>(featureIdsPath);
+    const auto* importedEulers = importedDs.getDataAs<Float32Array>(eulersPath);
+    REQUIRE(importedFeatureIds != nullptr);
+    REQUIRE(importedEulers != nullptr);
+
+    int32 featureIdSum = 0;
+    float32 eulerSum = 0.0f;
+    bool reimported = false;
+    std::thread featureIdsThread([&]() { featureIdSum = std::accumulate(importedFeatureIds->begin(), importedFeatureIds->end(), 0); });
+    std::thread eulersThread([&]() { eulerSum = std::accumulate(importedEulers->begin(), importedEulers->end(), 0.0f); });
+    std::thread importThread([&]() {
+      reimported = DREAM3D::ImportDataStructureFromFile(filePath).valid();
+    });
+    featureIdsThread.join();
+    eulersThread.join();
+    importThread.join();
+    REQUIRE(featureIdSum == std::accumulate(featureIds->begin(), featureIds->end(), 0));
+    REQUIRE(eulerSum == 0.0f);
+    REQUIRE(reimported);
+  }
+
+  // Only the selected arrays are imported and only the sub-volume is read
+  {
+    ImportH5ObjectPathsAction::SubVolume subVolume{{1, 2, 1}, {4, 3, 2}};
+    ImportH5ObjectPathsAction action(filePath, std::vector<DataPath>{geomPath, cellDataPath, featureIdsPath}, subVolume);
+    DataStructure importedDs;
+    Result<> result = action.apply(importedDs, IDataAction::Mode::Execute);
+    COMPLEX_RESULT_REQUIRE_VALID(result);
+
+    REQUIRE(importedDs.getData(eulersPath) == nullptr);
+    const auto* importedGeom = importedDs.getDataAs<ImageGeom>(geomPath);
+    REQUIRE(importedGeom != nullptr);
+    REQUIRE(importedGeom->getDimensions() == SizeVec3(4, 2, 2));
+    REQUIRE(importedGeom->getOrigin() == FloatVec3(10.5f, 22.0f, 32.0f));
+    const auto* importedCellData = importedDs.getDataAs<AttributeMatrix>(cellDataPath);
+    REQUIRE(importedCellData != nullptr);
+    REQUIRE(importedCellData->getShape() == std::vector<usize>{2, 2, 4});
+
+    const auto* importedFeatureIds = importedDs.getDataAs<Int32Array>(featureIdsPath);
+    REQUIRE(importedFeatureIds != nullptr);
+    REQUIRE(importedFeatureIds->getIDataStoreAs<DataStore<int32>>() != nullptr);
+    REQUIRE(importedFeatureIds->getTupleShape() == std::vector<usize>{2, 2, 4});
+    usize index = 0;
+    for(usize z = 1; z <= 2; z++)
+    {
+      for(usize y = 2; y <= 3; y++)
+      {
+        for(usize x = 1; x <= 4; x++)
+        {
+          REQUIRE((*importedFeatureIds)[index] == static_cast<int32>((z * 5 + y) * 6 + x));
+          index++;
+        }
+      }
+    }
+  }
+
+  // Bounds outside of the geometry are rejected
+  {
+    ImportH5ObjectPathsAction::SubVolume subVolume{{0, 0, 0}, {6, 4, 3}};
+    ImportH5ObjectPathsAction action(filePath, std::vector<DataPath>{geomPath}, subVolume);
+    DataStructure importedDs;
+    Result<> result = action.apply(importedDs, IDataAction::Mode::Preflight);
+    REQUIRE(result.invalid());
+  }
+}
+
 TEST_CASE("xmdf")
 {
   DataStructure ds;
@@ -1,12 +1,16 @@
 #include "catch2/catch.hpp"
 
 #include "complex/Core/Application.hpp"
+#include "complex/DataStructure/DataArray.hpp"
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
 #include "complex/Filter/Actions/DeleteDataAction.hpp"
 #include "complex/Filter/Arguments.hpp"
 #include "complex/Filter/FilterHandle.hpp"
+#include "complex/Parameters/ArrayCreationParameter.hpp"
+#include "complex/Parameters/ArraySelectionParameter.hpp"
 #include "complex/Parameters/ChoicesParameter.hpp"
 #include "complex/Parameters/GeneratedFileListParameter.hpp"
+#include "complex/Parameters/NumberParameter.hpp"
 #include "complex/Pipeline/Pipeline.hpp"
 #include "complex/Pipeline/PipelineFilter.hpp"
 #include "complex/Plugin/AbstractPlugin.hpp"
@@ -105,6 +109,230 @@ protected:
     return {};
   }
 };
+
+constexpr StringLiteral k_FillArrayPathKey = "array_path";
+constexpr StringLiteral k_FillValueKey = "fill_value";
+
+class FillArrayTestFilter : public IFilter
+{
+public:
+  FillArrayTestFilter() = default;
+
+  ~FillArrayTestFilter() noexcept override = default;
+
+  FillArrayTestFilter(const FillArrayTestFilter&) = delete;
+  FillArrayTestFilter(FillArrayTestFilter&&) noexcept = delete;
+
+  FillArrayTestFilter& operator=(const FillArrayTestFilter&) = delete;
+  FillArrayTestFilter& operator=(FillArrayTestFilter&&) noexcept = delete;
+
+  std::string name() const override
+  {
+    return "FillArrayTestFilter";
+  }
+
+  std::string className() const override
+  {
+    return "FillArrayTestFilter";
+  }
+
+  Uuid uuid() const override
+  {
+    static constexpr Uuid uuid = *Uuid::FromString("1b0b4c6e-0e0a-4a8e-9c5c-6f1d3b2f7a41");
+    return uuid;
+  }
+
+  std::string humanName() const override
+  {
+    return "Fill Array Test Filter";
+  }
+
+  Parameters parameters() const override
+  {
+    Parameters params;
+    params.insert(std::make_unique<ArrayCreationParameter>(k_FillArrayPathKey, "Array", "", DataPath{}));
+    params.insert(std::make_unique<Int32Parameter>(k_FillValueKey, "Value", "Negative values fail during execute", 0));
+    return params;
+  }
+
+  UniquePointer clone() const override
+  {
+    return std::make_unique<FillArrayTestFilter>();
+  }
+
+protected:
+  PreflightResult preflightImpl(const DataStructure& data, const Arguments& args, const MessageHandler& messageHandler, const std::atomic_bool& shouldCancel) const override
+  {
+    OutputActions outputActions;
+    outputActions.actions.push_back(std::make_unique<CreateArrayAction>(DataType::int32, std::vector<usize>{10}, std::vector<usize>{1}, args.value<DataPath>(k_FillArrayPathKey)));
+    return {std::move(outputActions)};
+  }
+
+  Result<> executeImpl(DataStructure& data, const Arguments& args, const PipelineFilter* pipelineNode, const MessageHandler& messageHandler, const std::atomic_bool& shouldCancel) const override
+  {
+    auto value = args.value<int32>(k_FillValueKey);
+    if(value < 0)
+    {
+      return MakeErrorResult(-1, "Fill value must not be negative");
+    }
+    auto& dataArray = data.getDataRefAs<Int32Array>(args.value<DataPath>(k_FillArrayPathKey));
+    dataArray.fill(value);
+    return {};
+  }
+};
+
+Arguments CreateFillArgs(const DataPath& path, int32 value)
+{
+  Arguments args;
+  args.insert(k_FillArrayPathKey, std::make_any<DataPath>(path));
+  args.insert(k_FillValueKey, std::make_any<int32>(value));
+  return args;
+}
+
+constexpr StringLiteral k_IncrementArrayPathKey = "array_path";
+
+class IncrementArrayTestFilter : public IFilter
+{
+public:
+  IncrementArrayTestFilter() = default;
+
+  ~IncrementArrayTestFilter() noexcept override = default;
+
+  IncrementArrayTestFilter(const IncrementArrayTestFilter&) = delete;
+  IncrementArrayTestFilter(IncrementArrayTestFilter&&) noexcept = delete;
+
+  IncrementArrayTestFilter& operator=(const IncrementArrayTestFilter&) = delete;
+  IncrementArrayTestFilter& operator=(IncrementArrayTestFilter&&) noexcept = delete;
+
+  std::string name() const override
+  {
+    return "IncrementArrayTestFilter";
+  }
+
+  std::string className() const override
+  {
+    return "IncrementArrayTestFilter";
+  }
+
+  Uuid uuid() const override
+  {
+    static constexpr Uuid uuid = *Uuid::FromString("4c0f6a52-6f0b-4d0e-8f53-2a7e1c9d5b18");
+    return uuid;
+  }
+
+  std::string humanName() const override
+  {
+    return "Increment Array Test Filter";
+  }
+
+  Parameters parameters() const override
+  {
+    Parameters params;
+    params.insert(std::make_unique<ArraySelectionParameter>(k_IncrementArrayPathKey, "Array", "", DataPath{}, ArraySelectionParameter::AllowedTypes{DataType::int32}));
+    return params;
+  }
+
+  UniquePointer clone() const override
+  {
+    return std::make_unique<IncrementArrayTestFilter>();
+  }
+
+protected:
+  PreflightResult preflightImpl(const DataStructure& data, const Arguments& args, const MessageHandler& messageHandler, const std::atomic_bool& shouldCancel) const override
+  {
+    return {};
+  }
+
+  Result<> executeImpl(DataStructure& data, const Arguments& args, const PipelineFilter* pipelineNode, const MessageHandler& messageHandler, const std::atomic_bool& shouldCancel) const override
+  {
+    // Writes through references, which detach the array from earlier nodes
+    auto& dataArray = data.getDataRefAs<Int32Array>(args.value<DataPath>(k_IncrementArrayPathKey));
+    for(usize i = 0; i < dataArray.getSize(); i++)
+    {
+      dataArray[i] += 1;
+    }
+    return {};
+  }
+};
+
+constexpr StringLiteral k_SumInputArrayPathKey = "input_array_path";
+constexpr StringLiteral k_SumOutputArrayPathKey = "output_array_path";
+
+class SumArrayTestFilter : public IFilter
+{
+public:
+  SumArrayTestFilter() = default;
+
+  ~SumArrayTestFilter() noexcept override = default;
+
+  SumArrayTestFilter(const SumArrayTestFilter&) = delete;
+  SumArrayTestFilter(SumArrayTestFilter&&) noexcept = delete;
+
+  SumArrayTestFilter& operator=(const SumArrayTestFilter&) = delete;
+  SumArrayTestFilter& operator=(SumArrayTestFilter&&) noexcept = delete;
+
+  std::string name() const override
+  {
+    return "SumArrayTestFilter";
+  }
+
+  std::string className() const override
+  {
+    return "SumArrayTestFilter";
+  }
+
+  Uuid uuid() const override
+  {
+    static constexpr Uuid uuid = *Uuid::FromString("9e3d7c21-5a4b-4f6e-b2d8-0c1a7f3e6b95");
+    return uuid;
+  }
+
+  std::string humanName() const override
+  {
+    return "Sum Array Test Filter";
+  }
+
+  Parameters parameters() const override
+  {
+    Parameters params;
+    params.insert(std::make_unique<ArraySelectionParameter>(k_SumInputArrayPathKey, "Input Array", "", DataPath{}, ArraySelectionParameter::AllowedTypes{DataType::int32}));
+    params.insert(std::make_unique<ArrayCreationParameter>(k_SumOutputArrayPathKey, "Sum Array", "", DataPath{}));
+    return params;
+  }
+
+  UniquePointer clone() const override
+  {
+    return std::make_unique<SumArrayTestFilter>();
+  }
+
+protected:
+  PreflightResult preflightImpl(const DataStructure& data, const Arguments& args, const MessageHandler& messageHandler, const std::atomic_bool& shouldCancel) const override
+  {
+    OutputActions outputActions;
+    outputActions.actions.push_back(std::make_unique<CreateArrayAction>(DataType::int32, std::vector<usize>{1}, std::vector<usize>{1}, args.value<DataPath>(k_SumOutputArrayPathKey)));
+    return {std::move(outputActions)};
+  }
+
+  Result<> executeImpl(DataStructure& data, const Arguments& args, const PipelineFilter* pipelineNode, const MessageHandler& messageHandler, const std::atomic_bool& shouldCancel) const override
+  {
+    const auto& inputArray = std::as_const(data).getDataRefAs<Int32Array>(args.value<DataPath>(k_SumInputArrayPathKey));
+    int32 sum = 0;
+    for(usize i = 0; i < inputArray.getSize(); i++)
+    {
+      sum += inputArray[i];
+    }
+    data.getDataRefAs<Int32Array>(args.value<DataPath>(k_SumOutputArrayPathKey))[0] = sum;
+    return {};
+  }
+};
+
+Arguments CreateSumArgs(const DataPath& inputPath, const DataPath& outputPath)
+{
+  Arguments args;
+  args.insert(k_SumInputArrayPathKey, std::make_any<DataPath>(inputPath));
+  args.insert(k_SumOutputArrayPathKey, std::make_any<DataPath>(outputPath));
+  return args;
+}
 } // namespace
 
 TEST_CASE("Execute Pipeline")
@@ -368,3 +596,241 @@ TEST_CASE("PipelineDeferredActionTest")
   DataObject* executeObject = dataStructure.getData(k_DeferredActionPath);
   REQUIRE(executeObject == nullptr);
 }
+
+TEST_CASE("PipelineConcurrentExecutionTest")
+{
+  const DataPath pathA({"A"});
+  const DataPath pathB({"B"});
+  const DataPath pathC({"C"});
+
+  // Filters that use a DataObject, its parent or its children conflict
+  {
+    PipelineFilter::DataAccess groupAccess;
+    groupAccess.dataPaths = {DataPath({"Group"})};
+    PipelineFilter::DataAccess childAccess;
+    childAccess.dataPaths = {DataPath({"Group", "Child"})};
+    PipelineFilter::DataAccess otherAccess;
+    otherAccess.dataPaths = {DataPath({"Other"})};
+    PipelineFilter::DataAccess unboundedAccess;
+    unboundedAccess.unbounded = true;
+
+    REQUIRE(groupAccess.conflictsWith(childAccess));
+    REQUIRE(childAccess.conflictsWith(groupAccess));
+    REQUIRE_FALSE(childAccess.conflictsWith(otherAccess));
+    REQUIRE(otherAccess.conflictsWith(unboundedAccess));
+  }
+
+  // Created arrays are part of the prepared execution's DataAccess
+  {
+    PipelineFilter filterNode(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathA, 1));
+    DataStructure dataStructure;
+    REQUIRE(filterNode.prepareExecution(dataStructure, false));
+    PipelineFilter::DataAccess access = filterNode.getExecutionAccess();
+    REQUIRE_FALSE(access.unbounded);
+    REQUIRE(std::find(access.dataPaths.begin(), access.dataPaths.end(), pathA) != access.dataPaths.end());
+    REQUIRE(access.createdPaths == std::vector<DataPath>{pathA});
+    REQUIRE(access.droppable);
+    filterNode.discardExecution();
+
+    // Filters without data parameters may use anything
+    PipelineFilter deferredNode(std::make_unique<DeferredActionTestFilter>());
+    REQUIRE(deferredNode.prepareExecution(dataStructure, false));
+    REQUIRE(deferredNode.getExecutionAccess().unbounded);
+    deferredNode.discardExecution();
+  }
+
+  // Independent filters produce the same results either way
+  for(bool concurrent : {false, true})
+  {
+    Pipeline pipeline;
+    pipeline.setConcurrentExecutionEnabled(concurrent);
+    REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathA, 1)));
+    REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathB, 2)));
+    REQUIRE(pipeline.push_back(std::make_unique<DeferredActionTestFilter>()));
+    REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathC, 3)));
+
+    DataStructure dataStructure;
+    REQUIRE(pipeline.execute(dataStructure, false));
+    const std::vector<std::pair<DataPath, int32>> expectedValues = {{pathA, 1}, {pathB, 2}, {pathC, 3}};
+    for(const auto& [path, value] : expectedValues)
+    {
+      const auto* dataArray = dataStructure.getDataAs<Int32Array>(path);
+      REQUIRE(dataArray != nullptr);
+      REQUIRE(std::all_of(dataArray->begin(), dataArray->end(), [value = value](int32 element) { return element == value; }));
+    }
+    REQUIRE(dataStructure.getData(k_DeferredActionPath) == nullptr);
+  }
+
+  // Errors are reported for the first failing filter in pipeline order
+  for(bool concurrent : {false, true})
+  {
+    Pipeline pipeline;
+    pipeline.setConcurrentExecutionEnabled(concurrent);
+    REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathA, 1)));
+    REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathB, -1)));
+    REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathC, -2)));
+
+    DataStructure dataStructure;
+    REQUIRE_FALSE(pipeline.execute(dataStructure, false));
+    auto* filterB = dynamic_cast<PipelineFilter*>(pipeline.at(1));
+    auto* filterC = dynamic_cast<PipelineFilter*>(pipeline.at(2));
+    REQUIRE(filterB != nullptr);
+    REQUIRE(filterC != nullptr);
+    REQUIRE(filterB->getErrors().size() == 1);
+    REQUIRE(filterC->getErrors().empty());
+  }
+
+  // Filters grouped after a failing filter leave nothing behind
+  for(bool concurrent : {false, true})
+  {
+    Pipeline pipeline;
+    pipeline.setConcurrentExecutionEnabled(concurrent);
+    REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathA, -1)));
+    REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathB, 2)));
+    REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathC, 3)));
+
+    DataStructure dataStructure;
+    REQUIRE_FALSE(pipeline.execute(dataStructure, false));
+    auto* filterA = dynamic_cast<PipelineFilter*>(pipeline.at(0));
+    REQUIRE(filterA != nullptr);
+    REQUIRE(filterA->getErrors().size() == 1);
+    // The failing filter's own array was created before it ran, as in sequential execution
+    REQUIRE(dataStructure.getData(pathA) != nullptr);
+    REQUIRE(dataStructure.getData(pathB) == nullptr);
+    REQUIRE(dataStructure.getData(pathC) == nullptr);
+  }
+
+  // Filters that read existing arrays into disjoint outputs can be grouped
+  {
+    const DataPath sumPathA({"SumA"});
+    const DataPath sumPathB({"SumB"});
+    DataStructure dataStructure;
+    Int32Array::CreateWithStore<Int32DataStore>(dataStructure, "A", {10}, {1})->fill(1);
+    Int32Array::CreateWithStore<Int32DataStore>(dataStructure, "B", {10}, {1})->fill(2);
+
+    PipelineFilter sumNodeA(std::make_unique<SumArrayTestFilter>(), CreateSumArgs(pathA, sumPathA));
+    PipelineFilter sumNodeB(std::make_unique<SumArrayTestFilter>(), CreateSumArgs(pathB, sumPathB));
+    REQUIRE(sumNodeA.prepareExecution(dataStructure, false));
+    REQUIRE(sumNodeB.prepareExecution(dataStructure, false));
+    PipelineFilter::DataAccess accessA = sumNodeA.getExecutionAccess();
+    PipelineFilter::DataAccess accessB = sumNodeB.getExecutionAccess();
+    REQUIRE(accessA.inputPaths == std::vector<DataPath>{pathA});
+    REQUIRE(accessA.createdPaths == std::vector<DataPath>{sumPathA});
+    REQUIRE(accessB.droppable);
+    REQUIRE(accessB.canRestoreInputs(dataStructure));
+    REQUIRE_FALSE(accessA.conflictsWith(accessB));
+    sumNodeA.discardExecution();
+    sumNodeB.discardExecution();
+  }
+  for(bool concurrent : {false, true})
+  {
+    const DataPath sumPathA({"SumA"});
+    const DataPath sumPathB({"SumB"});
+    Pipeline pipeline;
+    pipeline.setConcurrentExecutionEnabled(concurrent);
+    REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathA, 1)));
+    REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathB, 2)));
+    REQUIRE(pipeline.push_back(std::make_unique<DeferredActionTestFilter>()));
+    REQUIRE(pipeline.push_back(std::make_unique<SumArrayTestFilter>(), CreateSumArgs(pathA, sumPathA)));
+    REQUIRE(pipeline.push_back(std::make_unique<SumArrayTestFilter>(), CreateSumArgs(pathB, sumPathB)));
+
+    DataStructure dataStructure;
+    REQUIRE(pipeline.execute(dataStructure, false));
+    REQUIRE(std::as_const(dataStructure).getDataRefAs<Int32Array>(sumPathA)[0] == 10);
+    REQUIRE(std::as_const(dataStructure).getDataRefAs<Int32Array>(sumPathB)[0] == 20);
+  }
+
+  // Inputs changed in place by a dropped filter are restored
+  for(bool concurrent : {false, true})
+  {
+    Pipeline pipeline;
+    pipeline.setConcurrentExecutionEnabled(concurrent);
+    REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathB, 2)));
+    REQUIRE(pipeline.push_back(std::make_unique<DeferredActionTestFilter>()));
+    REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathC, -1)));
+    Arguments incrementArgs;
+    incrementArgs.insert(k_IncrementArrayPathKey, std::make_any<DataPath>(pathB));
+    REQUIRE(pipeline.push_back(std::make_unique<IncrementArrayTestFilter>(), incrementArgs));
+
+    DataStructure dataStructure;
+    REQUIRE_FALSE(pipeline.execute(dataStructure, false));
+    const auto& arrayB = std::as_const(dataStructure).getDataRefAs<Int32Array>(pathB);
+    REQUIRE(std::all_of(arrayB.begin(), arrayB.end(), [](int32 element) { return element == 2; }));
+  }
+}
+
+TEST_CASE("PipelineMemoryBudgetTest")
+{
+  const DataPath pathA({"A"});
+  const DataPath pathB({"B"});
+  const DataPath pathC({"C"});
+  constexpr usize k_ArrayBytes = 10 * sizeof(int32);
+
+  Pipeline pipeline;
+  REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathA, 1)));
+  REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathB, 2)));
+  REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathC, 3)));
+
+  // Preflight stores report the memory of the arrays they stand in for
+  DataStructure dataStructure;
+  REQUIRE(pipeline.preflight(dataStructure, false));
+  REQUIRE(dataStructure.getMemoryUsage() == 3 * k_ArrayBytes);
+  REQUIRE(pipeline.getProjectedMemoryUsage() == std::vector<usize>{k_ArrayBytes, 2 * k_ArrayBytes, 3 * k_ArrayBytes});
+  REQUIRE(pipeline.getProjectedPeakMemoryUsage() == 3 * k_ArrayBytes);
+
+  // The first filter to exceed the budget fails during preflight
+  pipeline.setMemoryBudget(2 * k_ArrayBytes);
+  DataStructure budgetDataStructure;
+  REQUIRE_FALSE(pipeline.preflight(budgetDataStructure, false));
+  auto* filterB = dynamic_cast<PipelineFilter*>(pipeline.at(1));
+  auto* filterC = dynamic_cast<PipelineFilter*>(pipeline.at(2));
+  REQUIRE(filterB != nullptr);
+  REQUIRE(filterC != nullptr);
+  REQUIRE(filterB->getErrors().empty());
+  REQUIRE(filterC->getErrors().size() == 1);
+  REQUIRE(filterC->getErrors()[0].code == -6100);
+
+  pipeline.setMemoryBudget(3 * k_ArrayBytes);
+  DataStructure executeDataStructure;
+  REQUIRE(pipeline.execute(executeDataStructure, false));
+  REQUIRE(executeDataStructure.getMemoryUsage() == 3 * k_ArrayBytes);
+}
+
+TEST_CASE("PipelineCopyOnWriteTest")
+{
+  const DataPath pathA({"A"});
+
+  Pipeline pipeline;
+  REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathA, 1)));
+  Arguments incrementArgs;
+  incrementArgs.insert(k_IncrementArrayPathKey, std::make_any<DataPath>(pathA));
+  REQUIRE(pipeline.push_back(std::make_unique<IncrementArrayTestFilter>(), incrementArgs));
+
+  DataStructure dataStructure;
+  REQUIRE(pipeline.execute(dataStructure, false));
+  REQUIRE(dataStructure.getDataRefAs<Int32Array>(pathA)[0] == 2);
+
+  // The in place edit of the second filter must not reach the first node's DataStructure
+  const auto& firstNodeArray = pipeline.at(0)->getDataStructure().getDataRefAs<Int32Array>(pathA);
+  REQUIRE(firstNodeArray[0] == 1);
+  REQUIRE(firstNodeArray.getDataStore() != std::as_const(dataStructure).getDataRefAs<Int32Array>(pathA).getDataStore());
+}
+
+TEST_CASE("PipelineCopyOnWriteReadOnlyTest")
+{
+  const DataPath pathA({"A"});
+  const DataPath pathSum({"Sum"});
+
+  Pipeline pipeline;
+  REQUIRE(pipeline.push_back(std::make_unique<FillArrayTestFilter>(), CreateFillArgs(pathA, 1)));
+  REQUIRE(pipeline.push_back(std::make_unique<SumArrayTestFilter>(), CreateSumArgs(pathA, pathSum)));
+
+  DataStructure dataStructure;
+  REQUIRE(pipeline.execute(dataStructure, false));
+  REQUIRE(std::as_const(dataStructure).getDataRefAs<Int32Array>(pathSum)[0] == 10);
+
+  // Selecting an array only to read it must not copy its DataStore
+  const auto& firstNodeArray = pipeline.at(0)->getDataStructure().getDataRefAs<Int32Array>(pathA);
+  const auto& finalArray = std::as_const(dataStructure).getDataRefAs<Int32Array>(pathA);
+  REQUIRE(firstNodeArray.getDataStore() == finalArray.getDataStore());
+}